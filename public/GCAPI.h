@@ -355,6 +355,60 @@ typedef enum JSGCParamKey {
    * This parameter is read-only.
    */
   JSGC_CHUNK_BYTES = 38,
+
+  /**
+   * The number of threads, including the main thread, to use for marking.
+   *
+   * Values greater than one enable parallel marking of the black part of the
+   * heap on helper threads. Must be between 1 and 16.
+   *
+   * Default: MarkingThreadCount
+   */
+  JSGC_MARKING_THREAD_COUNT = 39,
+
+  /**
+   * Whether black marking continues on a helper thread between the slices of
+   * an incremental GC, while the mutator runs.
+   *
+   * Marking only starts concurrently when the nursery is empty, and stops at
+   * the next minor or major GC slice. Objects the helper thread can't scan
+   * safely are left for the main thread to mark in the next slice.
+   *
+   * Default: ConcurrentMarking
+   */
+  JSGC_CONCURRENT_MARKING = 40,
+
+  /**
+   * The number of threads, including the main thread, to use for promoting
+   * nursery cells during a minor GC.
+   *
+   * Values greater than one let helper threads promote the plain objects and
+   * arrays reachable from the store buffer in parallel. Must be between 1 and
+   * 16.
+   *
+   * Default: TenuringThreadCount
+   */
+  JSGC_TENURING_THREAD_COUNT = 41,
+
+  /**
+   * Percentage of free cells in arenas of compactable kinds above which a
+   * non-shrinking GC will also compact the heap after sweeping. Zero disables
+   * this. Only zones that are not preserving JIT code are considered.
+   *
+   * Default: AutoCompactingThreshold
+   */
+  JSGC_AUTO_COMPACTING_THRESHOLD = 42,
+
+  /**
+   * Whether a major GC merges identical tenured strings.
+   *
+   * When enabled, live linear strings in each swept zone are hashed and
+   * duplicates are turned into dependent strings sharing a single copy of
+   * the chars. The pass is bounded by the slice budget.
+   *
+   * Default: TenuredStringDeduplication
+   */
+  JSGC_TENURED_STRING_DEDUPLICATION = 43,
 } JSGCParamKey;
 
 /*
@@ -788,6 +842,77 @@ using GCNurseryCollectionCallback = void (*)(JSContext* cx,
 extern JS_PUBLIC_API GCNurseryCollectionCallback SetGCNurseryCollectionCallback(
     JSContext* cx, GCNurseryCollectionCallback callback);
 
+/**
+ * The time spent in one GC phase during a major GC slice. |name| is the
+ * phase's path as used in the JSON output, e.g. "sweep.sweep_string".
+ */
+struct GCTelemetryPhaseTime {
+  const char* name;
+  mozilla::TimeDuration time;
+};
+
+enum class GCTelemetryEventKind { MajorSlice, MinorGC };
+
+/**
+ * A structured record of a single major GC slice or nursery collection, for
+ * embedders that want a machine-readable stream of GC events.
+ *
+ * Records are only built while a telemetry callback is installed. Pointers in
+ * a record are only valid for the duration of the callback.
+ */
+struct GCTelemetryRecord {
+  GCTelemetryEventKind kind = GCTelemetryEventKind::MajorSlice;
+  GCReason reason = GCReason::NO_REASON;
+
+  // The major GC number for slices, or the minor GC number for nursery
+  // collections.
+  uint64_t gcNumber = 0;
+
+  mozilla::TimeStamp start;
+  mozilla::TimeStamp end;
+
+  // The following fields are only set for major GC slices.
+
+  // The index of this slice within its GC and whether it finished the GC.
+  uint32_t sliceNumber = 0;
+  bool isLastSlice = false;
+
+  // The slice budget. At most one of these is set; both are -1 for an
+  // unlimited budget.
+  int64_t timeBudgetMS = -1;
+  int64_t workBudget = -1;
+
+  // The size of the GC heap at the start and end of the slice. Memory released
+  // by background sweeping after the slice ends is not included.
+  size_t heapBytesBefore = 0;
+  size_t heapBytesAfter = 0;
+
+  // Time spent in each phase that ran during the slice.
+  const GCTelemetryPhaseTime* phaseTimes = nullptr;
+  size_t phaseCount = 0;
+
+  // The following fields are only set for nursery collections.
+
+  // Bytes allocated in the nursery since the previous collection and the bytes
+  // of those that were promoted to the tenured heap.
+  size_t nurseryUsedBytes = 0;
+  size_t tenuredBytes = 0;
+  double promotionRate = 0.0;
+};
+
+using GCTelemetryCallback = void (*)(JSContext* cx,
+                                     const GCTelemetryRecord& record,
+                                     void* data);
+
+/**
+ * Set a callback to be called with a GCTelemetryRecord at the end of every
+ * major GC slice and every nursery collection, or pass nullptr to remove it.
+ * The callback must not GC or run JS.
+ */
+extern JS_PUBLIC_API void SetGCTelemetryCallback(JSContext* cx,
+                                                 GCTelemetryCallback callback,
+                                                 void* data);
+
 typedef void (*DoCycleCollectionCallback)(JSContext* cx);
 
 /**
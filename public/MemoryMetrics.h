@@ -651,6 +651,8 @@ struct ZoneStats {
     unusedGCThings.addSizes(other.unusedGCThings);
     stringInfo.add(other.stringInfo);
     shapeInfo.add(other.shapeInfo);
+    tenuredStringsDeduplicated += other.tenuredStringsDeduplicated;
+    tenuredStringDedupBytesSaved += other.tenuredStringDedupBytesSaved;
   }
 
   size_t sizeOfLiveGCThings() const {
@@ -691,6 +693,12 @@ struct ZoneStats {
   CodeSizes code;
   void* extra = nullptr;  // This field can be used by embedders.
 
+  // Totals for tenured string deduplication (JSGC_TENURED_STRING_DEDUPLICATION)
+  // in this zone. The bytes have already been freed, so they are not part of
+  // any of the sizes above.
+  size_t tenuredStringsDeduplicated = 0;
+  size_t tenuredStringDedupBytesSaved = 0;
+
   typedef js::HashMap<JSString*, StringInfo,
                       js::InefficientNonFlatteningStringHashPolicy,
                       js::SystemAllocPolicy>
@@ -0,0 +1,62 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * JIT profiles let an embedding carry script hotness across runs, so that
+ * scripts that were hot in a previous run are JIT-compiled without waiting for
+ * them to warm up again.
+ *
+ * A profile records the warm-up counts of the scripts that have run so far,
+ * which of them were Ion-compiled and which were the single target of a call
+ * site, so that they can be compiled ahead of their callers being inlined.
+ * Scripts are identified by their source filename, a hash of their source
+ * text and their position within the source. It is only meaningful for the same build of the engine loading the
+ * same, unchanged sources, and it uses native byte order. Loading a profile
+ * that doesn't match the current scripts is harmless: unmatched entries are
+ * ignored, and scripts without a matching entry warm up as usual.
+ *
+ * These APIs are experimental because the contents of the profile may grow to
+ * include more of the information gathered by the JITs.
+ */
+
+#ifndef js_experimental_JitProfile_h
+#define js_experimental_JitProfile_h
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t
+
+#include "jstypes.h"  // JS_PUBLIC_API
+
+#include "js/Transcoding.h"  // JS::TranscodeBuffer
+
+struct JS_PUBLIC_API JSContext;
+
+namespace JS {
+
+/**
+ * Write a profile of the warm-up counts of all scripts in the runtime to
+ * |buffer|, which must be empty.
+ */
+extern JS_PUBLIC_API bool SaveJitProfile(JSContext* cx,
+                                         TranscodeBuffer& buffer);
+
+/**
+ * Load a profile produced by SaveJitProfile, replacing any profile already
+ * loaded. Scripts that start running after this call begin with the warm-up
+ * count recorded for them. Reports an error and returns false if the data is
+ * not a valid profile.
+ */
+extern JS_PUBLIC_API bool LoadJitProfile(JSContext* cx, const uint8_t* data,
+                                         size_t length);
+
+/**
+ * Discard any profile loaded by LoadJitProfile.
+ */
+extern JS_PUBLIC_API void ClearJitProfile(JSContext* cx);
+
+}  // namespace JS
+
+#endif  // js_experimental_JitProfile_h
@@ -4306,7 +4306,8 @@ ArrayObject* js::NewCopiedArrayForCallingAllocationSite(
 
 ArrayObject* js::NewArrayWithGroup(JSContext* cx, uint32_t length,
                                    HandleObjectGroup group,
-                                   bool convertDoubleElements) {
+                                   bool convertDoubleElements,
+                                   gc::AllocSite* site /* = nullptr */) {
   // Ion can call this with a group from a different realm when calling
   // another realm's Array constructor.
   Maybe<AutoRealm> ar;
@@ -4315,11 +4316,15 @@ ArrayObject* js::NewArrayWithGroup(JSContext* cx, uint32_t length,
     ar.emplace(cx, group);
   }
 
-  ArrayObject* res = NewFullyAllocatedArrayTryUseGroup(cx, group, length);
+  NewObjectKind newKind = NewKindForAllocSite(site, GenericObject);
+  ArrayObject* res =
+      NewFullyAllocatedArrayTryUseGroup(cx, group, length, newKind);
   if (!res) {
     return nullptr;
   }
 
+  SetNurseryAllocSite(cx, res, site);
+
   if (convertDoubleElements) {
     res->setShouldConvertDoubleElements();
   }
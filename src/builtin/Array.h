@@ -116,7 +116,8 @@ extern ArrayObject* NewCopiedArrayForCallingAllocationSite(
 
 extern ArrayObject* NewArrayWithGroup(JSContext* cx, uint32_t length,
                                       HandleObjectGroup group,
-                                      bool convertDoubleElements);
+                                      bool convertDoubleElements,
+                                      gc::AllocSite* site = nullptr);
 
 extern bool ToLength(JSContext* cx, HandleValue v, uint64_t* out);
 
@@ -43,11 +43,14 @@
 #  include "frontend/TokenStream.h"
 #endif
 #include "gc/Allocator.h"
+#include "gc/GCLock.h"
 #include "gc/Zone.h"
 #include "jit/BaselineJIT.h"
 #include "jit/InlinableNatives.h"
 #include "jit/Ion.h"
+#include "jit/IonScript.h"
 #include "jit/JitRealm.h"
+#include "jit/JitScript.h"
 #include "js/Array.h"        // JS::NewArrayObject
 #include "js/ArrayBuffer.h"  // JS::{DetachArrayBuffer,GetArrayBufferLengthAndData,NewArrayBufferWithContents}
 #include "js/CharacterEncoding.h"
@@ -98,6 +101,8 @@
 #include "vm/TraceLogging.h"
 #include "wasm/AsmJS.h"
 #include "wasm/WasmBaselineCompile.h"
+#include "wasm/WasmCodeCache.h"
+#include "wasm/WasmCompile.h"
 #include "wasm/WasmCraneliftCompile.h"
 #include "wasm/WasmInstance.h"
 #include "wasm/WasmIonCompile.h"
@@ -582,6 +587,293 @@ static bool MinorGC(JSContext* cx, unsigned argc, Value* vp) {
   return true;
 }
 
+static bool NurseryTenurings(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  Nursery& nursery = cx->nursery();
+  nursery.setRecordTenurings(true);
+  cx->minorGC(JS::GCReason::API);
+  nursery.setRecordTenurings(false);
+
+  // Copy the records as creating the result may trigger another collection.
+  Nursery::TenuringRecords records;
+  if (!records.appendAll(nursery.tenuringRecords())) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  RootedObject result(cx, NewDenseEmptyArray(cx));
+  if (!result) {
+    return false;
+  }
+
+  RootedObject info(cx);
+  RootedString className(cx);
+  RootedValue pretenured(cx);
+  for (size_t i = 0; i < records.length(); i++) {
+    const Nursery::TenuringRecord& record = records[i];
+
+    info = JS_NewPlainObject(cx);
+    if (!info) {
+      return false;
+    }
+
+    className = JS_NewStringCopyZ(cx, record.clasp->name);
+    if (!className) {
+      return false;
+    }
+
+    pretenured.setBoolean(record.pretenured);
+    if (!JS_DefineProperty(cx, info, "className", className,
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, info, "count", record.count,
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, info, "pretenured", pretenured,
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineElement(cx, result, i, info, JSPROP_ENUMERATE)) {
+      return false;
+    }
+  }
+
+  args.rval().setObject(*result);
+  return true;
+}
+
+static bool TenuringThreadStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  cx->minorGC(JS::GCReason::API);
+
+  // Copy the statistics as creating the result may trigger another collection.
+  const gc::ParallelTenuring& pt = cx->runtime()->gc.parallelTenuring;
+  Vector<gc::TenuringThreadStats, 0, SystemAllocPolicy> stats;
+  for (size_t i = 0; i < pt.lastThreadCount(); i++) {
+    if (!stats.append(pt.lastStats(i))) {
+      ReportOutOfMemory(cx);
+      return false;
+    }
+  }
+
+  RootedObject result(cx, NewDenseEmptyArray(cx));
+  if (!result) {
+    return false;
+  }
+
+  RootedObject info(cx);
+  for (size_t i = 0; i < stats.length(); i++) {
+    info = JS_NewPlainObject(cx);
+    if (!info) {
+      return false;
+    }
+
+    if (!JS_DefineProperty(cx, info, "bytes", double(stats[i].tenuredBytes),
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, info, "cells", double(stats[i].tenuredCells),
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, info, "stolen", double(stats[i].stolenObjects),
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineElement(cx, result, i, info, JSPROP_ENUMERATE)) {
+      return false;
+    }
+  }
+
+  args.rval().setObject(*result);
+  return true;
+}
+
+static bool MarkingThreadStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  // Copy the statistics as creating the result may trigger another collection.
+  const gc::ParallelMarker& pm = cx->runtime()->gc.parallelMarker;
+  Vector<gc::MarkingThreadStats, 0, SystemAllocPolicy> stats;
+  for (size_t i = 0; i < pm.lastThreadCount(); i++) {
+    if (!stats.append(pm.lastStats(i))) {
+      ReportOutOfMemory(cx);
+      return false;
+    }
+  }
+
+  RootedObject result(cx, NewDenseEmptyArray(cx));
+  if (!result) {
+    return false;
+  }
+
+  RootedObject info(cx);
+  for (size_t i = 0; i < stats.length(); i++) {
+    info = JS_NewPlainObject(cx);
+    if (!info) {
+      return false;
+    }
+
+    if (!JS_DefineProperty(cx, info, "cells", double(stats[i].markedCells),
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, info, "stolen", double(stats[i].stolenWords),
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, info, "time",
+                           stats[i].duration.ToMilliseconds(),
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineElement(cx, result, i, info, JSPROP_ENUMERATE)) {
+      return false;
+    }
+  }
+
+  args.rval().setObject(*result);
+  return true;
+}
+
+static JSObject* NewAllocSiteInfo(JSContext* cx, const gc::AllocSite& site) {
+  RootedObject info(cx, JS_NewPlainObject(cx));
+  if (!info) {
+    return nullptr;
+  }
+
+  const char* stateName = gc::AllocSite::stateName(site.state());
+  RootedString state(cx, JS_NewStringCopyZ(cx, stateName));
+  if (!state) {
+    return nullptr;
+  }
+
+  if (!JS_DefineProperty(cx, info, "state", state, JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, info, "allocs", double(site.lastAllocCount()),
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, info, "tenured", double(site.lastTenuredCount()),
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, info, "stateChanges",
+                         double(site.stateChangeCount()), JSPROP_ENUMERATE)) {
+    return nullptr;
+  }
+
+  return info;
+}
+
+static bool AllocSiteStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  RootedObject callee(cx, &args.callee());
+
+  if (args.length() > 1) {
+    ReportUsageErrorASCII(cx, callee, "Wrong number of arguments");
+    return false;
+  }
+
+  // Process the sites that allocated since the last collection.
+  cx->minorGC(JS::GCReason::API);
+
+  if (args.length() == 0) {
+    RootedObject result(cx, JS_NewPlainObject(cx));
+    if (!result) {
+      return false;
+    }
+
+    static const struct {
+      const char* name;
+      JS::TraceKind kind;
+    } kinds[] = {{"object", JS::TraceKind::Object},
+                 {"string", JS::TraceKind::String},
+                 {"bigint", JS::TraceKind::BigInt}};
+
+    RootedObject info(cx);
+    for (const auto& k : kinds) {
+      info = NewAllocSiteInfo(cx, *cx->zone()->unknownAllocSite(k.kind));
+      if (!info ||
+          !JS_DefineProperty(cx, result, k.name, info, JSPROP_ENUMERATE)) {
+        return false;
+      }
+    }
+
+    args.rval().setObject(*result);
+    return true;
+  }
+
+  RootedScript script(cx, TestingFunctionArgumentToScript(cx, args[0]));
+  if (!script) {
+    return false;
+  }
+
+  RootedObject result(cx, NewDenseEmptyArray(cx));
+  if (!result) {
+    return false;
+  }
+
+  if (!script->hasJitScript()) {
+    args.rval().setObject(*result);
+    return true;
+  }
+
+  RootedObject info(cx);
+  RootedString kind(cx);
+  jit::JitScript* jitScript = script->jitScript();
+  for (size_t i = 0; i < jitScript->numICEntries(); i++) {
+    jit::ICFallbackStub* stub = jitScript->icEntry(i).fallbackStub();
+
+    gc::AllocSite* site;
+    const char* kindName;
+    if (stub->isNewArray_Fallback()) {
+      site = stub->toNewArray_Fallback()->allocSite();
+      kindName = "array";
+    } else if (stub->isNewObject_Fallback()) {
+      site = stub->toNewObject_Fallback()->allocSite();
+      kindName = "object";
+    } else {
+      continue;
+    }
+
+    info = NewAllocSiteInfo(cx, *site);
+    if (!info) {
+      return false;
+    }
+
+    kind = JS_NewStringCopyZ(cx, kindName);
+    if (!kind) {
+      return false;
+    }
+
+    jsbytecode* pc = script->offsetToPC(site->pcOffset());
+    if (!JS_DefineProperty(cx, info, "kind", kind, JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, info, "pcOffset", site->pcOffset(),
+                           JSPROP_ENUMERATE) ||
+        !JS_DefineProperty(cx, info, "line", PCToLineNumber(script, pc),
+                           JSPROP_ENUMERATE) ||
+        !NewbornArrayPush(cx, result, ObjectValue(*info))) {
+      return false;
+    }
+  }
+
+  args.rval().setObject(*result);
+  return true;
+}
+
+static bool HelperThreadArenaStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  js::gc::GCRuntime& gc = cx->runtime()->gc;
+  js::gc::GCRuntime::HelperThreadArenaStats stats;
+  {
+    AutoLockGC lock(&gc);
+    stats = gc.helperThreadArenaStats.ref();
+  }
+
+  RootedObject info(cx, JS_NewPlainObject(cx));
+  if (!info) {
+    return false;
+  }
+
+  if (!JS_DefineProperty(cx, info, "batchSize",
+                         double(js::gc::HelperThreadArenaBatchSize),
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, info, "batches", double(stats.batches),
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, info, "unusedArenas", double(stats.unusedArenas),
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, info, "cellsMerged", double(stats.cellsMerged),
+                         JSPROP_ENUMERATE)) {
+    return false;
+  }
+
+  args.rval().setObject(*info);
+  return true;
+}
+
 #define FOR_EACH_GC_PARAM(_)                                               \
   _("maxBytes", JSGC_MAX_BYTES, true)                                      \
   _("minNurseryBytes", JSGC_MIN_NURSERY_BYTES, true)                       \
@@ -618,7 +910,12 @@ static bool MinorGC(JSContext* cx, unsigned argc, Value* vp) {
   _("zoneAllocDelayKB", JSGC_ZONE_ALLOC_DELAY_KB, true)                    \
   _("mallocThresholdBase", JSGC_MALLOC_THRESHOLD_BASE, true)               \
   _("mallocGrowthFactor", JSGC_MALLOC_GROWTH_FACTOR, true)                 \
-  _("chunkBytes", JSGC_CHUNK_BYTES, false)
+  _("chunkBytes", JSGC_CHUNK_BYTES, false)                                  \
+  _("markingThreadCount", JSGC_MARKING_THREAD_COUNT, true)                 \
+  _("concurrentMarking", JSGC_CONCURRENT_MARKING, true)                    \
+  _("tenuringThreadCount", JSGC_TENURING_THREAD_COUNT, true)               \
+  _("autoCompactingThreshold", JSGC_AUTO_COMPACTING_THRESHOLD, true)       \
+  _("tenuredStringDeduplication", JSGC_TENURED_STRING_DEDUPLICATION, true)
 
 static const struct ParamInfo {
   const char* name;
@@ -1147,6 +1444,74 @@ static bool WasmLoadedFromCache(JSContext* cx, unsigned argc, Value* vp) {
   return WasmReturnFlag(cx, argc, vp, Flag::Deserialized);
 }
 
+static bool WasmCodeCacheStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  RootedObject stats(cx, JS_NewPlainObject(cx));
+  if (!stats) {
+    return false;
+  }
+
+  wasm::CodeCacheStats cacheStats = wasm::GetCodeCacheStats();
+  if (!JS_DefineProperty(cx, stats, "enabled",
+                         wasm::CodeCacheEnabled() ? JS::TrueHandleValue
+                                                  : JS::FalseHandleValue,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "hits", cacheStats.hits,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "misses", cacheStats.misses,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "stores", cacheStats.stores,
+                         JSPROP_ENUMERATE)) {
+    return false;
+  }
+
+  args.rval().setObject(*stats);
+  return true;
+}
+
+static bool WasmLazyTieringStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  RootedObject stats(cx, JS_NewPlainObject(cx));
+  if (!stats) {
+    return false;
+  }
+
+  wasm::LazyTieringStats tieringStats = wasm::GetLazyTieringStats();
+  if (!JS_DefineProperty(cx, stats, "hotFuncs", tieringStats.hotFuncs,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "started", tieringStats.started,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "finished", tieringStats.finished,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "failed", tieringStats.failed,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "maxBatches", tieringStats.maxBatches,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "optimizedFuncs",
+                         tieringStats.optimizedFuncs, JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "forwardedFuncs",
+                         tieringStats.forwardedFuncs, JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "optimizedBytes",
+                         double(tieringStats.optimizedBytes),
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "forwardedBytes",
+                         double(tieringStats.forwardedBytes),
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "compileTimeMs",
+                         double(tieringStats.compileTimeUs) / 1000,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "savedTimeMs",
+                         double(tieringStats.savedTimeUs) / 1000,
+                         JSPROP_ENUMERATE)) {
+    return false;
+  }
+
+  args.rval().setObject(*stats);
+  return true;
+}
+
 static bool IsLazyFunction(JSContext* cx, unsigned argc, Value* vp) {
   CallArgs args = CallArgsFromVp(argc, vp);
   if (args.length() != 1) {
@@ -3211,6 +3576,13 @@ static bool GetJitCompilerOptions(JSContext* cx, unsigned argc, Value* vp) {
   JIT_COMPILER_OPTIONS(JIT_COMPILER_MATCH);
 #undef JIT_COMPILER_MATCH
 
+  // WarpBuilder can only be selected at startup, so this isn't an option that
+  // setJitCompilerOption understands.
+  value.setInt32(jit::JitOptions.warpBuilder);
+  if (!JS_SetProperty(cx, info, "warp.enable", value)) {
+    return false;
+  }
+
   args.rval().setObject(*info);
   return true;
 }
@@ -5878,6 +6250,184 @@ static bool BaselineCompile(JSContext* cx, unsigned argc, Value* vp) {
   return true;
 }
 
+static bool GetBailoutReport(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  RootedObject callee(cx, &args.callee());
+
+  if (args.length() != 1) {
+    ReportUsageErrorASCII(cx, callee, "Wrong number of arguments");
+    return false;
+  }
+
+  RootedScript script(cx, TestingFunctionArgumentToScript(cx, args[0]));
+  if (!script) {
+    return false;
+  }
+
+  RootedObject report(cx, JS_NewPlainObject(cx));
+  if (!report) {
+    return false;
+  }
+
+  RootedObject sites(cx, NewDenseEmptyArray(cx));
+  if (!sites) {
+    return false;
+  }
+
+  uint32_t numInvalidations = 0;
+  uint32_t ionCompileDelay = 0;
+  const auto* data =
+      script->hasJitScript() ? script->jitScript()->bailoutData() : nullptr;
+  if (data) {
+    numInvalidations = data->numInvalidations;
+    ionCompileDelay = data->ionCompileDelay;
+
+    RootedObject site(cx);
+    RootedValue val(cx);
+    for (const jit::BailoutSite& s : data->sites) {
+      site = JS_NewPlainObject(cx);
+      if (!site) {
+        return false;
+      }
+
+      jsbytecode* pc = script->offsetToPC(s.pcOffset);
+      JSString* kind = JS_NewStringCopyZ(cx, BailoutKindString(s.kind));
+      if (!kind) {
+        return false;
+      }
+      val.setString(kind);
+      if (!JS_DefineProperty(cx, site, "kind", val, JSPROP_ENUMERATE) ||
+          !JS_DefineProperty(cx, site, "pcOffset", s.pcOffset,
+                             JSPROP_ENUMERATE) ||
+          !JS_DefineProperty(cx, site, "line", PCToLineNumber(script, pc),
+                             JSPROP_ENUMERATE) ||
+          !JS_DefineProperty(cx, site, "count", s.count, JSPROP_ENUMERATE) ||
+          !JS_DefineProperty(cx, site, "licmDisabled",
+                             s.licmDisabled ? TrueHandleValue
+                                            : FalseHandleValue,
+                             JSPROP_ENUMERATE)) {
+        return false;
+      }
+
+      if (!NewbornArrayPush(cx, sites, ObjectValue(*site))) {
+        return false;
+      }
+    }
+  }
+
+  if (!JS_DefineProperty(cx, report, "invalidations", numInvalidations,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, report, "compileDelay", ionCompileDelay,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, report, "sites", sites, JSPROP_ENUMERATE)) {
+    return false;
+  }
+
+  args.rval().setObject(*report);
+  return true;
+}
+
+static bool GetOsrEntryInfo(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  RootedObject callee(cx, &args.callee());
+
+  if (args.length() != 1) {
+    ReportUsageErrorASCII(cx, callee, "Wrong number of arguments");
+    return false;
+  }
+
+  RootedScript script(cx, TestingFunctionArgumentToScript(cx, args[0]));
+  if (!script) {
+    return false;
+  }
+
+  if (!script->hasJitScript() || !script->jitScript()->hasIonScript()) {
+    args.rval().setUndefined();
+    return true;
+  }
+
+  jit::IonScript* ion = script->jitScript()->ionScript();
+
+  RootedObject info(cx, JS_NewPlainObject(cx));
+  if (!info) {
+    return false;
+  }
+
+  uint32_t line = 0;
+  if (jsbytecode* osrPc = ion->osrPc()) {
+    line = PCToLineNumber(script, osrPc);
+  }
+  if (!JS_DefineProperty(cx, info, "osr",
+                         ion->osrPc() ? TrueHandleValue : FalseHandleValue,
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, info, "line", line, JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, info, "specializedValues",
+                         ion->numSpecializedOsrValues(), JSPROP_ENUMERATE)) {
+    return false;
+  }
+
+  args.rval().setObject(*info);
+  return true;
+}
+
+static bool GetStubCorpusStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  size_t stubs = 0;
+  size_t hits = 0;
+  if (jit::JitZone* jitZone = cx->zone()->jitZone()) {
+    stubs = jitZone->baselineCacheIRStubCorpusLength();
+    hits = jitZone->baselineCacheIRStubCorpusHits();
+  }
+
+  RootedObject stats(cx, JS_NewPlainObject(cx));
+  if (!stats) {
+    return false;
+  }
+
+  if (!JS_DefineProperty(cx, stats, "stubs", double(stubs),
+                         JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "hits", double(hits), JSPROP_ENUMERATE)) {
+    return false;
+  }
+
+  args.rval().setObject(*stats);
+  return true;
+}
+
+static bool GetJitCodeStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  RootedObject stats(cx, JS_NewPlainObject(cx));
+  if (!stats) {
+    return false;
+  }
+
+  double ion = 0, baseline = 0, regexp = 0, other = 0, pools = 0;
+  if (jit::JitZone* jitZone = cx->zone()->jitZone()) {
+    const jit::ExecutableAllocator& execAlloc = jitZone->execAlloc();
+    ion = execAlloc.codeBytes(jit::CodeKind::Ion);
+    baseline = execAlloc.codeBytes(jit::CodeKind::Baseline);
+    regexp = execAlloc.codeBytes(jit::CodeKind::RegExp);
+    other = execAlloc.codeBytes(jit::CodeKind::Other);
+    pools = execAlloc.totalPoolBytes();
+  }
+
+  if (!JS_DefineProperty(cx, stats, "ion", ion, JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "baseline", baseline, JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "regexp", regexp, JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "other", other, JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "pools", pools, JSPROP_ENUMERATE) ||
+      !JS_DefineProperty(cx, stats, "budget",
+                         double(jit::JitOptions.jitCodeBudgetKB) * 1024,
+                         JSPROP_ENUMERATE)) {
+    return false;
+  }
+
+  args.rval().setObject(*stats);
+  return true;
+}
+
 static bool ClearKeptObjects(JSContext* cx, unsigned argc, Value* vp) {
   CallArgs args = CallArgsFromVp(argc, vp);
   JS::ClearKeptObjects(cx);
@@ -6052,6 +6602,43 @@ static const JSFunctionSpecWithHelp TestingFunctions[] = {
 "  Run a minor collector on the Nursery. When aboutToOverflow is true, marks\n"
 "  the store buffer as about-to-overflow before collecting."),
 
+    JS_FN_HELP("nurseryTenurings", NurseryTenurings, 0, 0,
+"nurseryTenurings()",
+"  Run a minor collection and return an array describing the object groups\n"
+"  whose objects were tenured. Each element has the group's className, the\n"
+"  number of objects tenured and whether the group is now pretenured."),
+
+    JS_FN_HELP("tenuringThreadStats", TenuringThreadStats, 0, 0,
+"tenuringThreadStats()",
+"  Run a minor collection and return an array with the number of bytes and\n"
+"  cells each thread tenured and the number of objects it stole from other\n"
+"  threads. The array is empty if the collection didn't tenure in parallel."),
+
+    JS_FN_HELP("helperThreadArenaStats", HelperThreadArenaStats, 0, 0,
+"helperThreadArenaStats()",
+"  Return an object with the number of arenas a helper thread allocates at\n"
+"  once (batchSize), the number of batches allocated so far, and the number\n"
+"  of unused arenas released and of cells found when helper-thread zones were\n"
+"  merged into their targets."),
+
+    JS_FN_HELP("markingThreadStats", MarkingThreadStats, 0, 0,
+"markingThreadStats()",
+"  Return an array with the number of cells each thread marked, the number\n"
+"  of mark stack words it stole from other threads and the time it spent\n"
+"  marking in milliseconds, for the last slice that marked in parallel. The\n"
+"  array is empty if no slice has marked in parallel since the number of\n"
+"  marking threads was last set."),
+
+    JS_FN_HELP("allocSiteStats", AllocSiteStats, 1, 0,
+"allocSiteStats([fun])",
+"  Run a minor collection and return the state of allocation sites, as used\n"
+"  for pretenuring. With a function, return an array describing the object\n"
+"  and array literal sites in its script. Otherwise return the current zone's\n"
+"  catch-all object, string and bigint sites. Each site has its state\n"
+"  ('unknown' or 'longLived'), the number of cells it allocated in the\n"
+"  nursery and how many were tenured the last time its survival rate was\n"
+"  looked at, and the number of times its state changed."),
+
     JS_FN_HELP("maybegc", ::MaybeGC, 0, 0,
 "maybegc()",
 "  Hint to the engine that now is an ok time to run the garbage collector.\n"),
@@ -6502,6 +7089,20 @@ gc::ZealModeHelpText),
 "  Returns a boolean indicating whether a given module was deserialized directly from a\n"
 "  cache (as opposed to compiled from bytecode)."),
 
+    JS_FN_HELP("wasmCodeCacheStats", WasmCodeCacheStats, 0, 0,
+"wasmCodeCacheStats()",
+"  Returns an object with the state of the on-disk wasm code cache enabled by\n"
+"  --wasm-code-cache: whether it's enabled, and its hit, miss and store counts."),
+
+    JS_FN_HELP("wasmLazyTieringStats", WasmLazyTieringStats, 0, 0,
+"wasmLazyTieringStats()",
+"  Returns an object with counters for lazy tier-2 compilation, which is enabled\n"
+"  by --wasm-tier-up-threshold: the number of functions that got hot, of lazy\n"
+"  tier-2 batches started, finished and failed, the most batches a module can\n"
+"  have, the numbers and bytecode sizes of the functions they optimized and\n"
+"  still left in tier-1 code, the time spent compiling and an estimate of the\n"
+"  time saved by not optimizing everything."),
+
     JS_FN_HELP("wasmReftypesEnabled", WasmReftypesEnabled, 1, 0,
 "wasmReftypesEnabled()",
 "  Returns a boolean indicating whether the WebAssembly reftypes proposal is enabled."),
@@ -6895,6 +7496,35 @@ gc::ZealModeHelpText),
 "  The interpreter will enter the new jitcode at the loop header unless\n"
 "  baselineCompile returned a string or threw an error.\n"),
 
+    JS_FN_HELP("bailoutReport", GetBailoutReport, 1, 0,
+"bailoutReport(fun)",
+"  Returns an object describing the bailouts from Ion code into the given\n"
+"  function or script: the number of invalidations due to frequent bailouts,\n"
+"  the number of compilation attempts still skipped because of them, and a\n"
+"  list of bailout sites with their kind, location, count and whether LICM is\n"
+"  disabled for the loop starting there.\n"),
+
+    JS_FN_HELP("osrEntryInfo", GetOsrEntryInfo, 1, 0,
+"osrEntryInfo(fun)",
+"  Returns undefined if the given function or script has no Ion code.\n"
+"  Otherwise returns an object describing how the Ion code was compiled:\n"
+"  whether it was compiled for OSR, the line of the loop it can be entered\n"
+"  at, and the number of values in the OSR entry block that were specialized\n"
+"  on the types of the frame the compilation was triggered from.\n"),
+
+    JS_FN_HELP("stubCorpusStats", GetStubCorpusStats, 0, 0,
+"stubCorpusStats()",
+"  Returns the number of stubs in the current zone's Baseline CacheIR stub\n"
+"  corpus (see --cacheir-stub-corpus) and the number of Baseline IC stubs\n"
+"  that were attached using code from it.\n"),
+
+    JS_FN_HELP("jitCodeStats", GetJitCodeStats, 0, 0,
+"jitCodeStats()",
+"  Returns the number of bytes of JIT code in the current zone per kind of\n"
+"  code (ion, baseline, regexp and other), the number of bytes allocated for\n"
+"  code pools, and the zone's Baseline and Ion code budget in bytes (0 if\n"
+"  there's no limit).\n"),
+
     JS_FN_HELP("markObjectPropertiesUnknown", MarkObjectPropertiesUnknown, 1, 0,
 "markObjectPropertiesUnknown(obj)",
 "  Mark all objects in obj's object group as having unknown properties.\n"),
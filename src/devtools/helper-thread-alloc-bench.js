@@ -0,0 +1,75 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Measures how fast helper threads allocate GC cells, as tenured cells per
+// second of wall-clock time, while one or more off-thread parses run at once.
+//
+// Usage:
+//   js devtools/helper-thread-alloc-bench.js [functions [iterations]]
+//
+// Each sample starts |jobs| off-thread parses of a source with |functions|
+// functions (2000 by default) and waits for all of them. Every function
+// allocates a script, scopes, atoms and literal templates. The cell count is
+// taken from helperThreadArenaStats() when the parse zones are merged, so it
+// only includes cells allocated on helper threads. Each row reports the
+// number of concurrent jobs, the median time in milliseconds, the cells
+// allocated per job, the median rate in millions of cells per second and the
+// number of arena batches the parses allocated.
+
+const functions = scriptArgs.length > 0 ? parseInt(scriptArgs[0]) : 2000;
+const iterations = scriptArgs.length > 1 ? parseInt(scriptArgs[1]) : 10;
+
+function makeSource(functions, salt) {
+  let source = "";
+  for (let i = 0; i < functions; i++) {
+    source += `function f${i}() { return [${i}, 'atom${salt}_${i}', ` +
+              `{p${i}: ${i}}]; }\n`;
+  }
+  return source;
+}
+
+function measure(sources) {
+  gc();
+  let before = helperThreadArenaStats();
+  let start = performance.now();
+  let ids = sources.map(source => offThreadCompileScript(source));
+  for (let id of ids) {
+    runOffThreadScript(id);
+  }
+  let time = performance.now() - start;
+  let after = helperThreadArenaStats();
+  return {
+    time,
+    cells: after.cellsMerged - before.cellsMerged,
+    batches: after.batches - before.batches,
+  };
+}
+
+function median(values) {
+  values.sort((a, b) => a - b);
+  return values[values.length >> 1];
+}
+
+print("jobs\ttime(ms)\tcells/job\tMcells/s\tbatches");
+for (let jobs of [1, 2, 4, 8]) {
+  let sources = [];
+  for (let i = 0; i < jobs; i++) {
+    sources.push(makeSource(functions, i));
+  }
+
+  let times = [];
+  let rates = [];
+  let cells = 0;
+  let batches = 0;
+  for (let i = 0; i < iterations; i++) {
+    let result = measure(sources);
+    times.push(result.time);
+    rates.push(result.cells / result.time / 1000);
+    cells = result.cells / jobs;
+    batches = result.batches;
+  }
+
+  print([jobs, median(times).toFixed(2), Math.round(cells),
+         median(rates).toFixed(2), batches].join("\t"));
+}
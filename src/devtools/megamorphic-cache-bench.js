@@ -0,0 +1,97 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Measures megamorphic property loads, which are served by the runtime-wide
+// megamorphic cache, for sites seeing more than ten receiver shapes.
+//
+// Usage:
+//   js devtools/megamorphic-cache-bench.js [loads [iterations]]
+//
+// Each row reports the kind of receiver, the number of receiver shapes seen
+// by the load site and the median time per load in nanoseconds. Compare with
+// a shell built from before the cache was added to see the cost of the
+// generic lookup.
+
+const loads = scriptArgs.length > 0 ? parseInt(scriptArgs[0]) : 5000000;
+const iterations = scriptArgs.length > 1 ? parseInt(scriptArgs[1]) : 5;
+
+// Objects that have |x| in a fixed slot when |extra| is small, and in a
+// dynamic slot once it is larger than the number of fixed slots.
+function makeObjects(count, extra) {
+  let objs = [];
+  for (let i = 0; i < count; i++) {
+    let o = {};
+    for (let j = 0; j < extra; j++) {
+      o["p" + i + "_" + j] = j;
+    }
+    o.x = i;
+    objs.push(o);
+  }
+  return objs;
+}
+
+// Config-style objects in dictionary mode, each with its own shape.
+function makeDictionaries(count) {
+  let objs = makeObjects(count, 4);
+  for (let i = 0; i < count; i++) {
+    // Deleting a property other than the last one converts the object.
+    delete objs[i]["p" + i + "_0"];
+  }
+  return objs;
+}
+
+// Each kind gets its own copy of the load site, so that sites don't share
+// IC state between kinds.
+function makeLoop() {
+  return new Function("objs", "n", `
+    let sum = 0;
+    let len = objs.length;
+    for (let i = 0; i < n; i++) {
+      sum += objs[i % len].x;
+    }
+    return sum;
+  `);
+}
+
+function measure(loop, objs) {
+  let start = performance.now();
+  let sum = loop(objs, loads);
+  let time = performance.now() - start;
+
+  let expected = 0;
+  for (let i = 0; i < objs.length; i++) {
+    expected += objs[i].x * Math.floor((loads - i + objs.length - 1) /
+                                       objs.length);
+  }
+  if (sum !== expected) {
+    throw new Error(`wrong result: ${sum} !== ${expected}`);
+  }
+  return time;
+}
+
+function median(values) {
+  values.sort((a, b) => a - b);
+  return values[values.length >> 1];
+}
+
+const kinds = {
+  "fixed": count => makeObjects(count, 1),
+  "dynamic": count => makeObjects(count, 20),
+  "dictionary": makeDictionaries,
+};
+
+print("kind\tshapes\tns/load");
+
+for (let kind in kinds) {
+  for (let count of [12, 32, 128]) {
+    let objs = kinds[kind](count);
+    let loop = makeLoop();
+    let samples = [];
+    for (let i = 0; i < iterations; i++) {
+      samples.push(measure(loop, objs));
+    }
+    print([kind, count,
+           (median(samples) * 1e6 / loads).toFixed(2)].join("\t"));
+  }
+}
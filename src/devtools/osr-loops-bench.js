@@ -0,0 +1,109 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Measures long-running loops in code that only runs once, which can only get
+// into Ion through OSR. Each sample runs the benchmark's source in a function
+// called once in a fresh global, as in batch jobs.
+//
+// Usage:
+//   js --warp devtools/osr-loops-bench.js [iterations]
+//
+// OSR entry blocks are only specialized on the frame's types with WarpBuilder.
+// Compare against a run with --no-warp, or with --ion-osr=off to see the time
+// spent in Baseline. Each row reports the median time to run the benchmark,
+// whether its Ion code was compiled for OSR and the number of values in the
+// OSR entry block that were specialized on the types of the frame.
+
+const iterations = scriptArgs.length > 0 ? parseInt(scriptArgs[0]) : 10;
+
+const benchmarks = {
+  // The accumulator is an int32 before the loop and a double in it.
+  "int-to-double": `
+    var acc = 0;
+    var step = 0;
+    for (var i = 0; i < 5e6; i++) {
+      if (i === 1) {
+        step = 0.5;
+      }
+      acc += step * (i & 7);
+    }
+    acc;
+  `,
+
+  // Several live values of different types cross the loop header.
+  "mixed-locals": `
+    var s = "";
+    var o = {x: 1, y: 2};
+    var d = 0.25;
+    var n = 0;
+    for (var i = 0; i < 3e6; i++) {
+      n = (n + o.x * i + o.y) | 0;
+      d = d * 0.5 + n;
+      if ((i & 0xfffff) === 0) {
+        s += i;
+      }
+    }
+    n + d + s.length;
+  `,
+
+  // Typed array kernel, as in numeric batch jobs.
+  "typed-array-sum": `
+    var a = new Float64Array(1 << 16);
+    for (var i = 0; i < a.length; i++) {
+      a[i] = i * 0.5;
+    }
+    var total = 0;
+    for (var k = 0; k < 60; k++) {
+      for (var j = 0; j < a.length; j++) {
+        total += a[j];
+      }
+    }
+    total;
+  `,
+
+  // The loop is entered once with each type of value, so the OSR entry
+  // guards fail and the loop is recompiled.
+  "type-change": `
+    var results = [];
+    for (var k = 0; k < 3; k++) {
+      var v = [0, 0.5, 1e20][k];
+      for (var i = 0; i < 2e6; i++) {
+        v = v + 1;
+      }
+      results.push(v);
+    }
+    results.length;
+  `,
+};
+
+function measure(source) {
+  // The loops run in a function called once, so that their Ion code can be
+  // inspected afterwards.
+  let global = newGlobal();
+  global.evaluate(`function run() { ${source} }`);
+  let start = performance.now();
+  global.evaluate("run()");
+  let time = performance.now() - start;
+  return {time, info: global.evaluate("osrEntryInfo(run)")};
+}
+
+function median(values) {
+  values.sort((a, b) => a - b);
+  return values[values.length >> 1];
+}
+
+print("benchmark\ttime(ms)\tosr\tspecialized");
+
+for (let name in benchmarks) {
+  let samples = [];
+  let info;
+  for (let i = 0; i < iterations; i++) {
+    let result = measure(benchmarks[name]);
+    samples.push(result.time);
+    info = result.info;
+  }
+
+  print([name, median(samples).toFixed(1), info ? info.osr : false,
+         info ? info.specializedValues : 0].join("\t"));
+}
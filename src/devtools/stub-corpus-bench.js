@@ -0,0 +1,60 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Measures the time a fresh zone takes to attach its first Baseline IC stubs,
+// with and without the Baseline CacheIR stub corpus.
+//
+// Usage:
+//   js --blinterp-eager devtools/stub-corpus-bench.js [sites [iterations]]
+//   js --blinterp-eager --cacheir-stub-corpus devtools/stub-corpus-bench.js
+//
+// Each sample creates a global in a new zone and runs code with |sites| IC
+// sites (1000 by default) for array lengths, dense elements and int32
+// arithmetic, each hit once. The time includes compiling the corpus, if it
+// is enabled. Each row reports the number of sites, the median time in
+// milliseconds and the number of stubs attached using code from the corpus.
+
+const sites = scriptArgs.length > 0 ? parseInt(scriptArgs[0]) : 1000;
+const iterations = scriptArgs.length > 1 ? parseInt(scriptArgs[1]) : 20;
+
+// Five IC sites per statement: the length, the element and three arithmetic
+// operations. Every statement is in its own function, so that each site is
+// only hit once.
+function makeSource(sites) {
+  let source = "var arr = [1, 2, 3, 4];\nvar sum = 0;\n";
+  let count = Math.ceil(sites / 5);
+  for (let i = 0; i < count; i++) {
+    source += `function f${i}() {
+      sum = ((sum + arr[${i & 3}]) - arr.length) * 1;
+    }
+    f${i}();\n`;
+  }
+  return source;
+}
+
+function measure(source) {
+  let start = performance.now();
+  let global = newGlobal({newCompartment: true});
+  global.evaluate(source);
+  let time = performance.now() - start;
+  return {time, hits: global.evaluate("stubCorpusStats().hits")};
+}
+
+function median(values) {
+  values.sort((a, b) => a - b);
+  return values[values.length >> 1];
+}
+
+const source = makeSource(sites);
+
+let samples = [];
+let hits = 0;
+for (let i = 0; i < iterations; i++) {
+  let result = measure(source);
+  samples.push(result.time);
+  hits = result.hits;
+}
+
+print("sites\ttime(ms)\tcorpus-hits");
+print([sites, median(samples).toFixed(2), hits].join("\t"));
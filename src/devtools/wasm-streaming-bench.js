@@ -0,0 +1,80 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Measures how long WebAssembly.instantiateStreaming takes to finish after
+// the last byte of a module has been received, for modules fed to the engine
+// at various rates.
+//
+// Usage:
+//   js devtools/wasm-streaming-bench.js [numFuncs [iterations]]
+//
+// Pass --wasm-compiler=baseline or --wasm-compiler=ion to the shell to
+// measure one tier only. Each row reports the module size, the stream
+// parameters, the time at which the last chunk was delivered (computed from
+// the stream parameters), the time to instantiate, and the difference
+// between the two, which is the part of compilation that didn't overlap the
+// download.
+
+const numFuncs = scriptArgs.length > 0 ? parseInt(scriptArgs[0]) : 2000;
+const iterations = scriptArgs.length > 1 ? parseInt(scriptArgs[1]) : 5;
+
+function makeModule(numFuncs) {
+  let text = `(module\n`;
+  text += ` (func $f0 (param i32) (result i32) local.get 0)\n`;
+  for (let i = 1; i < numFuncs; i++) {
+    text += ` (func $f${i} (param i32) (result i32) (local i32)
+  (local.set 1 (i32.const ${i}))
+  (block (loop
+    (br_if 1 (i32.eqz (local.get 0)))
+    (local.set 1 (i32.xor (i32.mul (local.get 1) (i32.const 31))
+                          (local.get 0)))
+    (local.set 0 (i32.sub (local.get 0) (i32.const 1)))
+    (br 0)))
+  (i32.add (local.get 1) (call $f${i - 1} (i32.const 3))))\n`;
+  }
+  text += ` (func (export "run") (result i32) (call $f${numFuncs - 1}
+                                                 (i32.const 10)))\n`;
+  text += `)`;
+  return wasmTextToBinary(text);
+}
+
+function measure(code, delayMillis, chunkSize) {
+  setBufferStreamParams(delayMillis, chunkSize);
+
+  let instantiatedAt;
+  let start = performance.now();
+  WebAssembly.instantiateStreaming(code).then(({instance}) => {
+    instantiatedAt = performance.now();
+    instance.exports.run();
+  });
+  drainJobQueue();
+
+  if (instantiatedAt === undefined) {
+    throw new Error("instantiateStreaming failed");
+  }
+  return instantiatedAt - start;
+}
+
+function median(values) {
+  values.sort((a, b) => a - b);
+  return values[values.length >> 1];
+}
+
+const code = makeModule(numFuncs);
+
+print("bytes\tchunk\tdelay\treceived(ms)\tinstantiated(ms)\tafter-last-byte(ms)");
+
+for (let [delayMillis, chunkSize] of [[0, 1 << 20], [1, 65536], [1, 16384],
+                                      [1, 4096], [5, 4096]]) {
+  let samples = [];
+  for (let i = 0; i < iterations; i++) {
+    samples.push(measure(code, delayMillis, chunkSize));
+  }
+
+  let received = Math.ceil(code.length / chunkSize) * delayMillis;
+  let instantiated = median(samples);
+  print([code.length, chunkSize, delayMillis, received,
+         instantiated.toFixed(1),
+         Math.max(0, instantiated - received).toFixed(1)].join("\t"));
+}
@@ -8,6 +8,7 @@
 
 #include "mozilla/DebugOnly.h"
 #include "mozilla/TimeStamp.h"
+#include "mozilla/Unused.h"
 
 #include <type_traits>
 
@@ -557,8 +558,9 @@ TenuredCell* ArenaLists::refillFreeListAndAllocate(
 
   Arena* arena = arenaList(thingKind).takeNextArena();
   if (arena) {
-    // Empty arenas should be immediately freed.
-    MOZ_ASSERT(!arena->isEmpty());
+    // Empty arenas should be immediately freed, except for those allocated in
+    // advance for helper threads.
+    MOZ_ASSERT_IF(!zone_->usedByHelperThread(), !arena->isEmpty());
 
     return freeLists.setArenaAndAllocate(arena, thingKind);
   }
@@ -584,6 +586,10 @@ TenuredCell* ArenaLists::refillFreeListAndAllocate(
 
   addNewArena(arena, thingKind);
 
+  if (zone_->usedByHelperThread()) {
+    addArenaBatchForHelperThread(thingKind, checkThresholds, maybeLock.ref());
+  }
+
   return freeLists.setArenaAndAllocate(arena, thingKind);
 }
 
@@ -595,6 +601,37 @@ inline void ArenaLists::addNewArena(Arena* arena, AllocKind thingKind) {
   al.insertBeforeCursor(arena);
 }
 
+// Helper threads allocate arenas in batches so that they take the GC lock
+// less often. Zones used by helper threads are not shared with other threads,
+// so the extra arenas can be put after the cursor and later taken from there
+// without locking. Any that are still empty are released when the zone is
+// merged into its target.
+void ArenaLists::addArenaBatchForHelperThread(
+    AllocKind thingKind, ShouldCheckThresholds checkThresholds,
+    AutoLockGCBgAlloc& lock) {
+  MOZ_ASSERT(concurrentUse(thingKind) == ConcurrentUse::None);
+  MOZ_ASSERT(!zone_->isGCMarking());
+
+  GCRuntime* gc = &runtimeFromAnyThread()->gc;
+  for (size_t i = 1; i < HelperThreadArenaBatchSize; i++) {
+    Chunk* chunk = gc->pickChunk(lock);
+    if (!chunk) {
+      return;
+    }
+
+    Arena* arena =
+        gc->allocateArena(chunk, zone_, thingKind, checkThresholds, lock);
+    if (!arena) {
+      return;
+    }
+
+    arenaList(thingKind).insertAtCursor(arena);
+    if (i == 1) {
+      gc->helperThreadArenaStats.ref().batches++;
+    }
+  }
+}
+
 inline TenuredCell* FreeLists::setArenaAndAllocate(Arena* arena,
                                                    AllocKind kind) {
 #ifdef DEBUG
@@ -623,10 +660,18 @@ void Arena::arenaAllocatedDuringGC() {
   // arena we are about to allocate from.
 
   if (zone->needsIncrementalBarrier() || zone->isGCSweeping()) {
+    // A concurrent marker may be setting mark bits for other cells in this
+    // arena, which share the same bitmap words.
+    bool atomic =
+        zone->runtimeFromAnyThread()->gc.parallelMarker.isConcurrentMarking();
     for (ArenaFreeCellIter iter(this); !iter.done(); iter.next()) {
       TenuredCell* cell = iter.getCell();
       MOZ_ASSERT(!cell->isMarkedAny());
-      cell->markBlack();
+      if (atomic) {
+        mozilla::Unused << cell->markBlackIfUnmarkedAtomic();
+      } else {
+        cell->markBlack();
+      }
     }
   }
 }
@@ -655,10 +700,11 @@ void ArenaLists::setParallelAllocEnabled(bool enabled) {
 
 bool GCRuntime::wantBackgroundAllocation(const AutoLockGC& lock) const {
   // To minimize memory waste, we do not want to run the background chunk
-  // allocation if we already have some empty chunks or when the runtime has
-  // a small heap size (and therefore likely has a small growth rate).
+  // allocation if we already have enough empty chunks for the predicted demand
+  // or when the runtime has a small heap size (and therefore likely has a
+  // small growth rate).
   return allocTask.enabled() &&
-         emptyChunks(lock).count() < tunables.minEmptyChunkCount(lock) &&
+         emptyChunks(lock).count() < targetEmptyChunkCount(lock) &&
          (fullChunks(lock).count() + availableChunks(lock).count()) >= 4;
 }
 
@@ -750,6 +796,8 @@ uint32_t Chunk::findDecommittedArenaOffset() {
 // ///////////  System -> Chunk Allocator  /////////////////////////////////////
 
 Chunk* GCRuntime::getOrAllocChunk(AutoLockGCBgAlloc& lock) {
+  chunkDemand_.ref().noteChunkAllocated();
+
   Chunk* chunk = emptyChunks(lock).pop();
   if (!chunk) {
     chunk = Chunk::allocate(this);
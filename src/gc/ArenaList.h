@@ -20,6 +20,7 @@
 
 namespace js {
 
+class AutoLockGCBgAlloc;
 class Nursery;
 class TenuringTracer;
 
@@ -34,6 +35,10 @@ struct FinalizePhase;
 class FreeSpan;
 class TenuredCell;
 
+// The number of arenas allocated under a single lock acquisition when a zone
+// used by a helper thread needs a new arena.
+static const size_t HelperThreadArenaBatchSize = 4;
+
 /*
  * A single segment of a SortedArenaList. Each segment has a head and a tail,
  * which track the start and end of a segment for O(1) append and concatenation.
@@ -384,6 +389,9 @@ class ArenaLists {
                                          ShouldCheckThresholds checkThresholds);
 
   void addNewArena(Arena* arena, AllocKind thingKind);
+  void addArenaBatchForHelperThread(AllocKind thingKind,
+                                    ShouldCheckThresholds checkThresholds,
+                                    AutoLockGCBgAlloc& lock);
 
   friend class GCRuntime;
   friend class js::Nursery;
@@ -237,6 +237,7 @@ class TenuredCell : public Cell {
   // The return value indicates if the cell went from unmarked to marked.
   MOZ_ALWAYS_INLINE bool markIfUnmarked(
       MarkColor color = MarkColor::Black) const;
+  MOZ_ALWAYS_INLINE bool markBlackIfUnmarkedAtomic() const;
   MOZ_ALWAYS_INLINE void markBlack() const;
   MOZ_ALWAYS_INLINE void copyMarkBitsFrom(const TenuredCell* src);
   MOZ_ALWAYS_INLINE void unmark();
@@ -413,6 +414,10 @@ bool TenuredCell::markIfUnmarked(MarkColor color /* = Black */) const {
   return chunk()->bitmap.markIfUnmarked(this, color);
 }
 
+bool TenuredCell::markBlackIfUnmarkedAtomic() const {
+  return chunk()->bitmap.markBlackIfUnmarkedAtomic(this);
+}
+
 void TenuredCell::markBlack() const { chunk()->bitmap.markBlack(this); }
 
 void TenuredCell::copyMarkBitsFrom(const TenuredCell* src) {
@@ -718,14 +718,19 @@ void ChunkPool::Iter::next() {
   current_ = current_->info.next;
 }
 
+uint32_t GCRuntime::targetEmptyChunkCount(const AutoLockGC& lock) const {
+  return chunkDemand_.ref().targetEmptyChunkCount(tunables, lock);
+}
+
 inline bool GCRuntime::tooManyEmptyChunks(const AutoLockGC& lock) {
-  return emptyChunks(lock).count() > tunables.minEmptyChunkCount(lock);
+  return emptyChunks(lock).count() > targetEmptyChunkCount(lock);
 }
 
 ChunkPool GCRuntime::expireEmptyChunkPool(const AutoLockGC& lock) {
   MOZ_ASSERT(emptyChunks(lock).verify());
   MOZ_ASSERT(tunables.minEmptyChunkCount(lock) <=
              tunables.maxEmptyChunkCount());
+  MOZ_ASSERT(targetEmptyChunkCount(lock) <= tunables.maxEmptyChunkCount());
 
   ChunkPool expired;
   while (tooManyEmptyChunks(lock)) {
@@ -737,7 +742,7 @@ ChunkPool GCRuntime::expireEmptyChunkPool(const AutoLockGC& lock) {
   MOZ_ASSERT(expired.verify());
   MOZ_ASSERT(emptyChunks(lock).verify());
   MOZ_ASSERT(emptyChunks(lock).count() <= tunables.maxEmptyChunkCount());
-  MOZ_ASSERT(emptyChunks(lock).count() <= tunables.minEmptyChunkCount(lock));
+  MOZ_ASSERT(emptyChunks(lock).count() <= targetEmptyChunkCount(lock));
   return expired;
 }
 
@@ -868,6 +873,8 @@ GCRuntime::GCRuntime(JSRuntime* rt)
       heapState_(JS::HeapState::Idle),
       stats_(this),
       marker(rt),
+      parallelMarker(this),
+      parallelTenuring(this),
       heapSize(nullptr),
       rootsHash(256),
       nextCellUniqueId_(LargestTaggedNullCellPointer +
@@ -918,6 +925,9 @@ GCRuntime::GCRuntime(JSRuntime* rt)
       defaultTimeBudgetMS_(TuningDefaults::DefaultTimeBudgetMS),
       incrementalAllowed(true),
       compactingEnabled(TuningDefaults::CompactingEnabled),
+      concurrentMarkingEnabled(TuningDefaults::ConcurrentMarking),
+      autoCompactingThreshold(TuningDefaults::AutoCompactingThreshold),
+      tenuredStringDedupEnabled(TuningDefaults::TenuredStringDeduplication),
       rootsRemoved(false),
 #ifdef JS_GC_ZEAL
       zealModeBits(0),
@@ -1289,6 +1299,8 @@ void GCRuntime::freezeSelfHostingZone() {
 void GCRuntime::finish() {
   MOZ_ASSERT(inPageLoadCount == 0);
 
+  stopConcurrentMarking();
+
   // Wait for nursery background free to end and disable it to release memory.
   if (nursery().isEnabled()) {
     nursery().disable();
@@ -1337,6 +1349,7 @@ void GCRuntime::finish() {
 
 bool GCRuntime::setParameter(JSGCParamKey key, uint32_t value) {
   MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt));
+  stopConcurrentMarking();
   waitBackgroundSweepEnd();
   AutoLockGC lock(this);
   return setParameter(key, value, lock);
@@ -1364,9 +1377,31 @@ bool GCRuntime::setParameter(JSGCParamKey key, uint32_t value,
     case JSGC_COMPACTING_ENABLED:
       compactingEnabled = value != 0;
       break;
+    case JSGC_CONCURRENT_MARKING:
+      concurrentMarkingEnabled = value != 0;
+      break;
+    case JSGC_AUTO_COMPACTING_THRESHOLD:
+      if (value > 100) {
+        return false;
+      }
+      autoCompactingThreshold = value;
+      break;
+    case JSGC_TENURED_STRING_DEDUPLICATION:
+      tenuredStringDedupEnabled = value != 0;
+      break;
     case JSGC_INCREMENTAL_WEAKMAP_ENABLED:
       marker.incrementalWeakMapMarkingEnabled = value != 0;
       break;
+    case JSGC_MARKING_THREAD_COUNT:
+      if (value < 1 || value > MaxParallelMarkers) {
+        return false;
+      }
+      return setMarkingThreadCount(value, lock);
+    case JSGC_TENURING_THREAD_COUNT:
+      if (value < 1 || value > MaxParallelTenuringThreads) {
+        return false;
+      }
+      return setTenuringThreadCount(value, lock);
     default:
       if (!tunables.setParameter(key, value, lock)) {
         return false;
@@ -1381,6 +1416,7 @@ bool GCRuntime::setParameter(JSGCParamKey key, uint32_t value,
 
 void GCRuntime::resetParameter(JSGCParamKey key) {
   MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt));
+  stopConcurrentMarking();
   waitBackgroundSweepEnd();
   AutoLockGC lock(this);
   resetParameter(key, lock);
@@ -1400,10 +1436,27 @@ void GCRuntime::resetParameter(JSGCParamKey key, AutoLockGC& lock) {
     case JSGC_COMPACTING_ENABLED:
       compactingEnabled = TuningDefaults::CompactingEnabled;
       break;
+    case JSGC_CONCURRENT_MARKING:
+      concurrentMarkingEnabled = TuningDefaults::ConcurrentMarking;
+      break;
+    case JSGC_AUTO_COMPACTING_THRESHOLD:
+      autoCompactingThreshold = TuningDefaults::AutoCompactingThreshold;
+      break;
+    case JSGC_TENURED_STRING_DEDUPLICATION:
+      tenuredStringDedupEnabled = TuningDefaults::TenuredStringDeduplication;
+      break;
     case JSGC_INCREMENTAL_WEAKMAP_ENABLED:
       marker.incrementalWeakMapMarkingEnabled =
           TuningDefaults::IncrementalWeakMapMarkingEnabled;
       break;
+    case JSGC_MARKING_THREAD_COUNT:
+      mozilla::Unused << setMarkingThreadCount(
+          TuningDefaults::MarkingThreadCount, lock);
+      break;
+    case JSGC_TENURING_THREAD_COUNT:
+      mozilla::Unused << setTenuringThreadCount(
+          TuningDefaults::TenuringThreadCount, lock);
+      break;
     default:
       tunables.resetParameter(key, lock);
       for (ZonesIter zone(this, WithAtoms); !zone.done(); zone.next()) {
@@ -1475,8 +1528,18 @@ uint32_t GCRuntime::getParameter(JSGCParamKey key, const AutoLockGC& lock) {
       return tunables.maxEmptyChunkCount();
     case JSGC_COMPACTING_ENABLED:
       return compactingEnabled;
+    case JSGC_CONCURRENT_MARKING:
+      return concurrentMarkingEnabled;
+    case JSGC_AUTO_COMPACTING_THRESHOLD:
+      return autoCompactingThreshold;
+    case JSGC_TENURED_STRING_DEDUPLICATION:
+      return tenuredStringDedupEnabled;
     case JSGC_INCREMENTAL_WEAKMAP_ENABLED:
       return marker.incrementalWeakMapMarkingEnabled;
+    case JSGC_MARKING_THREAD_COUNT:
+      return parallelMarker.threadCount();
+    case JSGC_TENURING_THREAD_COUNT:
+      return parallelTenuring.threadCount();
     case JSGC_NURSERY_FREE_THRESHOLD_FOR_IDLE_COLLECTION:
       return tunables.nurseryFreeThresholdForIdleCollection();
     case JSGC_NURSERY_FREE_THRESHOLD_FOR_IDLE_COLLECTION_PERCENT:
@@ -1506,6 +1569,52 @@ void GCRuntime::setMarkStackLimit(size_t limit, AutoLockGC& lock) {
   AutoUnlockGC unlock(lock);
   AutoStopVerifyingBarriers pauseVerification(rt, false);
   marker.setMaxCapacity(limit);
+  parallelMarker.setMaxCapacity(limit);
+}
+
+bool GCRuntime::setMarkingThreadCount(size_t count, AutoLockGC& lock) {
+  MOZ_ASSERT(!JS::RuntimeHeapIsBusy());
+  AutoUnlockGC unlock(lock);
+  return parallelMarker.setThreadCount(count, mode);
+}
+
+void GCRuntime::stopConcurrentMarking() {
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt));
+  if (parallelMarker.isConcurrentMarking()) {
+    parallelMarker.finishConcurrentMarking();
+  }
+}
+
+void GCRuntime::maybeStartConcurrentMarking() {
+  // Only mark concurrently when there are no nursery cells. The mutator can
+  // allocate in the nursery again while the concurrent marker runs, but the
+  // next minor GC, which moves those cells, stops it first.
+  if (!concurrentMarkingEnabled || !isIncrementalGCInProgress() ||
+      !nursery().isEmpty() || !parallelMarker.shouldMarkConcurrently()) {
+    return;
+  }
+
+  parallelMarker.startConcurrentMarking();
+}
+
+void GCRuntime::joinConcurrentMarking() {
+  if (!concurrentMarkingEnabled && !parallelMarker.isConcurrentMarking()) {
+    return;
+  }
+
+  // Wait for the concurrent marker to stop, and record the time it spent
+  // marking since the last slice. Its remaining work is finished by the main
+  // marker in this slice.
+  gcstats::AutoPhase ap(stats(), gcstats::PhaseKind::JOIN_CONCURRENT_MARK);
+  stopConcurrentMarking();
+  stats().recordParallelPhase(gcstats::PhaseKind::CONCURRENT_MARK,
+                              parallelMarker.takeConcurrentMarkTime());
+}
+
+bool GCRuntime::setTenuringThreadCount(size_t count, AutoLockGC& lock) {
+  MOZ_ASSERT(!JS::RuntimeHeapIsBusy());
+  AutoUnlockGC unlock(lock);
+  return parallelTenuring.setThreadCount(count);
 }
 
 bool GCRuntime::addBlackRootsTracer(JSTraceDataOp traceOp, void* data) {
@@ -2021,6 +2130,47 @@ static AllocKinds CompactingAllocKinds() {
   return result;
 }
 
+bool GCRuntime::shouldCompactForFragmentation(const SliceBudget& budget) {
+  // Decide at the end of sweeping whether a GC that was not started as a
+  // shrinking GC should compact anyway because the heap is fragmented. The
+  // arena lists have been sorted by occupancy during sweeping, so only the
+  // least used arenas will be relocated.
+
+  if (isCompacting || !autoCompactingThreshold || !isCompactingGCEnabled()) {
+    return false;
+  }
+
+  if (isIncremental &&
+      IsCurrentlyAnimating(rt->lastAnimationTime, TimeStamp::Now())) {
+    return false;
+  }
+
+  // Incremental GCs yield before compacting and the nursery is evicted at the
+  // start of the next slice. Otherwise we can only compact if the nursery is
+  // already empty.
+  if (budget.isUnlimited() && !nursery().isEmpty()) {
+    return false;
+  }
+
+  size_t freeCells = 0;
+  size_t totalCells = 0;
+  for (GCZonesIter zone(this); !zone.done(); zone.next()) {
+    if (!canRelocateZone(zone) || zone->isPreservingCode()) {
+      continue;
+    }
+    for (auto kind : CompactingAllocKinds()) {
+      ArenaList& al = zone->arenas.arenaList(kind);
+      for (Arena* arena = al.head(); arena; arena = arena->next) {
+        freeCells += arena->countFreeCells();
+        totalCells += arena->getThingsPerArena();
+      }
+    }
+  }
+
+  return totalCells != 0 &&
+         freeCells * 100 >= totalCells * size_t(autoCompactingThreshold);
+}
+
 bool ArenaLists::relocateArenas(Arena*& relocatedListOut, JS::GCReason reason,
                                 SliceBudget& sliceBudget,
                                 gcstats::Statistics& stats) {
@@ -2634,7 +2784,11 @@ void GCRuntime::releaseRelocatedArenasWithoutUnlocking(Arena* arenaList,
 
     // We already updated the memory accounting so just call
     // Chunk::releaseArena.
-    arena->chunk()->releaseArena(this, arena, lock);
+    Chunk* chunk = arena->chunk();
+    chunk->releaseArena(this, arena, lock);
+    if (chunk->unused()) {
+      stats().count(gcstats::COUNT_CHUNK_RECLAIMED);
+    }
   }
 }
 
@@ -3190,6 +3344,11 @@ void GCRuntime::startDecommit() {
   }
 #endif
 
+  {
+    AutoLockGC lock(this);
+    chunkDemand_.ref().update(invocationKind);
+  }
+
   // If we are allocating heavily enough to trigger "high frequency" GC, then
   // skip decommit so that we do not compete with the mutator. However if we're
   // doing a shrinking GC we always decommit to release as much memory as
@@ -3307,51 +3466,42 @@ void GCRuntime::cancelRequestedGCAfterBackgroundTask() {
                                        JS::GCReason::NO_REASON);
 }
 
-void GCRuntime::sweepBackgroundThings(ZoneList& zones) {
-  if (zones.isEmpty()) {
-    return;
-  }
+void GCRuntime::sweepBackgroundThings(Zone* zone) {
+  MOZ_ASSERT(zone->isGCFinished());
 
   JSFreeOp fop(nullptr);
 
-  // Sweep zones in order. The atoms zone must be finalized last as other
-  // zones may have direct pointers into it.
-  while (!zones.isEmpty()) {
-    Zone* zone = zones.removeFront();
-    MOZ_ASSERT(zone->isGCFinished());
-
-    Arena* emptyArenas = nullptr;
+  Arena* emptyArenas = nullptr;
 
-    AutoSetThreadIsSweeping threadIsSweeping(zone);
+  AutoSetThreadIsSweeping threadIsSweeping(zone);
 
-    // We must finalize thing kinds in the order specified by
-    // BackgroundFinalizePhases.
-    for (auto phase : BackgroundFinalizePhases) {
-      for (auto kind : phase.kinds) {
-        Arena* arenas = zone->arenas.arenasToSweep(kind);
-        MOZ_RELEASE_ASSERT(uintptr_t(arenas) != uintptr_t(-1));
-        if (arenas) {
-          ArenaLists::backgroundFinalize(&fop, arenas, &emptyArenas);
-        }
+  // We must finalize thing kinds in the order specified by
+  // BackgroundFinalizePhases.
+  for (auto phase : BackgroundFinalizePhases) {
+    for (auto kind : phase.kinds) {
+      Arena* arenas = zone->arenas.arenasToSweep(kind);
+      MOZ_RELEASE_ASSERT(uintptr_t(arenas) != uintptr_t(-1));
+      if (arenas) {
+        ArenaLists::backgroundFinalize(&fop, arenas, &emptyArenas);
       }
     }
+  }
 
-    // Release any arenas that are now empty.
-    //
-    // Periodically drop and reaquire the GC lock every so often to avoid
-    // blocking the main thread from allocating chunks.
-    //
-    // Also use this opportunity to periodically recalculate the GC thresholds
-    // as we free more memory.
-    static const size_t LockReleasePeriod = 32;
-
-    while (emptyArenas) {
-      AutoLockGC lock(this);
-      for (size_t i = 0; i < LockReleasePeriod && emptyArenas; i++) {
-        Arena* arena = emptyArenas;
-        emptyArenas = emptyArenas->next;
-        releaseArena(arena, lock);
-      }
+  // Release any arenas that are now empty.
+  //
+  // Periodically drop and reaquire the GC lock every so often to avoid
+  // blocking the main thread from allocating chunks.
+  //
+  // Also use this opportunity to periodically recalculate the GC thresholds
+  // as we free more memory.
+  static const size_t LockReleasePeriod = 32;
+
+  while (emptyArenas) {
+    AutoLockGC lock(this);
+    for (size_t i = 0; i < LockReleasePeriod && emptyArenas; i++) {
+      Arena* arena = emptyArenas;
+      emptyArenas = emptyArenas->next;
+      releaseArena(arena, lock);
     }
   }
 }
@@ -3400,22 +3550,73 @@ void BackgroundSweepTask::run() {
   setFinishing(lock);
 }
 
-void GCRuntime::sweepFromBackgroundThread(AutoLockHelperThreadState& lock) {
-  do {
-    ZoneList zones;
-    zones.transferFrom(backgroundSweepZones.ref());
+// Zones to finalize in parallel in the background. The atoms zone must be
+// finalized after any zones queued before it as they may have direct pointers
+// into it, so iteration stops there.
+class BackgroundSweepZonesIter {
+ public:
+  explicit BackgroundSweepZonesIter(ZoneList& zones) : zones(zones) {}
 
-    AutoUnlockHelperThreadState unlock(lock);
-    sweepBackgroundThings(zones);
+  bool done() const { return zones.isEmpty() || zones.front()->isAtomsZone(); }
+
+  Zone* get() const {
+    MOZ_ASSERT(!done());
+    return zones.front();
+  }
+
+  void next() {
+    MOZ_ASSERT(!done());
+    zones.removeFront();
+  }
+
+ private:
+  ZoneList& zones;
+};
+
+/* static */
+size_t GCRuntime::sweepBackgroundZone(GCRuntime* gc, Zone* const& zone) {
+  gc->sweepBackgroundThings(zone);
+  return 1;
+}
 
-    // The main thread may call queueZonesAndStartBackgroundSweep() while this
-    // is running so we must check there is no more work after releasing the
-    // lock.
-  } while (!backgroundSweepZones.ref().isEmpty());
+void GCRuntime::sweepFromBackgroundThread(AutoLockHelperThreadState& lock) {
+  // The main thread may call queueZonesAndStartBackgroundSweep() while this is
+  // running. The zones are taken from the shared list with the lock held so
+  // any zones queued in the meantime are finalized too.
+  ZoneList& zones = backgroundSweepZones.ref();
+  while (!zones.isEmpty()) {
+    // Zones are finalized independently of each other, so finalize them in
+    // parallel when there are many of them.
+    {
+      BackgroundSweepZonesIter work(zones);
+      AutoRunParallelWork finalizeZones(this, sweepBackgroundZone,
+                                        backgroundSweepTaskTimes.ref(), work,
+                                        SliceBudget::unlimited(), lock);
+      AutoUnlockHelperThreadState unlock(lock);
+    }
+
+    // The workers have finished with the zones before the atoms zone.
+    if (!zones.isEmpty()) {
+      Zone* zone = zones.removeFront();
+      MOZ_ASSERT(zone->isAtomsZone());
+      AutoUnlockHelperThreadState unlock(lock);
+      sweepBackgroundThings(zone);
+    }
+  }
 
   maybeRequestGCAfterBackgroundTask(lock);
 }
 
+void GCRuntime::recordBackgroundSweepTaskTimes() {
+  AutoLockHelperThreadState lock;
+  ParallelTaskTimes& times = backgroundSweepTaskTimes.ref();
+  if (times.count) {
+    stats().recordParallelTasks(gcstats::PhaseKind::BACKGROUND_FINALIZE,
+                                times.count, times.total, times.longest);
+    times = ParallelTaskTimes();
+  }
+}
+
 void GCRuntime::waitBackgroundSweepEnd() {
   sweepTask.join();
   if (state() != State::Sweep) {
@@ -3984,6 +4185,10 @@ void GCRuntime::discardJITCodeForGC() {
   js::CancelOffThreadIonCompile(rt, JS::Zone::MarkBlackOnly);
   for (GCZonesIter zone(this); !zone.done(); zone.next()) {
     gcstats::AutoPhase ap(stats(), gcstats::PhaseKind::MARK_DISCARD_CODE);
+    if (zone->isPreservingCode()) {
+      zone->discardColdJitCode(rt->defaultFreeOp());
+      continue;
+    }
     zone->discardJitCode(rt->defaultFreeOp(), Zone::DiscardBaselineCode,
                          Zone::DiscardJitScripts);
   }
@@ -4813,6 +5018,10 @@ enum {
 };
 
 unsigned js::NotifyGCPreSwap(JSObject* a, JSObject* b) {
+  // Swapping rewrites both objects in place, which a concurrent marker may be
+  // scanning.
+  a->runtimeFromMainThread()->gc.stopConcurrentMarking();
+
   /*
    * Two objects in the same compartment are about to have had their contents
    * swapped.  If either of them are in our gray pointer list, then we remove
@@ -5248,6 +5457,119 @@ static void SweepAllWeakCachesOnMainThread(JSRuntime* rt) {
   });
 }
 
+/*
+ * Tenured string deduplication.
+ *
+ * When enabled, live linear strings in each zone being swept are hashed by
+ * their contents and any string whose chars match a string already seen is
+ * turned into a dependent string of that string, freeing its own chars.
+ *
+ * A string's chars can only be freed if nothing else refers to them. Dependent
+ * strings point into the chars of their base, so the bases of all live
+ * dependent strings are found first and excluded. This relies on the nursery
+ * being empty and on the whole pass running without yielding to the mutator.
+ * Strings whose chars are held by AutoStableStringChars are excluded by
+ * NON_TENURED_DEDUP_BIT.
+ *
+ * Only black strings are merged so that we never create a black to gray edge.
+ * The pass stops when the slice budget is exhausted; strings that were not
+ * reached are considered again by a later GC.
+ */
+
+struct TenuredStringDedupHasher {
+  using Lookup = JSLinearString*;
+
+  static HashNumber hash(const Lookup& lookup) {
+    return HashStringChars(lookup);
+  }
+
+  static bool match(JSLinearString* key, const Lookup& lookup) {
+    return key->length() == lookup->length() &&
+           key->hasLatin1Chars() == lookup->hasLatin1Chars() &&
+           EqualChars(key, lookup);
+  }
+};
+
+using TenuredStringDedupSet =
+    HashSet<JSLinearString*, TenuredStringDedupHasher, SystemAllocPolicy>;
+
+static bool CanDeduplicateTenuredString(JSString* str) {
+  MOZ_ASSERT(!str->isAtom());
+  return str->asTenured().isMarkedBlack() && str->isLinear() &&
+         str->asLinear().ownsMallocedChars() && !str->isExtensible() &&
+         str->isTenuredDeduplicatable();
+}
+
+void GCRuntime::deduplicateTenuredStrings(JSFreeOp* fop, Zone* zone,
+                                          SliceBudget& budget) {
+  MOZ_ASSERT(zone->isGCSweeping());
+  MOZ_ASSERT(!zone->isAtomsZone());
+  MOZ_ASSERT(nursery().isEmpty());
+
+  size_t thingsPerArena = Arena::thingsPerArena(AllocKind::STRING);
+
+  // Pin the bases of all live dependent strings.
+  for (ArenaIter arena(zone, AllocKind::STRING); !arena.done(); arena.next()) {
+    for (ArenaCellIterUnderGC cell(arena.get()); !cell.done(); cell.next()) {
+      JSString* str = cell.as<JSString>();
+      if (!str->asTenured().isMarkedAny() || !str->hasBase()) {
+        continue;
+      }
+
+      JSLinearString* base = str->base();
+      while (!base->isAtom()) {
+        base->setNonTenuredDeduplicatable();
+        if (!base->hasBase()) {
+          break;
+        }
+        base = base->base();
+      }
+    }
+
+    budget.step(thingsPerArena);
+  }
+
+  if (budget.isOverBudget()) {
+    return;
+  }
+
+  TenuredStringDedupSet strings;
+  size_t count = 0;
+  size_t bytesSaved = 0;
+  auto updateZoneCounts = mozilla::MakeScopeExit([&] {
+    zone->tenuredStringsDeduplicated += count;
+    zone->tenuredStringDedupBytesSaved += bytesSaved;
+  });
+
+  for (ArenaIter arena(zone, AllocKind::STRING);
+       !arena.done() && !budget.isOverBudget(); arena.next()) {
+    for (ArenaCellIterUnderGC cell(arena.get()); !cell.done(); cell.next()) {
+      JSString* str = cell.as<JSString>();
+      if (!CanDeduplicateTenuredString(str)) {
+        continue;
+      }
+
+      JSLinearString* linear = &str->asLinear();
+      auto p = strings.lookupForAdd(linear);
+      if (!p) {
+        if (!strings.add(p, linear)) {
+          // Stop deduplicating on OOM; this is only an optimization.
+          return;
+        }
+        continue;
+      }
+
+      JSLinearString* canonical = *p;
+      bytesSaved += linear->allocSize();
+      linear->deduplicateTo(fop, canonical);
+      canonical->setNonTenuredDeduplicatable();
+      count++;
+    }
+
+    budget.step(thingsPerArena);
+  }
+}
+
 IncrementalProgress GCRuntime::beginSweepingSweepGroup(JSFreeOp* fop,
                                                        SliceBudget& budget) {
   /*
@@ -5369,6 +5691,18 @@ IncrementalProgress GCRuntime::beginSweepingSweepGroup(JSFreeOp* fop,
   // for zones that are still marking.
   sweepFinalizationRegistriesOnMainThread();
 
+  // Merge identical tenured strings while everything that can refer to their
+  // chars is still known. Nursery strings may depend on tenured strings, so
+  // this is skipped if the nursery was not collected for this slice.
+  if (tenuredStringDedupEnabled && nursery().isEmpty()) {
+    AutoPhase ap(stats(), PhaseKind::SWEEP_DEDUP_STRINGS);
+    for (SweepGroupZonesIter zone(this); !zone.done(); zone.next()) {
+      if (!zone->isAtomsZone()) {
+        deduplicateTenuredStrings(fop, zone, budget);
+      }
+    }
+  }
+
   // Queue all GC things in all zones for sweeping, either on the foreground
   // or on the background thread.
 
@@ -5575,6 +5909,14 @@ IncrementalProgress GCRuntime::markUntilBudgetExhausted(
     return NotFinished;
   }
 
+  // Mark the black part of the heap in parallel when there is enough work.
+  // Anything that remains, including gray and delayed marking, is finished
+  // off below.
+  if (parallelMarker.shouldMarkInParallel() &&
+      !parallelMarker.mark(sliceBudget)) {
+    return NotFinished;
+  }
+
   return marker.markUntilBudgetExhausted(sliceBudget, reportTime) ? Finished
                                                                   : NotFinished;
 }
@@ -6261,7 +6603,9 @@ void GCRuntime::beginCompactPhase() {
 
   MOZ_ASSERT(zonesToMaybeCompact.ref().isEmpty());
   for (GCZonesIter zone(this); !zone.done(); zone.next()) {
-    if (canRelocateZone(zone)) {
+    // Zones preserving JIT code can only be present when compacting was
+    // triggered by fragmentation rather than by a shrinking GC.
+    if (canRelocateZone(zone) && !zone->isPreservingCode()) {
       zonesToMaybeCompact.ref().append(zone);
     }
   }
@@ -6397,6 +6741,9 @@ AutoHeapSession::AutoHeapSession(GCRuntime* gc, JS::HeapState heapState)
   MOZ_ASSERT(prevState == JS::HeapState::Idle);
   MOZ_ASSERT(heapState != JS::HeapState::Idle);
 
+  // Nothing may run concurrently with a collection or heap traversal.
+  gc->stopConcurrentMarking();
+
   gc->heapState_ = heapState;
 
   if (heapState == JS::HeapState::MinorCollecting ||
@@ -6723,6 +7070,7 @@ void GCRuntime::incrementalSlice(SliceBudget& budget,
         // Sweep the zones list now that background finalization is finished to
         // remove and free dead zones, compartments and realms.
         gcstats::AutoPhase ap1(stats(), gcstats::PhaseKind::SWEEP);
+        recordBackgroundSweepTaskTimes();
         gcstats::AutoPhase ap2(stats(), gcstats::PhaseKind::DESTROY);
         JSFreeOp fop(rt);
         sweepZones(&fop, destroyingRuntime);
@@ -6731,6 +7079,10 @@ void GCRuntime::incrementalSlice(SliceBudget& budget,
       MOZ_ASSERT(!startedCompacting);
       incrementalState = State::Compact;
 
+      if (shouldCompactForFragmentation(budget)) {
+        isCompacting = true;
+      }
+
       // Always yield before compacting since it is not incremental.
       if (isCompacting && !budget.isUnlimited()) {
         break;
@@ -7067,6 +7419,8 @@ MOZ_NEVER_INLINE GCRuntime::IncrementalResult GCRuntime::gcCycle(
   gcstats::AutoGCSlice agc(stats(), scanZonesBeforeGC(),
                            gckind.valueOr(invocationKind), budget, reason);
 
+  joinConcurrentMarking();
+
   auto result = budgetIncrementalGC(nonincrementalByAPI, reason, budget);
   if (result == IncrementalResult::ResetIncremental) {
     reason = JS::GCReason::RESET;
@@ -7393,6 +7747,9 @@ void GCRuntime::collect(bool nonincrementalByAPI, SliceBudget budget,
     MOZ_RELEASE_ASSERT(CheckGrayMarkingState(rt));
   }
 #endif
+
+  maybeStartConcurrentMarking();
+
   stats().writeLogMessage("GC ending in state %s", StateName(incrementalState));
 
   UnscheduleZones(this);
@@ -8019,7 +8376,16 @@ void ArenaLists::adoptArenas(ArenaLists* fromArenaLists,
       // Copy fromArena->next before releasing/reinserting.
       next = fromArena->next;
 
-      MOZ_ASSERT(!fromArena->isEmpty());
+      // Release any arenas that were allocated in advance for a helper
+      // thread but never used.
+      if (fromArena->isEmpty()) {
+        runtime()->gc.releaseArena(fromArena, lock);
+        runtime()->gc.helperThreadArenaStats.ref().unusedArenas++;
+        continue;
+      }
+
+      runtime()->gc.helperThreadArenaStats.ref().cellsMerged +=
+          fromArena->countUsedCells();
 
       // If the target zone is being collected then we need to add the
       // arenas before the cursor because the collector assumes that the
@@ -8107,6 +8473,7 @@ JS::AutoEnterCycleCollection::AutoEnterCycleCollection(JSRuntime* rt)
     : runtime_(rt) {
   MOZ_ASSERT(CurrentThreadCanAccessRuntime(rt));
   MOZ_ASSERT(!JS::RuntimeHeapIsBusy());
+  runtime_->gc.stopConcurrentMarking();
   runtime_->gc.heapState_ = HeapState::CycleCollecting;
 }
 
@@ -8364,6 +8731,12 @@ JS::SetGCNurseryCollectionCallback(JSContext* cx,
   return cx->runtime()->gc.setNurseryCollectionCallback(callback);
 }
 
+JS_PUBLIC_API void JS::SetGCTelemetryCallback(JSContext* cx,
+                                              GCTelemetryCallback callback,
+                                              void* data) {
+  cx->runtime()->gc.stats().setTelemetryCallback(callback, data);
+}
+
 JS_PUBLIC_API void JS::SetLowMemoryState(JSContext* cx, bool newState) {
   return cx->runtime()->gc.setLowMemoryState(newState);
 }
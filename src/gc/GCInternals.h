@@ -305,6 +305,16 @@ struct TenureCountCache {
   TenureCount& findEntry(ObjectGroup* group) {
     return entries[hash(group) % EntryCount];
   }
+
+  void noteTenured(ObjectGroup* group, unsigned count = 1) {
+    TenureCount& entry = findEntry(group);
+    if (entry.group == group) {
+      entry.count += count;
+    } else if (!entry.group) {
+      entry.group = group;
+      entry.count = count;
+    }
+  }
 };
 
 extern void DelayCrossCompartmentGrayMarking(JSObject* src);
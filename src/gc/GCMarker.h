@@ -22,6 +22,10 @@ namespace js {
 class AutoAccessAtomsZone;
 class WeakMapBase;
 
+namespace gc {
+class ParallelMarker;
+}  // namespace gc
+
 static const size_t NON_INCREMENTAL_MARK_STACK_BASE_CAPACITY = 4096;
 static const size_t INCREMENTAL_MARK_STACK_BASE_CAPACITY = 32768;
 static const size_t SMALL_MARK_STACK_BASE_CAPACITY = 256;
@@ -164,6 +168,13 @@ class MarkStack {
   // storage to hold rope pointers.
   MOZ_MUST_USE bool pushTempRope(JSRope* ptr);
 
+  // Move entries from the top of |src| to |dst|, used to share work between
+  // parallel markers. Returns false if there was nothing to move or |dst|
+  // could not be grown.
+  enum MoveAmount { MoveHalf, MoveAll };
+  static MOZ_MUST_USE bool moveWork(MarkStack& dst, MarkStack& src,
+                                    MoveAmount amount);
+
   bool isEmpty() const { return topIndex_ == 0; }
 
   Tag peekTag() const;
@@ -383,7 +394,30 @@ class GCMarker : public JSTracer {
 
   bool isWeakMarking() const { return state == MarkingState::WeakMarking; }
 
+  bool isParallelMarking() const { return parallelMarker_; }
+  gc::ParallelMarker* parallelMarker() const { return parallelMarker_; }
+
+  // Whether this marker runs on a helper thread while the mutator runs.
+  bool isConcurrentMarking() const { return concurrentMarking_; }
+
  private:
+  friend class gc::ParallelMarker;
+
+  void enterParallelMarkingMode(gc::ParallelMarker* pm,
+                                bool concurrent = false);
+  void leaveParallelMarkingMode();
+
+  // Process up to |maxEntries| black mark stack entries while taking part in
+  // parallel marking. Returns false if the budget was exhausted or marking is
+  // being stopped.
+  MOZ_MUST_USE bool markCurrentColorInParallel(SliceBudget& budget,
+                                               size_t maxEntries);
+
+  // Move any remaining work to |dst| after parallel marking.
+  void transferWorkTo(GCMarker& dst);
+
+  void delayMarkingChildrenImpl(gc::Cell* cell);
+
 #ifdef DEBUG
   void checkZone(void* p);
 #else
@@ -401,6 +435,8 @@ class GCMarker : public JSTracer {
   template <typename T>
   void markAndScan(T* thing);
   template <typename T>
+  void markAndDelayChildren(T* thing);
+  template <typename T>
   void markImplicitEdgesHelper(T oldThing);
   void eagerlyMarkChildren(JSLinearString* str);
   void eagerlyMarkChildren(JSRope* rope);
@@ -496,6 +532,15 @@ class GCMarker : public JSTracer {
   /* The count of marked objects during GC. */
   size_t markCount;
 
+  /* Set while this marker is taking part in parallel marking. */
+  MainThreadOrGCTaskData<gc::ParallelMarker*> parallelMarker_;
+
+  /*
+   * Set while this marker is marking concurrently with the mutator. Things the
+   * mutator can rewrite or free are left for the main marker.
+   */
+  MainThreadOrGCTaskData<bool> concurrentMarking_;
+
   /* Track the state of marking. */
   MainThreadOrGCTaskData<MarkingState> state;
 
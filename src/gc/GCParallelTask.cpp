@@ -120,6 +120,13 @@ void js::GCParallelTask::runFromMainThread() {
   runTask();
 }
 
+void js::GCParallelTask::runFromCurrentThread() {
+  assertIdle();
+  MOZ_ASSERT(js::CurrentThreadCanAccessRuntime(gc->rt) ||
+             CurrentThreadIsPerformingGC());
+  runTask();
+}
+
 void js::GCParallelTask::runFromHelperThread(AutoLockHelperThreadState& lock) {
   setRunning(lock);
 
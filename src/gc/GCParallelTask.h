@@ -10,6 +10,7 @@
 #include "mozilla/LinkedList.h"
 #include "mozilla/TimeStamp.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "js/TypeDecls.h"
@@ -101,6 +102,10 @@ class GCParallelTask : public mozilla::LinkedListElement<GCParallelTask>,
   // Instead of dispatching to a helper, run the task on the current thread.
   void runFromMainThread();
 
+  // Like runFromMainThread(), but the current thread may also be a helper
+  // thread that is running another GC task.
+  void runFromCurrentThread();
+
   // If the task is not already running, either start it or run it on the main
   // thread if that fails.
   void startOrRunIfIdle(AutoLockHelperThreadState& lock);
@@ -189,5 +194,20 @@ class GCParallelTask : public mozilla::LinkedListElement<GCParallelTask>,
   void runFromHelperThread(AutoLockHelperThreadState& locked);
 };
 
+// The number and duration of GC tasks that ran outside of a GC slice. These
+// can't be recorded in the statistics by the thread that runs them, so they are
+// accumulated until the main thread can record them.
+struct ParallelTaskTimes {
+  size_t count = 0;
+  mozilla::TimeDuration total;
+  mozilla::TimeDuration longest;
+
+  void add(mozilla::TimeDuration duration) {
+    count++;
+    total += duration;
+    longest = std::max(longest, duration);
+  }
+};
+
 } /* namespace js */
 #endif /* gc_GCParallelTask_h */
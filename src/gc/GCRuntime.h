@@ -17,6 +17,8 @@
 #include "gc/GCMarker.h"
 #include "gc/IteratorUtils.h"
 #include "gc/Nursery.h"
+#include "gc/ParallelMarking.h"
+#include "gc/ParallelTenuring.h"
 #include "gc/Scheduling.h"
 #include "gc/Statistics.h"
 #include "gc/StoreBuffer.h"
@@ -263,6 +265,12 @@ class GCRuntime {
   MOZ_MUST_USE bool addRoot(Value* vp, const char* name);
   void removeRoot(Value* vp);
   void setMarkStackLimit(size_t limit, AutoLockGC& lock);
+  MOZ_MUST_USE bool setMarkingThreadCount(size_t count, AutoLockGC& lock);
+  MOZ_MUST_USE bool setTenuringThreadCount(size_t count, AutoLockGC& lock);
+
+  // Stop any marking running concurrently with the mutator. This must happen
+  // before anything other than the mutator's barriers touches the heap.
+  void stopConcurrentMarking();
 
   MOZ_MUST_USE bool setParameter(JSGCParamKey key, uint32_t value);
   MOZ_MUST_USE bool setParameter(JSGCParamKey key, uint32_t value,
@@ -488,6 +496,7 @@ class GCRuntime {
   void setGCMode(JSGCMode m) {
     mode = m;
     marker.setGCMode(mode);
+    parallelMarker.setGCMode(mode);
   }
 
   inline void updateOnFreeArenaAlloc(const ChunkInfo& info);
@@ -617,6 +626,7 @@ class GCRuntime {
    * Must be called either during the GC or with the GC lock taken.
    */
   friend class BackgroundDecommitTask;
+  uint32_t targetEmptyChunkCount(const AutoLockGC& lock) const;
   bool tooManyEmptyChunks(const AutoLockGC& lock);
   ChunkPool expireEmptyChunkPool(const AutoLockGC& lock);
   void freeEmptyChunks(const AutoLockGC& lock);
@@ -701,6 +711,8 @@ class GCRuntime {
   void checkNoRuntimeRoots(AutoGCSession& session);
   void maybeDoCycleCollection();
   void findDeadCompartments();
+  void maybeStartConcurrentMarking();
+  void joinConcurrentMarking();
 
   friend class SweepMarkTask;
   IncrementalProgress markUntilBudgetExhausted(
@@ -741,6 +753,8 @@ class GCRuntime {
   void sweepFinalizationRegistries(Zone* zone);
   void queueFinalizationRegistryForCleanup(FinalizationQueueObject* queue);
   void sweepWeakRefs();
+  void deduplicateTenuredStrings(JSFreeOp* fop, Zone* zone,
+                                 SliceBudget& budget);
   IncrementalProgress endSweepingSweepGroup(JSFreeOp* fop, SliceBudget& budget);
   IncrementalProgress performSweepActions(SliceBudget& sliceBudget);
   IncrementalProgress sweepTypeInformation(JSFreeOp* fop, SliceBudget& budget);
@@ -761,9 +775,12 @@ class GCRuntime {
   void sweepFromBackgroundThread(AutoLockHelperThreadState& lock);
   void startBackgroundFree();
   void freeFromBackgroundThread(AutoLockHelperThreadState& lock);
-  void sweepBackgroundThings(ZoneList& zones);
+  void sweepBackgroundThings(Zone* zone);
+  static size_t sweepBackgroundZone(GCRuntime* gc, Zone* const& zone);
+  void recordBackgroundSweepTaskTimes();
   void assertBackgroundSweepingFinished();
   bool shouldCompact();
+  bool shouldCompactForFragmentation(const SliceBudget& budget);
   void beginCompactPhase();
   IncrementalProgress compactPhase(JS::GCReason reason,
                                    SliceBudget& sliceBudget,
@@ -840,6 +857,12 @@ class GCRuntime {
 
   GCMarker marker;
 
+  // Helper markers used to mark in parallel with |marker|.
+  ParallelMarker parallelMarker;
+
+  // Helper threads used to promote nursery cells during minor GC.
+  ParallelTenuring parallelTenuring;
+
   Vector<JS::GCCellPtr, 0, SystemAllocPolicy> unmarkGrayStack;
 
   /* Track heap size for this runtime. */
@@ -860,6 +883,9 @@ class GCRuntime {
   // without syscalls.
   GCLockData<ChunkPool> emptyChunks_;
 
+  // Used to decide how many chunks to keep in the emptyChunks pool.
+  GCLockData<ChunkDemandPredictor> chunkDemand_;
+
   // Chunks which have had some, but not all, of their arenas allocated live
   // in the available chunk lists. When all available arenas in a chunk have
   // been allocated, the chunk is removed from the available list and moved
@@ -883,6 +909,18 @@ class GCRuntime {
   mozilla::Atomic<uint32_t, mozilla::ReleaseAcquire> numArenasFreeCommitted;
   MainThreadData<VerifyPreTracer*> verifyPreData;
 
+  /*
+   * Counts of the arena batches allocated for helper-thread zones, and of the
+   * unused arenas and allocated cells found when those zones are merged into
+   * their targets.
+   */
+  struct HelperThreadArenaStats {
+    size_t batches = 0;
+    size_t unusedArenas = 0;
+    size_t cellsMerged = 0;
+  };
+  GCLockData<HelperThreadArenaStats> helperThreadArenaStats;
+
  private:
   MainThreadData<mozilla::TimeStamp> lastGCStartTime_;
   MainThreadData<mozilla::TimeStamp> lastGCEndTime_;
@@ -996,6 +1034,12 @@ class GCRuntime {
   /* Singly linked list of zones to be swept in the background. */
   HelperThreadLockData<ZoneList> backgroundSweepZones;
 
+  /*
+   * The times of the tasks that finalized zones in parallel in the background,
+   * to be recorded in the statistics by the main thread.
+   */
+  HelperThreadLockData<ParallelTaskTimes> backgroundSweepTaskTimes;
+
   /*
    * Whether to trigger a GC slice after a background task is complete, so that
    * the collector can continue or finsish collecting. This is only used for the
@@ -1076,6 +1120,28 @@ class GCRuntime {
    */
   MainThreadData<bool> compactingEnabled;
 
+  /*
+   * Whether to keep marking on a helper thread between incremental slices.
+   *
+   * JSGC_CONCURRENT_MARKING
+   */
+  MainThreadData<bool> concurrentMarkingEnabled;
+
+  /*
+   * Percentage of free cells in compactable arenas at the end of sweeping
+   * above which a non-shrinking GC also compacts. Zero disables this.
+   *
+   * JSGC_AUTO_COMPACTING_THRESHOLD
+   */
+  MainThreadData<uint32_t> autoCompactingThreshold;
+
+  /*
+   * Whether to merge identical tenured strings when sweeping.
+   *
+   * JSGC_TENURED_STRING_DEDUPLICATION
+   */
+  MainThreadData<bool> tenuredStringDedupEnabled;
+
   MainThreadData<bool> rootsRemoved;
 
   /*
@@ -81,6 +81,9 @@ JoinParallelTasksPhaseKind = PhaseKind("JOIN_PARALLEL_TASKS", "Join Parallel Tas
 PhaseKindGraphRoots = [
     PhaseKind("MUTATOR", "Mutator Running", 0),
     PhaseKind("GC_BEGIN", "Begin Callback", 1),
+    PhaseKind("JOIN_CONCURRENT_MARK", "Join Concurrent Mark", 78, [
+        PhaseKind("CONCURRENT_MARK", "Concurrent Mark", 79)
+    ]),
     PhaseKind("EVICT_NURSERY_FOR_MAJOR_GC", "Evict Nursery For Major GC", 70, [
         MarkRootsPhaseKind,
     ]),
@@ -98,7 +101,9 @@ PhaseKindGraphRoots = [
     ]),
     PhaseKind("MARK", "Mark", 6, [
         MarkRootsPhaseKind,
-        PhaseKind("MARK_DELAYED", "Mark Delayed", 8)
+        PhaseKind("MARK_DELAYED", "Mark Delayed", 8),
+        PhaseKind("PARALLEL_MARK", "Parallel Mark", 77),
+        JoinParallelTasksPhaseKind
     ]),
     PhaseKind("SWEEP", "Sweep", 9, [
         PhaseKind("SWEEP_MARK", "Mark During Sweeping", 10, [
@@ -137,6 +142,7 @@ PhaseKindGraphRoots = [
             ]),
             JoinParallelTasksPhaseKind
         ]),
+        PhaseKind("SWEEP_DEDUP_STRINGS", "Deduplicate Tenured Strings", 80),
         PhaseKind("SWEEP_OBJECT", "Sweep Object", 33),
         PhaseKind("SWEEP_STRING", "Sweep String", 34),
         PhaseKind("SWEEP_SCRIPT", "Sweep Script", 35),
@@ -144,6 +150,7 @@ PhaseKindGraphRoots = [
         PhaseKind("SWEEP_REGEXP_SHARED", "Sweep RegExpShared", 61),
         PhaseKind("SWEEP_SHAPE", "Sweep Shape", 36),
         PhaseKind("FINALIZE_END", "Finalize End Callback", 38),
+        PhaseKind("BACKGROUND_FINALIZE", "Background Finalize", 81),
         PhaseKind("DESTROY", "Deallocate", 39),
         JoinParallelTasksPhaseKind
     ]),
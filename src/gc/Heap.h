@@ -13,6 +13,7 @@
 #include "ds/BitArray.h"
 #include "gc/AllocKind.h"
 #include "gc/GCEnum.h"
+#include "gc/Pretenuring.h"
 #include "js/TypeDecls.h"
 #include "util/Poison.h"
 
@@ -671,6 +672,24 @@ struct ChunkBitmap {
     return true;
   }
 
+  // As markIfUnmarked, but safe to call while other threads are also setting
+  // black mark bits in the same words. Only black marking happens in parallel.
+  MOZ_ALWAYS_INLINE bool markBlackIfUnmarkedAtomic(const TenuredCell* cell) {
+    uintptr_t *word, mask;
+    getMarkWordAndMask(cell, ColorBit::BlackBit, &word, &mask);
+    auto* atomicWord =
+        reinterpret_cast<mozilla::Atomic<uintptr_t, mozilla::Relaxed>*>(word);
+    for (;;) {
+      uintptr_t bits = *atomicWord;
+      if (bits & mask) {
+        return false;
+      }
+      if (atomicWord->compareExchange(bits, bits | mask)) {
+        return true;
+      }
+    }
+  }
+
   MOZ_ALWAYS_INLINE void markBlack(const TenuredCell* cell) {
     uintptr_t *word, mask;
     getMarkWordAndMask(cell, ColorBit::BlackBit, &word, &mask);
@@ -845,28 +864,36 @@ static const int32_t ChunkStoreBufferOffsetFromLastByte =
 
 // Cell header stored before all nursery cells.
 struct alignas(gc::CellAlignBytes) NurseryCellHeader {
-  // Store zone pointer with the trace kind in the lowest three bits.
-  const uintptr_t zoneAndTraceKind;
+  // Store the allocation site pointer with the trace kind in the lowest two
+  // bits. The site gives the zone.
+  uintptr_t allocSiteAndTraceKind;
 
   // We only need to store a subset of trace kinds so this doesn't cover the
   // full range.
   static const uintptr_t TraceKindMask = 3;
 
-  static uintptr_t MakeValue(JS::Zone* const zone, JS::TraceKind kind) {
+  static uintptr_t MakeValue(AllocSite* const site, JS::TraceKind kind) {
     MOZ_ASSERT(uintptr_t(kind) < TraceKindMask);
-    MOZ_ASSERT((uintptr_t(zone) & TraceKindMask) == 0);
-    return uintptr_t(zone) | uintptr_t(kind);
+    MOZ_ASSERT((uintptr_t(site) & TraceKindMask) == 0);
+    MOZ_ASSERT(site->traceKind() == kind);
+    return uintptr_t(site) | uintptr_t(kind);
   }
 
-  NurseryCellHeader(JS::Zone* const zone, JS::TraceKind kind)
-      : zoneAndTraceKind(MakeValue(zone, kind)) {}
+  NurseryCellHeader(AllocSite* const site, JS::TraceKind kind)
+      : allocSiteAndTraceKind(MakeValue(site, kind)) {}
 
-  JS::Zone* zone() const {
-    return reinterpret_cast<JS::Zone*>(zoneAndTraceKind & ~TraceKindMask);
+  AllocSite* allocSite() const {
+    return reinterpret_cast<AllocSite*>(allocSiteAndTraceKind & ~TraceKindMask);
   }
 
+  JS::Zone* zone() const { return allocSite()->zone(); }
+
   JS::TraceKind traceKind() const {
-    return JS::TraceKind(zoneAndTraceKind & TraceKindMask);
+    return JS::TraceKind(allocSiteAndTraceKind & TraceKindMask);
+  }
+
+  void setAllocSite(AllocSite* const site) {
+    allocSiteAndTraceKind = MakeValue(site, traceKind());
   }
 
   static const NurseryCellHeader* from(const Cell* cell) {
@@ -874,6 +901,10 @@ struct alignas(gc::CellAlignBytes) NurseryCellHeader {
     return reinterpret_cast<const NurseryCellHeader*>(
         uintptr_t(cell) - sizeof(NurseryCellHeader));
   }
+  static NurseryCellHeader* from(Cell* cell) {
+    return const_cast<NurseryCellHeader*>(
+        from(static_cast<const Cell*>(cell)));
+  }
 };
 
 static_assert(uintptr_t(JS::TraceKind::Object) <=
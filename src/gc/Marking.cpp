@@ -24,6 +24,8 @@
 #include "debugger/DebugAPI.h"
 #include "gc/GCInternals.h"
 #include "gc/GCProbes.h"
+#include "gc/ParallelMarking.h"
+#include "gc/ParallelTenuring.h"
 #include "gc/Policy.h"
 #include "jit/JitCode.h"
 #include "js/friend/DumpFunctions.h"  // js::DumpObject
@@ -1018,9 +1020,23 @@ void js::GCMarker::markAndTraceChildren(T* thing) {
     thing->traceChildren(this);
   }
 }
+
+// Mark a thing and leave tracing its children to the main marker's delayed
+// marking. Used during concurrent marking for things the mutator can rewrite
+// in place.
+template <typename T>
+void js::GCMarker::markAndDelayChildren(T* thing) {
+  if (mark(thing)) {
+    delayMarkingChildren(thing);
+  }
+}
 namespace js {
 template <>
 void GCMarker::traverse(BaseShape* thing) {
+  if (MOZ_UNLIKELY(isConcurrentMarking())) {
+    // The mutator may grow or free a base shape's shape table at any time.
+    return markAndDelayChildren(thing);
+  }
   markAndTraceChildren(thing);
 }
 template <>
@@ -1033,6 +1049,10 @@ void GCMarker::traverse(JS::BigInt* thing) {
 }
 template <>
 void GCMarker::traverse(RegExpShared* thing) {
+  if (MOZ_UNLIKELY(isConcurrentMarking())) {
+    // The mutator may discard a RegExpShared's compiled code at any time.
+    return markAndDelayChildren(thing);
+  }
   markAndTraceChildren(thing);
 }
 }  // namespace js
@@ -1052,6 +1072,10 @@ void js::GCMarker::markAndScan(T* thing) {
 namespace js {
 template <>
 void GCMarker::traverse(JSString* thing) {
+  if (MOZ_UNLIKELY(isConcurrentMarking()) && !thing->isAtom()) {
+    // Flattening a rope rewrites it and its leftmost children in place.
+    return markAndDelayChildren(thing);
+  }
   markAndScan(thing);
 }
 template <>
@@ -1181,7 +1205,14 @@ bool js::GCMarker::mark(T* thing) {
 
   MarkColor color =
       TraceKindCanBeGray<T>::value ? markColor() : MarkColor::Black;
-  bool marked = cell->markIfUnmarked(color);
+  bool marked;
+  if (MOZ_UNLIKELY(isParallelMarking())) {
+    // Other markers may be setting bits in the same bitmap words.
+    MOZ_ASSERT(color == MarkColor::Black);
+    marked = cell->markBlackIfUnmarkedAtomic();
+  } else {
+    marked = cell->markIfUnmarked(color);
+  }
   if (marked) {
     markCount++;
   }
@@ -1251,7 +1282,11 @@ inline void js::GCMarker::eagerlyMarkChildren(Shape* shape) {
     // be traced by this loop they do not need to be traced here as well.
     BaseShape* base = shape->base();
     CheckTraversedEdge(shape, base);
-    if (mark(base)) {
+    if (MOZ_UNLIKELY(isConcurrentMarking())) {
+      // The mutator may make the base shape owned or convert its object to
+      // dictionary mode while we run, so leave it for the main marker.
+      markAndDelayChildren(base);
+    } else if (mark(base)) {
       MOZ_ASSERT(base->canSkipMarkingShapeCache(shape));
       base->traceChildrenSkipShapeCache(this);
     }
@@ -1616,6 +1651,28 @@ template <typename Functor>
 static void VisitTraceList(const Functor& f, const uint32_t* traceList,
                            uint8_t* memory);
 
+// Whether the trace hook of |clasp|, if it has one, can be called from a
+// helper thread during parallel marking. Only hooks known to do nothing but
+// trace edges are allowed. Other hooks, including all embedder hooks, may use
+// state that only the main thread can touch.
+static bool CanTraceOffThread(const JSClass* clasp) {
+  return !clasp->hasTrace() || clasp->isJSFunction() ||
+         clasp->isTrace(InlineTypedObject::obj_trace);
+}
+
+// Whether an object can be scanned by a helper thread while the mutator runs.
+// The mutator may reallocate dynamic slots and elements at any time, and trace
+// hooks, including function hooks, read state that changes without a barrier,
+// so only native objects with nothing but fixed slots qualify.
+static bool CanScanConcurrently(JSObject* obj) {
+  if (obj->getClass()->hasTrace() || !obj->isNative()) {
+    return false;
+  }
+
+  NativeObject* nobj = &obj->as<NativeObject>();
+  return !nobj->hasDynamicSlots() && nobj->hasEmptyElements();
+}
+
 // Call the trace hook set on the object, if present. If further tracing of
 // NativeObject fields is required, this will return the native object.
 enum class CheckGeneration { DoChecks, NoChecks };
@@ -1892,6 +1949,76 @@ bool GCMarker::markUntilBudgetExhausted(SliceBudget& budget,
   return true;
 }
 
+void GCMarker::enterParallelMarkingMode(ParallelMarker* pm, bool concurrent) {
+  MOZ_ASSERT(!parallelMarker_);
+  MOZ_ASSERT(markColor() == MarkColor::Black);
+  MOZ_ASSERT_IF(concurrent, this != &runtime()->gc.marker);
+
+  if (this != &runtime()->gc.marker) {
+    MOZ_ASSERT(state == MarkingState::NotActive);
+    MOZ_ASSERT(isDrained());
+    state = MarkingState::RegularMarking;
+  }
+
+  parallelMarker_ = pm;
+  concurrentMarking_ = concurrent;
+}
+
+void GCMarker::leaveParallelMarkingMode() {
+  MOZ_ASSERT(parallelMarker_);
+  parallelMarker_ = nullptr;
+  concurrentMarking_ = false;
+
+  if (this != &runtime()->gc.marker) {
+    MOZ_ASSERT(state == MarkingState::RegularMarking);
+    state = MarkingState::NotActive;
+  }
+}
+
+bool GCMarker::markCurrentColorInParallel(SliceBudget& budget,
+                                          size_t maxEntries) {
+  MOZ_ASSERT(isParallelMarking());
+  MOZ_ASSERT(markColor() == MarkColor::Black);
+
+  ParallelMarker* pm = parallelMarker_;
+  for (size_t i = 0; i < maxEntries && hasBlackEntries(); i++) {
+    processMarkStackTop(budget);
+    if (budget.isOverBudget() || pm->isStopping()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void GCMarker::transferWorkTo(GCMarker& dst) {
+  MOZ_ASSERT(!isParallelMarking());
+  MOZ_ASSERT(auxStack.isEmpty());
+
+  if (!stack.isEmpty() &&
+      !MarkStack::moveWork(dst.stack, stack, MarkStack::MoveAll)) {
+    // Fall back to delayed marking if the destination stack can't grow.
+    while (!stack.isEmpty()) {
+      Cell* cell;
+      switch (stack.peekTag()) {
+        case MarkStack::ValueArrayTag:
+          cell = stack.popValueArray().ptr.asValueArrayObject();
+          break;
+        case MarkStack::SavedValueArrayTag:
+          cell = stack.popSavedValueArray().ptr.asSavedValueArrayObject();
+          break;
+        default:
+          cell = stack.popPtr().ptr();
+          break;
+      }
+      dst.delayMarkingChildrenImpl(cell);
+    }
+  }
+
+  dst.markCount += markCount;
+  markCount = 0;
+}
+
 inline static bool ObjectDenseElementsMayBeMarkable(NativeObject* nobj) {
   /*
    * For arrays that are large enough it's worth checking the type information
@@ -1963,6 +2090,13 @@ inline void GCMarker::processMarkStackTop(SliceBudget& budget) {
     case MarkStack::ValueArrayTag: {
       auto array = stack.popValueArray();
       obj = array.ptr.asValueArrayObject();
+      if (isConcurrentMarking()) {
+        // The concurrent marker never pushes value arrays itself, so this came
+        // from the main marker and may refer to slots the mutator has since
+        // reallocated. The object is marked, so delayed marking traces all of
+        // its children.
+        return delayMarkingChildren(obj);
+      }
       vp = array.start;
       end = array.end;
       goto scan_value_array;
@@ -1976,17 +2110,30 @@ inline void GCMarker::processMarkStackTop(SliceBudget& budget) {
 
     case MarkStack::GroupTag: {
       auto group = stack.popPtr().as<ObjectGroup>();
+      if (isParallelMarking()) {
+        // Tracing a group may sweep its type information, which can't happen
+        // off the main thread. Leave it for the main marker.
+        return delayMarkingChildren(group);
+      }
       return lazilyMarkChildren(group);
     }
 
     case MarkStack::JitCodeTag: {
       auto code = stack.popPtr().as<jit::JitCode>();
+      if (isConcurrentMarking()) {
+        // The mutator may patch or invalidate code while it runs.
+        return delayMarkingChildren(code);
+      }
       AutoSetTracingSource asts(this, code);
       return code->traceChildren(this);
     }
 
     case MarkStack::ScriptTag: {
       auto script = stack.popPtr().as<BaseScript>();
+      if (isConcurrentMarking()) {
+        // Delazification and JIT code discarding replace script data.
+        return delayMarkingChildren(script);
+      }
       AutoSetTracingSource asts(this, script);
       return script->traceChildren(this);
     }
@@ -1994,6 +2141,10 @@ inline void GCMarker::processMarkStackTop(SliceBudget& budget) {
     case MarkStack::SavedValueArrayTag: {
       auto savedArray = stack.popSavedValueArray();
       JSObject* obj = savedArray.ptr.asSavedValueArrayObject();
+      if (isConcurrentMarking()) {
+        // As above, the mutator may be reallocating the slots or elements.
+        return delayMarkingChildren(obj);
+      }
       if (restoreValueArray(savedArray, &vp, &end)) {
         pushValueArray(obj, vp, end);
       } else {
@@ -2059,6 +2210,19 @@ scan_obj : {
     return;
   }
 
+  if (MOZ_UNLIKELY(isParallelMarking()) &&
+      !CanTraceOffThread(obj->getClass()) &&
+      !CurrentThreadCanAccessRuntime(runtime())) {
+    // Leave objects whose trace hook may not be thread safe for the main
+    // marker. The object is already marked, so its children are traced when
+    // delayed marking scans its arena.
+    return delayMarkingChildren(obj);
+  }
+
+  if (MOZ_UNLIKELY(isConcurrentMarking()) && !CanScanConcurrently(obj)) {
+    return delayMarkingChildren(obj);
+  }
+
   markImplicitEdges(obj);
   traverseEdge(obj, obj->groupRaw());
 
@@ -2074,6 +2238,17 @@ scan_obj : {
 
   unsigned nslots = nobj->slotSpan();
 
+  if (MOZ_UNLIKELY(isConcurrentMarking())) {
+    // Only scan the fixed slots, which CanScanConcurrently found to be the
+    // only ones. Slots or elements added since then hold values stored after
+    // the collection started. Those were either reachable when it started, so
+    // are marked through another edge or that edge's pre-write barrier, or
+    // were allocated marked.
+    vp = nobj->fixedSlots();
+    end = vp + std::min(nslots, nobj->numFixedSlots());
+    goto scan_value_array;
+  }
+
   do {
     if (nobj->hasEmptyElements()) {
       break;
@@ -2547,6 +2722,31 @@ size_t MarkStack::sizeOfExcludingThis(
   return stack().sizeOfExcludingThis(mallocSizeOf);
 }
 
+/* static */
+bool MarkStack::moveWork(MarkStack& dst, MarkStack& src, MoveAmount amount) {
+  // Find an entry boundary so that we don't split up a value array. Value
+  // array entries have their tag in the topmost word.
+  size_t wordsToMove = amount == MoveAll ? src.position() : src.position() / 2;
+  size_t pos = src.position();
+  while (src.position() - pos < wordsToMove) {
+    MOZ_ASSERT(pos != 0);
+    MarkStack::Tag tag = src.stack()[pos - 1].tag();
+    MOZ_ASSERT(tag != TempRopeTag);
+    pos -= TagIsArrayTag(tag) ? ValueArrayWords : 1;
+  }
+
+  size_t count = src.position() - pos;
+  if (count == 0 || !dst.ensureSpace(count)) {
+    return false;
+  }
+
+  PodCopy(dst.topPtr(), &src.stack()[pos], count);
+  dst.topIndex_ += count;
+  src.topIndex_ -= count;
+  src.poisonUnused();
+  return true;
+}
+
 MarkStackIter::MarkStackIter(MarkStack& stack)
     : stack_(stack), pos_(stack.position()) {
 #ifdef DEBUG
@@ -2631,6 +2831,8 @@ GCMarker::GCMarker(JSRuntime* rt)
       delayedMarkingList(nullptr),
       delayedMarkingWorkAdded(false),
       state(MarkingState::NotActive),
+      parallelMarker_(nullptr),
+      concurrentMarking_(false),
       incrementalWeakMapMarkingEnabled(
           TuningDefaults::IncrementalWeakMapMarkingEnabled)
 #ifdef DEBUG
@@ -2753,6 +2955,14 @@ void GCMarker::pushValueArray(JSObject* obj, HeapSlot* start, HeapSlot* end) {
     return;
   }
 
+  if (isConcurrentMarking()) {
+    // Raw slot ranges can't be saved reliably once the mutator has changed
+    // the object's shape, so push the object itself. Rescanning its fixed
+    // slots is cheap, as things that are already marked are skipped.
+    repush(obj);
+    return;
+  }
+
   if (!currentStack().push(obj, start, end)) {
     delayMarkingChildren(obj);
   }
@@ -2889,6 +3099,15 @@ void GCMarker::leaveWeakMarkingMode() {
 }
 
 void GCMarker::delayMarkingChildren(Cell* cell) {
+  if (isParallelMarking()) {
+    parallelMarker_->delayMarkingChildren(cell);
+    return;
+  }
+
+  delayMarkingChildrenImpl(cell);
+}
+
+void GCMarker::delayMarkingChildrenImpl(Cell* cell) {
   Arena* arena = cell->asTenured().arena();
   if (!arena->onDelayedMarkingList()) {
     arena->setNextDelayedMarkingArena(delayedMarkingList);
@@ -3040,11 +3259,66 @@ namespace js {
 template <typename T>
 void TenuringTracer::traverse(T** tp) {}
 
+// When promoting in parallel, move a nursery cell if this thread can, and
+// return whether the edge has been handled.
+template <typename T>
+bool TenuringTracer::tenureInParallel(T** thingp) {
+  // Only objects, strings and BigInts can be allocated in the nursery.
+  return true;
+}
+
+template <>
+bool TenuringTracer::tenureInParallel(JSObject** objp) {
+  Cell* cell = *objp;
+  if (!IsInsideNursery(cell)) {
+    return true;
+  }
+
+  // Another thread may be moving the same object.
+  NurseryCellLocks::AutoLock lock(parallelThread->owner().cellLocks(), cell);
+  if (Nursery::getForwardedPointer(&cell)) {
+    *objp = static_cast<JSObject*>(cell);
+    return true;
+  }
+
+  // Other classes may have hooks that aren't safe to run off the main thread.
+  JSObject* obj = static_cast<JSObject*>(cell);
+  if (obj->is<PlainObject>()) {
+    *objp = movePlainObjectToTenured(&obj->as<PlainObject>());
+    return true;
+  }
+  if (obj->is<ArrayObject>()) {
+    *objp = moveToTenuredSlow(obj);
+    return true;
+  }
+
+  return false;
+}
+
+// Promoting strings interacts with deduplication and the whole cell buffer,
+// so they are left to the main thread. So are BigInts, which are rare.
+template <>
+bool TenuringTracer::tenureInParallel(JSString** strp) {
+  return !IsInsideNursery(*strp);
+}
+
+template <>
+bool TenuringTracer::tenureInParallel(JS::BigInt** bip) {
+  return !IsInsideNursery(*bip);
+}
+
 template <>
 void TenuringTracer::traverse(JSObject** objp) {
   // We only ever visit the internals of objects after moving them to tenured.
   MOZ_ASSERT(!nursery().isInside(objp));
 
+  if (parallelThread) {
+    if (!tenureInParallel(objp)) {
+      parallelThread->deferEdge(reinterpret_cast<Cell**>(objp));
+    }
+    return;
+  }
+
   Cell** cellp = reinterpret_cast<Cell**>(objp);
   if (!IsInsideNursery(*cellp) || nursery().getForwardedPointer(cellp)) {
     return;
@@ -3066,6 +3340,13 @@ void TenuringTracer::traverse(JSString** strp) {
   // We only ever visit the internals of strings after moving them to tenured.
   MOZ_ASSERT(!nursery().isInside(strp));
 
+  if (parallelThread) {
+    if (!tenureInParallel(strp)) {
+      parallelThread->deferEdge(reinterpret_cast<Cell**>(strp));
+    }
+    return;
+  }
+
   Cell** cellp = reinterpret_cast<Cell**>(strp);
   if (IsInsideNursery(*cellp) && !nursery().getForwardedPointer(cellp)) {
     *strp = moveToTenured(*strp);
@@ -3077,6 +3358,13 @@ void TenuringTracer::traverse(JS::BigInt** bip) {
   // We only ever visit the internals of BigInts after moving them to tenured.
   MOZ_ASSERT(!nursery().isInside(bip));
 
+  if (parallelThread) {
+    if (!tenureInParallel(bip)) {
+      parallelThread->deferEdge(reinterpret_cast<Cell**>(bip));
+    }
+    return;
+  }
+
   Cell** cellp = reinterpret_cast<Cell**>(bip);
   if (IsInsideNursery(*cellp) && !nursery().getForwardedPointer(cellp)) {
     *bip = moveToTenured(*bip);
@@ -3085,6 +3373,11 @@ void TenuringTracer::traverse(JS::BigInt** bip) {
 
 template <typename T>
 void TenuringTracer::traverse(T* thingp) {
+  if (parallelThread) {
+    traverseInParallel(thingp);
+    return;
+  }
+
   auto tenured = MapGCThingTyped(*thingp, [this](auto t) {
     this->traverse(&t);
     return TaggedPtr<T>::wrap(t);
@@ -3094,6 +3387,31 @@ void TenuringTracer::traverse(T* thingp) {
   }
 }
 
+template <typename T>
+void TenuringTracer::traverseInParallel(T* thingp) {
+  // Defer the whole tagged edge, not the untagged copy passed to the lambda.
+  bool deferred = false;
+  auto tenured = MapGCThingTyped(*thingp, [this, &deferred](auto t) {
+    if (!this->tenureInParallel(&t)) {
+      deferred = true;
+    }
+    return TaggedPtr<T>::wrap(t);
+  });
+
+  if (deferred) {
+    if constexpr (std::is_same_v<T, JS::Value>) {
+      parallelThread->deferEdge(thingp);
+      return;
+    } else {
+      MOZ_CRASH("Unexpected nursery edge while tenuring in parallel");
+    }
+  }
+
+  if (tenured.isSome() && tenured.value() != *thingp) {
+    *thingp = tenured.value();
+  }
+}
+
 }  // namespace js
 
 template <typename T>
@@ -3335,6 +3653,9 @@ void js::gc::StoreBuffer::CellPtrEdge<T>::trace(TenuringTracer& mover) const {
   mover.traverse(edge);
 }
 
+template void js::gc::StoreBuffer::CellPtrEdge<JSObject>::trace(
+    TenuringTracer& mover) const;
+
 void js::gc::StoreBuffer::ValueEdge::trace(TenuringTracer& mover) const {
   if (deref()) {
     mover.traverse(edge);
@@ -3397,6 +3718,47 @@ void js::TenuringTracer::traceBigInt(JS::BigInt* bi) {
   bi->traceChildren(this);
 }
 
+void js::TenuringTracer::traceDeferredEdge(JS::Value* vp) {
+  MOZ_ASSERT(!parallelThread);
+  traverse(vp);
+}
+
+void js::TenuringTracer::traceDeferredEdge(Cell** cellp) {
+  MOZ_ASSERT(!parallelThread);
+
+  // The edge may have been updated if it was deferred more than once.
+  switch ((*cellp)->getTraceKind()) {
+    case JS::TraceKind::Object:
+      traverse(reinterpret_cast<JSObject**>(cellp));
+      break;
+    case JS::TraceKind::String:
+      traverse(reinterpret_cast<JSString**>(cellp));
+      break;
+    case JS::TraceKind::BigInt:
+      traverse(reinterpret_cast<JS::BigInt**>(cellp));
+      break;
+    default:
+      MOZ_CRASH("Unexpected deferred edge kind");
+  }
+}
+
+namespace {
+
+// The nursery's malloced buffer set and forwarding table are shared by the
+// threads taking part in parallel promotion.
+class MOZ_RAII AutoLockNurseryTables {
+  mozilla::Maybe<LockGuard<Mutex>> guard;
+
+ public:
+  explicit AutoLockNurseryTables(ParallelTenuringThread* thread) {
+    if (thread) {
+      guard.emplace(thread->owner().nurseryTablesLock());
+    }
+  }
+};
+
+}  // namespace
+
 #ifdef DEBUG
 static inline ptrdiff_t OffsetToChunkEnd(void* p) {
   return ChunkLocationOffset - (uintptr_t(p) & gc::ChunkMask);
@@ -3406,13 +3768,32 @@ static inline ptrdiff_t OffsetToChunkEnd(void* p) {
 /* Insert the given relocation entry into the list of things to visit. */
 inline void js::TenuringTracer::insertIntoObjectFixupList(
     RelocationOverlay* entry) {
+  if (parallelThread) {
+    parallelThread->pushObject(
+        static_cast<JSObject*>(entry->forwardingAddress()));
+    return;
+  }
+
   *objTail = entry;
   objTail = &entry->nextRef();
   *objTail = nullptr;
 }
 
+inline void js::TenuringTracer::noteTenured(Cell* src) {
+  AllocSite* site = NurseryCellHeader::from(src)->allocSite();
+  if (parallelThread) {
+    site->noteTenuredAtomic();
+  } else {
+    site->noteTenured();
+  }
+}
+
 template <typename T>
 inline T* js::TenuringTracer::allocTenured(Zone* zone, AllocKind kind) {
+  if (parallelThread) {
+    return static_cast<T*>(
+        static_cast<Cell*>(parallelThread->allocateCell(zone, kind)));
+  }
   return static_cast<T*>(static_cast<Cell*>(AllocateCellInGC(zone, kind)));
 }
 
@@ -3430,6 +3811,8 @@ JSObject* js::TenuringTracer::moveToTenuredSlow(JSObject* src) {
   MOZ_ASSERT(!src->nurseryZone()->usedByHelperThread());
   MOZ_ASSERT(!src->is<PlainObject>());
 
+  noteTenured(src);
+
   AllocKind dstKind = src->allocKindForTenure(nursery());
   auto dst = allocTenured<JSObject>(src->nurseryZone(), dstKind);
 
@@ -3507,6 +3890,8 @@ inline JSObject* js::TenuringTracer::movePlainObjectToTenured(
   MOZ_ASSERT(IsInsideNursery(src));
   MOZ_ASSERT(!src->nurseryZone()->usedByHelperThread());
 
+  noteTenured(src);
+
   AllocKind dstKind = src->allocKindForTenure();
   auto dst = allocTenured<PlainObject>(src->nurseryZone(), dstKind);
 
@@ -3543,6 +3928,7 @@ size_t js::TenuringTracer::moveSlotsToTenured(NativeObject* dst,
 
   if (!nursery().isInside(src->slots_)) {
     AddCellMemory(dst, count * sizeof(HeapSlot), MemoryUse::ObjectSlots);
+    AutoLockNurseryTables lock(parallelThread);
     nursery().removeMallocedBufferDuringMinorGC(src->slots_);
     return 0;
   }
@@ -3580,7 +3966,10 @@ size_t js::TenuringTracer::moveElementsToTenured(NativeObject* dst,
   /* TODO Bug 874151: Prefer to put element data inline if we have space. */
   if (!nursery().isInside(srcAllocatedHeader)) {
     MOZ_ASSERT(src->elements_ == dst->elements_);
-    nursery().removeMallocedBufferDuringMinorGC(srcAllocatedHeader);
+    {
+      AutoLockNurseryTables lock(parallelThread);
+      nursery().removeMallocedBufferDuringMinorGC(srcAllocatedHeader);
+    }
 
     AddCellMemory(dst, nslots * sizeof(HeapSlot), MemoryUse::ObjectElements);
 
@@ -3596,6 +3985,7 @@ size_t js::TenuringTracer::moveElementsToTenured(NativeObject* dst,
     js_memcpy(dst->getElementsHeader(), srcAllocatedHeader,
               nslots * sizeof(HeapSlot));
     dst->elements_ += numShifted;
+    AutoLockNurseryTables lock(parallelThread);
     nursery().setElementsForwardingPointer(srcHeader, dst->getElementsHeader(),
                                            srcHeader->capacity);
     return nslots * sizeof(HeapSlot);
@@ -3618,6 +4008,7 @@ size_t js::TenuringTracer::moveElementsToTenured(NativeObject* dst,
 
   js_memcpy(dstHeader, srcAllocatedHeader, nslots * sizeof(HeapSlot));
   dst->elements_ = dstHeader->elements() + numShifted;
+  AutoLockNurseryTables lock(parallelThread);
   nursery().setElementsForwardingPointer(srcHeader, dst->getElementsHeader(),
                                          srcHeader->capacity);
   return nslots * sizeof(HeapSlot);
@@ -3635,6 +4026,8 @@ JSString* js::TenuringTracer::moveToTenured(JSString* src) {
   MOZ_ASSERT(!src->nurseryZone()->usedByHelperThread());
   MOZ_ASSERT(!src->isExternal());
 
+  noteTenured(src);
+
   AllocKind dstKind = src->getAllocKind();
   Zone* zone = src->nurseryZone();
   zone->tenuredStrings++;
@@ -3757,6 +4150,8 @@ JS::BigInt* js::TenuringTracer::moveToTenured(JS::BigInt* src) {
   MOZ_ASSERT(IsInsideNursery(src));
   MOZ_ASSERT(!src->nurseryZone()->usedByHelperThread());
 
+  noteTenured(src);
+
   AllocKind dstKind = src->getAllocKind();
   Zone* zone = src->nurseryZone();
   zone->tenuredBigInts++;
@@ -3777,14 +4172,7 @@ void js::Nursery::collectToFixedPoint(TenuringTracer& mover,
   for (RelocationOverlay* p = mover.objHead; p; p = p->next()) {
     JSObject* obj = static_cast<JSObject*>(p->forwardingAddress());
     mover.traceObject(obj);
-
-    TenureCount& entry = tenureCounts.findEntry(obj->groupRaw());
-    if (entry.group == obj->groupRaw()) {
-      entry.count++;
-    } else if (!entry.group) {
-      entry.group = obj->groupRaw();
-      entry.count = 1;
-    }
+    tenureCounts.noteTenured(obj->groupRaw());
   }
 
   for (StringRelocationOverlay* p = mover.stringHead; p; p = p->next()) {
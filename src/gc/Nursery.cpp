@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 
 #include "builtin/MapObject.h"
@@ -22,6 +23,9 @@
 #include "gc/GCInternals.h"
 #include "gc/GCLock.h"
 #include "gc/Memory.h"
+#include "gc/ParallelTenuring.h"
+#include "gc/ParallelWork.h"
+#include "gc/Pretenuring.h"
 #include "gc/PublicIterators.h"
 #include "jit/JitFrames.h"
 #include "jit/JitRealm.h"
@@ -229,6 +233,8 @@ js::Nursery::Nursery(GCRuntime* gc)
       canAllocateStrings_(true),
       canAllocateBigInts_(true),
       reportTenurings_(0),
+      recordTenurings_(false),
+      allocatedSites_(AllocSite::EndSentinel),
       minorGCTriggerReason_(JS::GCReason::NO_REASON),
 #ifndef JS_MORE_DETERMINISTIC
       smoothedGrowthFactor(1.0),
@@ -476,7 +482,9 @@ Cell* js::Nursery::allocateCell(Zone* zone, size_t size, JS::TraceKind kind) {
     return nullptr;
   }
 
-  new (ptr) NurseryCellHeader(zone, kind);
+  AllocSite* site = zone->unknownAllocSite(kind);
+  new (ptr) NurseryCellHeader(site, kind);
+  noteAllocation(site);
 
   auto cell =
       reinterpret_cast<Cell*>(uintptr_t(ptr) + sizeof(NurseryCellHeader));
@@ -484,6 +492,26 @@ Cell* js::Nursery::allocateCell(Zone* zone, size_t size, JS::TraceKind kind) {
   return cell;
 }
 
+inline void js::Nursery::noteAllocation(AllocSite* site) {
+  if (site->noteNurseryAllocation()) {
+    site->setNextNurseryAllocated(allocatedSites_);
+    allocatedSites_ = site;
+  }
+}
+
+void js::Nursery::setAllocSite(Cell* cell, AllocSite* site) {
+  MOZ_ASSERT(IsInsideNursery(cell));
+  NurseryCellHeader* header = NurseryCellHeader::from(cell);
+  AllocSite* previous = header->allocSite();
+  MOZ_ASSERT(previous->zone() == site->zone());
+  MOZ_ASSERT(previous->isCatchAll());
+
+  // The catch-all site stays in the list even if its count drops to zero.
+  previous->unnoteNurseryAllocation();
+  header->setAllocSite(site);
+  noteAllocation(site);
+}
+
 inline void* js::Nursery::allocate(size_t size) {
   MOZ_ASSERT(isEnabled());
   MOZ_ASSERT(!JS::RuntimeHeapIsBusy());
@@ -757,7 +785,8 @@ js::TenuringTracer::TenuringTracer(JSRuntime* rt, Nursery* nursery)
       stringHead(nullptr),
       stringTail(&stringHead),
       bigIntHead(nullptr),
-      bigIntTail(&bigIntHead) {}
+      bigIntTail(&bigIntHead),
+      parallelThread(nullptr) {}
 
 inline double js::Nursery::calcPromotionRate(bool* validForTenuring) const {
   double used = double(previousGC.nurseryUsedBytes);
@@ -838,6 +867,10 @@ void js::Nursery::renderProfileJSON(JSONPrinter& json) const {
     json.property("groups_pretenured",
                   stats().getStat(gcstats::STAT_OBJECT_GROUPS_PRETENURED));
   }
+  if (stats().getStat(gcstats::STAT_ALLOC_SITES_PRETENURED)) {
+    json.property("sites_pretenured",
+                  stats().getStat(gcstats::STAT_ALLOC_SITES_PRETENURED));
+  }
   if (stats().getStat(gcstats::STAT_NURSERY_STRING_REALMS_DISABLED)) {
     json.property(
         "nursery_string_realms_disabled",
@@ -864,6 +897,21 @@ void js::Nursery::renderProfileJSON(JSONPrinter& json) const {
 
   json.endObject();  // timings value
 
+  const ParallelTenuring& pt = gc->parallelTenuring;
+  if (pt.lastThreadCount()) {
+    json.beginListProperty("tenuring_threads");
+    for (size_t i = 0; i < pt.lastThreadCount(); i++) {
+      const TenuringThreadStats& stats = pt.lastStats(i);
+      json.beginObject();
+      json.property("bytes_tenured", stats.tenuredBytes);
+      json.property("cells_tenured", stats.tenuredCells);
+      json.property("objects_stolen", stats.stolenObjects);
+      json.property("time", stats.duration, json.MICROSECONDS);
+      json.endObject();
+    }
+    json.endList();
+  }
+
   json.endObject();
 }
 
@@ -1038,6 +1086,8 @@ void js::Nursery::collect(JSGCInvocationKind kind, JS::GCReason reason) {
       validPromotionRate && promotionRate > tunables().pretenureThreshold();
 
   startProfile(ProfileKey::Pretenure);
+  size_t sitesPretenured = processAllocSites();
+  stats().setStat(gcstats::STAT_ALLOC_SITES_PRETENURED, sitesPretenured);
   size_t pretenureCount =
       doPretenuring(rt, reason, tenureCounts, highPromotionRate);
   endProfile(ProfileKey::Pretenure);
@@ -1067,6 +1117,10 @@ void js::Nursery::collect(JSGCInvocationKind kind, JS::GCReason reason) {
   if (reportTenurings_) {
     printTenuringData(tenureCounts);
   }
+
+  if (recordTenurings_) {
+    recordTenuringData(tenureCounts);
+  }
 }
 
 void js::Nursery::sendTelemetry(JS::GCReason reason, TimeDuration totalTime,
@@ -1085,6 +1139,19 @@ void js::Nursery::sendTelemetry(JS::GCReason reason, TimeDuration totalTime,
     rt->addTelemetry(JS_TELEMETRY_GC_NURSERY_PROMOTION_RATE,
                      promotionRate * 100);
   }
+
+  if (stats().hasTelemetryCallback()) {
+    JS::GCTelemetryRecord record;
+    record.kind = JS::GCTelemetryEventKind::MinorGC;
+    record.reason = reason;
+    record.gcNumber = gc->minorGCCount();
+    record.start = startTimes_[ProfileKey::Total];
+    record.end = record.start + totalTime;
+    record.nurseryUsedBytes = previousGC.nurseryUsedBytes;
+    record.tenuredBytes = previousGC.tenuredBytes;
+    record.promotionRate = promotionRate;
+    stats().sendTelemetryRecord(record);
+  }
 }
 
 void js::Nursery::printCollectionProfile(JS::GCReason reason,
@@ -1098,6 +1165,16 @@ void js::Nursery::printCollectionProfile(JS::GCReason reason,
           previousGC.nurseryCapacity / 1024);
 
   printProfileDurations(profileDurations_);
+
+  const ParallelTenuring& pt = gc->parallelTenuring;
+  for (size_t i = 0; i < pt.lastThreadCount(); i++) {
+    const TenuringThreadStats& stats = pt.lastStats(i);
+    fprintf(stderr,
+            "MinorGC:   tenuring thread %2zu: %8zu bytes %6zu cells %6zu "
+            "stolen %6" PRIi64 " us\n",
+            i, stats.tenuredBytes, stats.tenuredCells, stats.stolenObjects,
+            static_cast<int64_t>(stats.duration.ToMicroseconds()));
+  }
 }
 
 void js::Nursery::printTenuringData(const TenureCountCache& tenureCounts) {
@@ -1110,6 +1187,24 @@ void js::Nursery::printTenuringData(const TenureCountCache& tenureCounts) {
   }
 }
 
+void js::Nursery::recordTenuringData(const TenureCountCache& tenureCounts) {
+  tenuringRecords_.clear();
+  for (const auto& entry : tenureCounts.entries) {
+    if (!entry.count) {
+      continue;
+    }
+
+    ObjectGroup* group = entry.group;
+    TenuringRecord record = {group->clasp(), entry.count,
+                             group->shouldPreTenureDontCheckGeneration()};
+    if (!tenuringRecords_.append(record)) {
+      // This data is only used for testing, so just drop it on OOM.
+      tenuringRecords_.clear();
+      return;
+    }
+  }
+}
+
 js::Nursery::CollectionResult js::Nursery::doCollection(
     JS::GCReason reason, TenureCountCache& tenureCounts) {
   JSRuntime* rt = runtime();
@@ -1141,17 +1236,30 @@ js::Nursery::CollectionResult js::Nursery::doCollection(
   sb.traceWholeCells(mover);
   endProfile(ProfileKey::TraceWholeCells);
 
-  startProfile(ProfileKey::TraceValues);
-  sb.traceValues(mover);
-  endProfile(ProfileKey::TraceValues);
+  // Promote what the value, object and slots edges point to on several
+  // threads if there are enough of them, or else trace them here.
+  startProfile(ProfileKey::ParallelTenuring);
+  bool tenuredInParallel =
+      gc->parallelTenuring.tenure(mover, sb, tenureCounts);
+  endProfile(ProfileKey::ParallelTenuring);
+
+  if (tenuredInParallel) {
+    startProfile(ProfileKey::TraceCells);
+    sb.traceNonObjectCells(mover);
+    endProfile(ProfileKey::TraceCells);
+  } else {
+    startProfile(ProfileKey::TraceValues);
+    sb.traceValues(mover);
+    endProfile(ProfileKey::TraceValues);
 
-  startProfile(ProfileKey::TraceCells);
-  sb.traceCells(mover);
-  endProfile(ProfileKey::TraceCells);
+    startProfile(ProfileKey::TraceCells);
+    sb.traceCells(mover);
+    endProfile(ProfileKey::TraceCells);
 
-  startProfile(ProfileKey::TraceSlots);
-  sb.traceSlots(mover);
-  endProfile(ProfileKey::TraceSlots);
+    startProfile(ProfileKey::TraceSlots);
+    sb.traceSlots(mover);
+    endProfile(ProfileKey::TraceSlots);
+  }
 
   startProfile(ProfileKey::TraceGenericEntries);
   sb.traceGenericEntries(&mover);
@@ -1324,6 +1432,28 @@ size_t js::Nursery::doPretenuring(JSRuntime* rt, JS::GCReason reason,
   return pretenureCount;
 }
 
+size_t js::Nursery::processAllocSites() {
+  // Sites are looked at even if pretenuring is disabled, so that their
+  // statistics are available, but then they don't change state.
+  double threshold = tunables().attemptPretenuring()
+                         ? tunables().pretenureThreshold()
+                         : std::numeric_limits<double>::infinity();
+
+  size_t sitesPretenured = 0;
+  AllocSite* site = allocatedSites_;
+  while (site != AllocSite::EndSentinel) {
+    AllocSite* next = site->nextNurseryAllocated();
+    if (site->processSite(threshold) &&
+        site->state() == AllocSite::State::LongLived) {
+      sitesPretenured++;
+    }
+    site = next;
+  }
+  allocatedSites_ = AllocSite::EndSentinel;
+
+  return sitesPretenured;
+}
+
 bool js::Nursery::registerMallocedBuffer(void* buffer, size_t nbytes) {
   MOZ_ASSERT(buffer);
   MOZ_ASSERT(nbytes > 0);
@@ -1379,9 +1509,8 @@ void js::Nursery::clear() {
     MOZ_ASSERT(currentStartChunk_ == 0);
     firstClearChunk = 1;
   }
-  for (unsigned i = firstClearChunk; i < currentChunk_; ++i) {
-    chunk(i).poisonAfterEvict();
-  }
+  poisonChunksAfterEvict(firstClearChunk, currentChunk_);
+
   // Clear only the used part of the chunk because that's the part we touched,
   // but only if it's not going to be re-used immediately (>= firstClearChunk).
   if (currentChunk_ >= firstClearChunk) {
@@ -1402,6 +1531,78 @@ void js::Nursery::clear() {
   setStartPosition();
 }
 
+#ifdef JS_GC_POISONING
+namespace {
+
+// Poisons a contiguous range of whole nursery chunks after a minor GC.
+class NurseryPoisonTask : public GCParallelTask {
+ public:
+  NurseryPoisonTask(GCRuntime* gc, NurseryChunk* const* begin,
+                    NurseryChunk* const* end)
+      : GCParallelTask(gc), begin(begin), end(end) {}
+  ~NurseryPoisonTask() override { join(); }
+
+  void run() override {
+    for (NurseryChunk* const* chunk = begin; chunk != end; chunk++) {
+      (*chunk)->poisonAfterEvict();
+    }
+  }
+
+ private:
+  NurseryChunk* const* const begin;
+  NurseryChunk* const* const end;
+};
+
+}  // namespace
+#endif
+
+void js::Nursery::poisonChunksAfterEvict(unsigned first, unsigned end) {
+  if (first >= end) {
+    return;
+  }
+
+#ifdef JS_GC_POISONING
+  // Poisoning a large nursery can take several milliseconds, so split the
+  // chunks between the main thread and helper threads. Don't bother for a
+  // small number of chunks or when poisoning is disabled at runtime.
+  static constexpr size_t MinChunksPerTask = 2;
+  size_t chunkCount = end - first;
+  size_t taskCount = std::min(ParallelWorkerCount(),
+                              chunkCount / MinChunksPerTask);
+  if (!gDisablePoisoning && taskCount > 1) {
+    NurseryChunk* const* chunks = &chunks_[first];
+    size_t chunksPerTask = chunkCount / taskCount;
+
+    // The main thread poisons the first share itself.
+    mozilla::Maybe<NurseryPoisonTask> tasks[MaxParallelWorkers];
+    {
+      AutoLockHelperThreadState lock;
+      for (size_t i = 1; i < taskCount; i++) {
+        NurseryChunk* const* taskEnd = i == taskCount - 1
+                                           ? chunks + chunkCount
+                                           : chunks + (i + 1) * chunksPerTask;
+        tasks[i].emplace(gc, chunks + i * chunksPerTask, taskEnd);
+        tasks[i]->startWithLockHeld(lock);
+      }
+    }
+
+    for (size_t i = 0; i < chunksPerTask; i++) {
+      chunks[i]->poisonAfterEvict();
+    }
+
+    AutoLockHelperThreadState lock;
+    for (size_t i = 1; i < taskCount; i++) {
+      tasks[i]->joinWithLockHeld(lock);
+    }
+    return;
+  }
+#endif
+
+  for (unsigned i = first; i < end; ++i) {
+    chunk(i).poisonAfterEvict();
+  }
+}
+
 size_t js::Nursery::spaceToEnd(unsigned chunkCount) const {
   if (chunkCount == 0) {
     return 0;
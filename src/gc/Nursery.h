@@ -29,6 +29,7 @@
   _(TraceCells, "mkClls")                     \
   _(TraceSlots, "mkSlts")                     \
   _(TraceWholeCells, "mcWCll")                \
+  _(ParallelTenuring, "prlTen")               \
   _(TraceGenericEntries, "mkGnrc")            \
   _(CheckHashTables, "ckTbls")                \
   _(MarkRuntime, "mkRntm")                    \
@@ -61,11 +62,14 @@ class MapObject;
 class SetObject;
 
 namespace gc {
+class AllocSite;
 class AutoMaybeStartBackgroundAllocation;
 class AutoTraceSession;
 struct Cell;
 class GCSchedulingTunables;
 class MinorCollectionTracer;
+class ParallelTenuring;
+class ParallelTenuringThread;
 class RelocationOverlay;
 class StringRelocationOverlay;
 struct TenureCountCache;
@@ -104,6 +108,8 @@ class NurseryDecommitTask : public GCParallelTask {
 
 class TenuringTracer : public JSTracer {
   friend class Nursery;
+  friend class gc::ParallelTenuring;
+  friend class gc::ParallelTenuringThread;
   Nursery& nursery_;
 
   // Amount of data moved to the tenured generation during collection.
@@ -121,6 +127,11 @@ class TenuringTracer : public JSTracer {
   gc::RelocationOverlay* bigIntHead;
   gc::RelocationOverlay** bigIntTail;
 
+  // The thread this tracer belongs to when promoting in parallel. Such a
+  // tracer only moves plain objects and arrays, queueing them on the thread
+  // rather than on the fixup lists, and defers all other nursery edges.
+  gc::ParallelTenuringThread* parallelThread;
+
   TenuringTracer(JSRuntime* rt, Nursery* nursery);
 
  public:
@@ -138,11 +149,23 @@ class TenuringTracer : public JSTracer {
   void traceString(JSString* src);
   void traceBigInt(JS::BigInt* src);
 
+  // Trace an edge that a parallel tenuring thread couldn't handle.
+  void traceDeferredEdge(JS::Value* vp);
+  void traceDeferredEdge(gc::Cell** cellp);
+
  private:
+  template <typename T>
+  bool tenureInParallel(T** thingp);
+  template <typename T>
+  void traverseInParallel(T* thingp);
+
   inline void insertIntoObjectFixupList(gc::RelocationOverlay* entry);
   inline void insertIntoStringFixupList(gc::StringRelocationOverlay* entry);
   inline void insertIntoBigIntFixupList(gc::RelocationOverlay* entry);
 
+  // Count a promoted cell against its allocation site.
+  inline void noteTenured(gc::Cell* src);
+
   template <typename T>
   inline T* allocTenured(JS::Zone* zone, gc::AllocKind kind);
   JSString* allocTenuredString(JSString* src, JS::Zone* zone,
@@ -252,6 +275,14 @@ class Nursery {
     return sizeof(gc::NurseryCellHeader);
   }
 
+  // Attribute a cell that was just allocated in the nursery to |site| rather
+  // than to its zone's catch-all site.
+  void setAllocSite(gc::Cell* cell, gc::AllocSite* site);
+
+  // The head of the list of allocation sites that allocated in the nursery
+  // since the last minor GC, for JIT code.
+  gc::AllocSite** addressOfAllocatedSites() { return &allocatedSites_; }
+
   // Allocate a buffer for a given zone, using the nursery if possible.
   void* allocateBuffer(JS::Zone* zone, size_t nbytes);
 
@@ -293,6 +324,19 @@ class Nursery {
   // Do a minor collection.
   void collect(JSGCInvocationKind kind, JS::GCReason reason);
 
+  // How many objects of a particular class were tenured in one object group
+  // during the last minor collection, and whether that group is now being
+  // pretenured. These are only recorded when requested by testing functions.
+  struct TenuringRecord {
+    const JSClass* clasp;
+    uint32_t count;
+    bool pretenured;
+  };
+  using TenuringRecords = Vector<TenuringRecord, 0, SystemAllocPolicy>;
+
+  void setRecordTenurings(bool record) { recordTenurings_ = record; }
+  const TenuringRecords& tenuringRecords() const { return tenuringRecords_; }
+
   // If the thing at |*ref| in the Nursery has been forwarded, set |*ref| to
   // the new location and return true. Otherwise return false and leave
   // |*ref| unset.
@@ -483,6 +527,16 @@ class Nursery {
   // Report ObjectGroups with at least this many instances tenured.
   int64_t reportTenurings_;
 
+  // Whether to save per-group tenuring data for the testing functions, and
+  // the data from the last collection.
+  bool recordTenurings_;
+  TenuringRecords tenuringRecords_;
+
+  // The allocation sites that allocated in the nursery since the last minor
+  // GC, linked through AllocSite::nextNurseryAllocated and ending with
+  // AllocSite::EndSentinel.
+  gc::AllocSite* allocatedSites_;
+
   // Whether and why a collection of this nursery has been requested. This is
   // mutable as it is set by the store buffer, which otherwise cannot modify
   // anything in the nursery.
@@ -689,6 +743,13 @@ class Nursery {
                        const gc::TenureCountCache& tenureCounts,
                        bool highPromotionRate);
 
+  inline void noteAllocation(gc::AllocSite* site);
+
+  // Update the state of the allocation sites that allocated since the last
+  // minor GC from the survival rate of their cells. Returns the number of
+  // sites that became long-lived.
+  size_t processAllocSites();
+
   // Move the object at |src| in the Nursery to an already-allocated cell
   // |dst| in Tenured.
   void collectToFixedPoint(TenuringTracer& trc,
@@ -723,6 +784,10 @@ class Nursery {
   // the nursery on debug & nightly builds.
   void clear();
 
+  // Poison whole chunks in the range [first, end), using helper threads when
+  // there are enough of them.
+  void poisonChunksAfterEvict(unsigned first, unsigned end);
+
   void sweepDictionaryModeObjects();
   void sweepMapAndSetObjects();
 
@@ -744,6 +809,7 @@ class Nursery {
 
   void printCollectionProfile(JS::GCReason reason, double promotionRate);
   void printTenuringData(const gc::TenureCountCache& tenureCounts);
+  void recordTenuringData(const gc::TenureCountCache& tenureCounts);
 
   // Profile recording and printing.
   void maybeClearProfileDurations();
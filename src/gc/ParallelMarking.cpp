@@ -0,0 +1,520 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gc/ParallelMarking.h"
+
+#include "mozilla/Maybe.h"
+#include "mozilla/ScopeExit.h"
+#include "mozilla/Unused.h"
+
+#include <algorithm>
+
+#include "gc/GCInternals.h"
+#include "gc/GCLock.h"
+#include "vm/HelperThreads.h"
+#include "vm/MutexIDs.h"
+#include "vm/Runtime.h"
+
+using namespace js;
+using namespace js::gc;
+
+using mozilla::TimeDuration;
+using mozilla::TimeStamp;
+
+ParallelMarkingThread::ParallelMarkingThread(GCMarker* marker, size_t index)
+    : marker_(marker),
+      index(index),
+      stackLock(mutexid::GCParallelMarkerStack),
+      stackWords(0) {}
+
+ParallelMarkTask::ParallelMarkTask(ParallelMarker* pm,
+                                   ParallelMarkingThread* thread,
+                                   const SliceBudget& budget)
+    : GCParallelTask(&thread->marker()->runtime()->gc),
+      pm(pm),
+      thread(thread),
+      budget_(budget) {}
+
+void ParallelMarkTask::run() {
+  AutoSetThreadIsMarking threadIsMarking;
+  mozilla::Unused << pm->markOneThread(*thread, budget_);
+}
+
+ConcurrentMarkTask::ConcurrentMarkTask(GCRuntime* gc, ParallelMarker* pm)
+    : GCParallelTask(gc), pm(pm) {}
+
+void ConcurrentMarkTask::run() {
+  AutoSetThreadIsMarking threadIsMarking;
+  pm->markConcurrently();
+}
+
+ParallelMarker::ParallelMarker(GCRuntime* gc)
+    : gc(gc),
+      concurrentTask(gc, this),
+      concurrentMarking(false),
+      lastThreadCount_(0),
+      lock(mutexid::GCParallelMarker),
+      activeTaskCount(0),
+      waitingTaskCount(0),
+      stopping(false),
+      weakMapLock(mutexid::GCParallelMarkerWeakMaps) {}
+
+bool ParallelMarker::setThreadCount(size_t threadCount, JSGCMode gcMode) {
+  MOZ_ASSERT(threadCount >= 1 && threadCount <= MaxParallelMarkers);
+  MOZ_ASSERT(!concurrentMarking);
+
+  // The threads refer to the markers, so they are recreated below.
+  threads.clear();
+  lastThreadCount_ = 0;
+
+  size_t helperCount = threadCount - 1;
+  if (helperCount < helperMarkers.length()) {
+    helperMarkers.shrinkTo(helperCount);
+  }
+
+  while (helperMarkers.length() < helperCount) {
+    UniquePtr<GCMarker> marker = MakeUnique<GCMarker>(gc->rt);
+    if (!marker || !marker->init(gcMode)) {
+      return false;
+    }
+    marker->setMaxCapacity(mainMarker().maxCapacity());
+    if (!helperMarkers.append(std::move(marker))) {
+      return false;
+    }
+  }
+
+  if (helperCount == 0) {
+    return true;
+  }
+
+  if (!threads.reserve(threadCount)) {
+    return false;
+  }
+  for (size_t i = 0; i < threadCount; i++) {
+    GCMarker* marker = i == 0 ? &mainMarker() : helperMarkers[i - 1].get();
+    auto thread = MakeUnique<ParallelMarkingThread>(marker, i);
+    if (!thread) {
+      threads.clear();
+      return false;
+    }
+    threads.infallibleAppend(std::move(thread));
+  }
+
+  return true;
+}
+
+void ParallelMarker::setMaxCapacity(size_t maxCap) {
+  MOZ_ASSERT(!concurrentMarking);
+  for (auto& marker : helperMarkers) {
+    marker->setMaxCapacity(maxCap);
+  }
+  if (concurrentMarker) {
+    concurrentMarker->setMaxCapacity(maxCap);
+  }
+}
+
+void ParallelMarker::setGCMode(JSGCMode mode) {
+  MOZ_ASSERT(!concurrentMarking);
+  for (auto& marker : helperMarkers) {
+    marker->setGCMode(mode);
+  }
+  if (concurrentMarker) {
+    concurrentMarker->setGCMode(mode);
+  }
+}
+
+GCMarker& ParallelMarker::mainMarker() { return gc->marker; }
+
+bool ParallelMarker::shouldMarkInParallel() const {
+  if (threads.empty() || !CanUseExtraThreads()) {
+    return false;
+  }
+
+  const GCMarker& marker = gc->marker;
+  return gc->state() == State::Mark &&
+         marker.markColor() == MarkColor::Black &&
+         marker.state == MarkingState::RegularMarking &&
+         marker.stack.position() >= MinParallelMarkingWork;
+}
+
+// The budget for one of |count| markers. Time budgets are shared, as every
+// marker checks the same deadline. Work budgets are split.
+static SliceBudget MarkerBudget(const SliceBudget& budget, size_t count) {
+  if (!budget.isWorkBudget()) {
+    return budget;
+  }
+
+  int64_t share = std::max(int64_t(budget.counter), int64_t(0)) / count;
+  return SliceBudget(WorkBudget(std::max(share, int64_t(1))));
+}
+
+// The work done with |budget|, which was created by MarkerBudget.
+static int64_t WorkDone(const SliceBudget& initial, const SliceBudget& budget) {
+  MOZ_ASSERT(budget.isWorkBudget());
+  return int64_t(initial.counter) - int64_t(budget.counter);
+}
+
+bool ParallelMarker::mark(SliceBudget& budget) {
+  MOZ_ASSERT(shouldMarkInParallel());
+
+  enter();
+
+  SliceBudget markerBudget = MarkerBudget(budget, threads.length());
+
+  // Helper tasks record their time under PARALLEL_MARK when they are joined,
+  // as the maximum time taken by any one task.
+  mozilla::Maybe<ParallelMarkTask> tasks[MaxParallelMarkers];
+  {
+    AutoLockHelperThreadState helperLock;
+    for (size_t i = 1; i < threads.length(); i++) {
+      tasks[i].emplace(this, threads[i].get(), markerBudget);
+      gc->startTask(*tasks[i], gcstats::PhaseKind::PARALLEL_MARK, helperLock);
+    }
+  }
+
+  // The main thread takes part using the main marker.
+  SliceBudget mainBudget = markerBudget;
+  {
+    gcstats::AutoPhase ap(gc->stats(), gcstats::PhaseKind::PARALLEL_MARK);
+    mozilla::Unused << markOneThread(*threads[0], mainBudget);
+  }
+
+  {
+    AutoLockHelperThreadState helperLock;
+    for (size_t i = 1; i < threads.length(); i++) {
+      gc->joinTask(*tasks[i], gcstats::PhaseKind::PARALLEL_MARK, helperLock);
+    }
+  }
+
+  leave();
+
+  for (size_t i = 0; i < threads.length(); i++) {
+    gc->stats().recordMarkingThreadTime(i, threads[i]->stats().duration);
+  }
+
+  // Charge the slice's budget. For a work budget that's the work every
+  // marker did. Otherwise, make the next check look at the deadline.
+  if (budget.isWorkBudget()) {
+    int64_t work = WorkDone(markerBudget, mainBudget);
+    for (size_t i = 1; i < threads.length(); i++) {
+      work += WorkDone(markerBudget, tasks[i]->budget());
+    }
+    budget.step(intptr_t(work));
+  } else {
+    budget.step(budget.counter);
+  }
+
+  if (budget.isOverBudget()) {
+    // Change representation of value arrays on the stack while the mutator
+    // runs.
+    mainMarker().saveValueRanges();
+    return false;
+  }
+
+  return true;
+}
+
+void ParallelMarker::enter() {
+  MOZ_ASSERT(!concurrentMarking);
+  MOZ_ASSERT(activeTaskCount == 0);
+  MOZ_ASSERT(waitingTaskCount == 0);
+
+  stopping = false;
+
+  // The main thread is registered before any helpers start, so that a helper
+  // can't decide marking has finished while the main thread still has work.
+  activeTaskCount = 1;
+
+  for (auto& thread : threads) {
+    thread->stackWords = thread->marker()->stack.position();
+    thread->stats_ = MarkingThreadStats();
+  }
+  lastThreadCount_ = threads.length();
+
+  GCMarker& main = mainMarker();
+  main.enterParallelMarkingMode(this);
+  for (auto& marker : helperMarkers) {
+    marker->incrementalWeakMapMarkingEnabled =
+        main.incrementalWeakMapMarkingEnabled;
+    marker->enterParallelMarkingMode(this);
+  }
+}
+
+void ParallelMarker::leave() {
+  MOZ_ASSERT(activeTaskCount == 0);
+  MOZ_ASSERT(waitingTaskCount == 0);
+
+  GCMarker& main = mainMarker();
+  main.leaveParallelMarkingMode();
+
+  // Markers stop with work left on their stacks if the budget was exhausted.
+  // Hand it back to the main marker so it is saved between slices.
+  for (auto& marker : helperMarkers) {
+    marker->leaveParallelMarkingMode();
+    marker->transferWorkTo(main);
+    MOZ_ASSERT(marker->isDrained());
+  }
+
+  for (auto& thread : threads) {
+    thread->stackWords = 0;
+  }
+}
+
+bool ParallelMarker::registerTask() {
+  LockGuard<Mutex> guard(lock);
+  if (stopping) {
+    // A task that starts after marking finished has nothing to do.
+    return false;
+  }
+
+  activeTaskCount++;
+  return true;
+}
+
+void ParallelMarker::unregisterTask() {
+  LockGuard<Mutex> guard(lock);
+  MOZ_ASSERT(activeTaskCount);
+  activeTaskCount--;
+}
+
+bool ParallelMarker::markOneThread(ParallelMarkingThread& thread,
+                                   SliceBudget& budget) {
+  if (&thread != threads[0].get() && !registerTask()) {
+    return true;
+  }
+
+  GCMarker* marker = thread.marker();
+  size_t initialMarkCount = marker->markCount;
+  TimeStamp start = TimeStamp::Now();
+  auto finishOnExit = mozilla::MakeScopeExit([&] {
+    thread.stats_.markedCells = marker->markCount - initialMarkCount;
+    thread.stats_.duration = TimeStamp::Now() - start;
+    unregisterTask();
+  });
+
+  for (;;) {
+    if (!drainStack(thread, budget)) {
+      if (budget.isOverBudget()) {
+        stop();
+      }
+      return false;
+    }
+
+    if (!waitForWork(thread)) {
+      return true;
+    }
+  }
+}
+
+bool ParallelMarker::drainStack(ParallelMarkingThread& thread,
+                                SliceBudget& budget) {
+  GCMarker* marker = thread.marker();
+
+  for (;;) {
+    {
+      LockGuard<Mutex> guard(thread.stackLock);
+      bool ok = marker->markCurrentColorInParallel(budget,
+                                                   MarkStackEntriesPerBatch);
+      thread.stackWords = marker->stack.position();
+      if (!ok) {
+        return false;
+      }
+    }
+
+    if (thread.stackWords == 0) {
+      return true;
+    }
+
+    // Let markers that are out of work know they can steal from us.
+    if (waitingTaskCount && thread.stackWords >= MinMarkStackWordsToSteal) {
+      notifyWaitingTasks();
+    }
+  }
+}
+
+bool ParallelMarker::stealWork(ParallelMarkingThread& thread) {
+  MOZ_ASSERT(thread.stackWords == 0);
+
+  // Start with the thread after this one so that idle threads don't all pick
+  // the same victim.
+  size_t count = threads.length();
+  for (size_t i = 1; i < count; i++) {
+    ParallelMarkingThread& victim = *threads[(thread.index + i) % count];
+    if (victim.stackWords < MinMarkStackWordsToSteal) {
+      continue;
+    }
+
+    LockGuard<Mutex> guard(victim.stackLock);
+    if (victim.stackWords < MinMarkStackWordsToSteal) {
+      continue;
+    }
+
+    // Nothing steals from this thread while its stackWords is zero, so its
+    // stack can be used without taking its lock.
+    MarkStack& stack = thread.marker()->stack;
+    if (!MarkStack::moveWork(stack, victim.marker()->stack,
+                             MarkStack::MoveHalf)) {
+      continue;
+    }
+
+    victim.stackWords = victim.marker()->stack.position();
+    thread.stats_.stolenWords += stack.position();
+    return true;
+  }
+
+  return false;
+}
+
+bool ParallelMarker::waitForWork(ParallelMarkingThread& thread) {
+  MOZ_ASSERT(!thread.marker()->hasBlackEntries());
+
+  for (;;) {
+    if (stopping) {
+      return false;
+    }
+
+    if (stealWork(thread)) {
+      return true;
+    }
+
+    LockGuard<Mutex> guard(lock);
+    if (stopping) {
+      return false;
+    }
+
+    MOZ_ASSERT(waitingTaskCount < activeTaskCount);
+    if (waitingTaskCount + 1 == activeTaskCount) {
+      // Every other marker is waiting, so their stacks are empty and black
+      // marking is complete.
+      stopping = true;
+      workAvailable.notify_all();
+      return false;
+    }
+
+    waitingTaskCount++;
+    workAvailable.wait(guard);
+    waitingTaskCount--;
+  }
+}
+
+void ParallelMarker::notifyWaitingTasks() {
+  LockGuard<Mutex> guard(lock);
+  workAvailable.notify_all();
+}
+
+void ParallelMarker::stop() {
+  LockGuard<Mutex> guard(lock);
+  stopping = true;
+  workAvailable.notify_all();
+}
+
+bool ParallelMarker::shouldMarkConcurrently() const {
+  if (!CanUseExtraThreads()) {
+    return false;
+  }
+
+  const GCMarker& marker = gc->marker;
+  return gc->state() == State::Mark &&
+         marker.markColor() == MarkColor::Black &&
+         marker.state == MarkingState::RegularMarking &&
+         !marker.hasGrayEntries() &&
+         marker.stack.position() >= MinParallelMarkingWork;
+}
+
+void ParallelMarker::startConcurrentMarking() {
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(gc->rt));
+  MOZ_ASSERT(shouldMarkConcurrently());
+  MOZ_ASSERT(!concurrentMarking);
+  MOZ_ASSERT(activeTaskCount == 0);
+
+  if (!concurrentMarker) {
+    UniquePtr<GCMarker> marker = MakeUnique<GCMarker>(gc->rt);
+    if (!marker || !marker->init(gc->gcMode())) {
+      return;
+    }
+    marker->setMaxCapacity(mainMarker().maxCapacity());
+    concurrentMarker = std::move(marker);
+  }
+
+  // The main marker keeps its delayed marking list, and its stack collects
+  // the things the mutator's barriers mark while the concurrent marker runs.
+  GCMarker& main = mainMarker();
+  if (!MarkStack::moveWork(concurrentMarker->stack, main.stack,
+                           MarkStack::MoveAll)) {
+    return;
+  }
+
+  stopping = false;
+  main.enterParallelMarkingMode(this);
+  concurrentMarker->incrementalWeakMapMarkingEnabled =
+      main.incrementalWeakMapMarkingEnabled;
+  concurrentMarker->enterParallelMarkingMode(this, /* concurrent = */ true);
+  concurrentMarking = true;
+
+  concurrentTask.start();
+}
+
+void ParallelMarker::markConcurrently() {
+  // The task runs on the main thread when it is joined before a helper thread
+  // picks it up, after stopping has been set.
+  if (stopping) {
+    return;
+  }
+
+  GCMarker& marker = *concurrentMarker;
+  SliceBudget budget = SliceBudget::unlimited();
+  mozilla::Unused << marker.markCurrentColorInParallel(budget, SIZE_MAX);
+}
+
+void ParallelMarker::finishConcurrentMarking() {
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(gc->rt));
+  MOZ_ASSERT(concurrentMarking);
+
+  stopping = true;
+  concurrentTask.join();
+  concurrentMarkTime += concurrentTask.duration();
+  concurrentMarking = false;
+
+  // The main marker finishes whatever is left in its next slice.
+  GCMarker& main = mainMarker();
+  main.leaveParallelMarkingMode();
+  concurrentMarker->leaveParallelMarkingMode();
+  concurrentMarker->transferWorkTo(main);
+  MOZ_ASSERT(concurrentMarker->isDrained());
+}
+
+TimeDuration ParallelMarker::takeConcurrentMarkTime() {
+  TimeDuration time = concurrentMarkTime;
+  concurrentMarkTime = TimeDuration();
+  return time;
+}
+
+void ParallelMarker::delayMarkingChildren(Cell* cell) {
+  // The delayed marking list and the per-arena delayed marking state are
+  // shared, so all markers record delayed work on the main marker.
+  LockGuard<Mutex> guard(lock);
+  mainMarker().delayMarkingChildrenImpl(cell);
+}
+
+size_t ParallelMarker::sizeOfExcludingThis(
+    mozilla::MallocSizeOf mallocSizeOf) const {
+  size_t size = helperMarkers.sizeOfExcludingThis(mallocSizeOf) +
+                threads.sizeOfExcludingThis(mallocSizeOf);
+  for (const auto& thread : threads) {
+    size += mallocSizeOf(thread.get());
+  }
+  for (const auto& marker : helperMarkers) {
+    size += mallocSizeOf(marker.get()) +
+            marker->stack.sizeOfExcludingThis(mallocSizeOf) +
+            marker->auxStack.sizeOfExcludingThis(mallocSizeOf);
+  }
+  if (concurrentMarker) {
+    size += mallocSizeOf(concurrentMarker.get()) +
+            concurrentMarker->stack.sizeOfExcludingThis(mallocSizeOf) +
+            concurrentMarker->auxStack.sizeOfExcludingThis(mallocSizeOf);
+  }
+  return size;
+}
@@ -0,0 +1,254 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef gc_ParallelMarking_h
+#define gc_ParallelMarking_h
+
+#include "mozilla/Atomics.h"
+#include "mozilla/TimeStamp.h"
+
+#include "gc/GCMarker.h"
+#include "gc/GCParallelTask.h"
+#include "js/SliceBudget.h"
+#include "js/UniquePtr.h"
+#include "js/Vector.h"
+#include "threading/ConditionVariable.h"
+#include "threading/Mutex.h"
+
+namespace js {
+namespace gc {
+
+class ParallelMarker;
+
+// The maximum number of threads, including the main thread, that can take
+// part in marking.
+static constexpr size_t MaxParallelMarkers = 16;
+
+// Don't bother starting helper threads unless there is at least this much work
+// on the mark stack, measured in mark stack words. Helpers steal work as the
+// main marker's stack grows, so this only needs to be enough for a first
+// steal.
+static constexpr size_t MinParallelMarkingWork = 64;
+
+// A marker only steals from another marker whose mark stack holds at least
+// this many words.
+static constexpr size_t MinMarkStackWordsToSteal = 32;
+
+// The number of mark stack entries a marker processes between releasing its
+// stack lock, which is when other markers can steal from it.
+static constexpr size_t MarkStackEntriesPerBatch = 128;
+
+// Per-thread results of the last slice that marked in parallel.
+struct MarkingThreadStats {
+  size_t markedCells = 0;
+  size_t stolenWords = 0;
+  mozilla::TimeDuration duration;
+};
+
+// The state of one marker taking part in parallel marking.
+class ParallelMarkingThread {
+ public:
+  ParallelMarkingThread(GCMarker* marker, size_t index);
+
+  GCMarker* marker() const { return marker_; }
+  const MarkingThreadStats& stats() const { return stats_; }
+
+ private:
+  friend class ParallelMarker;
+
+  GCMarker* const marker_;
+  const size_t index;
+
+  // Held by this thread while it processes its mark stack, and by other
+  // threads while they steal from it.
+  Mutex stackLock;
+
+  // The size of the mark stack in words, updated with |stackLock| held. Other
+  // threads check it to pick a thread to steal from. The owning thread only
+  // uses its stack without holding |stackLock| while this is zero.
+  mozilla::Atomic<size_t, mozilla::ReleaseAcquire> stackWords;
+
+  MarkingThreadStats stats_;
+};
+
+// A task that runs one marker's share of a parallel marking phase.
+class ParallelMarkTask : public GCParallelTask {
+ public:
+  ParallelMarkTask(ParallelMarker* pm, ParallelMarkingThread* thread,
+                   const SliceBudget& budget);
+  ~ParallelMarkTask() override { join(); }
+
+  void run() override;
+
+  const SliceBudget& budget() const { return budget_; }
+
+ private:
+  ParallelMarker* const pm;
+  ParallelMarkingThread* const thread;
+  SliceBudget budget_;
+};
+
+// A task that marks on a helper thread while the mutator runs.
+class ConcurrentMarkTask : public GCParallelTask {
+ public:
+  ConcurrentMarkTask(GCRuntime* gc, ParallelMarker* pm);
+  ~ConcurrentMarkTask() override { join(); }
+
+  void run() override;
+
+ private:
+  ParallelMarker* const pm;
+};
+
+/*
+ * Parallel marking of the black part of the heap.
+ *
+ * The main thread's GCMarker and a number of helper GCMarkers each drain their
+ * own mark stack in batches, holding their stack lock during a batch. When a
+ * marker runs out of work it steals the top half of the mark stack of another
+ * marker between two of its batches. If there is nothing to steal, it waits
+ * until a busy marker with enough work wakes it up. Marking finishes when
+ * every participating marker is waiting for work, or stops early when any
+ * marker exceeds its budget, in which case all unprocessed work is moved back
+ * to the main marker.
+ *
+ * Markers share a time budget's deadline. A work budget is split between
+ * them, and the slice's budget is charged with the work they all did.
+ *
+ * Only black marking in the RegularMarking state is parallelized. Gray
+ * marking, weak marking mode (ephemeron processing driven by the weak keys
+ * tables) and delayed marking all still happen on the main thread afterwards.
+ * Work that is not safe to do concurrently is serialized through this class:
+ * updates to the shared weak keys tables made when tracing a WeakMap take
+ * |weakMapLock|, and ObjectGroups, whose tracing can sweep type information,
+ * are put on the delayed marking list and traced later by the main marker.
+ * Objects whose class has a trace hook are treated the same way when a helper
+ * thread reaches them, unless the hook is one of the engine's own hooks that
+ * only trace edges (see CanTraceOffThread in Marking.cpp), so embedder trace
+ * hooks only ever run on the main thread.
+ *
+ * The number of threads used is controlled by JSGC_MARKING_THREAD_COUNT.
+ *
+ * Black marking can also continue concurrently with the mutator between the
+ * slices of an incremental GC, controlled by JSGC_CONCURRENT_MARKING. At the
+ * end of a slice the main marker's stack is moved to a separate concurrent
+ * marker, which drains it on a helper thread. The incremental pre-write
+ * barriers give a snapshot at the beginning of the collection, as for
+ * incremental marking: the mutator's barriers keep pushing overwritten edges
+ * onto the main marker's stack. Both markers stay in parallel marking mode, so
+ * mark bits are set atomically and delayed marking and weak map updates are
+ * serialized as above. The mutator can reallocate or rewrite some things
+ * without a barrier, so the concurrent marker leaves anything but atoms,
+ * shapes, scopes, symbols, BigInts and native objects with only fixed slots
+ * to the main marker's delayed marking. Concurrent marking stops as soon as
+ * the heap becomes busy for any reason, and the concurrent marker's remaining
+ * work is moved back to the main marker, which finishes it in the next
+ * slice. It is only started when the nursery is empty, and so stops at the
+ * first minor GC after nursery allocation resumes.
+ */
+class ParallelMarker {
+ public:
+  explicit ParallelMarker(GCRuntime* gc);
+
+  MOZ_MUST_USE bool setThreadCount(size_t threadCount, JSGCMode gcMode);
+  size_t threadCount() const { return helperMarkers.length() + 1; }
+
+  void setMaxCapacity(size_t maxCap);
+  void setGCMode(JSGCMode mode);
+
+  // Whether the current state of the main marker allows marking in parallel.
+  bool shouldMarkInParallel() const;
+
+  // Mark in parallel until the black mark stack is empty or the budget is
+  // exhausted. Returns false if the budget was exhausted.
+  bool mark(SliceBudget& budget);
+
+  // Called from the markers taking part in parallel marking.
+  bool markOneThread(ParallelMarkingThread& thread, SliceBudget& budget);
+  void delayMarkingChildren(gc::Cell* cell);
+  bool isStopping() const { return stopping; }
+
+  // Per-thread statistics for the last slice that marked in parallel. The
+  // thread count is zero if no slice has marked in parallel since the number
+  // of threads was last set.
+  size_t lastThreadCount() const { return lastThreadCount_; }
+  const MarkingThreadStats& lastStats(size_t i) const {
+    MOZ_ASSERT(i < lastThreadCount_);
+    return threads[i]->stats();
+  }
+
+  Mutex& weakMapMarkingLock() { return weakMapLock; }
+
+  // Whether the current state of the main marker allows marking to continue
+  // concurrently with the mutator.
+  bool shouldMarkConcurrently() const;
+
+  // Start or stop marking concurrently with the mutator. Stopping moves any
+  // work the concurrent marker has left back to the main marker.
+  void startConcurrentMarking();
+  void finishConcurrentMarking();
+  bool isConcurrentMarking() const { return concurrentMarking; }
+
+  // Called from the concurrent marking task.
+  void markConcurrently();
+
+  // Return and reset the time spent marking concurrently since this was last
+  // called.
+  mozilla::TimeDuration takeConcurrentMarkTime();
+
+  size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) const;
+
+ private:
+  bool registerTask();
+  void unregisterTask();
+  bool drainStack(ParallelMarkingThread& thread, SliceBudget& budget);
+  bool stealWork(ParallelMarkingThread& thread);
+  bool waitForWork(ParallelMarkingThread& thread);
+  void notifyWaitingTasks();
+  void stop();
+
+  void enter();
+  void leave();
+
+  GCMarker& mainMarker();
+
+  GCRuntime* const gc;
+
+  // Markers used by helper threads. The main thread uses GCRuntime::marker.
+  Vector<UniquePtr<GCMarker>, 0, SystemAllocPolicy> helperMarkers;
+
+  // The marker used for concurrent marking, created when first needed.
+  UniquePtr<GCMarker> concurrentMarker;
+  ConcurrentMarkTask concurrentTask;
+  bool concurrentMarking;
+  mozilla::TimeDuration concurrentMarkTime;
+
+  // Thread 0 uses the main marker, the others use the helper markers in order.
+  Vector<UniquePtr<ParallelMarkingThread>, 0, SystemAllocPolicy> threads;
+  size_t lastThreadCount_;
+
+  // Protects the fields below.
+  Mutex lock;
+  ConditionVariable workAvailable;
+
+  // Number of tasks which have started running and not yet finished.
+  size_t activeTaskCount;
+
+  // Number of markers which have run out of work and found nothing to steal.
+  // Atomic so that busy markers can check it without taking the lock.
+  mozilla::Atomic<size_t, mozilla::Relaxed> waitingTaskCount;
+
+  // Set when marking has finished or the budget has been exhausted.
+  mozilla::Atomic<bool, mozilla::Relaxed> stopping;
+
+  // Serializes weak keys table updates made while tracing WeakMaps.
+  Mutex weakMapLock;
+};
+
+} /* namespace gc */
+} /* namespace js */
+
+#endif /* gc_ParallelMarking_h */
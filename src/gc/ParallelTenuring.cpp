@@ -0,0 +1,462 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gc/ParallelTenuring.h"
+
+#include "mozilla/Maybe.h"
+#include "mozilla/ScopeExit.h"
+
+#include "gc/GCInternals.h"
+#include "vm/HelperThreads.h"
+#include "vm/MutexIDs.h"
+#include "vm/Runtime.h"
+
+#include "gc/ArenaList-inl.h"
+
+using namespace js;
+using namespace js::gc;
+
+using mozilla::TimeStamp;
+
+// The number of store buffer edges a thread claims at a time.
+static constexpr size_t EdgesPerChunk = 256;
+
+// The number of queued objects a thread takes from its own queue at a time.
+static constexpr size_t PopBatchSize = 16;
+
+// The maximum number of objects taken from another thread's queue at a time.
+static constexpr size_t MaxStealCount = 256;
+
+// How often, in queued objects, a busy thread wakes idle threads to steal.
+static constexpr size_t StealNotifyInterval = 32;
+
+void ParallelTenuringTask::run() { thread->owner().tenureOneThread(*thread); }
+
+ParallelTenuringThread::ParallelTenuringThread(ParallelTenuring* pt,
+                                               JSRuntime* rt, Nursery* nursery)
+    : pt(pt),
+      mover(rt, nursery),
+      queueLock(mutexid::GCParallelTenuringQueue),
+      queueStart(0),
+      queueLength(0) {
+  mover.parallelThread = this;
+}
+
+ParallelTenuringThread::~ParallelTenuringThread() = default;
+
+void ParallelTenuringThread::reset() {
+  MOZ_ASSERT(queueLength == 0);
+  MOZ_ASSERT(deferredValues.empty() && deferredCells.empty());
+  MOZ_ASSERT(freeLists.empty());
+
+  mover.tenuredSize = 0;
+  mover.tenuredCells = 0;
+  *tenureCounts = TenureCountCache();
+  stats_ = TenuringThreadStats();
+}
+
+TenuredCell* ParallelTenuringThread::allocateCell(JS::Zone* zone,
+                                                  AllocKind kind) {
+  FreeLists* zoneFreeLists = nullptr;
+  for (ZoneFreeLists& entry : freeLists) {
+    if (entry.zone == zone) {
+      zoneFreeLists = &entry.freeLists;
+      break;
+    }
+  }
+
+  AutoEnterOOMUnsafeRegion oomUnsafe;
+  if (!zoneFreeLists) {
+    if (!freeLists.emplaceBack(ZoneFreeLists{zone, FreeLists()})) {
+      oomUnsafe.crash("ParallelTenuringThread::allocateCell");
+    }
+    zoneFreeLists = &freeLists.back().freeLists;
+  }
+
+  if (TenuredCell* cell = zoneFreeLists->allocate(kind)) {
+    return cell;
+  }
+
+  // Arena lists and chunks are shared by all threads.
+  LockGuard<Mutex> guard(pt->allocationLock());
+  TenuredCell* cell = zone->arenas.refillFreeListAndAllocate(
+      *zoneFreeLists, kind, ShouldCheckThresholds::DontCheckThresholds);
+  if (!cell) {
+    oomUnsafe.crash(ChunkSize, "Failed to allocate new chunk during GC");
+  }
+  return cell;
+}
+
+void ParallelTenuringThread::pushObject(JSObject* obj) {
+  size_t length;
+  {
+    LockGuard<Mutex> guard(queueLock);
+    AutoEnterOOMUnsafeRegion oomUnsafe;
+    if (!queue.append(obj)) {
+      oomUnsafe.crash("ParallelTenuringThread::pushObject");
+    }
+    length = queue.length() - queueStart;
+    queueLength = length;
+  }
+
+  pt->maybeNotifyWork(length);
+}
+
+size_t ParallelTenuringThread::popObjects(JSObject** buffer, size_t max) {
+  LockGuard<Mutex> guard(queueLock);
+
+  size_t count = std::min(max, queue.length() - queueStart);
+  for (size_t i = 0; i < count; i++) {
+    buffer[i] = queue.popCopy();
+  }
+
+  if (queue.length() == queueStart) {
+    queue.clear();
+    queueStart = 0;
+  }
+  queueLength = queue.length() - queueStart;
+
+  return count;
+}
+
+size_t ParallelTenuringThread::stealObjects(ParallelTenuringThread& victim) {
+  MOZ_ASSERT(&victim != this);
+
+  JSObject* stolen[MaxStealCount];
+  size_t count;
+  {
+    LockGuard<Mutex> guard(victim.queueLock);
+    size_t length = victim.queue.length() - victim.queueStart;
+    count = std::min(length - length / 2, MaxStealCount);
+    for (size_t i = 0; i < count; i++) {
+      stolen[i] = victim.queue[victim.queueStart + i];
+    }
+    victim.queueStart += count;
+    victim.queueLength = victim.queue.length() - victim.queueStart;
+  }
+
+  if (count) {
+    LockGuard<Mutex> guard(queueLock);
+    AutoEnterOOMUnsafeRegion oomUnsafe;
+    if (!queue.append(stolen, count)) {
+      oomUnsafe.crash("ParallelTenuringThread::stealObjects");
+    }
+    queueLength = queue.length() - queueStart;
+    stats_.stolenObjects += count;
+  }
+
+  return count;
+}
+
+void ParallelTenuringThread::drainQueue() {
+  JSObject* batch[PopBatchSize];
+  while (size_t count = popObjects(batch, PopBatchSize)) {
+    for (size_t i = 0; i < count; i++) {
+      JSObject* obj = batch[i];
+      mover.traceObject(obj);
+      tenureCounts->noteTenured(obj->groupRaw());
+    }
+  }
+}
+
+void ParallelTenuringThread::deferEdge(JS::Value* vp) {
+  AutoEnterOOMUnsafeRegion oomUnsafe;
+  if (!deferredValues.append(vp)) {
+    oomUnsafe.crash("ParallelTenuringThread::deferEdge");
+  }
+}
+
+void ParallelTenuringThread::deferEdge(Cell** cellp) {
+  AutoEnterOOMUnsafeRegion oomUnsafe;
+  if (!deferredCells.append(cellp)) {
+    oomUnsafe.crash("ParallelTenuringThread::deferEdge");
+  }
+}
+
+ParallelTenuring::ParallelTenuring(GCRuntime* gc)
+    : gc(gc),
+      lastThreadCount_(0),
+      edgeCount(0),
+      nextChunk(0),
+      lock(mutexid::GCParallelTenuring),
+      activeThreadCount(0),
+      waitingThreadCount(0),
+      finished(false),
+      tablesLock(mutexid::GCParallelTenuringTables),
+      allocLock(mutexid::GCParallelTenuringAlloc) {}
+
+ParallelTenuring::~ParallelTenuring() = default;
+
+bool ParallelTenuring::setThreadCount(size_t threadCount) {
+  MOZ_ASSERT(threadCount >= 1 && threadCount <= MaxParallelTenuringThreads);
+
+  lastThreadCount_ = 0;
+
+  if (threadCount == 1) {
+    threads.clearAndFree();
+    return true;
+  }
+
+  if (threadCount < threads.length()) {
+    threads.shrinkTo(threadCount);
+    return true;
+  }
+
+  while (threads.length() < threadCount) {
+    auto thread =
+        MakeUnique<ParallelTenuringThread>(this, gc->rt, &gc->nursery());
+    if (!thread) {
+      return false;
+    }
+    thread->tenureCounts = MakeUnique<TenureCountCache>();
+    if (!thread->tenureCounts || !threads.append(std::move(thread))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool ParallelTenuring::tenure(TenuringTracer& mover, StoreBuffer& sb,
+                              TenureCountCache& tenureCounts) {
+  lastThreadCount_ = 0;
+
+  if (threads.empty() || !CanUseExtraThreads() ||
+      sb.parallelTenuringEdgeCount() < MinParallelTenuringEdges) {
+    return false;
+  }
+
+  // Fall back to serial promotion if we can't allocate the edge arrays.
+  if (!copyEdges(sb)) {
+    return false;
+  }
+
+  MOZ_ASSERT(activeThreadCount == 0);
+  MOZ_ASSERT(waitingThreadCount == 0);
+  nextChunk = 0;
+  finished = false;
+  for (auto& thread : threads) {
+    thread->reset();
+  }
+
+  // The main thread runs thread 0 and helper tasks run the rest.
+  mozilla::Maybe<ParallelTenuringTask> tasks[MaxParallelTenuringThreads];
+  {
+    AutoLockHelperThreadState helperLock;
+    for (size_t i = 1; i < threads.length(); i++) {
+      tasks[i].emplace(gc, threads[i].get());
+      tasks[i]->startWithLockHeld(helperLock);
+    }
+  }
+
+  tenureOneThread(*threads[0]);
+
+  {
+    AutoLockHelperThreadState helperLock;
+    for (size_t i = 1; i < threads.length(); i++) {
+      tasks[i]->joinWithLockHeld(helperLock);
+    }
+  }
+
+  finish(mover, tenureCounts);
+  lastThreadCount_ = threads.length();
+  return true;
+}
+
+bool ParallelTenuring::copyEdges(StoreBuffer& sb) {
+  if (!sb.copyValueEdges(valueEdges) || !sb.copyObjectEdges(objectEdges) ||
+      !sb.copySlotsEdges(slotsEdges)) {
+    valueEdges.clearAndFree();
+    objectEdges.clearAndFree();
+    slotsEdges.clearAndFree();
+    return false;
+  }
+
+  edgeCount = valueEdges.length() + objectEdges.length() + slotsEdges.length();
+  return true;
+}
+
+bool ParallelTenuring::claimChunk(size_t* beginp, size_t* endp) {
+  size_t begin = nextChunk++ * EdgesPerChunk;
+  if (begin >= edgeCount) {
+    return false;
+  }
+
+  *beginp = begin;
+  *endp = std::min(begin + EdgesPerChunk, edgeCount);
+  return true;
+}
+
+bool ParallelTenuring::hasUnclaimedChunks() const {
+  return nextChunk * EdgesPerChunk < edgeCount;
+}
+
+void ParallelTenuring::traceEdges(ParallelTenuringThread& thread, size_t begin,
+                                  size_t end) {
+  TenuringTracer& mover = thread.tracer();
+  for (size_t i = begin; i < end; i++) {
+    size_t index = i;
+    if (index < valueEdges.length()) {
+      valueEdges[index].trace(mover);
+      continue;
+    }
+    index -= valueEdges.length();
+    if (index < objectEdges.length()) {
+      objectEdges[index].trace(mover);
+      continue;
+    }
+    index -= objectEdges.length();
+    slotsEdges[index].trace(mover);
+  }
+}
+
+void ParallelTenuring::tenureOneThread(ParallelTenuringThread& thread) {
+  if (!registerThread()) {
+    return;
+  }
+
+  auto unregisterOnExit = mozilla::MakeScopeExit([&] { unregisterThread(); });
+
+  TimeStamp start = TimeStamp::Now();
+
+  do {
+    size_t begin, end;
+    while (claimChunk(&begin, &end)) {
+      traceEdges(thread, begin, end);
+      thread.drainQueue();
+    }
+    thread.drainQueue();
+  } while (waitForWork(thread));
+
+  thread.stats_.duration = TimeStamp::Now() - start;
+}
+
+bool ParallelTenuring::registerThread() {
+  LockGuard<Mutex> guard(lock);
+  if (finished) {
+    // A task that starts after promotion finished has nothing to do.
+    return false;
+  }
+
+  activeThreadCount++;
+  return true;
+}
+
+void ParallelTenuring::unregisterThread() {
+  LockGuard<Mutex> guard(lock);
+  MOZ_ASSERT(activeThreadCount);
+  activeThreadCount--;
+}
+
+bool ParallelTenuring::waitForWork(ParallelTenuringThread& thread) {
+  MOZ_ASSERT(thread.queueLength == 0);
+
+  LockGuard<Mutex> guard(lock);
+
+  for (;;) {
+    if (finished) {
+      return false;
+    }
+
+    if (hasUnclaimedChunks()) {
+      return true;
+    }
+
+    for (auto& victim : threads) {
+      if (victim.get() != &thread && victim->queueLength &&
+          thread.stealObjects(*victim)) {
+        return true;
+      }
+    }
+
+    waitingThreadCount++;
+    if (waitingThreadCount == activeThreadCount) {
+      // Every thread is out of work and all the queues are empty.
+      waitingThreadCount--;
+      finished = true;
+      workAvailable.notify_all();
+      return false;
+    }
+
+    workAvailable.wait(guard);
+    waitingThreadCount--;
+  }
+}
+
+void ParallelTenuring::maybeNotifyWork(size_t queueLength) {
+  if (waitingThreadCount && queueLength % StealNotifyInterval == 0) {
+    LockGuard<Mutex> guard(lock);
+    workAvailable.notify_all();
+  }
+}
+
+void ParallelTenuring::finish(TenuringTracer& mover,
+                              TenureCountCache& tenureCounts) {
+  MOZ_ASSERT(activeThreadCount == 0);
+
+  for (auto& thread : threads) {
+    MOZ_ASSERT(thread->queueLength == 0);
+
+    TenuringTracer& trc = thread->tracer();
+    MOZ_ASSERT(!trc.objHead && !trc.stringHead && !trc.bigIntHead);
+    mover.tenuredSize += trc.tenuredSize;
+    mover.tenuredCells += trc.tenuredCells;
+
+    TenuringThreadStats& stats = thread->stats_;
+    stats.tenuredBytes = trc.tenuredSize;
+    stats.tenuredCells = trc.tenuredCells;
+
+    for (const TenureCount& entry : thread->tenureCounts->entries) {
+      if (entry.group) {
+        tenureCounts.noteTenured(entry.group, entry.count);
+      }
+    }
+
+    // The rest of each thread's last arenas stays unused until they are next
+    // swept. Free cells in them may have been pre-marked if an incremental GC
+    // is in progress, so unmark them now they will not be allocated.
+    for (auto& entry : thread->freeLists) {
+      for (auto kind : AllAllocKinds()) {
+        entry.freeLists.unmarkPreMarkedFreeCells(kind);
+      }
+    }
+    thread->freeLists.clear();
+  }
+
+  // Trace the edges the threads couldn't handle with the main thread's tracer.
+  // Anything this promotes is traced in collectToFixedPoint().
+  for (auto& thread : threads) {
+    for (JS::Value* vp : thread->deferredValues) {
+      mover.traceDeferredEdge(vp);
+    }
+    for (Cell** cellp : thread->deferredCells) {
+      mover.traceDeferredEdge(cellp);
+    }
+    thread->deferredValues.clear();
+    thread->deferredCells.clear();
+  }
+
+  valueEdges.clear();
+  objectEdges.clear();
+  slotsEdges.clear();
+  edgeCount = 0;
+}
+
+size_t ParallelTenuring::sizeOfExcludingThis(
+    mozilla::MallocSizeOf mallocSizeOf) const {
+  size_t size = threads.sizeOfExcludingThis(mallocSizeOf) +
+                valueEdges.sizeOfExcludingThis(mallocSizeOf) +
+                objectEdges.sizeOfExcludingThis(mallocSizeOf) +
+                slotsEdges.sizeOfExcludingThis(mallocSizeOf);
+  for (const auto& thread : threads) {
+    size += mallocSizeOf(thread.get()) +
+            thread->queue.sizeOfExcludingThis(mallocSizeOf) +
+            thread->deferredValues.sizeOfExcludingThis(mallocSizeOf) +
+            thread->deferredCells.sizeOfExcludingThis(mallocSizeOf) +
+            mallocSizeOf(thread->tenureCounts.get());
+  }
+  return size;
+}
@@ -0,0 +1,234 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef gc_ParallelTenuring_h
+#define gc_ParallelTenuring_h
+
+#include "mozilla/Array.h"
+#include "mozilla/Atomics.h"
+#include "mozilla/TimeStamp.h"
+
+#include <algorithm>
+
+#include "gc/ArenaList.h"
+#include "gc/GCParallelTask.h"
+#include "gc/Nursery.h"
+#include "gc/StoreBuffer.h"
+#include "js/UniquePtr.h"
+#include "js/Vector.h"
+#include "threading/ConditionVariable.h"
+#include "threading/Mutex.h"
+
+namespace js {
+namespace gc {
+
+class ParallelTenuring;
+
+// The maximum number of threads, including the main thread, that can take
+// part in promotion.
+static constexpr size_t MaxParallelTenuringThreads = 16;
+
+// Don't bother starting helper threads unless the store buffer holds at least
+// this many value, object and slots edges.
+static constexpr size_t MinParallelTenuringEdges = 1024;
+
+// Per-thread results of the last parallel promotion, for the nursery profile.
+struct TenuringThreadStats {
+  size_t tenuredBytes = 0;
+  size_t tenuredCells = 0;
+  size_t stolenObjects = 0;
+  mozilla::TimeDuration duration;
+};
+
+// Striped spin locks that serialize forwarding of nursery cells. A thread
+// holds the lock for a cell while it checks whether the cell has been
+// forwarded and, if not, copies it and installs the forwarding pointer.
+class NurseryCellLocks {
+  static constexpr size_t LockCount = 1024;
+
+  mozilla::Array<mozilla::Atomic<bool, mozilla::ReleaseAcquire>, LockCount>
+      locks;
+
+  mozilla::Atomic<bool, mozilla::ReleaseAcquire>& lockFor(Cell* cell) {
+    return locks[(uintptr_t(cell) >> CellAlignShift) % LockCount];
+  }
+
+ public:
+  class MOZ_RAII AutoLock {
+    mozilla::Atomic<bool, mozilla::ReleaseAcquire>& lock;
+
+   public:
+    AutoLock(NurseryCellLocks& locks, Cell* cell) : lock(locks.lockFor(cell)) {
+      while (!lock.compareExchange(false, true)) {
+        while (lock) {
+        }
+      }
+    }
+    ~AutoLock() { lock = false; }
+  };
+};
+
+// The state of one thread taking part in parallel promotion: a
+// TenuringTracer, tenured free lists that are not shared with other threads
+// and a queue of promoted objects whose children have not been traced yet.
+class ParallelTenuringThread {
+ public:
+  ParallelTenuringThread(ParallelTenuring* pt, JSRuntime* rt,
+                         Nursery* nursery);
+  ~ParallelTenuringThread();
+
+  ParallelTenuring& owner() { return *pt; }
+  TenuringTracer& tracer() { return mover; }
+  const TenuringThreadStats& stats() const { return stats_; }
+
+  // Allocate a tenured cell from this thread's free lists.
+  TenuredCell* allocateCell(JS::Zone* zone, AllocKind kind);
+
+  // Objects promoted by this thread whose children still need tracing.
+  void pushObject(JSObject* obj);
+
+  // Edges that can't be handled off the main thread, to be traced after all
+  // threads have finished.
+  void deferEdge(JS::Value* vp);
+  void deferEdge(Cell** cellp);
+
+ private:
+  friend class ParallelTenuring;
+
+  void reset();
+  void drainQueue();
+  size_t popObjects(JSObject** buffer, size_t max);
+  size_t stealObjects(ParallelTenuringThread& victim);
+
+  ParallelTenuring* const pt;
+  TenuringTracer mover;
+
+  struct ZoneFreeLists {
+    JS::Zone* zone;
+    FreeLists freeLists;
+  };
+  Vector<ZoneFreeLists, 0, SystemAllocPolicy> freeLists;
+
+  // Other threads steal from the front of the queue while this thread pushes
+  // and pops at the back. The length is atomic so that idle threads can find
+  // a victim without taking every queue lock.
+  Mutex queueLock;
+  Vector<JSObject*, 0, SystemAllocPolicy> queue;
+  size_t queueStart;
+  mozilla::Atomic<size_t, mozilla::SequentiallyConsistent> queueLength;
+
+  Vector<JS::Value*, 0, SystemAllocPolicy> deferredValues;
+  Vector<Cell**, 0, SystemAllocPolicy> deferredCells;
+
+  UniquePtr<TenureCountCache> tenureCounts;
+  TenuringThreadStats stats_;
+};
+
+// A task that runs one thread's share of a parallel promotion.
+class ParallelTenuringTask : public GCParallelTask {
+ public:
+  ParallelTenuringTask(GCRuntime* gc, ParallelTenuringThread* thread)
+      : GCParallelTask(gc), thread(thread) {}
+  ~ParallelTenuringTask() override { join(); }
+
+  void run() override;
+
+ private:
+  ParallelTenuringThread* const thread;
+};
+
+/*
+ * Parallel promotion of the nursery cells reachable from the store buffer.
+ *
+ * The value, object and slots edges in the store buffer are copied into
+ * arrays and split into chunks that the main thread and a number of helper
+ * threads claim in turn. Each thread promotes the plain objects and arrays
+ * those edges point to, allocating from its own tenured free lists, and queues
+ * the promoted objects so their children are traced on the same thread. A
+ * thread that runs out of work steals half of the queue of another thread.
+ * Promotion finishes when every thread is out of work.
+ *
+ * Only plain objects and arrays are promoted off the main thread. Edges to
+ * other nursery cells, notably strings, whose promotion interacts with
+ * deduplication, and objects with class hooks, are deferred and traced by the
+ * main thread's TenuringTracer afterwards, as are the whole cell buffer, the
+ * generic buffer and the roots. Updates to the nursery's malloced buffer set
+ * and forwarding table take |tablesLock|.
+ *
+ * The number of threads used is controlled by JSGC_TENURING_THREAD_COUNT.
+ */
+class ParallelTenuring {
+ public:
+  explicit ParallelTenuring(GCRuntime* gc);
+  ~ParallelTenuring();
+
+  MOZ_MUST_USE bool setThreadCount(size_t threadCount);
+  size_t threadCount() const { return std::max(threads.length(), size_t(1)); }
+
+  // Promote everything reachable from the store buffer's value, object and
+  // slots edges, adding the results to |mover| and |tenureCounts|. Returns
+  // false without doing anything if promotion should happen serially.
+  bool tenure(TenuringTracer& mover, StoreBuffer& sb,
+              TenureCountCache& tenureCounts);
+
+  // Called from the threads taking part in promotion.
+  void tenureOneThread(ParallelTenuringThread& thread);
+  void maybeNotifyWork(size_t queueLength);
+
+  NurseryCellLocks& cellLocks() { return cellLocks_; }
+  Mutex& nurseryTablesLock() { return tablesLock; }
+  Mutex& allocationLock() { return allocLock; }
+
+  // Per-thread statistics for the last collection that promoted in parallel,
+  // or an empty array if the last collection was serial.
+  size_t lastThreadCount() const { return lastThreadCount_; }
+  const TenuringThreadStats& lastStats(size_t i) const {
+    MOZ_ASSERT(i < lastThreadCount_);
+    return threads[i]->stats();
+  }
+
+  size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) const;
+
+ private:
+  bool copyEdges(StoreBuffer& sb);
+  bool claimChunk(size_t* beginp, size_t* endp);
+  void traceEdges(ParallelTenuringThread& thread, size_t begin, size_t end);
+  bool hasUnclaimedChunks() const;
+  bool registerThread();
+  void unregisterThread();
+  bool waitForWork(ParallelTenuringThread& thread);
+  void finish(TenuringTracer& mover, TenureCountCache& tenureCounts);
+
+  GCRuntime* const gc;
+
+  // Thread 0 is run by the main thread. Empty when promotion is serial.
+  Vector<UniquePtr<ParallelTenuringThread>, 0, SystemAllocPolicy> threads;
+  size_t lastThreadCount_;
+
+  // The store buffer edges for this collection, indexed in that order, and the
+  // next chunk to hand out.
+  Vector<StoreBuffer::ValueEdge, 0, SystemAllocPolicy> valueEdges;
+  Vector<StoreBuffer::ObjectPtrEdge, 0, SystemAllocPolicy> objectEdges;
+  Vector<StoreBuffer::SlotsEdge, 0, SystemAllocPolicy> slotsEdges;
+  size_t edgeCount;
+  mozilla::Atomic<size_t, mozilla::SequentiallyConsistent> nextChunk;
+
+  // Protects the fields below.
+  Mutex lock;
+  ConditionVariable workAvailable;
+  size_t activeThreadCount;
+  mozilla::Atomic<size_t, mozilla::Relaxed> waitingThreadCount;
+  bool finished;
+
+  NurseryCellLocks cellLocks_;
+  Mutex tablesLock;
+  Mutex allocLock;
+};
+
+} /* namespace gc */
+} /* namespace js */
+
+#endif /* gc_ParallelTenuring_h */
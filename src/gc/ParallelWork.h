@@ -96,36 +96,96 @@ class MOZ_RAII AutoRunParallelWork {
   using Worker = ParallelWorker<WorkItem, WorkItemIterator>;
   using WorkFunc = ParallelWorkFunc<WorkItem>;
 
+  // Run work during a GC slice, recording the tasks' times in the statistics
+  // for |phaseKind|.
   AutoRunParallelWork(GCRuntime* gc, WorkFunc func,
                       gcstats::PhaseKind phaseKind, WorkItemIterator& work,
                       const SliceBudget& budget,
                       AutoLockHelperThreadState& lock)
-      : gc(gc), phaseKind(phaseKind), lock(lock), tasksStarted(0) {
+      : gc(gc),
+        phaseKind(mozilla::Some(phaseKind)),
+        times(nullptr),
+        lock(lock),
+        tasksStarted(0) {
+    startWorkers(func, work, budget);
+  }
+
+  // Run work outside of a GC slice, possibly from another GC task running on
+  // a helper thread. The tasks' times are added to |times|.
+  AutoRunParallelWork(GCRuntime* gc, WorkFunc func, ParallelTaskTimes& times,
+                      WorkItemIterator& work, const SliceBudget& budget,
+                      AutoLockHelperThreadState& lock)
+      : gc(gc), times(&times), lock(lock), tasksStarted(0) {
+    startWorkers(func, work, budget);
+  }
+
+  ~AutoRunParallelWork() {
+    MOZ_ASSERT(HelperThreadState().isLockedByCurrentThread());
+
+    for (size_t i = 0; i < tasksStarted; i++) {
+      if (phaseKind) {
+        gc->joinTask(*tasks[i], *phaseKind, lock);
+      } else {
+        joinOutsideSlice(*tasks[i]);
+      }
+    }
+    for (size_t i = tasksStarted; i < MaxParallelWorkers; i++) {
+      MOZ_ASSERT(tasks[i].isNothing());
+    }
+  }
+
+ private:
+  void startWorkers(WorkFunc func, WorkItemIterator& work,
+                    const SliceBudget& budget) {
     size_t workerCount = ParallelWorkerCount();
     MOZ_ASSERT(workerCount <= MaxParallelWorkers);
     MOZ_ASSERT_IF(workerCount == 0, work.done());
 
     for (size_t i = 0; i < workerCount && !work.done(); i++) {
       tasks[i].emplace(gc, func, work, budget, lock);
-      gc->startTask(*tasks[i], phaseKind, lock);
+      if (phaseKind) {
+        gc->startTask(*tasks[i], *phaseKind, lock);
+      } else {
+        startOutsideSlice(*tasks[i]);
+      }
       tasksStarted++;
     }
   }
 
-  ~AutoRunParallelWork() {
-    MOZ_ASSERT(HelperThreadState().isLockedByCurrentThread());
+  // These are similar to GCRuntime::startTask and GCRuntime::joinTask, but
+  // may run the task on the current thread even if it is a helper thread.
+  void startOutsideSlice(Worker& task) {
+    if (!CanUseExtraThreads()) {
+      AutoUnlockHelperThreadState unlock(lock);
+      task.runFromCurrentThread();
+      times->add(task.duration());
+      return;
+    }
 
-    for (size_t i = 0; i < tasksStarted; i++) {
-      gc->joinTask(*tasks[i], phaseKind, lock);
+    task.startWithLockHeld(lock);
+  }
+
+  void joinOutsideSlice(Worker& task) {
+    if (task.isIdle(lock)) {
+      return;
     }
-    for (size_t i = tasksStarted; i < MaxParallelWorkers; i++) {
-      MOZ_ASSERT(tasks[i].isNothing());
+
+    if (task.isDispatched(lock)) {
+      // Don't wait for a helper thread to become available, as the current
+      // thread may be the only one.
+      task.cancelDispatchedTask(lock);
+      AutoUnlockHelperThreadState unlock(lock);
+      task.runFromCurrentThread();
+    } else {
+      task.joinRunningOrFinishedTask(lock);
     }
+
+    times->add(task.duration());
   }
 
- private:
   GCRuntime* gc;
-  gcstats::PhaseKind phaseKind;
+  mozilla::Maybe<gcstats::PhaseKind> phaseKind;
+  ParallelTaskTimes* times;
   AutoLockHelperThreadState& lock;
   size_t tasksStarted;
   mozilla::Maybe<Worker> tasks[MaxParallelWorkers];
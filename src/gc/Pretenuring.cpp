@@ -0,0 +1,57 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "gc/Pretenuring.h"
+
+using namespace js;
+using namespace js::gc;
+
+AllocSite* const AllocSite::EndSentinel = reinterpret_cast<AllocSite*>(1);
+
+/* static */
+const char* AllocSite::stateName(State state) {
+  switch (state) {
+    case State::Unknown:
+      return "unknown";
+    case State::LongLived:
+      return "longLived";
+  }
+  MOZ_CRASH("Unknown AllocSite state");
+}
+
+bool AllocSite::processSite(double longLivedThreshold) {
+  MOZ_ASSERT(isInAllocatedList());
+  nextNurseryAllocated_ = nullptr;
+
+  uint32_t minCount =
+      state_ == State::LongLived ? MinSampleCount : MinAllocCount;
+  if (nurseryAllocCount_ < minCount) {
+    return false;
+  }
+
+  uint32_t tenuredCount = nurseryTenuredCount_;
+  MOZ_ASSERT(tenuredCount <= nurseryAllocCount_);
+  lastAllocCount_ = nurseryAllocCount_;
+  lastTenuredCount_ = tenuredCount;
+  nurseryAllocCount_ = 0;
+  nurseryTenuredCount_ = 0;
+
+  if (isCatchAll()) {
+    return false;
+  }
+
+  double survivalRate = double(lastTenuredCount_) / double(lastAllocCount_);
+  State newState =
+      survivalRate >= longLivedThreshold ? State::LongLived : State::Unknown;
+  if (newState == state_) {
+    return false;
+  }
+
+  state_ = newState;
+  tenuredAllocCount_ = 0;
+  stateChangeCount_++;
+  return true;
+}
@@ -0,0 +1,178 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * Pretenuring by allocation site.
+ *
+ * Every nursery cell records the site it was allocated from in its
+ * NurseryCellHeader. A site counts the cells it allocates in the nursery and
+ * how many of them are promoted. After each minor GC, the nursery looks at the
+ * sites that allocated since the previous one. A site whose cells mostly
+ * survive becomes long-lived, and from then on its cells are allocated
+ * directly in the tenured heap.
+ *
+ * Long-lived sites keep allocating a sample of their cells in the nursery. If
+ * the survival rate of the sample drops, the site goes back to nursery
+ * allocation.
+ *
+ * Object and array literals (JSOp::NewObject, JSOp::NewObjectWithGroup,
+ * JSOp::NewInit and JSOp::NewArray) each have a site, stored in the op's
+ * Baseline fallback stub. The interpreter, Baseline and Ion all use it. JIT
+ * code checks the site's state when it allocates, so it doesn't need to be
+ * invalidated when the state changes. All other nursery cells are attributed
+ * to one of their zone's catch-all sites, one per trace kind. Catch-all sites
+ * only collect statistics: they never become long-lived.
+ */
+
+#ifndef gc_Pretenuring_h
+#define gc_Pretenuring_h
+
+#include "mozilla/Atomics.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gc/Allocator.h"
+#include "js/TraceKind.h"
+#include "js/TypeDecls.h"
+
+namespace js {
+namespace gc {
+
+class AllocSite {
+ public:
+  enum class State : uint32_t { Unknown = 0, LongLived = 1 };
+
+  // A long-lived site still allocates one in this many cells in the nursery.
+  // Must be a power of two.
+  static constexpr uint32_t SampleInterval = 16;
+
+  // The number of nursery allocations needed before the survival rate of an
+  // unknown or a long-lived site is looked at. Counts carry over between minor
+  // GCs until there are enough.
+  static constexpr uint32_t MinAllocCount = 100;
+  static constexpr uint32_t MinSampleCount = 8;
+
+  // Catch-all site for |kind| in |zone|.
+  AllocSite(JS::Zone* zone, JS::TraceKind kind)
+      : zone_(zone), pcOffset_(CatchAllPCOffset), traceKind_(kind) {}
+
+  // Site for an object or array literal at |pcOffset|.
+  AllocSite(JS::Zone* zone, uint32_t pcOffset)
+      : zone_(zone), pcOffset_(pcOffset), traceKind_(JS::TraceKind::Object) {
+    MOZ_ASSERT(pcOffset != CatchAllPCOffset);
+  }
+
+  AllocSite(const AllocSite&) = delete;
+  AllocSite& operator=(const AllocSite&) = delete;
+
+  JS::Zone* zone() const { return zone_; }
+  JS::TraceKind traceKind() const { return traceKind_; }
+  bool isCatchAll() const { return pcOffset_ == CatchAllPCOffset; }
+  uint32_t pcOffset() const {
+    MOZ_ASSERT(!isCatchAll());
+    return pcOffset_;
+  }
+
+  State state() const { return state_; }
+  static const char* stateName(State state);
+
+  // The heap to allocate the next cell from this site in.
+  InitialHeap initialHeap() {
+    if (state_ == State::LongLived &&
+        (++tenuredAllocCount_ & (SampleInterval - 1)) != 0) {
+      return TenuredHeap;
+    }
+    return DefaultHeap;
+  }
+
+  // Called when a cell from this site is allocated in the nursery. Returns
+  // whether the site needs to be added to the nursery's list of sites that
+  // allocated since the last minor GC.
+  bool noteNurseryAllocation() {
+    nurseryAllocCount_++;
+    return !nextNurseryAllocated_;
+  }
+
+  // Called when an allocation is attributed to another site after the event.
+  void unnoteNurseryAllocation() {
+    MOZ_ASSERT(nurseryAllocCount_ != 0);
+    nurseryAllocCount_--;
+  }
+
+  // Called when a cell from this site is promoted. Threads that promote in
+  // parallel use the atomic version.
+  void noteTenured() { nurseryTenuredCount_ = nurseryTenuredCount_ + 1; }
+  void noteTenuredAtomic() { nurseryTenuredCount_++; }
+
+  bool isInAllocatedList() const { return nextNurseryAllocated_; }
+  AllocSite* nextNurseryAllocated() const {
+    MOZ_ASSERT(isInAllocatedList());
+    return nextNurseryAllocated_;
+  }
+  void setNextNurseryAllocated(AllocSite* next) {
+    MOZ_ASSERT(next);
+    nextNurseryAllocated_ = next;
+  }
+
+  // After a minor GC, look at the survival rate of this site's cells if there
+  // are enough of them and update the state. Removes the site from the
+  // nursery's list. Returns whether the state changed.
+  bool processSite(double longLivedThreshold);
+
+  // The counts from the last time processSite looked at this site.
+  uint32_t lastAllocCount() const { return lastAllocCount_; }
+  uint32_t lastTenuredCount() const { return lastTenuredCount_; }
+  uint32_t stateChangeCount() const { return stateChangeCount_; }
+
+  // Marks the end of the nursery's list of sites.
+  static AllocSite* const EndSentinel;
+
+  static constexpr size_t offsetOfNextNurseryAllocated() {
+    return offsetof(AllocSite, nextNurseryAllocated_);
+  }
+  static constexpr size_t offsetOfNurseryAllocCount() {
+    return offsetof(AllocSite, nurseryAllocCount_);
+  }
+  static constexpr size_t offsetOfTenuredAllocCount() {
+    return offsetof(AllocSite, tenuredAllocCount_);
+  }
+  static constexpr size_t offsetOfState() {
+    return offsetof(AllocSite, state_);
+  }
+
+ private:
+  static constexpr uint32_t CatchAllPCOffset = UINT32_MAX;
+
+  JS::Zone* const zone_;
+
+  // The next site in the nursery's list of sites that allocated since the last
+  // minor GC, or null if this site is not in the list.
+  AllocSite* nextNurseryAllocated_ = nullptr;
+
+  // Cells allocated in the nursery and cells promoted since this site's
+  // survival rate was last looked at. The tenured count is atomic because
+  // cells may be promoted on several threads.
+  uint32_t nurseryAllocCount_ = 0;
+  mozilla::Atomic<uint32_t, mozilla::Relaxed> nurseryTenuredCount_{0};
+
+  // Counts allocations by long-lived sites, to pick the ones to sample.
+  uint32_t tenuredAllocCount_ = 0;
+
+  State state_ = State::Unknown;
+
+  const uint32_t pcOffset_;
+  const JS::TraceKind traceKind_;
+
+  uint32_t lastAllocCount_ = 0;
+  uint32_t lastTenuredCount_ = 0;
+  uint32_t stateChangeCount_ = 0;
+};
+
+}  // namespace gc
+}  // namespace js
+
+#endif  // gc_Pretenuring_h
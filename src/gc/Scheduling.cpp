@@ -7,6 +7,7 @@
 #include "gc/Scheduling.h"
 
 #include "mozilla/CheckedInt.h"
+#include "mozilla/MathAlgorithms.h"
 #include "mozilla/TimeStamp.h"
 
 #include <algorithm>
@@ -348,6 +349,25 @@ void GCSchedulingTunables::resetParameter(JSGCParamKey key,
   }
 }
 
+void ChunkDemandPredictor::update(JSGCInvocationKind gckind) {
+  if (gckind == GC_SHRINK) {
+    // Shrinking GCs release as much memory as possible, so start again.
+    predictedChunks_ = 0;
+  } else if (chunksAllocated_ >= predictedChunks_) {
+    predictedChunks_ = chunksAllocated_;
+  } else {
+    predictedChunks_ = (predictedChunks_ + chunksAllocated_) / 2;
+  }
+
+  chunksAllocated_ = 0;
+}
+
+uint32_t ChunkDemandPredictor::targetEmptyChunkCount(
+    const GCSchedulingTunables& tunables, const AutoLockGC& lock) const {
+  return mozilla::Clamp(predictedChunks_, tunables.minEmptyChunkCount(lock),
+                        tunables.maxEmptyChunkCount());
+}
+
 void HeapThreshold::setIncrementalLimitFromStartBytes(
     size_t retainedBytes, const GCSchedulingTunables& tunables) {
   // Calculate the incremental limit for a heap based on its size and start
@@ -400,6 +400,21 @@ static const bool CompactingEnabled = true;
 /* JSGC_INCREMENTAL_WEAKMAP_ENABLED */
 static const bool IncrementalWeakMapMarkingEnabled = true;
 
+/* JSGC_MARKING_THREAD_COUNT */
+static const uint32_t MarkingThreadCount = 1;
+
+/* JSGC_CONCURRENT_MARKING */
+static const bool ConcurrentMarking = false;
+
+/* JSGC_TENURING_THREAD_COUNT */
+static const uint32_t TenuringThreadCount = 1;
+
+/* JSGC_AUTO_COMPACTING_THRESHOLD */
+static const uint32_t AutoCompactingThreshold = 0;
+
+/* JSGC_TENURED_STRING_DEDUPLICATION */
+static const bool TenuredStringDeduplication = false;
+
 /* JSGC_NURSERY_FREE_THRESHOLD_FOR_IDLE_COLLECTION */
 static const uint32_t NurseryFreeThresholdForIdleCollection = ChunkSize / 4;
 
@@ -658,6 +673,35 @@ class GCSchedulingState {
   }
 };
 
+/*
+ * Predicts how many chunks will be needed between one GC and the next from the
+ * demand seen in recent cycles. This is used to size the empty chunk pool: we
+ * keep enough empty chunks to satisfy the predicted demand without mapping new
+ * memory (and faulting it in), and release the rest. The prediction follows
+ * increases in demand immediately but decays gradually, so that one quiet
+ * cycle does not cause chunks that will be needed again soon to be released.
+ */
+class ChunkDemandPredictor {
+  // Chunks taken from the empty chunk pool or newly allocated since the last
+  // call to update().
+  uint32_t chunksAllocated_ = 0;
+
+  uint32_t predictedChunks_ = 0;
+
+ public:
+  void noteChunkAllocated() { chunksAllocated_++; }
+
+  // Called by GCRuntime::startDecommit, before the empty chunk pool is trimmed
+  // at the end of a major GC, to update the prediction.
+  void update(JSGCInvocationKind gckind);
+
+  uint32_t predictedChunks() const { return predictedChunks_; }
+
+  // The number of empty chunks to keep in the pool.
+  uint32_t targetEmptyChunkCount(const GCSchedulingTunables& tunables,
+                                 const AutoLockGC& lock) const;
+};
+
 enum class TriggerKind { None, Incremental, NonIncremental };
 
 struct TriggerResult {
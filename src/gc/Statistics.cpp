@@ -251,6 +251,16 @@ void Statistics::sccDurations(TimeDuration* total,
   }
 }
 
+// Page faults taken by the process during the slices of this GC. Faults taken
+// while the mutator runs between slices are not included.
+size_t Statistics::pageFaults() const {
+  size_t faults = 0;
+  for (const SliceData& slice : slices_) {
+    faults += slice.endFaults - slice.startFaults;
+  }
+  return faults;
+}
+
 typedef Vector<UniqueChars, 8, SystemAllocPolicy> FragmentVector;
 
 static UniqueChars Join(const FragmentVector& fragments,
@@ -368,12 +378,12 @@ UniqueChars Statistics::formatCompactSummaryMessage() const {
     return UniqueChars(nullptr);
   }
 
-  MOZ_ASSERT_IF(counts[COUNT_ARENA_RELOCATED], gckind == GC_SHRINK);
-  if (gckind == GC_SHRINK) {
+  if (gckind == GC_SHRINK || counts[COUNT_ARENA_RELOCATED]) {
     SprintfLiteral(
-        buffer, "Kind: %s; Relocated: %.3f MiB; ",
+        buffer, "Kind: %s; Relocated: %.3f MiB; Chunks Reclaimed: %u; ",
         ExplainInvocationKind(gckind),
-        double(ArenaSize * counts[COUNT_ARENA_RELOCATED]) / BYTES_PER_MB);
+        double(ArenaSize * counts[COUNT_ARENA_RELOCATED]) / BYTES_PER_MB,
+        uint32_t(counts[COUNT_CHUNK_RECLAIMED]));
     if (!fragments.append(DuplicateString(buffer))) {
       return UniqueChars(nullptr);
     }
@@ -436,6 +446,9 @@ UniqueChars Statistics::formatDetailedMessage() const {
   if (!fragments.append(formatDetailedPhaseTimes(phaseTimes))) {
     return UniqueChars(nullptr);
   }
+  if (!fragments.append(formatDetailedParallelTimes())) {
+    return UniqueChars(nullptr);
+  }
 
   return Join(fragments);
 }
@@ -460,6 +473,7 @@ UniqueChars Statistics::formatDetailedDescription() const {
   SCC Sweep Total (MaxPause): %.3fms (%.3fms)\n\
   HeapSize: %.3f MiB\n\
   Chunk Delta (magnitude): %+d  (%d)\n\
+  Page Faults: %zu\n\
   Arenas Relocated: %.3f MiB\n\
 ";
 
@@ -475,7 +489,7 @@ UniqueChars Statistics::formatDetailedDescription() const {
       mmu20 * 100., mmu50 * 100., t(sccTotal), t(sccLongest),
       double(preTotalHeapBytes) / BYTES_PER_MB,
       getCount(COUNT_NEW_CHUNK) - getCount(COUNT_DESTROY_CHUNK),
-      getCount(COUNT_NEW_CHUNK) + getCount(COUNT_DESTROY_CHUNK),
+      getCount(COUNT_NEW_CHUNK) + getCount(COUNT_DESTROY_CHUNK), pageFaults(),
       double(ArenaSize * getCount(COUNT_ARENA_RELOCATED)) / BYTES_PER_MB);
 
   return DuplicateString(buffer);
@@ -552,6 +566,34 @@ UniqueChars Statistics::formatDetailedPhaseTimes(
   return Join(fragments);
 }
 
+UniqueChars Statistics::formatDetailedParallelTimes() const {
+  FragmentVector fragments;
+  char buffer[128];
+  for (auto phase : AllPhases()) {
+    if (!parallelTaskCounts[phase]) {
+      continue;
+    }
+
+    if (fragments.empty() &&
+        !fragments.append(DuplicateString("  ---- Parallel Tasks ----\n"))) {
+      return UniqueChars(nullptr);
+    }
+
+    TimeDuration longest;
+    for (const SliceData& slice : slices_) {
+      longest = std::max(longest, slice.maxParallelTimes[phase]);
+    }
+
+    SprintfLiteral(buffer, "    %s: %u tasks, %.3fms total, %.3fms longest\n",
+                   phases[phase].name, parallelTaskCounts[phase],
+                   t(parallelTimes[phase]), t(longest));
+    if (!fragments.append(DuplicateString(buffer))) {
+      return UniqueChars(nullptr);
+    }
+  }
+  return Join(fragments);
+}
+
 UniqueChars Statistics::formatDetailedTotals() const {
   TimeDuration total, longest;
   gcDuration(&total, &longest);
@@ -579,6 +621,17 @@ void Statistics::formatJsonSlice(size_t sliceNum, JSONPrinter& json) const {
   formatJsonPhaseTimes(slices_[sliceNum].phaseTimes, json);
   json.endObject();
 
+  const auto& markingThreadTimes = slices_[sliceNum].markingThreadTimes;
+  if (!markingThreadTimes.empty()) {
+    json.beginListProperty("marking_threads");  // # 13
+    for (TimeDuration time : markingThreadTimes) {
+      json.beginObject();
+      json.property("time", time, JSONPrinter::MILLISECONDS);
+      json.endObject();
+    }
+    json.endList();
+  }
+
   json.endObject();
 }
 
@@ -645,6 +698,10 @@ UniqueChars Statistics::renderJsonMessage() const {
   formatJsonPhaseTimes(phaseTimes, json);
   json.endObject();
 
+  json.beginObjectProperty("parallel_tasks");
+  formatJsonPhaseTimes(parallelTimes, json);
+  json.endObject();
+
   json.endObject();
 
   return printer.release();
@@ -697,6 +754,15 @@ void Statistics::formatJsonDescription(JSONPrinter& json) const {
   if (removedChunks) {
     json.property("removed_chunks", removedChunks);
   }
+  size_t faults = pageFaults();
+  if (faults) {
+    json.property("page_faults", faults);
+  }
+  uint32_t relocatedArenas = getCount(COUNT_ARENA_RELOCATED);
+  if (relocatedArenas) {
+    json.property("relocated_arenas", relocatedArenas);
+    json.property("reclaimed_chunks", getCount(COUNT_CHUNK_RECLAIMED));
+  }
   json.property("major_gc_number", startingMajorGCNumber);
   json.property("minor_gc_number", startingMinorGCNumber);
   json.property("slice_number", startingSliceNumber);
@@ -758,6 +824,8 @@ Statistics::Statistics(GCRuntime* gc)
       maxPauseInInterval(0),
       sliceCallback(nullptr),
       nurseryCollectionCallback(nullptr),
+      telemetryCallback(nullptr),
+      telemetryCallbackData(nullptr),
       aborted(false),
       enableProfiling_(false),
       sliceCount_(0) {
@@ -769,6 +837,10 @@ Statistics::Statistics(GCRuntime* gc)
     stat = 0;
   }
 
+  for (auto& count : parallelTaskCounts) {
+    count = 0;
+  }
+
 #ifdef DEBUG
   for (const auto& duration : totalTimes_) {
     using ElementType = std::remove_reference_t<decltype(duration)>;
@@ -854,6 +926,54 @@ JS::GCSliceCallback Statistics::setSliceCallback(
   return oldCallback;
 }
 
+void Statistics::setTelemetryCallback(JS::GCTelemetryCallback callback,
+                                      void* data) {
+  telemetryCallback = callback;
+  telemetryCallbackData = data;
+  if (!callback) {
+    telemetryPhaseTimes.clearAndFree();
+  }
+}
+
+void Statistics::sendTelemetryRecord(const JS::GCTelemetryRecord& record) {
+  MOZ_ASSERT(telemetryCallback);
+  (*telemetryCallback)(context(), record, telemetryCallbackData);
+}
+
+void Statistics::sendSliceTelemetryRecord(const SliceData& slice, bool last) {
+  JS::GCTelemetryRecord record;
+  record.kind = JS::GCTelemetryEventKind::MajorSlice;
+  record.reason = slice.reason;
+  record.gcNumber = startingMajorGCNumber;
+  record.start = slice.start;
+  record.end = slice.end;
+  record.sliceNumber = slices_.length() - 1;
+  record.isLastSlice = last;
+  if (slice.budget.isTimeBudget()) {
+    record.timeBudgetMS = slice.budget.timeBudget.budget;
+  } else if (slice.budget.isWorkBudget()) {
+    record.workBudget = slice.budget.workBudget.budget;
+  }
+  record.heapBytesBefore = slice.startHeapBytes;
+  record.heapBytesAfter = slice.endHeapBytes;
+
+  // If we OOM the record is still sent without any phase times.
+  telemetryPhaseTimes.clear();
+  for (auto phase : AllPhases()) {
+    TimeDuration time = slice.phaseTimes[phase];
+    if (!time.IsZero() &&
+        !telemetryPhaseTimes.append(
+            JS::GCTelemetryPhaseTime{phases[phase].path, time})) {
+      telemetryPhaseTimes.clear();
+      break;
+    }
+  }
+  record.phaseTimes = telemetryPhaseTimes.begin();
+  record.phaseCount = telemetryPhaseTimes.length();
+
+  sendTelemetryRecord(record);
+}
+
 JS::GCNurseryCollectionCallback Statistics::setNurseryCollectionCallback(
     JS::GCNurseryCollectionCallback newCallback) {
   auto oldCallback = nurseryCollectionCallback;
@@ -1176,6 +1296,8 @@ void Statistics::beginSlice(const ZoneGCStats& zoneStats,
     return;
   }
 
+  slices_.back().startHeapBytes = gc->heapSize.bytes();
+
   runtime->addTelemetry(JS_TELEMETRY_GC_REASON, uint32_t(reason));
 
   // Slice callbacks should only fire for the outermost level.
@@ -1200,6 +1322,7 @@ void Statistics::endSlice() {
     auto& slice = slices_.back();
     slice.end = ReallyNow();
     slice.endFaults = GetPageFaultCount();
+    slice.endHeapBytes = gc->heapSize.bytes();
     slice.finalState = gc->state();
 
     writeLogMessage("end slice");
@@ -1236,6 +1359,10 @@ void Statistics::endSlice() {
         (*sliceCallback)(cx, JS::GC_CYCLE_END, desc);
       }
     }
+
+    if (telemetryCallback) {
+      sendSliceTelemetryRecord(slices_.back(), last);
+    }
   }
 
   // Do this after the slice callback since it uses these values.
@@ -1262,6 +1389,12 @@ void Statistics::endSlice() {
       duration = TimeDuration();
       MOZ_ASSERT(duration.IsZero());
     }
+    for (TimeDuration& duration : parallelTimes) {
+      duration = TimeDuration();
+    }
+    for (uint32_t& count : parallelTaskCounts) {
+      count = 0;
+    }
 
     phaseStartTimes[Phase::MUTATOR] = mutatorStartTime;
     phaseTimes[Phase::MUTATOR] = mutatorTime;
@@ -1487,6 +1620,12 @@ void Statistics::endPhase(PhaseKind phaseKind) {
 
 void Statistics::recordParallelPhase(PhaseKind phaseKind,
                                      TimeDuration duration) {
+  recordParallelTasks(phaseKind, 1, duration, duration);
+}
+
+void Statistics::recordParallelTasks(PhaseKind phaseKind, size_t count,
+                                     TimeDuration total,
+                                     TimeDuration longest) {
   MOZ_ASSERT(CurrentThreadCanAccessRuntime(gc->rt));
 
   if (aborted) {
@@ -1497,7 +1636,27 @@ void Statistics::recordParallelPhase(PhaseKind phaseKind,
   // phases.
   Phase phase = lookupChildPhase(phaseKind);
   TimeDuration& time = slices_.back().maxParallelTimes[phase];
-  time = std::max(time, duration);
+  time = std::max(time, longest);
+
+  parallelTimes[phase] += total;
+  parallelTaskCounts[phase] += count;
+}
+
+void Statistics::recordMarkingThreadTime(size_t index,
+                                         TimeDuration duration) {
+  MOZ_ASSERT(CurrentThreadCanAccessRuntime(gc->rt));
+
+  if (aborted) {
+    return;
+  }
+
+  // A slice can mark in parallel more than once. On OOM the per-thread times
+  // are lost, but the PARALLEL_MARK phase time is still recorded.
+  auto& times = slices_.back().markingThreadTimes;
+  if (index >= times.length() && !times.resize(index + 1)) {
+    return;
+  }
+  times[index] += duration;
 }
 
 TimeStamp Statistics::beginSCC() { return ReallyNow(); }
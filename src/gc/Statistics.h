@@ -46,6 +46,9 @@ enum Count {
   // Number of arenas relocated by compacting GC.
   COUNT_ARENA_RELOCATED,
 
+  // Number of chunks left empty by releasing relocated arenas.
+  COUNT_CHUNK_RECLAIMED,
+
   COUNT_LIMIT
 };
 
@@ -57,6 +60,9 @@ enum Stat {
   // Number of object types pretenured this minor GC.
   STAT_OBJECT_GROUPS_PRETENURED,
 
+  // Number of allocation sites that became long-lived this minor GC.
+  STAT_ALLOC_SITES_PRETENURED,
+
   // Number of realms that had nursery strings disabled due to large numbers
   // being tenured.
   STAT_NURSERY_STRING_REALMS_DISABLED,
@@ -147,6 +153,7 @@ struct Statistics {
 
   // Create a convenient type for referring to tables of phase times.
   using PhaseTimeTable = EnumeratedArray<Phase, Phase::LIMIT, TimeDuration>;
+  using PhaseCountTable = EnumeratedArray<Phase, Phase::LIMIT, uint32_t>;
 
   static MOZ_MUST_USE bool initialize();
 
@@ -159,6 +166,12 @@ struct Statistics {
   void beginPhase(PhaseKind phaseKind);
   void endPhase(PhaseKind phaseKind);
   void recordParallelPhase(PhaseKind phaseKind, TimeDuration duration);
+  void recordParallelTasks(PhaseKind phaseKind, size_t count,
+                           TimeDuration total, TimeDuration longest);
+
+  // Add to the time the marker with the given index spent in parallel marking
+  // during the current slice. Index zero is the main thread's marker.
+  void recordMarkingThreadTime(size_t index, TimeDuration duration);
 
   // Occasionally, we may be in the middle of something that is tracked by
   // this class, and we need to do something unusual (eg evict the nursery)
@@ -252,6 +265,10 @@ struct Statistics {
   JS::GCNurseryCollectionCallback setNurseryCollectionCallback(
       JS::GCNurseryCollectionCallback callback);
 
+  void setTelemetryCallback(JS::GCTelemetryCallback callback, void* data);
+  bool hasTelemetryCallback() const { return telemetryCallback; }
+  void sendTelemetryRecord(const JS::GCTelemetryRecord& record);
+
   TimeDuration clearMaxGCPauseAccumulator();
   TimeDuration getMaxGCPauseSinceClear();
 
@@ -274,9 +291,15 @@ struct Statistics {
     TimeStamp end;
     size_t startFaults = 0;
     size_t endFaults = 0;
+    size_t startHeapBytes = 0;
+    size_t endHeapBytes = 0;
     PhaseTimeTable phaseTimes;
     PhaseTimeTable maxParallelTimes;
 
+    // Time each marker spent in parallel marking, indexed as for
+    // recordMarkingThreadTime. Empty if the slice didn't mark in parallel.
+    Vector<TimeDuration, 0, SystemAllocPolicy> markingThreadTimes;
+
     TimeDuration duration() const { return end - start; }
     bool wasReset() const { return resetReason != gc::AbortReason::None; }
   };
@@ -353,6 +376,14 @@ struct Statistics {
   /* Total time in a given phase for this GC. */
   PhaseTimeTable phaseTimes;
 
+  /*
+   * Total time spent by, and number of, parallel tasks run in a given phase for
+   * this GC. Comparing the total with the longest single task gives the
+   * parallelism achieved.
+   */
+  PhaseTimeTable parallelTimes;
+  PhaseCountTable parallelTaskCounts;
+
   /* Number of events of this type for this GC. */
   EnumeratedArray<Count, COUNT_LIMIT,
                   mozilla::Atomic<uint32_t, mozilla::ReleaseAcquire>>
@@ -412,6 +443,11 @@ struct Statistics {
   JS::GCSliceCallback sliceCallback;
   JS::GCNurseryCollectionCallback nurseryCollectionCallback;
 
+  /* Structured per-slice and per-minor-GC records for the embedder. */
+  JS::GCTelemetryCallback telemetryCallback;
+  void* telemetryCallbackData;
+  Vector<JS::GCTelemetryPhaseTime, 0, SystemAllocPolicy> telemetryPhaseTimes;
+
   /*
    * True if we saw an OOM while allocating slices or we saw an impossible
    * timestamp. The statistics for this GC will be invalid.
@@ -446,12 +482,14 @@ struct Statistics {
 
   void sendGCTelemetry();
   void sendSliceTelemetry(const SliceData& slice);
+  void sendSliceTelemetryRecord(const SliceData& slice, bool last);
 
   void recordPhaseBegin(Phase phase);
   void recordPhaseEnd(Phase phase);
 
   void gcDuration(TimeDuration* total, TimeDuration* maxPause) const;
   void sccDurations(TimeDuration* total, TimeDuration* maxPause) const;
+  size_t pageFaults() const;
   void printStats();
 
   void reportLongestPhaseInMajorGC(PhaseKind longest, int telemetryId);
@@ -463,6 +501,7 @@ struct Statistics {
   UniqueChars formatDetailedSliceDescription(unsigned i,
                                              const SliceData& slice) const;
   UniqueChars formatDetailedPhaseTimes(const PhaseTimeTable& phaseTimes) const;
+  UniqueChars formatDetailedParallelTimes() const;
   UniqueChars formatDetailedTotals() const;
 
   void formatJsonDescription(JSONPrinter&) const;
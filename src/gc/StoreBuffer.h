@@ -132,6 +132,23 @@ class StoreBuffer {
     /* Trace the source of all edges in the store buffer. */
     void trace(TenuringTracer& mover);
 
+    /* The number of edges in the buffer. */
+    size_t count() const { return stores_.count() + (last_ ? 1 : 0); }
+
+    /* Append all the edges in the buffer to |edges|. */
+    MOZ_MUST_USE bool copyTo(Vector<T, 0, SystemAllocPolicy>& edges) const {
+      if (!edges.reserve(edges.length() + count())) {
+        return false;
+      }
+      if (last_) {
+        edges.infallibleAppend(last_);
+      }
+      for (auto r = stores_.all(); !r.empty(); r.popFront()) {
+        edges.infallibleAppend(r.front());
+      }
+      return true;
+    }
+
     size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) {
       return stores_.shallowSizeOfExcludingThis(mallocSizeOf);
     }
@@ -517,14 +534,37 @@ class StoreBuffer {
   /* Methods to trace the source of all edges in the store buffer. */
   void traceValues(TenuringTracer& mover) { bufferVal.trace(mover); }
   void traceCells(TenuringTracer& mover) {
+    traceNonObjectCells(mover);
+    bufObjCell.trace(mover);
+  }
+  void traceNonObjectCells(TenuringTracer& mover) {
     bufStrCell.trace(mover);
     bufBigIntCell.trace(mover);
-    bufObjCell.trace(mover);
   }
   void traceSlots(TenuringTracer& mover) { bufferSlot.trace(mover); }
   void traceWholeCells(TenuringTracer& mover) { bufferWholeCell.trace(mover); }
   void traceGenericEntries(JSTracer* trc) { bufferGeneric.trace(trc); }
 
+  /*
+   * Methods to copy the value, object and slots edges for promotion on
+   * several threads. The other buffers are always traced by the main thread.
+   */
+  size_t parallelTenuringEdgeCount() const {
+    return bufferVal.count() + bufObjCell.count() + bufferSlot.count();
+  }
+  MOZ_MUST_USE bool copyValueEdges(
+      Vector<ValueEdge, 0, SystemAllocPolicy>& edges) const {
+    return bufferVal.copyTo(edges);
+  }
+  MOZ_MUST_USE bool copyObjectEdges(
+      Vector<ObjectPtrEdge, 0, SystemAllocPolicy>& edges) const {
+    return bufObjCell.copyTo(edges);
+  }
+  MOZ_MUST_USE bool copySlotsEdges(
+      Vector<SlotsEdge, 0, SystemAllocPolicy>& edges) const {
+    return bufferSlot.copyTo(edges);
+  }
+
   /* For use by our owned buffers and for testing. */
   void setAboutToOverflow(JS::GCReason);
 
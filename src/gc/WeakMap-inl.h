@@ -10,11 +10,13 @@
 #include "gc/WeakMap.h"
 
 #include "mozilla/DebugOnly.h"
+#include "mozilla/Maybe.h"
 #include "mozilla/Unused.h"
 
 #include <algorithm>
 #include <type_traits>
 
+#include "gc/ParallelMarking.h"
 #include "gc/Zone.h"
 #include "js/TraceKind.h"
 #include "vm/JSContext.h"
@@ -211,6 +213,13 @@ void WeakMap<K, V>::trace(JSTracer* trc) {
     MOZ_ASSERT(trc->weakMapAction() == ExpandWeakMaps);
     auto marker = GCMarker::fromTracer(trc);
 
+    // Markers running in parallel share the weak keys tables and may trace the
+    // same map concurrently.
+    mozilla::Maybe<LockGuard<Mutex>> lock;
+    if (marker->isParallelMarking()) {
+      lock.emplace(marker->parallelMarker()->weakMapMarkingLock());
+    }
+
     // Don't downgrade the map color from black to gray. This can happen when a
     // barrier pushes the map object onto the black mark stack when it's
     // already present on the gray mark stack, which is marked later.
@@ -6,6 +6,7 @@
 
 #include "gc/Zone-inl.h"
 
+#include <algorithm>
 #include <type_traits>
 
 #include "gc/FreeOp.h"
@@ -15,6 +16,7 @@
 #include "jit/BaselineIC.h"
 #include "jit/BaselineJIT.h"
 #include "jit/Ion.h"
+#include "jit/IonScript.h"
 #include "jit/JitRealm.h"
 #include "vm/Runtime.h"
 #include "wasm/WasmInstance.h"
@@ -149,8 +151,13 @@ JS::Zone::Zone(JSRuntime* rt)
       data(this, nullptr),
       tenuredStrings(this, 0),
       tenuredBigInts(this, 0),
+      tenuredStringsDeduplicated(this, 0),
+      tenuredStringDedupBytesSaved(this, 0),
       allocNurseryStrings(this, true),
       allocNurseryBigInts(this, true),
+      unknownObjectAllocSite_(this, JS::TraceKind::Object),
+      unknownStringAllocSite_(this, JS::TraceKind::String),
+      unknownBigIntAllocSite_(this, JS::TraceKind::BigInt),
       suppressAllocationMetadataBuilder(this, false),
       uniqueIds_(this),
       tenuredAllocsSinceMinorGC_(0),
@@ -484,6 +491,112 @@ void Zone::discardJitCode(JSFreeOp* fop,
   }
 }
 
+namespace {
+
+struct ColdJitScript {
+  JSScript* script;
+  uint32_t gcsSinceLastRun;
+  size_t codeBytes;
+  double poolOccupancy;
+};
+
+}  // namespace
+
+static double PoolOccupancy(jit::JitCode* code) {
+  jit::ExecutablePool* pool = code->pool();
+  return double(pool->usedCodeBytes()) / double(pool->allocatedBytes());
+}
+
+void Zone::discardColdJitCode(JSFreeOp* fop) {
+  if (!jitZone() || jit::JitOptions.jitCodeBudgetKB == 0) {
+    return;
+  }
+
+  MOZ_ASSERT(isPreservingCode());
+
+  // Age all scripts, and collect the ones that didn't run since the last GC
+  // and aren't on the stack.
+  jit::MarkActiveJitScripts(this);
+
+  Vector<ColdJitScript, 0, SystemAllocPolicy> candidates;
+  bool oom = false;
+  for (auto base = cellIterUnsafe<BaseScript>(); !base.done(); base.next()) {
+    jit::JitScript* jitScript = base->maybeJitScript();
+    if (!jitScript) {
+      continue;
+    }
+
+    JSScript* script = base->asJSScript();
+    jitScript->noteGCForColdness(script->getWarmUpCount());
+
+    bool active = jitScript->active();
+    jitScript->resetActive();
+    if (active || jitScript->gcsSinceLastRun() == 0 || oom) {
+      continue;
+    }
+
+    // Bailouts from Ion code (including code this script was inlined into)
+    // resume in Baseline, so only discard Baseline code if the script was
+    // never Ion compiled or inlined.
+    ColdJitScript cold{script, jitScript->gcsSinceLastRun(), 0, 1.0};
+    if (jitScript->hasIonScript()) {
+      jit::JitCode* code = jitScript->ionScript()->method();
+      cold.codeBytes += code->headerSize() + code->bufferSize();
+      cold.poolOccupancy = PoolOccupancy(code);
+    }
+    if (jitScript->hasBaselineScript() &&
+        !jitScript->ionCompiledOrInlined()) {
+      jit::JitCode* code = jitScript->baselineScript()->method();
+      cold.codeBytes += code->headerSize() + code->bufferSize();
+      cold.poolOccupancy = std::min(cold.poolOccupancy, PoolOccupancy(code));
+    }
+    if (cold.codeBytes == 0) {
+      continue;
+    }
+
+    if (!candidates.append(cold)) {
+      // Keep aging the remaining scripts and work with what we have.
+      oom = true;
+    }
+  }
+
+  const jit::ExecutableAllocator& execAlloc = jitZone()->execAlloc();
+  size_t budget = size_t(jit::JitOptions.jitCodeBudgetKB) * 1024;
+  size_t used = execAlloc.codeBytes(jit::CodeKind::Ion) +
+                execAlloc.codeBytes(jit::CodeKind::Baseline);
+  if (used <= budget) {
+    return;
+  }
+  size_t excess = used - budget;
+
+  // Coldest first. Among equally cold scripts prefer the ones in emptier
+  // pools, as that's more likely to let us release whole pools.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const ColdJitScript& a, const ColdJitScript& b) {
+              if (a.gcsSinceLastRun != b.gcsSinceLastRun) {
+                return a.gcsSinceLastRun > b.gcsSinceLastRun;
+              }
+              return a.poolOccupancy < b.poolOccupancy;
+            });
+
+  // The code is freed when its JitCode cell is finalized later in this GC.
+  size_t discarded = 0;
+  for (const ColdJitScript& cold : candidates) {
+    if (discarded >= excess) {
+      break;
+    }
+
+    JSScript* script = cold.script;
+    jit::JitScript* jitScript = script->jitScript();
+    jit::FinishInvalidation(fop, script);
+    if (jitScript->hasBaselineScript() &&
+        !jitScript->ionCompiledOrInlined()) {
+      jit::FinishDiscardBaselineScript(fop, script);
+    }
+    discarded += cold.codeBytes;
+  }
+}
+
 void JS::Zone::beforeClearDelegateInternal(JSObject* wrapper,
                                            JSObject* delegate) {
   MOZ_ASSERT(js::gc::detail::GetDelegate(wrapper) == delegate);
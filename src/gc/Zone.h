@@ -17,6 +17,7 @@
 #include "gc/FindSCCs.h"
 #include "gc/GCMarker.h"
 #include "gc/NurseryAwareHashMap.h"
+#include "gc/Pretenuring.h"
 #include "gc/ZoneAllocator.h"
 #include "js/GCHashTable.h"
 #include "vm/AtomsTable.h"
@@ -202,9 +203,35 @@ class Zone : public js::ZoneAllocator, public js::gc::GraphNodeBase<JS::Zone> {
   js::ZoneData<uint32_t> tenuredStrings;
   js::ZoneData<uint32_t> tenuredBigInts;
 
+  // Totals for tenured string deduplication in this zone: the number of
+  // strings merged into an identical string and the malloc bytes freed.
+  js::ZoneOrGCTaskData<size_t> tenuredStringsDeduplicated;
+  js::ZoneOrGCTaskData<size_t> tenuredStringDedupBytesSaved;
+
   js::ZoneData<bool> allocNurseryStrings;
   js::ZoneData<bool> allocNurseryBigInts;
 
+ private:
+  // Allocation sites for nursery cells that don't have a more specific site.
+  // See gc/Pretenuring.h.
+  js::gc::AllocSite unknownObjectAllocSite_;
+  js::gc::AllocSite unknownStringAllocSite_;
+  js::gc::AllocSite unknownBigIntAllocSite_;
+
+ public:
+  js::gc::AllocSite* unknownAllocSite(JS::TraceKind kind) {
+    switch (kind) {
+      case JS::TraceKind::Object:
+        return &unknownObjectAllocSite_;
+      case JS::TraceKind::String:
+        return &unknownStringAllocSite_;
+      case JS::TraceKind::BigInt:
+        return &unknownBigIntAllocSite_;
+      default:
+        MOZ_CRASH("Unexpected nursery trace kind");
+    }
+  }
+
   // When true, skip calling the metadata callback. We use this:
   // - to avoid invoking the callback recursively;
   // - to avoid observing lazy prototype setup (which confuses callbacks that
@@ -412,6 +439,12 @@ class Zone : public js::ZoneAllocator, public js::gc::GraphNodeBase<JS::Zone> {
       ShouldDiscardBaselineCode discardBaselineCode = DiscardBaselineCode,
       ShouldDiscardJitScripts discardJitScripts = KeepJitScripts);
 
+  // Called instead of discardJitCode when the zone is preserving code. If the
+  // zone has more Baseline and Ion code than JitOptions.jitCodeBudgetKB,
+  // discard the code of the coldest scripts until it's back under budget.
+  // Shrinking GCs never preserve code, so they discard all of it anyway.
+  void discardColdJitCode(JSFreeOp* fop);
+
   void addSizeOfIncludingThis(
       mozilla::MallocSizeOf mallocSizeOf, JS::CodeSizes* code, size_t* typePool,
       size_t* regexpZone, size_t* jitZone, size_t* baselineStubsOptimized,
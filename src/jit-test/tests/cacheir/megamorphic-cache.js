@@ -0,0 +1,121 @@
+// Megamorphic property loads use a runtime-wide cache keyed on the receiver's
+// shape and the property name. Make sure it handles fixed and dynamic slots,
+// prototype lookups, and dictionary-mode objects whose shapes are changed in
+// place. devtools/megamorphic-cache-bench.js measures the cached path.
+
+function makeObjects() {
+  // More than enough different shapes to make the IC megamorphic.
+  var objs = [];
+  for (var i = 0; i < 24; i++) {
+    var o = {};
+    for (var j = 0; j < i; j++) {
+      o["p" + j] = j;
+    }
+    o.x = i;
+    objs.push(o);
+  }
+  return objs;
+}
+
+function getX(o) {
+  return o.x;
+}
+
+function testBasic() {
+  var objs = makeObjects();
+  for (var i = 0; i < 2000; i++) {
+    var o = objs[i % objs.length];
+    assertEq(getX(o), i % objs.length);
+  }
+}
+testBasic();
+
+// Properties found on the prototype aren't cached, but must still be found.
+function testProto() {
+  var objs = makeObjects();
+  for (var i = 0; i < objs.length; i++) {
+    var proto = {y: i * 2};
+    objs[i] = Object.create(proto);
+    objs[i]["q" + i] = 0;
+  }
+  function getY(o) {
+    return o.y;
+  }
+  for (var i = 0; i < 2000; i++) {
+    var idx = i % objs.length;
+    assertEq(getY(objs[idx]), idx * 2);
+  }
+}
+testProto();
+
+// Dictionary-mode objects: deleting and redefining properties changes the
+// shape in place, so cached slots must be invalidated.
+function testDictionary() {
+  var objs = makeObjects();
+  var dict = {a: 1, b: 2, x: 3, c: 4};
+  delete dict.a;
+  objs.push(dict);
+
+  for (var i = 0; i < 3000; i++) {
+    var o = objs[i % objs.length];
+    var expected = o === dict ? dict.x : i % objs.length;
+    assertEq(getX(o), expected);
+
+    if (i === 1000) {
+      // Redefine |x| in a new slot.
+      delete dict.x;
+      dict.x = 10;
+    } else if (i === 2000) {
+      delete dict.x;
+    } else if (i === 2500) {
+      Object.defineProperty(dict, "x", {get() { return 20; },
+                                        configurable: true});
+    }
+  }
+  assertEq(getX(dict), 20);
+}
+testDictionary();
+
+// Property removed from the receiver, exposing one on the prototype.
+function testShadowing() {
+  var objs = makeObjects();
+  var proto = {x: "proto"};
+  var o = Object.create(proto);
+  o.x = "own";
+  o.z = 0;
+  objs.push(o);
+  for (var i = 0; i < 2000; i++) {
+    var obj = objs[i % objs.length];
+    var res = getX(obj);
+    if (obj === o) {
+      assertEq(res, i < 1000 ? "own" : "proto");
+    }
+    if (i === 1000) {
+      delete o.x;
+    }
+  }
+}
+testShadowing();
+
+// Many objects with dynamic slots, read across GCs so the cache gets purged.
+function testDynamicSlots() {
+  var objs = [];
+  for (var i = 0; i < 16; i++) {
+    var o = {};
+    for (var j = 0; j < 40; j++) {
+      o["s" + ((j + i) % 40)] = j;
+    }
+    objs.push(o);
+  }
+  function getS(o) {
+    return o.s39;
+  }
+  for (var i = 0; i < 3000; i++) {
+    var idx = i % objs.length;
+    assertEq(getS(objs[idx]), (39 - idx + 40) % 40);
+    if (i % 1000 === 0) {
+      gc();
+    }
+  }
+}
+testDynamicSlots();
@@ -0,0 +1,65 @@
+// |jit-test| --cacheir-stub-corpus
+// Baseline ICs attach precompiled stubs for common operations and behave the
+// same as lazily compiled ones. The corpus is held weakly, and is compiled
+// again after a GC throws it away.
+
+// The corpus is only compiled when the Baseline Interpreter is enabled.
+var blinterp = getJitCompilerOptions()["blinterp.enable"] === 1;
+
+function arrays(arr) {
+    var sum = 0;
+    for (var i = 0; i < arr.length; i++) {
+        sum = sum + arr[i];
+        sum = sum - 1;
+        sum = sum * 1;
+    }
+    return sum;
+}
+
+function f() {
+    var arr = [1, 2, 3, 4, 5];
+    for (var i = 0; i < 100; i++) {
+        assertEq(arrays(arr), 10);
+    }
+
+    // The ICs used code from the corpus.
+    if (blinterp) {
+        assertEq(stubCorpusStats().stubs > 0, true);
+        assertEq(stubCorpusStats().hits > 0, true);
+    }
+
+    // Invalidate the stubs with values they don't handle.
+    assertEq(arrays([1.5, 2.5]), 2);
+    assertEq(arrays({length: 2, 0: 1, 1: 2}), 1);
+    assertEq(arrays([0x7fffffff, 0x7fffffff]), 0xfffffffc);
+}
+f();
+
+// A GC either keeps the whole corpus or drops it, and new ICs keep working.
+var corpusSize = stubCorpusStats().stubs;
+gc();
+gc();
+var stubs = stubCorpusStats().stubs;
+assertEq(stubs === corpusSize || stubs === 0, true);
+var arrays2 = new Function("return " + arrays.toString())();
+for (var i = 0; i < 100; i++) {
+    assertEq(arrays2([1, 2, 3]), 3);
+}
+
+// Nothing else keeps the corpus of an unused zone alive, so a GC drops it. A
+// new realm in that zone compiles it again.
+if (blinterp) {
+    var unused = newGlobal({newCompartment: true});
+    unused.eval("for (var i = 0; i < 100; i++) {}");
+    assertEq(unused.stubCorpusStats().stubs, corpusSize);
+    gc();
+    assertEq(unused.stubCorpusStats().stubs, 0);
+    var sameZone = newGlobal({sameZoneAs: unused});
+    sameZone.eval("for (var i = 0; i < 100; i++) {}");
+    assertEq(unused.stubCorpusStats().stubs, corpusSize);
+}
+
+// A new global in a new compartment starts with its own JitRealm.
+var g = newGlobal({newCompartment: true});
+g.eval(arrays.toString());
+assertEq(g.arrays([3, 4]), 5);
@@ -0,0 +1,86 @@
+// Test pretenuring by allocation site: a literal whose objects survive minor
+// collections is allocated in the tenured heap, one whose objects die young
+// stays in the nursery, and a long-lived site goes back to the nursery when
+// its objects stop surviving.
+
+gczeal(0);
+
+function siteOf(fun) {
+    let sites = allocSiteStats(fun);
+    assertEq(sites.length, 1);
+    assertEq(sites[0].kind, "object");
+    return sites[0];
+}
+
+let kept = [];
+function retain(n) {
+    for (let i = 0; i < n; i++) {
+        kept.push({value: i});
+    }
+}
+retain(1000);
+
+// Sites are kept in the script's JitScript, which isn't created without a
+// Baseline tier.
+if (allocSiteStats(retain).length === 0) {
+    quit();
+}
+
+let site = siteOf(retain);
+assertEq(site.state, "longLived");
+assertEq(site.stateChanges, 1);
+assertEq(site.allocs >= 100, true);
+assertEq(site.tenured, site.allocs);
+
+// The site stays long-lived while the objects it samples in the nursery keep
+// surviving.
+retain(2000);
+site = siteOf(retain);
+assertEq(site.state, "longLived");
+assertEq(site.stateChanges, 1);
+
+function temporary(n) {
+    let sum = 0;
+    for (let i = 0; i < n; i++) {
+        let o = {value: i};
+        sum += o.value;
+    }
+    return sum;
+}
+assertEq(temporary(1000), 499500);
+site = siteOf(temporary);
+assertEq(site.state, "unknown");
+assertEq(site.stateChanges, 0);
+
+let sink = [];
+function maybeRetain(n, keep) {
+    for (let i = 0; i < n; i++) {
+        let o = {value: i};
+        if (keep) {
+            sink.push(o);
+        }
+    }
+}
+maybeRetain(1000, true);
+assertEq(siteOf(maybeRetain).state, "longLived");
+
+// One in every 16 objects from a long-lived site is allocated in the nursery.
+// Once enough of them have died, the site goes back to the nursery.
+maybeRetain(16 * 100, false);
+site = siteOf(maybeRetain);
+assertEq(site.state, "unknown");
+assertEq(site.stateChanges, 2);
+assertEq(site.tenured < site.allocs / 2, true);
+
+// Everything else is counted against the zone's catch-all sites, which never
+// change state.
+let strings = [];
+for (let i = 0; i < 1000; i++) {
+    strings.push("s" + i);
+}
+let catchAll = allocSiteStats();
+for (let kind of ["object", "string", "bigint"]) {
+    assertEq(catchAll[kind].state, "unknown");
+    assertEq(catchAll[kind].stateChanges, 0);
+    assertEq(catchAll[kind].tenured <= catchAll[kind].allocs, true);
+}
@@ -0,0 +1,76 @@
+// Test that a normal GC compacts the heap when it is fragmented, once the
+// autoCompactingThreshold parameter is set.
+
+gczeal(0);
+
+assertEq(gcparam("autoCompactingThreshold"), 0);
+
+let threw = false;
+try {
+    gcparam("autoCompactingThreshold", 101);
+} catch {
+    threw = true;
+}
+assertEq(threw, true);
+assertEq(gcparam("autoCompactingThreshold"), 0);
+
+const objectCount = 100000;
+const keepEvery = 16;
+
+// Fill a zone with tenured objects, then drop most of them so that the arenas
+// they were in are left sparsely used.
+let g = newGlobal({newCompartment: true});
+g.evaluate(`
+    var objects = [];
+    for (let i = 0; i < ${objectCount}; i++) {
+        objects.push({i});
+    }
+`);
+gc();
+g.evaluate(`objects = objects.filter(o => o.i % ${keepEvery} === 0);`);
+gc();
+
+function zoneBytes() {
+    return g.evaluate("performance.mozMemory.zone.gcBytes");
+}
+
+function checkObjects() {
+    assertEq(g.evaluate("objects.length"), objectCount / keepEvery);
+    assertEq(g.evaluate(`objects.every((o, j) => o.i === j * ${keepEvery})`),
+             true);
+}
+
+checkObjects();
+
+// The heap size isn't available in more deterministic builds.
+let fragmentedBytes = zoneBytes();
+let checkBytes = typeof fragmentedBytes === "number";
+
+// The sweeping of the dead objects left the arenas in place, and a normal GC
+// doesn't compact by default.
+gc();
+checkObjects();
+if (checkBytes) {
+    assertEq(zoneBytes() >= fragmentedBytes * 0.9, true);
+    fragmentedBytes = zoneBytes();
+}
+
+// Once the threshold is below the proportion of free cells, the next normal GC
+// relocates the surviving objects into fewer arenas.
+gcparam("autoCompactingThreshold", 50);
+assertEq(gcparam("autoCompactingThreshold"), 50);
+gc();
+checkObjects();
+if (checkBytes) {
+    assertEq(zoneBytes() < fragmentedBytes / 2, true);
+}
+
+// The objects stay packed in later GCs.
+let compactedBytes = zoneBytes();
+gc();
+checkObjects();
+if (checkBytes) {
+    assertEq(zoneBytes() >= compactedBytes * 0.9, true);
+}
+
+gcparam("autoCompactingThreshold", 0);
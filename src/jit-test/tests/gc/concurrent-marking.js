@@ -0,0 +1,114 @@
+// Test marking on a helper thread between incremental slices while the
+// mutator changes the heap.
+
+gczeal(0);
+
+assertEq(gcparam("concurrentMarking"), 0);
+gcparam("concurrentMarking", 1);
+assertEq(gcparam("concurrentMarking"), 1);
+
+function makeTree(depth) {
+    if (depth === 0) {
+        return {leaf: true};
+    }
+    return {left: makeTree(depth - 1), right: makeTree(depth - 1), depth};
+}
+
+function checkTree(tree, depth) {
+    if (depth === 0) {
+        assertEq(tree.leaf, true);
+        return 1;
+    }
+    assertEq(tree.depth, depth);
+    return checkTree(tree.left, depth - 1) + checkTree(tree.right, depth - 1);
+}
+
+function makeChain(length) {
+    let head = null;
+    for (let i = 0; i < length; i++) {
+        head = {next: head, i, name: "node" + i, values: [i, {i}]};
+    }
+    return head;
+}
+
+function checkChain(head, length) {
+    let count = 0;
+    for (let node = head; node; node = node.next) {
+        assertEq(node.values[1].i, node.i);
+        assertEq(node.name.startsWith("node"), true);
+        count++;
+    }
+    assertEq(count, length);
+}
+
+// The concurrent marker leaves objects with hooks, dynamic slots or elements,
+// and strings that aren't atoms, to the main thread.
+function makeMixedChain(length) {
+    let head = null;
+    for (let i = 0; i < length; i++) {
+        let big = {};
+        for (let j = 0; j < 20; j++) {
+            big["p" + j] = {j};
+        }
+        head = new Proxy({next: head, i, big, rope: "a".repeat(20) + i,
+                          map: new Map([[i, {i}]])}, {});
+    }
+    return head;
+}
+
+function checkMixedChain(head, length) {
+    let count = 0;
+    for (let node = head; node; node = node.next) {
+        assertEq(node.big.p19.j, 19);
+        assertEq(node.map.get(node.i).i, node.i);
+        assertEq(node.rope.endsWith(String(node.i)), true);
+        count++;
+    }
+    assertEq(count, length);
+}
+
+let tree = makeTree(14);
+let chain = makeChain(20000);
+let mixedChain = makeMixedChain(2000);
+gc();
+
+// Move subtrees and chain links around between slices. The values that are
+// overwritten are only kept alive by the pre-write barrier.
+function mutate(round) {
+    let node = tree;
+    for (let i = 0; i < 10; i++) {
+        let tmp = node.left;
+        node.left = node.right;
+        node.right = tmp;
+        node = (round + i) & 1 ? node.left : node.right;
+    }
+
+    let link = chain;
+    for (let i = 0; i < 100 && link.next && link.next.next; i++) {
+        let next = link.next;
+        link.next = next.next;
+        next.next = link.next.next;
+        link.next.next = next;
+        link = next;
+    }
+
+    let obj = mixedChain.big;
+    obj["added" + round] = {round};
+    obj.p0 = {j: 0};
+}
+
+for (let round = 0; round < 5; round++) {
+    startgc(1);
+    let slices = 0;
+    while (gcstate() !== "NotActive") {
+        mutate(slices++);
+        gcslice(100);
+    }
+    assertEq(checkTree(tree, 14), 1 << 14);
+    checkChain(chain, 20000);
+    checkMixedChain(mixedChain, 2000);
+}
+
+gcparam("concurrentMarking", 0);
+assertEq(gcparam("concurrentMarking"), 0);
+gc();
@@ -0,0 +1,60 @@
+// Test merging of identical tenured strings during major GCs.
+
+gczeal(0);
+
+assertEq(gcparam("tenuredStringDeduplication"), 0);
+gcparam("tenuredStringDeduplication", 1);
+assertEq(gcparam("tenuredStringDeduplication"), 1);
+
+const latin1 = "a tenured Latin-1 string that is too long to be inline";
+const twoByte = "a tenured two-byte string ሴ that is too long to be inline";
+
+var strings = [];
+for (var i = 0; i < 100; i++) {
+    strings.push(newString(latin1, {tenured: true}));
+    strings.push(newString(twoByte, {tenured: true}));
+    strings.push(newString(twoByte, {tenured: true, twoByte: true}));
+}
+
+// Dependent strings keep their bases' chars alive.
+var bases = [];
+var substrings = [];
+for (var i = 0; i < 10; i++) {
+    var base = newString(latin1, {tenured: true});
+    bases.push(base);
+    substrings.push(base.substring(2, 40));
+}
+
+gc();
+
+function check() {
+    for (var i = 0; i < strings.length; i += 3) {
+        assertEq(strings[i], latin1);
+        assertEq(strings[i + 1], twoByte);
+        assertEq(strings[i + 2], twoByte);
+    }
+    for (var i = 0; i < bases.length; i++) {
+        assertEq(bases[i], latin1);
+        assertEq(substrings[i], latin1.substring(2, 40));
+    }
+}
+check();
+
+// Deduplicated strings can themselves be used as bases.
+var moreSubstrings = strings.map(s => s.substring(1, 30));
+gc();
+check();
+for (var i = 0; i < strings.length; i++) {
+    assertEq(moreSubstrings[i], strings[i].substring(1, 30));
+}
+
+// Incremental GCs give the same results.
+startgc(1);
+while (gcstate() !== "NotActive") {
+    gcslice(100);
+}
+check();
+
+gcparam("tenuredStringDeduplication", 0);
+gc();
+check();
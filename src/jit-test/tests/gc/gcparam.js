@@ -50,6 +50,7 @@ testChangeParam("largeHeapIncrementalLimit");
 testChangeParam("minEmptyChunkCount");
 testChangeParam("maxEmptyChunkCount");
 testChangeParam("compactingEnabled");
+testChangeParam("autoCompactingThreshold");
 testChangeParam("mallocThresholdBase");
 testChangeParam("mallocGrowthFactor");
 
@@ -0,0 +1,24 @@
+// Test the per-group tenuring data reported by nurseryTenurings().
+
+gczeal(0);
+minorgc();
+
+// An empty nursery tenures nothing.
+assertEq(nurseryTenurings().length, 0);
+
+var keep = [];
+for (var i = 0; i < 1000; i++) {
+    keep.push({i});
+}
+
+var tenurings = nurseryTenurings();
+assertEq(Array.isArray(tenurings), true);
+var total = 0;
+for (var record of tenurings) {
+    assertEq(typeof record.className, "string");
+    assertEq(typeof record.count, "number");
+    assertEq(typeof record.pretenured, "boolean");
+    total += record.count;
+}
+assertEq(total > 0, true);
+assertEq(tenurings.some(r => r.className === "Object"), true);
@@ -0,0 +1,76 @@
+// Test finalizing many zones in parallel in the background, including the
+// atoms zone, while the mutator keeps running and allocating.
+
+gczeal(0);
+
+const zoneCount = 64;
+const itemCount = 200;
+
+function makeGlobal(i) {
+    let g = newGlobal({newCompartment: true});
+    g.evaluate(`
+        var live = [];
+        function allocate(prefix) {
+            for (let j = 0; j < ${itemCount}; j++) {
+                live.push({j, s: prefix + j, a: [j, j + 1]});
+
+                // Garbage of each background finalized kind: objects, arrays
+                // with dynamic elements, strings and atoms.
+                let dead = {j, s: "dead" + prefix + j, a: new Array(20).fill(j)};
+                dead["atom_" + prefix + j] = j;
+            }
+        }
+        allocate("zone${i}-");
+    `);
+    return g;
+}
+
+function check(g, i, count) {
+    assertEq(g.evaluate("live.length"), count);
+    assertEq(g.evaluate(`live[${itemCount - 1}].s`),
+             `zone${i}-${itemCount - 1}`);
+    assertEq(g.evaluate("live.every((item, j) => item.a[1] === item.j + 1)"),
+             true);
+}
+
+let globals = [];
+for (let i = 0; i < zoneCount; i++) {
+    globals.push(makeGlobal(i));
+}
+
+// Drop half of the zones so that they are finalized and then destroyed.
+for (let i = 0; i < zoneCount; i += 2) {
+    globals[i] = null;
+}
+
+gc();
+for (let i = 1; i < zoneCount; i += 2) {
+    check(globals[i], i, itemCount);
+}
+
+// Run an incremental collection, allocating in the remaining zones between
+// slices, including after background finalization has started.
+for (let i = 1; i < zoneCount; i += 4) {
+    globals[i] = null;
+}
+startgc(1);
+let allocations = 0;
+while (gcstate() !== "NotActive") {
+    let i = 3 + 4 * (allocations % (zoneCount / 4));
+    globals[i].evaluate(`allocate("more${allocations}-")`);
+    allocations++;
+    gcslice(10);
+}
+
+let counts = new Array(zoneCount).fill(itemCount);
+for (let n = 0; n < allocations; n++) {
+    counts[3 + 4 * (n % (zoneCount / 4))] += itemCount;
+}
+
+gc();
+for (let i = 3; i < zoneCount; i += 4) {
+    check(globals[i], i, counts[i]);
+}
+
+// Atoms created in the collected zones can be created again.
+assertEq(globals[3].evaluate(`({["atom_zone0-0"]: 1})["atom_zone0-0"]`), 1);
@@ -0,0 +1,122 @@
+// Test marking with multiple threads, including incremental slices, weakmaps,
+// objects with class trace hooks and deep object graphs.
+
+gczeal(0);
+
+assertEq(gcparam("markingThreadCount"), 1);
+
+let threw = false;
+try {
+    gcparam("markingThreadCount", 0);
+} catch {
+    threw = true;
+}
+assertEq(threw, true);
+assertEq(gcparam("markingThreadCount"), 1);
+
+gcparam("markingThreadCount", 4);
+assertEq(gcparam("markingThreadCount"), 4);
+
+function makeTree(depth) {
+    if (depth === 0) {
+        return {leaf: true};
+    }
+    return {left: makeTree(depth - 1), right: makeTree(depth - 1), depth};
+}
+
+function checkTree(tree, depth) {
+    if (depth === 0) {
+        assertEq(tree.leaf, true);
+        return 1;
+    }
+    assertEq(tree.depth, depth);
+    return checkTree(tree.left, depth - 1) + checkTree(tree.right, depth - 1);
+}
+
+function makeChain(length) {
+    let head = null;
+    for (let i = 0; i < length; i++) {
+        head = {next: head, i, values: [i, String(i), {i}]};
+    }
+    return head;
+}
+
+function checkChain(head, length) {
+    let count = 0;
+    for (let node = head; node; node = node.next) {
+        assertEq(node.values[2].i, node.i);
+        count++;
+    }
+    assertEq(count, length);
+}
+
+// Helper threads leave objects whose class trace hook isn't known to be thread
+// safe, such as proxies, maps and typed arrays, for the main thread.
+function makeHookedChain(length) {
+    let head = null;
+    for (let i = 0; i < length; i++) {
+        let map = new Map([[i, {i}]]);
+        head = new Proxy({next: head, i, map, bytes: new Uint8Array([i & 0xff])},
+                         {});
+    }
+    return head;
+}
+
+function checkHookedChain(head, length) {
+    let count = 0;
+    for (let node = head; node; node = node.next) {
+        assertEq(node.map.get(node.i).i, node.i);
+        assertEq(node.bytes[0], node.i & 0xff);
+        count++;
+    }
+    assertEq(count, length);
+}
+
+let tree = makeTree(14);
+let chain = makeChain(20000);
+let hookedChain = makeHookedChain(5000);
+
+let wm = new WeakMap();
+let keys = [];
+for (let i = 0; i < 1000; i++) {
+    let key = {i};
+    keys.push(key);
+    wm.set(key, makeTree(3));
+    wm.set({dead: i}, {dead: i});
+}
+
+gc();
+assertEq(checkTree(tree, 14), 1 << 14);
+checkChain(chain, 20000);
+checkHookedChain(hookedChain, 5000);
+assertEq(nondeterministicGetWeakMapKeys(wm).length, keys.length);
+
+// Marking only happens in parallel when there are helper threads, and not at
+// all if the mark stack never got deep enough.
+let stats = markingThreadStats();
+if (stats.length) {
+    assertEq(helperThreadCount() > 0, true);
+    assertEq(stats.length, 4);
+    for (let thread of stats) {
+        assertEq(thread.cells >= 0, true);
+        assertEq(thread.stolen >= 0, true);
+        assertEq(thread.time >= 0, true);
+    }
+    assertEq(stats.some(thread => thread.cells > 0), true);
+}
+
+startgc(1);
+while (gcstate() !== "NotActive") {
+    gcslice(100);
+}
+assertEq(checkTree(tree, 14), 1 << 14);
+checkChain(chain, 20000);
+checkHookedChain(hookedChain, 5000);
+for (let key of keys) {
+    assertEq(checkTree(wm.get(key), 3), 8);
+}
+
+gcparam("markingThreadCount", 1);
+assertEq(gcparam("markingThreadCount"), 1);
+gc();
+assertEq(markingThreadStats().length, 0);
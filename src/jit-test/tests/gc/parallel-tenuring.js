@@ -0,0 +1,106 @@
+// Test promoting nursery cells with multiple threads, including objects and
+// arrays reachable from each other, strings and objects with class hooks
+// whose promotion is left to the main thread.
+
+gczeal(0);
+
+assertEq(gcparam("tenuringThreadCount"), 1);
+
+let threw = false;
+try {
+    gcparam("tenuringThreadCount", 0);
+} catch {
+    threw = true;
+}
+assertEq(threw, true);
+assertEq(gcparam("tenuringThreadCount"), 1);
+
+gcparam("tenuringThreadCount", 4);
+assertEq(gcparam("tenuringThreadCount"), 4);
+
+// Tenure the holders so that storing nursery things into them adds store
+// buffer entries.
+const holderCount = 5000;
+let holders = [];
+for (let i = 0; i < holderCount; i++) {
+    holders.push({a: null, b: null, c: null});
+}
+let arrays = [];
+for (let i = 0; i < 100; i++) {
+    arrays.push(new Array(64).fill(null));
+}
+gc();
+
+function fill(round) {
+    for (let i = 0; i < holderCount; i++) {
+        let h = holders[i];
+        let inner = {value: i, round, next: {value: i + 1}};
+        h.a = inner;
+        h.b = [inner, {value: -i}, "s" + i + "/" + round];
+        h.c = i % 7 === 0 ? new Map([[i, inner]]) : inner.next;
+    }
+    for (let i = 0; i < arrays.length; i++) {
+        for (let j = 0; j < arrays[i].length; j++) {
+            arrays[i][j] = {i, j, round};
+        }
+    }
+}
+
+function check(round) {
+    for (let i = 0; i < holderCount; i++) {
+        let h = holders[i];
+        assertEq(h.a.value, i);
+        assertEq(h.a.round, round);
+        assertEq(h.a.next.value, i + 1);
+        assertEq(h.b[0], h.a);
+        assertEq(h.b[1].value, -i);
+        assertEq(h.b[2], "s" + i + "/" + round);
+        if (i % 7 === 0) {
+            assertEq(h.c.get(i), h.a);
+        } else {
+            assertEq(h.c, h.a.next);
+        }
+    }
+    for (let i = 0; i < arrays.length; i++) {
+        for (let j = 0; j < arrays[i].length; j++) {
+            let o = arrays[i][j];
+            assertEq(o.i, i);
+            assertEq(o.j, j);
+            assertEq(o.round, round);
+        }
+    }
+}
+
+for (let round = 0; round < 5; round++) {
+    fill(round);
+    minorgc();
+    check(round);
+}
+
+// The store buffer holds well over the minimum number of edges, so promotion
+// happens on every thread if helper threads are available.
+fill(5);
+let stats = tenuringThreadStats();
+check(5);
+if (helperThreadCount() > 0) {
+    assertEq(stats.length, 4);
+    let cells = 0;
+    for (let s of stats) {
+        assertEq(s.bytes >= 0, true);
+        assertEq(s.stolen >= 0, true);
+        cells += s.cells;
+    }
+    assertEq(cells > 0, true);
+} else {
+    assertEq(stats.length, 0);
+}
+
+// Major GCs see a consistent heap.
+gc();
+check(5);
+
+gcparam("tenuringThreadCount", 1);
+assertEq(gcparam("tenuringThreadCount"), 1);
+fill(6);
+assertEq(tenuringThreadStats().length, 0);
+check(6);
@@ -0,0 +1,53 @@
+// |jit-test| --ion-warmup-threshold=20; --ion-offthread-compile=off
+// Test the per-script bailout report.
+
+function checkReport(report) {
+    assertEq(typeof report.invalidations, "number");
+    assertEq(typeof report.compileDelay, "number");
+    assertEq(Array.isArray(report.sites), true);
+    for (var site of report.sites) {
+        assertEq(typeof site.kind, "string");
+        assertEq(typeof site.pcOffset, "number");
+        assertEq(typeof site.line, "number");
+        assertEq(site.count > 0, true);
+        assertEq(typeof site.licmDisabled, "boolean");
+    }
+}
+
+function noBailouts(x) {
+    return x + 1;
+}
+for (var i = 0; i < 100; i++) {
+    noBailouts(i);
+}
+var report = bailoutReport(noBailouts);
+checkReport(report);
+assertEq(report.invalidations, 0);
+assertEq(report.compileDelay, 0);
+assertEq(report.sites.length, 0);
+
+// Keep bailing out of Ion code so that the script (or the script it's inlined
+// into) is invalidated and recompiled a few times.
+function alwaysBails(x) {
+    bailout();
+    return x + 1;
+}
+var sum = 0;
+for (var i = 0; i < 5000; i++) {
+    sum += alwaysBails(i);
+}
+assertEq(sum, 12502500);
+
+report = bailoutReport(alwaysBails);
+checkReport(report);
+if (getJitCompilerOptions()["ion.enable"]) {
+    assertEq(report.sites.length > 0, true);
+}
+
+var threw = false;
+try {
+    bailoutReport();
+} catch (e) {
+    threw = true;
+}
+assertEq(threw, true);
@@ -0,0 +1,74 @@
+// |jit-test| --jit-code-budget=1; --baseline-warmup-threshold=1; --ion-warmup-threshold=50
+// Zones over their JIT code budget discard the code of cold scripts when a GC
+// preserves JIT code. Scripts must keep working after their code is thrown
+// away, including ones that are on the stack.
+
+// The top-level script has no loops, so it stays in the interpreter and has
+// no JIT code on the stack when it calls gc() below.
+var stats = jitCodeStats();
+["ion", "baseline", "regexp", "other", "pools"].forEach(kind => {
+    assertEq(typeof stats[kind], "number");
+});
+assertEq(stats.budget, 1024);
+
+// Without this, GCs only preserve code when called from JIT code, and then
+// the zone's code is discarded regardless of the budget.
+gcPreserveCode();
+
+function codeBytes() {
+    var stats = jitCodeStats();
+    return stats.ion + stats.baseline;
+}
+
+var funs = Array.from({length: 100},
+                      (_, i) => new Function("x", "return x + " + i + ";"));
+
+function runAll() {
+    for (var i = 0; i < funs.length; i++) {
+        for (var j = 0; j < 100; j++) {
+            assertEq(funs[i](j), j + i);
+        }
+    }
+}
+
+runAll();
+var warm = codeBytes();
+
+// The scripts ran since the last GC, so the first GC only ages them. The second
+// one finds them cold and discards code until the zone is back under budget.
+gc();
+gc();
+var cold = codeBytes();
+if (warm > stats.budget) {
+    assertEq(cold < warm, true);
+}
+
+// Cold code can be recompiled.
+runAll();
+warm = codeBytes();
+
+// Shrinking GCs don't preserve code, so they discard all of it whatever the
+// budget.
+gc(null, "shrinking");
+if (warm > 0) {
+    assertEq(codeBytes() < warm, true);
+}
+runAll();
+
+// A script that's on the stack keeps its code.
+function collect(n) {
+    for (var i = 0; i < n; i++) {
+        gc();
+    }
+}
+function active(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        sum += i;
+        if (i % 1000 === 0) {
+            collect(2);
+        }
+    }
+    return sum;
+}
+assertEq(active(5000), 12497500);
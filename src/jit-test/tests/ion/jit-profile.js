@@ -0,0 +1,106 @@
+// Test saving and loading JIT warm-up profiles.
+
+// The loop count and the first |hot| call that also calls |callee| are
+// globals, so that the same source can define the functions without running
+// them.
+function makeSource(increment) {
+    return `
+function callee(x) {
+    return x;
+}
+function hot(x) {
+    if (x >= calleeFrom)
+        callee(x);
+    return x + ${increment};
+}
+for (var i = 0; i < iterations; i++) {
+    hot(i);
+}
+`;
+}
+const source = makeSource(1);
+
+// |callee| is only called once, from a call IC in |hot| that has a single
+// target, so its entry in the profile comes from being a call target rather
+// than from its warm-up count.
+var iterations = 200;
+var calleeFrom = iterations - 1;
+evaluate(source, {fileName: "jit-profile-source.js"});
+const hotCount = getWarmUpCount(hot);
+assertEq(hotCount >= iterations, true);
+
+let profile = saveJitProfile();
+assertEq(profile instanceof Uint8Array, true);
+assertEq(profile.length >= 12, true);
+assertEq(profile.length % 4, 0);
+
+// A script gets its profiled warm-up count when its JitScript is created.
+const options = getJitCompilerOptions();
+const jitScriptTrigger = options["blinterp.enable"]
+                         ? options["blinterp.warmup.trigger"]
+                         : options["baseline.warmup.trigger"];
+const jitEnabled = options["blinterp.enable"] || options["baseline.enable"];
+
+function runInNewGlobal(increment = 1) {
+    let g = newGlobal();
+    g.iterations = 0;
+    g.calleeFrom = 0;
+    g.evaluate(makeSource(increment), {fileName: "jit-profile-source.js"});
+    for (let i = 0; i <= jitScriptTrigger; i++)
+        assertEq(g.hot(i), i + increment);
+    return {hot: g.evaluate("getWarmUpCount(hot)"),
+            callee: g.evaluate("getWarmUpCount(callee)")};
+}
+
+// A call target is seeded past the Baseline threshold, so that it has
+// Baseline code when its callers are trial-inlined.
+const baselineTrigger = options["baseline.warmup.trigger"];
+loadJitProfile(profile);
+let seeded = runInNewGlobal();
+if (jitEnabled) {
+    assertEq(seeded.hot >= hotCount, true);
+    assertEq(seeded.callee > baselineTrigger, true);
+}
+
+// A script whose text changed doesn't use the profile, even though its source
+// has the same length and the script has the same position.
+assertEq(makeSource(2).length, source.length);
+assertEq(runInNewGlobal(2).hot < hotCount, true);
+
+// Without a profile, the same script starts cold.
+clearJitProfile();
+let cold = runInNewGlobal();
+assertEq(cold.hot < hotCount, true);
+if (options["blinterp.enable"] && jitScriptTrigger < baselineTrigger)
+    assertEq(cold.callee <= baselineTrigger, true);
+
+// A saved profile can be loaded again.
+loadJitProfile(saveJitProfile());
+clearJitProfile();
+
+// Malformed profiles are rejected.
+function assertBadProfile(bytes) {
+    let threw = false;
+    try {
+        loadJitProfile(bytes);
+    } catch (e) {
+        assertEq(e instanceof InternalError, true);
+        threw = true;
+    }
+    assertEq(threw, true);
+}
+assertBadProfile(new Uint8Array(0));
+assertBadProfile(new Uint8Array(12));
+assertBadProfile(profile.slice(0, profile.length - 1));
+
+let wrongCount = profile.slice();
+new DataView(wrongCount.buffer).setUint32(8, 0xffffffff);
+assertBadProfile(wrongCount);
+
+let threw = false;
+try {
+    loadJitProfile([1, 2, 3]);
+} catch (e) {
+    threw = true;
+}
+assertEq(threw, true);
@@ -0,0 +1,44 @@
+// |jit-test| --ion-regalloc=fast; --ion-eager; --ion-offthread-compile=off
+// Test code compiled with the fast register allocator, which spills values
+// that the backtracking allocator would keep in registers.
+
+function manyLiveValues(a, b) {
+    var x0 = a + 1, x1 = a + 2, x2 = a + 3, x3 = a + 4, x4 = a + 5;
+    var x5 = b * 2, x6 = b * 3, x7 = b * 4, x8 = b * 5, x9 = b * 6;
+    var y0 = a / 2, y1 = a / 3, y2 = b / 4, y3 = b / 5;
+    var sum = 0;
+    for (var i = 0; i < 10; i++) {
+        sum += x0 * i + x1 - x2 + x3 * x4 - x5 + x6 - x7 + x8 - x9;
+        sum += Math.floor(y0 + y1 + y2 + y3);
+    }
+    return sum + x0 + x9 + y0 + y3;
+}
+
+function calls(arr) {
+    var a = arr[0], b = arr[1], c = arr[2];
+    var r = Math.max(a, b) + Math.min(b, c);
+    r += String(a).length + String(c).length;
+    return r + a + b + c;
+}
+
+var expectedLive = [];
+for (var i = 0; i < 10; i++) {
+    var a = i, b = 10 - i;
+    var x0 = a + 1, x1 = a + 2, x2 = a + 3, x3 = a + 4, x4 = a + 5;
+    var x5 = b * 2, x6 = b * 3, x7 = b * 4, x8 = b * 5, x9 = b * 6;
+    var y0 = a / 2, y1 = a / 3, y2 = b / 4, y3 = b / 5;
+    var sum = 0;
+    for (var j = 0; j < 10; j++) {
+        sum += x0 * j + x1 - x2 + x3 * x4 - x5 + x6 - x7 + x8 - x9;
+        sum += Math.floor(y0 + y1 + y2 + y3);
+    }
+    expectedLive.push(sum + x0 + x9 + y0 + y3);
+}
+
+for (var n = 0; n < 50; n++) {
+    for (var i = 0; i < 10; i++) {
+        assertEq(manyLiveValues(i, 10 - i), expectedLive[i]);
+    }
+    assertEq(calls([1, 20, 300]), 20 + 20 + 1 + 3 + (1 + 20 + 300));
+    assertEq(calls([1.5, -2, 7]), 1.5 + -2 + 3 + 1 + (1.5 + -2 + 7));
+}
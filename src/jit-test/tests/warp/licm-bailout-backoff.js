@@ -0,0 +1,81 @@
+// |jit-test| --ion-warmup-threshold=20; --ion-offthread-compile=off
+// Test that frequent bailouts from instructions hoisted out of a loop disable
+// LICM for that loop only, and that recompiling a script that keeps being
+// invalidated because of frequent bailouts backs off exponentially.
+
+function make(v) {
+    return {a: v, b: v, c: v, d: v};
+}
+
+function loops(o, n, which) {
+    var s = 0;
+    for (var i = 0; i < n; i++) {
+        if (which === 0) {
+            s += o.a;
+        }
+    }
+    for (var i = 0; i < n; i++) {
+        if (which === 1) {
+            s += o.b;
+        }
+    }
+    for (var i = 0; i < n; i++) {
+        if (which === 2) {
+            s += o.c;
+        }
+    }
+    for (var i = 0; i < n; i++) {
+        if (which === 3) {
+            s += o.d;
+        }
+    }
+    return s;
+}
+
+// Warm up with int32 properties, taking every branch.
+for (var i = 0; i < 200; i++) {
+    assertEq(loops(make(1), 10, i % 4), 10);
+}
+
+// The properties are now strings, but none of the branches using them are
+// taken. The unboxes hoisted out of the first loop fail every time. Once LICM
+// is disabled for it, the ones hoisted out of the second loop fail, and so on.
+var invalidations = 0;
+var delays = [];
+for (var i = 0; i < 2000; i++) {
+    assertEq(loops(make("x"), 10, -1), 0);
+
+    var report = bailoutReport(loops);
+    if (report.invalidations !== invalidations) {
+        assertEq(report.invalidations, invalidations + 1);
+        invalidations = report.invalidations;
+
+        // No compilation has been attempted since the invalidation.
+        delays.push(report.compileDelay);
+    }
+}
+
+// Per-loop LICM disabling is only done for WarpBuilder.
+var options = getJitCompilerOptions();
+if (!options["ion.enable"] || !options["warp.enable"]) {
+    quit();
+}
+
+// Each loop was invalidated once. The first invalidation recompiles right
+// away, and each of the following ones doubles the number of compilation
+// attempts that are skipped.
+assertEq(invalidations, 4);
+assertEq(delays.toString(), "0,1,3,7");
+
+// Every skipped attempt has happened by now.
+report = bailoutReport(loops);
+assertEq(report.compileDelay, 0);
+
+var disabled = report.sites.filter(site => site.licmDisabled);
+assertEq(disabled.length, 4);
+var lines = new Set();
+for (var site of disabled) {
+    assertEq(site.kind, "BailoutKind::LICM");
+    lines.add(site.line);
+}
+assertEq(lines.size, 4);
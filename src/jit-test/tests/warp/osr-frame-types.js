@@ -0,0 +1,66 @@
+// |jit-test| --ion-warmup-threshold=50; --ion-osr=on; --ion-offthread-compile=off
+// OSR phis are specialized on the types of the frame we OSR into. Entering
+// the same loop with different types must bail out and produce the right
+// results.
+
+function sum(start, n) {
+    var acc = start;
+    for (var i = 0; i < n; i++) {
+        acc += 1;
+    }
+    return acc;
+}
+
+// The code before the loop sees an int32, but the accumulator is a double by
+// the time we OSR.
+function doubleAcc(n) {
+    var acc = 0;
+    var x = 0;
+    for (var i = 0; i < n; i++) {
+        if (i === 10) {
+            x = 0.5;
+        }
+        acc += x;
+    }
+    return acc;
+}
+
+for (var j = 0; j < 5; j++) {
+    assertEq(sum(0, 2000), 2000);
+    assertEq(sum(0.5, 2000), 2000.5);
+    assertEq(sum("a", 3), "a111");
+    assertEq(doubleAcc(2000), 995);
+}
+
+// Top-level loop whose live values change types between entries.
+var results = [];
+for (var k = 0; k < 3; k++) {
+    var v = [0, 0.25, "s"][k];
+    for (var i = 0; i < 1500; i++) {
+        v = v + (typeof v === "string" ? "" : 1);
+    }
+    results.push(v);
+}
+assertEq(results[0], 1500);
+assertEq(results[1], 1500.25);
+assertEq(results[2], "s");
+
+// A single long-running call OSRs into the loop, and the OSR block is
+// specialized on the frame's types: the double accumulator and the int32
+// induction variable. Make sure the call doesn't compile at entry instead.
+setJitCompilerOption("ion.warmup.trigger", 50);
+function longLoop(n) {
+    var acc = 0.5;
+    for (var i = 0; i < n; i++) {
+        acc += 1;
+    }
+    return acc;
+}
+assertEq(longLoop(100000), 100000.5);
+
+var options = getJitCompilerOptions();
+if (options["ion.enable"] && options["warp.enable"]) {
+    var info = osrEntryInfo(longLoop);
+    assertEq(info.osr, true);
+    assertEq(info.specializedValues >= 2, true);
+}
@@ -0,0 +1,109 @@
+// |jit-test| --ion-warmup-threshold=50
+// Scalar replacement of array iterators, iterator result objects and rest
+// arrays. The results must be correct whether or not the allocations are
+// removed, including across bailouts.
+
+// IonBuilder doesn't remove the guards around these allocations, so only check
+// whether they are recovered when compiling with Warp.
+if (!getJitCompilerOptions()["warp.enable"]) {
+    assertRecoveredOnBailout = function() {};
+}
+
+// Prevent the GC from cancelling Ion compilations, when we expect them to succeed
+gczeal(0);
+
+var escaped = [];
+
+function sumIterator(arr) {
+    var it = arr[Symbol.iterator]();
+    var r1 = it.next();
+    var r2 = it.next();
+    assertRecoveredOnBailout(it, true);
+    assertRecoveredOnBailout(r1, true);
+    assertRecoveredOnBailout(r2, true);
+    return r1.value + r2.value;
+}
+
+function sumIteratorEscape(arr) {
+    var it = arr[Symbol.iterator]();
+    var r1 = it.next();
+    escaped[0] = it;
+    escaped[1] = r1;
+    var r2 = it.next();
+    assertRecoveredOnBailout(it, false);
+    assertRecoveredOnBailout(r1, false);
+    return r1.value + r2.value;
+}
+
+function sumDestructure(arr) {
+    var [a, b, c] = arr;
+    return a + b + c;
+}
+
+function rest(...args) {
+    assertRecoveredOnBailout(args, true);
+    return args[0] + args[1] + args.length;
+}
+function sumRest(i) {
+    return rest(i, 1);
+}
+
+function restEscape(...args) {
+    escaped[0] = args;
+    assertRecoveredOnBailout(args, false);
+    return args[0] + args[1] + args.length;
+}
+function sumRestEscape(i) {
+    return restEscape(i, 1);
+}
+
+var arr = [1, 2, 3, 4];
+for (var i = 0; i < 2000; i++) {
+    assertEq(sumIterator(arr), 3);
+    assertEq(sumIteratorEscape(arr), 3);
+    assertEq(sumDestructure(arr), 6);
+    assertEq(sumRest(i), i + 3);
+    assertEq(sumRestEscape(i), i + 3);
+}
+
+// Bail out in the middle of a loop: the iterator's state has to be recovered.
+function forOfBailout(arr, n) {
+    var sum = 0;
+    for (var x of arr) {
+        if (x === n) {
+            bailout();
+        }
+        sum += x;
+    }
+    return sum;
+}
+for (var i = 0; i < 2000; i++) {
+    assertEq(forOfBailout(arr, i & 7), 10);
+}
+
+// Bail out between two calls to next(): the second result has to come from
+// the recovered iterator.
+function nextBailout(arr, i) {
+    var it = arr[Symbol.iterator]();
+    var r1 = it.next();
+    if (i > 1900) {
+        bailout();
+    }
+    var r2 = it.next();
+    assertRecoveredOnBailout(it, true);
+    return r1.value * 10 + r2.value;
+}
+for (var i = 0; i < 2000; i++) {
+    assertEq(nextBailout(arr, i), 12);
+}
+
+// Non-array iterables and holey arrays must still work.
+var holey = [1, , 3];
+for (var i = 0; i < 2000; i++) {
+    var s = 0;
+    for (var x of holey) {
+        s += x === undefined ? 100 : x;
+    }
+    assertEq(s, 104);
+    assertEq(sumDestructure("abc"), "abc");
+}
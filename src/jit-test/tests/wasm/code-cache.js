@@ -0,0 +1,43 @@
+// |jit-test| --wasm-code-cache-temp; skip-if: !wasmCachingIsSupported() || !wasmCodeCacheStats().enabled
+
+// Modules compiled with --wasm-code-cache are stored on disk once their
+// optimized tier is done, and loaded from disk by later compilations of the
+// same bytecode.
+
+// --wasm-code-cache-temp gives this run its own empty cache directory, which
+// is removed when the shell exits.
+const code = wasmTextToBinary(`(module
+    (func (export "run") (param i32) (result i32)
+        local.get 0
+        i32.const 12345
+        i32.add
+    )
+)`);
+
+function waitForTier2(m) {
+    while (!wasmHasTier2CompilationCompleted(m))
+        sleep(1);
+}
+
+let before = wasmCodeCacheStats();
+
+let m1 = new WebAssembly.Module(code);
+assertEq(wasmLoadedFromCache(m1), false);
+let expected = new WebAssembly.Instance(m1).exports.run(42);
+waitForTier2(m1);
+
+let afterStore = wasmCodeCacheStats();
+assertEq(before.hits, 0);
+assertEq(afterStore.misses, before.misses + 1);
+assertEq(afterStore.stores, before.stores + 1);
+
+let m2 = new WebAssembly.Module(code);
+assertEq(wasmLoadedFromCache(m2), true);
+assertEq(new WebAssembly.Instance(m2).exports.run(42), expected);
+assertEq(wasmCodeCacheStats().hits, afterStore.hits + 1);
+
+// Different bytecode doesn't hit.
+let m3 = new WebAssembly.Module(wasmTextToBinary(`(module
+    (func (export "run") (result i32) i32.const ${expected}))`));
+assertEq(wasmLoadedFromCache(m3), false);
+assertEq(new WebAssembly.Instance(m3).exports.run(), expected);
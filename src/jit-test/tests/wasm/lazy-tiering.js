@@ -0,0 +1,106 @@
+// |jit-test| skip-if: !wasmCompileMode().match("\\+") || helperThreadCount() === 0
+
+// With wasm.tier-up-threshold, tiered modules only get optimized code once a
+// function is hot, and then only for the functions that have run enough in
+// baseline code. The other functions keep running their baseline code until
+// they get hot too, and are then optimized in a later batch.
+
+setJitCompilerOption('wasm.tier-up-threshold', 10000);
+// Tiering is only used for large modules, unless it is forced.
+setJitCompilerOption('wasm.delay-tier2', 1);
+
+const numCold = 20;
+
+let text = `(module
+  (func $hot (export "hot") (param $n i32) (result i32) (local $acc i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.eqz (local.get $n)))
+        (local.set $acc (i32.add (i32.mul (local.get $acc) (i32.const 31))
+                                 (local.get $n)))
+        (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+        (br $loop)))
+    (local.get $acc))
+`;
+for (let i = 0; i < numCold; i++) {
+    text += `  (func (export "cold${i}") (param i32) (result i32)
+    (i32.add (call $hot (local.get 0)) (i32.const ${i})))
+`;
+}
+text += `)`;
+
+function hot(n) {
+    let acc = 0;
+    for (; n != 0; n--)
+        acc = (Math.imul(acc, 31) + n) | 0;
+    return acc;
+}
+
+function waitForBatch(stats, f) {
+    while (wasmLazyTieringStats().finished == stats.finished) {
+        f();
+        sleep(0.01);
+    }
+    return wasmLazyTieringStats();
+}
+
+const before = wasmLazyTieringStats();
+const e = new WebAssembly.Instance(new WebAssembly.Module(wasmTextToBinary(text))).exports;
+
+for (let i = 0; i < numCold; i++)
+    assertEq(e[`cold${i}`](5), hot(5) + i);
+
+const after = waitForBatch(before, () => assertEq(e.hot(1000), hot(1000)));
+assertEq(after.started, before.started + 1);
+assertEq(after.hotFuncs > before.hotFuncs, true);
+assertEq(after.optimizedFuncs - before.optimizedFuncs, 1);
+assertEq(after.forwardedFuncs - before.forwardedFuncs, numCold);
+assertEq(after.forwardedBytes > before.forwardedBytes, true);
+
+// The hot function now runs optimized code, the cold ones still run their
+// baseline code, called through the optimized tier's tables.
+assertEq(e.hot(100000), hot(100000));
+for (let i = 0; i < numCold; i++)
+    assertEq(e[`cold${i}`](7), hot(7) + i);
+
+// Functions are counted on entry too, so calling cold0 more times than the
+// threshold makes it hot. It goes in a second batch of its own, and is then
+// no longer left in baseline code.
+const after2 = waitForBatch(after, () => {
+    for (let i = 0; i < 1000; i++)
+        assertEq(e.cold0(3), hot(3));
+});
+assertEq(after2.started, after.started + 1);
+assertEq(after2.optimizedFuncs - after.optimizedFuncs, 1);
+assertEq(after2.forwardedFuncs - before.forwardedFuncs, numCold - 1);
+
+// Both batches' code and the remaining baseline code call each other.
+assertEq(e.hot(100000), hot(100000));
+for (let i = 0; i < numCold; i++)
+    assertEq(e[`cold${i}`](7), hot(7) + i);
+
+// A module only gets a limited number of batches, as each has stubs and
+// metadata for the whole module. The last one takes every function that is
+// left, however cold.
+assertEq(numCold > before.maxBatches, true);
+let last = after2;
+for (let i = 1; last.finished - before.finished < before.maxBatches; i++) {
+    last = waitForBatch(last, () => {
+        for (let j = 0; j < 1000; j++)
+            assertEq(e[`cold${i}`](3), hot(3) + i);
+    });
+}
+assertEq(last.started - before.started, before.maxBatches);
+assertEq(last.optimizedFuncs - before.optimizedFuncs, numCold + 1);
+assertEq(last.forwardedFuncs, before.forwardedFuncs);
+assertEq(last.failed, before.failed);
+
+// No further batches are started.
+for (let i = 0; i < numCold; i++) {
+    for (let j = 0; j < 1000; j++)
+        assertEq(e[`cold${i}`](7), hot(7) + i);
+}
+assertEq(wasmLazyTieringStats().started, last.started);
+
+setJitCompilerOption('wasm.delay-tier2', 0);
+setJitCompilerOption('wasm.tier-up-threshold', 0);
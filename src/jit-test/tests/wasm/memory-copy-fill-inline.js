@@ -0,0 +1,180 @@
+// memory.copy and memory.fill with a constant length are compiled inline, with
+// 16-byte accesses when SIMD is available.  Check them against a reference
+// implementation, including overlapping copies, fills with a non-constant
+// value and out-of-bounds accesses, which must trap without writing anything.
+//
+// This is also a benchmark of the inline code against the instance call that
+// non-constant lengths use:
+//
+//   js --wasm-compiler=ion -e 'var memBenchIterations = 200' memory-copy-fill-inline.js
+//
+// prints the time taken by each version of the benchmark below and the
+// speedup.
+
+const iterations = typeof memBenchIterations == "number" ? memBenchIterations : 1;
+const pageSize = 65536;
+
+const lengths = [1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 24, 31, 32, 33, 48, 63, 64,
+                 65, 100, 127, 128, 129, 200, 255, 256, 257, 300];
+
+function makeModule(len) {
+    return new WebAssembly.Instance(new WebAssembly.Module(wasmTextToBinary(`
+(module
+  (memory (export "mem") 1)
+  (func (export "copy") (param $dst i32) (param $src i32)
+    (memory.copy (local.get $dst) (local.get $src) (i32.const ${len})))
+  (func (export "fill") (param $dst i32)
+    (memory.fill (local.get $dst) (i32.const 0xa5) (i32.const ${len})))
+  (func (export "fillValue") (param $dst i32) (param $val i32)
+    (memory.fill (local.get $dst) (local.get $val) (i32.const ${len}))))`)));
+}
+
+function reset(mem) {
+    let u8 = new Uint8Array(mem.buffer);
+    for (let i = 0; i < u8.length; i++)
+        u8[i] = (i * 7 + 3) & 255;
+    return u8;
+}
+
+function assertSameBytes(actual, expected) {
+    assertEq(actual.length, expected.length);
+    for (let i = 0; i < actual.length; i++)
+        assertEq(actual[i], expected[i]);
+}
+
+function checkTrap(f) {
+    assertErrorMessage(f, WebAssembly.RuntimeError, /index out of bounds/);
+}
+
+for (let len of lengths) {
+    let {mem, copy, fill, fillValue} = makeModule(len).exports;
+
+    // Disjoint and overlapping copies, in both directions.
+    for (let [dst, src] of [[1000, 3], [500, 500], [100, 100 + (len >> 1)],
+                            [100 + (len >> 1), 100], [pageSize - len, 0],
+                            [0, pageSize - len]]) {
+        let u8 = reset(mem);
+        let expected = u8.slice();
+        expected.copyWithin(dst, src, src + len);
+        copy(dst, src);
+        assertSameBytes(u8, expected);
+    }
+
+    // Fills with a constant value and with values whose high bits must be
+    // ignored.
+    for (let [dst, val] of [[7, 0xa5], [pageSize - len, 0xa5], [33, 0],
+                            [33, 0x1ff], [40, -1], [64, 0x12345678]]) {
+        let u8 = reset(mem);
+        let expected = u8.slice();
+        expected.fill(val & 255, dst, dst + len);
+        if (val == 0xa5)
+            fill(dst);
+        else
+            fillValue(dst, val);
+        assertSameBytes(u8, expected);
+    }
+
+    // Out of bounds by one byte, and entirely out of bounds.
+    for (let [dst, src] of [[pageSize - len + 1, 0], [0, pageSize - len + 1],
+                            [pageSize, 0], [0, -1]]) {
+        let u8 = reset(mem);
+        let expected = u8.slice();
+        checkTrap(() => copy(dst, src));
+        assertSameBytes(u8, expected);
+    }
+    for (let dst of [pageSize - len + 1, pageSize, -1]) {
+        let u8 = reset(mem);
+        let expected = u8.slice();
+        checkTrap(() => fill(dst));
+        checkTrap(() => fillValue(dst, 0x5a));
+        assertSameBytes(u8, expected);
+    }
+}
+
+// The benchmark is what clang makes of this C code, with -mbulk-memory:
+//
+//   struct Particle { float pos[4], vel[4], color[4], extra[4]; };
+//
+//   void snapshot(struct Particle* out, const struct Particle* in, int n) {
+//     for (int i = 0; i < n; i++)
+//       out[i] = in[i];
+//   }
+//
+//   void reset(struct Particle* p, int n) {
+//     for (int i = 0; i < n; i++)
+//       memset(&p[i], 0, sizeof(p[i]));
+//   }
+//
+// The "call" versions pass the struct size as an argument, as if it weren't
+// known at compile time, so they use the instance call.
+
+const numParticles = 4096;
+const particleSize = 64;
+const IN = 0;
+const OUT = numParticles * particleSize;
+
+let bench = new WebAssembly.Instance(new WebAssembly.Module(wasmTextToBinary(`
+(module
+  (memory (export "mem") 8)
+  (func (export "snapshot_inline") (param $out i32) (param $in i32) (param $n i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.eqz (local.get $n)))
+        (memory.copy (local.get $out) (local.get $in) (i32.const ${particleSize}))
+        (local.set $out (i32.add (local.get $out) (i32.const ${particleSize})))
+        (local.set $in (i32.add (local.get $in) (i32.const ${particleSize})))
+        (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+        (br $loop))))
+  (func (export "snapshot_call") (param $out i32) (param $in i32) (param $n i32)
+                                 (param $size i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.eqz (local.get $n)))
+        (memory.copy (local.get $out) (local.get $in) (local.get $size))
+        (local.set $out (i32.add (local.get $out) (local.get $size)))
+        (local.set $in (i32.add (local.get $in) (local.get $size)))
+        (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+        (br $loop))))
+  (func (export "reset_inline") (param $p i32) (param $n i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.eqz (local.get $n)))
+        (memory.fill (local.get $p) (i32.const 0) (i32.const ${particleSize}))
+        (local.set $p (i32.add (local.get $p) (i32.const ${particleSize})))
+        (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+        (br $loop))))
+  (func (export "reset_call") (param $p i32) (param $n i32) (param $size i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.eqz (local.get $n)))
+        (memory.fill (local.get $p) (i32.const 0) (local.get $size))
+        (local.set $p (i32.add (local.get $p) (local.get $size)))
+        (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+        (br $loop)))))`))).exports;
+
+function time(f) {
+    let start = performance.now();
+    for (let i = 0; i < iterations; i++)
+        f();
+    return performance.now() - start;
+}
+
+function report(name, callMs, inlineMs) {
+    if (iterations > 1) {
+        print(`${name}: call ${callMs.toFixed(1)}ms, ` +
+              `inline ${inlineMs.toFixed(1)}ms, ` +
+              `speedup ${(callMs / inlineMs).toFixed(2)}x`);
+    }
+}
+
+let u8 = reset(bench.mem);
+report("snapshot",
+       time(() => bench.snapshot_call(OUT, IN, numParticles, particleSize)),
+       time(() => bench.snapshot_inline(OUT, IN, numParticles)));
+assertSameBytes(u8.subarray(OUT, 2 * OUT), u8.subarray(IN, OUT));
+
+report("reset",
+       time(() => bench.reset_call(OUT, numParticles, particleSize)),
+       time(() => bench.reset_inline(IN, numParticles)));
+assertSameBytes(u8.subarray(OUT, 2 * OUT), u8.subarray(IN, OUT));
+assertEq(u8.subarray(IN, OUT).every(b => b == 0), true);
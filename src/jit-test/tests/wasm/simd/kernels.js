@@ -0,0 +1,201 @@
+// Image-processing style kernels, each written with scalar code and with
+// SIMD128 code.  As a test, this checks that both versions compute the same
+// result.  It's also a benchmark of the SIMD code against the scalar code:
+//
+//   js --wasm-compiler=ion -e 'var kernelIterations = 500' kernels.js
+//
+// prints the time taken by each version and the speedup.
+
+const iterations = typeof kernelIterations == "number" ? kernelIterations : 1;
+const size = 1 << 16;
+
+const SRC = 0;
+const SRC2 = size;
+const DST = 2 * size;
+const DST2 = 3 * size;
+
+let ins = new WebAssembly.Instance(new WebAssembly.Module(wasmTextToBinary(`
+(module
+  (memory (export "mem") 4)
+
+  ;; dst[i] = min(src[i] + k, 255)
+
+  (func (export "brighten_scalar")
+        (param $src i32) (param $dst i32) (param $n i32) (param $k i32)
+    (local $i i32) (local $v i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (local.get $i) (local.get $n)))
+        (local.set $v (i32.add (i32.load8_u (i32.add (local.get $src)
+                                                     (local.get $i)))
+                               (local.get $k)))
+        (i32.store8 (i32.add (local.get $dst) (local.get $i))
+                    (select (i32.const 255) (local.get $v)
+                            (i32.gt_u (local.get $v) (i32.const 255))))
+        (local.set $i (i32.add (local.get $i) (i32.const 1)))
+        (br $loop))))
+
+  (func (export "brighten_simd")
+        (param $src i32) (param $dst i32) (param $n i32) (param $k i32)
+    (local $i i32) (local $kv v128)
+    (local.set $kv (i8x16.splat (local.get $k)))
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (local.get $i) (local.get $n)))
+        (v128.store (i32.add (local.get $dst) (local.get $i))
+          (i8x16.add_saturate_u
+            (v128.load (i32.add (local.get $src) (local.get $i)))
+            (local.get $kv)))
+        (local.set $i (i32.add (local.get $i) (i32.const 16)))
+        (br $loop))))
+
+  ;; dst[i] = (a[i] * alpha + b[i] * (256 - alpha)) >> 8, 0 <= alpha <= 256
+
+  (func (export "blend_scalar")
+        (param $a i32) (param $b i32) (param $dst i32) (param $n i32)
+        (param $alpha i32)
+    (local $i i32) (local $inv i32)
+    (local.set $inv (i32.sub (i32.const 256) (local.get $alpha)))
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (local.get $i) (local.get $n)))
+        (i32.store8 (i32.add (local.get $dst) (local.get $i))
+          (i32.shr_u
+            (i32.add
+              (i32.mul (i32.load8_u (i32.add (local.get $a) (local.get $i)))
+                       (local.get $alpha))
+              (i32.mul (i32.load8_u (i32.add (local.get $b) (local.get $i)))
+                       (local.get $inv)))
+            (i32.const 8)))
+        (local.set $i (i32.add (local.get $i) (i32.const 1)))
+        (br $loop))))
+
+  (func (export "blend_simd")
+        (param $a i32) (param $b i32) (param $dst i32) (param $n i32)
+        (param $alpha i32)
+    (local $i i32) (local $va v128) (local $vb v128)
+    (local $alphav v128) (local $invv v128)
+    (local.set $alphav (i16x8.splat (local.get $alpha)))
+    (local.set $invv (i16x8.splat (i32.sub (i32.const 256)
+                                           (local.get $alpha))))
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (local.get $i) (local.get $n)))
+        (local.set $va (v128.load (i32.add (local.get $a) (local.get $i))))
+        (local.set $vb (v128.load (i32.add (local.get $b) (local.get $i))))
+        (v128.store (i32.add (local.get $dst) (local.get $i))
+          (i8x16.narrow_i16x8_u
+            (i16x8.shr_u
+              (i16x8.add
+                (i16x8.mul (i16x8.widen_low_i8x16_u (local.get $va))
+                           (local.get $alphav))
+                (i16x8.mul (i16x8.widen_low_i8x16_u (local.get $vb))
+                           (local.get $invv)))
+              (i32.const 8))
+            (i16x8.shr_u
+              (i16x8.add
+                (i16x8.mul (i16x8.widen_high_i8x16_u (local.get $va))
+                           (local.get $alphav))
+                (i16x8.mul (i16x8.widen_high_i8x16_u (local.get $vb))
+                           (local.get $invv)))
+              (i32.const 8))))
+        (local.set $i (i32.add (local.get $i) (i32.const 16)))
+        (br $loop))))
+
+  ;; y[i] = a * x[i] + y[i] on f32 data, n is a byte count
+
+  (func (export "saxpy_scalar")
+        (param $x i32) (param $y i32) (param $n i32) (param $a f32)
+    (local $i i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (local.get $i) (local.get $n)))
+        (f32.store (i32.add (local.get $y) (local.get $i))
+          (f32.add
+            (f32.mul (local.get $a)
+                     (f32.load (i32.add (local.get $x) (local.get $i))))
+            (f32.load (i32.add (local.get $y) (local.get $i)))))
+        (local.set $i (i32.add (local.get $i) (i32.const 4)))
+        (br $loop))))
+
+  (func (export "saxpy_simd")
+        (param $x i32) (param $y i32) (param $n i32) (param $a f32)
+    (local $i i32) (local $av v128)
+    (local.set $av (f32x4.splat (local.get $a)))
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (local.get $i) (local.get $n)))
+        (v128.store (i32.add (local.get $y) (local.get $i))
+          (f32x4.add
+            (f32x4.mul (local.get $av)
+                       (v128.load (i32.add (local.get $x) (local.get $i))))
+            (v128.load (i32.add (local.get $y) (local.get $i)))))
+        (local.set $i (i32.add (local.get $i) (i32.const 16)))
+        (br $loop))))
+)`)));
+
+const {mem} = ins.exports;
+
+function random(seed) {
+    return () => (seed = (Math.imul(seed, 1103515245) + 12345) | 0) >>> 24;
+}
+
+function fillBytes() {
+    let next = random(12345);
+    let u8 = new Uint8Array(mem.buffer, 0, 2 * size);
+    for (let i = 0; i < u8.length; i++)
+        u8[i] = next();
+}
+
+function fillFloats() {
+    // Keep the data finite and away from denormals.
+    let next = random(54321);
+    let f32 = new Float32Array(mem.buffer, 0, (2 * size) >> 2);
+    for (let i = 0; i < f32.length; i++)
+        f32[i] = (next() - 128) / 16;
+}
+
+function assertSameBytes(start1, start2, length) {
+    let a = new Uint8Array(mem.buffer, start1, length);
+    let b = new Uint8Array(mem.buffer, start2, length);
+    for (let i = 0; i < length; i++)
+        assertEq(a[i], b[i]);
+}
+
+function time(f) {
+    let start = performance.now();
+    for (let i = 0; i < iterations; i++)
+        f();
+    return performance.now() - start;
+}
+
+function report(name, scalarMs, simdMs) {
+    if (iterations > 1) {
+        print(`${name}: scalar ${scalarMs.toFixed(1)}ms, ` +
+              `simd ${simdMs.toFixed(1)}ms, ` +
+              `speedup ${(scalarMs / simdMs).toFixed(2)}x`);
+    }
+}
+
+const e = ins.exports;
+
+fillBytes();
+report("brighten",
+       time(() => e.brighten_scalar(SRC, DST, size, 37)),
+       time(() => e.brighten_simd(SRC, DST2, size, 37)));
+assertSameBytes(DST, DST2, size);
+
+fillBytes();
+report("blend",
+       time(() => e.blend_scalar(SRC, SRC2, DST, size, 77)),
+       time(() => e.blend_simd(SRC, SRC2, DST2, size, 77)));
+assertSameBytes(DST, DST2, size);
+
+// saxpy accumulates into y, so run each version on its own copy of y.
+fillFloats();
+new Uint8Array(mem.buffer).copyWithin(DST, SRC2, SRC2 + size);
+new Uint8Array(mem.buffer).copyWithin(DST2, SRC2, SRC2 + size);
+report("saxpy",
+       time(() => e.saxpy_scalar(SRC, DST, size, 0.5)),
+       time(() => e.saxpy_simd(SRC, DST2, size, 0.5)));
+assertSameBytes(DST, DST2, size);
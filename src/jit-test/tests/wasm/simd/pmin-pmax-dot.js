@@ -0,0 +1,100 @@
+// Test f32x4.pmin, f32x4.pmax, f64x2.pmin, f64x2.pmax and i32x4.dot_i16x8_s.
+// These are encoded by hand since the text format may not know them yet.
+
+load(libdir + "wasm-binary.js");
+
+const LocalGetCode = 0x20;
+const V128LoadCode = 0x00;
+const V128StoreCode = 0x0b;
+const I32x4DotSI16x8Code = 0xba;
+const F32x4PMinCode = 0xea;
+const F32x4PMaxCode = 0xeb;
+const F64x2PMinCode = 0xf6;
+const F64x2PMaxCode = 0xf7;
+
+// (func (export "run") (param $dst i32) (param $a i32) (param $b i32)
+//   (v128.store (local.get $dst) (op (v128.load (local.get $a))
+//                                    (v128.load (local.get $b)))))
+// with the memory exported as "mem".
+function binop(op) {
+    let memarg = [4, 0];
+    let body = [
+        LocalGetCode, 0,
+        LocalGetCode, 1, SimdPrefix, V128LoadCode, ...memarg,
+        LocalGetCode, 2, SimdPrefix, V128LoadCode, ...memarg,
+        SimdPrefix, ...varU32(op),
+        SimdPrefix, V128StoreCode, ...memarg];
+    let exports = {
+        name: exportId,
+        body: [...varU32(2),
+               ...string("run"), FunctionCode, ...varU32(0),
+               ...string("mem"), MemoryCode, ...varU32(0)]
+    };
+    let bin = moduleWithSections([
+        sigSection([{args: [I32Code, I32Code, I32Code], ret: VoidCode}]),
+        declSection([0]),
+        memorySection(1),
+        exports,
+        bodySection([funcBody({locals: [], body})])]);
+    return new WebAssembly.Instance(new WebAssembly.Module(bin)).exports;
+}
+
+function check(op, Ty, as, bs, expectedFn) {
+    let {run, mem} = binop(op);
+    let lanes = 16 / Ty.BYTES_PER_ELEMENT;
+    for (let i = 0; i < as.length; i += lanes) {
+        let a = as.slice(i, i + lanes);
+        let b = bs.slice(i, i + lanes);
+        let view = new Ty(mem.buffer);
+        view.set(a, lanes);
+        view.set(b, 2 * lanes);
+        run(0, 16, 32);
+        let result = new Ty(mem.buffer, 0, lanes);
+        let expected = expectedFn(new Ty(a), new Ty(b));
+        for (let j = 0; j < lanes; j++)
+            assertEq(result[j], expected[j]);
+    }
+}
+
+// pmin(a, b) is b < a ? b : a and pmax(a, b) is a < b ? b : a, which differ
+// from min and max for NaNs and zeroes of different signs.
+function pmin(a, b) { return a.map((x, i) => b[i] < x ? b[i] : x); }
+function pmax(a, b) { return a.map((x, i) => x < b[i] ? b[i] : x); }
+
+let floats = [0, -0, 1, -1, 1.5, -2.5, NaN, Infinity, -Infinity, 3e38, -3e38,
+              1e-40, 7, 0, -0, NaN];
+let floats2 = [-0, 0, NaN, 1, -1.5, 2.5, 1, -Infinity, Infinity, -3e38, 3e38,
+               -1e-40, 7, NaN, NaN, 0];
+
+check(F32x4PMinCode, Float32Array, floats, floats2, pmin);
+check(F32x4PMaxCode, Float32Array, floats, floats2, pmax);
+check(F32x4PMinCode, Float32Array, floats2, floats, pmin);
+check(F32x4PMaxCode, Float32Array, floats2, floats, pmax);
+check(F64x2PMinCode, Float64Array, floats, floats2, pmin);
+check(F64x2PMaxCode, Float64Array, floats, floats2, pmax);
+check(F64x2PMinCode, Float64Array, floats2, floats, pmin);
+check(F64x2PMaxCode, Float64Array, floats2, floats, pmax);
+
+// dot_i16x8_s: lane i is a[2i]*b[2i] + a[2i+1]*b[2i+1], wrapping.
+function dot(a, b) {
+    let r = [];
+    for (let i = 0; i < 4; i++)
+        r.push((a[2 * i] * b[2 * i] + a[2 * i + 1] * b[2 * i + 1]) | 0);
+    return r;
+}
+
+let {run, mem} = binop(I32x4DotSI16x8Code);
+let shorts = [0, 1, -1, 32767, -32768, 1234, -4321, 100,
+              -32768, -32768, 32767, 32767, 7, -7, 255, -256];
+let shorts2 = [5, 1, -1, 32767, -32768, -2, 3, 100,
+               -32768, -32768, -32768, 32767, 7, 7, 255, 256];
+for (let i = 0; i < shorts.length; i += 8) {
+    let i16 = new Int16Array(mem.buffer);
+    i16.set(shorts.slice(i, i + 8), 8);
+    i16.set(shorts2.slice(i, i + 8), 16);
+    run(0, 16, 32);
+    let result = new Int32Array(mem.buffer, 0, 4);
+    let expected = dot(shorts.slice(i, i + 8), shorts2.slice(i, i + 8));
+    for (let j = 0; j < 4; j++)
+        assertEq(result[j], expected[j]);
+}
@@ -1454,8 +1454,8 @@ bool BacktrackingAllocator::processBundle(MIRGenerator* mir,
 
       // If that didn't work, but we have one or more non-fixed bundles
       // known to be conflicting, maybe we can evict them and try again.
-      if ((attempt < MAX_ATTEMPTS || minimalBundle(bundle)) && !fixed &&
-          !conflicting.empty() &&
+      if (((!fast && attempt < MAX_ATTEMPTS) || minimalBundle(bundle)) &&
+          !fixed && !conflicting.empty() &&
           maximumSpillWeight(conflicting) < computeSpillWeight(bundle)) {
         for (size_t i = 0; i < conflicting.length(); i++) {
           if (!evictBundle(conflicting[i])) {
@@ -1725,6 +1725,8 @@ bool BacktrackingAllocator::spill(LiveBundle* bundle) {
   JitSpew(JitSpew_RegAlloc, "  Spilling bundle");
   MOZ_ASSERT(bundle->allocation().isBogus());
 
+  numSpilledBundles_++;
+
   if (LiveBundle* spillParent = bundle->spillParent()) {
     JitSpew(JitSpew_RegAlloc, "    Using existing spill bundle");
     for (LiveRange::BundleLinkIterator iter = bundle->rangesBegin(); iter;
@@ -1758,8 +1760,8 @@ bool BacktrackingAllocator::tryAllocatingRegistersForSpillBundles() {
                      bundle->toString().get());
 
     // Search for any available register which the bundle can be
-    // allocated to.
-    for (size_t i = 0; i < AnyRegister::Total; i++) {
+    // allocated to. The fast allocator doesn't bother.
+    for (size_t i = 0; i < AnyRegister::Total && !fast; i++) {
       if (!tryAllocateRegister(registers[i], bundle, &success, &fixed,
                                conflicting)) {
         return false;
@@ -3443,6 +3445,14 @@ bool BacktrackingAllocator::chooseBundleSplit(LiveBundle* bundle, bool fixed,
                                               LiveBundle* conflict) {
   bool success = false;
 
+  if (fast) {
+    if (fixed) {
+      return splitAcrossCalls(bundle);
+    }
+    SplitPositionVector emptyPositions;
+    return splitAt(bundle, emptyPositions);
+  }
+
   if (!trySplitAcrossHotcode(bundle, &success)) {
     return false;
   }
@@ -541,6 +541,14 @@ class BacktrackingAllocator : protected RegisterAllocator {
   // This flag is set when testing new allocator modifications.
   bool testbed;
 
+  // This flag is set to trade allocation quality for compilation speed. Bundles
+  // that can't be allocated are split at all their register uses right away,
+  // without trying to evict other bundles or to find a better split.
+  bool fast;
+
+  // The number of bundles which were spilled to the stack.
+  size_t numSpilledBundles_;
+
   BitSet* liveIn;
   FixedList<VirtualRegister> vregs;
 
@@ -619,14 +627,18 @@ class BacktrackingAllocator : protected RegisterAllocator {
 
  public:
   BacktrackingAllocator(MIRGenerator* mir, LIRGenerator* lir, LIRGraph& graph,
-                        bool testbed)
+                        bool testbed, bool fast = false)
       : RegisterAllocator(mir, lir, graph),
         testbed(testbed),
+        fast(fast),
+        numSpilledBundles_(0),
         liveIn(nullptr),
         callRanges(nullptr) {}
 
   MOZ_MUST_USE bool go();
 
+  size_t numSpilledBundles() const { return numSpilledBundles_; }
+
   static size_t SpillWeightFromUsePolicy(LUse::Policy policy) {
     switch (policy) {
       case LUse::ANY:
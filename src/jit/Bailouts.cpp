@@ -11,6 +11,7 @@
 #include "jit/BaselineJIT.h"
 #include "jit/Ion.h"
 #include "jit/JitRealm.h"
+#include "jit/JitScript.h"
 #include "jit/JitSpewer.h"
 #include "jit/Snapshots.h"
 #include "vm/JSContext.h"
@@ -275,7 +276,8 @@ void jit::CheckFrequentBailouts(JSContext* cx, JSScript* script,
                                 BailoutKind bailoutKind) {
   if (script->hasIonScript()) {
     // Invalidate if this script keeps bailing out without invalidation. Next
-    // time we compile this script LICM will be disabled.
+    // time we compile this script LICM will be disabled for the offending loop
+    // or for the whole script.
     IonScript* ionScript = script->ionScript();
 
     if (ionScript->bailoutExpected()) {
@@ -284,9 +286,21 @@ void jit::CheckFrequentBailouts(JSContext* cx, JSScript* script,
       // which should prevent this from happening again.  Also note that
       // the first execution bailout can be related to an inlined script,
       // so there is no need to penalize the caller.
-      if (bailoutKind != BailoutKind::FirstExecution &&
-          !script->hadFrequentBailouts()) {
-        script->setHadFrequentBailouts();
+      if (bailoutKind != BailoutKind::FirstExecution) {
+        // If the bailouts come from instructions hoisted out of a single loop,
+        // only disable LICM for that loop. Otherwise disable LICM for the
+        // whole script. Only WarpBuilder supports the former.
+        JitScript* jitScript = script->jitScript();
+        if (JitOptions.warpBuilder &&
+            jitScript->disableLICMForFrequentBailouts(script)) {
+          JitSpew(JitSpew_IonInvalidate,
+                  "Disabling LICM for a loop due to too many bailouts");
+        } else if (!script->hadFrequentBailouts()) {
+          script->setHadFrequentBailouts();
+        }
+
+        // Back off recompilation if this script keeps bailing out.
+        jitScript->noteFrequentBailoutInvalidation();
       }
 
       JitSpew(JitSpew_IonInvalidate, "Invalidating due to too many bailouts");
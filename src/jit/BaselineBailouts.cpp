@@ -1999,6 +1999,17 @@ bool jit::FinishBailoutToBaseline(BaselineBailoutInfo* bailoutInfoArg) {
           innerScript->lineno(), innerScript->column(),
           innerScript->getWarmUpCount(), (unsigned)bailoutKind);
 
+  // Record where we resumed so that frequent bailouts can be attributed to a
+  // particular site. See CheckFrequentBailouts.
+  if (bailoutKind != BailoutKind::IonExceptionDebugMode &&
+      topFrame->runningInInterpreter() && innerScript->hasJitScript()) {
+    uint32_t pcOffset = innerScript->pcToOffset(topFrame->interpreterPC());
+    innerScript->jitScript()->noteBailout(pcOffset, bailoutKind);
+    JitSpew(JitSpew_IonBailouts, "Bailout (%s) at %s:%u:%u pc offset %u",
+            BailoutKindString(bailoutKind), innerScript->filename(),
+            innerScript->lineno(), innerScript->column(), pcOffset);
+  }
+
   switch (bailoutKind) {
     // Normal bailouts.
     case BailoutKind::Inevitable:
@@ -2029,6 +2040,7 @@ bool jit::FinishBailoutToBaseline(BaselineBailoutInfo* bailoutInfoArg) {
     case BailoutKind::NonInt32ArrayLength:
     case BailoutKind::ProtoGuard:
     case BailoutKind::NotProxyGuard:
+    case BailoutKind::LICM:
       // Do nothing.
       break;
 
@@ -6,7 +6,11 @@
 
 #include "jit/BaselineCacheIRCompiler.h"
 
+#include "mozilla/Unused.h"
+
+#include "builtin/Array.h"
 #include "jit/CacheIR.h"
+#include "jit/JitOptions.h"
 #include "jit/Linker.h"
 #include "jit/SharedICHelpers.h"
 #include "jit/VMFunctions.h"
@@ -2180,6 +2184,148 @@ static void ResetEnteredCounts(ICFallbackStub* stub) {
   stub->resetEnteredCount();
 }
 
+JitCode* js::jit::GetOrCompileBaselineCacheIRStubCode(
+    JSContext* cx, const CacheIRWriter& writer, CacheKind kind,
+    BaselineCacheIRStubKind stubKind, CacheIRStubInfo** stubInfo) {
+  uint32_t stubDataOffset = 0;
+  switch (stubKind) {
+    case BaselineCacheIRStubKind::Monitored:
+      stubDataOffset = sizeof(ICCacheIR_Monitored);
+      break;
+    case BaselineCacheIRStubKind::Regular:
+      stubDataOffset = sizeof(ICCacheIR_Regular);
+      break;
+    case BaselineCacheIRStubKind::Updated:
+      stubDataOffset = sizeof(ICCacheIR_Updated);
+      break;
+  }
+
+  JitZone* jitZone = cx->zone()->jitZone();
+
+  // Check if we already have JitCode for this stub.
+  CacheIRStubKey::Lookup lookup(kind, ICStubEngine::Baseline,
+                                writer.codeStart(), writer.codeLength());
+  JitCode* code = jitZone->getBaselineCacheIRStubCode(lookup, stubInfo);
+  if (code) {
+    return code;
+  }
+
+  // We have to generate stub code.
+  JitContext jctx(cx, nullptr);
+  BaselineCacheIRCompiler comp(cx, writer, stubDataOffset, stubKind);
+  if (!comp.init(kind)) {
+    return nullptr;
+  }
+
+  code = comp.compile();
+  if (!code) {
+    return nullptr;
+  }
+
+  // Allocate the shared CacheIRStubInfo. Note that the
+  // putBaselineCacheIRStubCode call below will transfer ownership
+  // to the stub code HashMap, so we don't have to worry about freeing
+  // it below.
+  MOZ_ASSERT(!*stubInfo);
+  *stubInfo =
+      CacheIRStubInfo::New(kind, ICStubEngine::Baseline, comp.makesGCCalls(),
+                           stubDataOffset, writer);
+  if (!*stubInfo) {
+    return nullptr;
+  }
+
+  CacheIRStubKey key(*stubInfo);
+  if (!jitZone->putBaselineCacheIRStubCode(lookup, key, code)) {
+    *stubInfo = nullptr;
+    return nullptr;
+  }
+
+  return code;
+}
+
+// Precompile the stub code for some of the most common Baseline IC stubs.
+// Each writer here must emit exactly the same CacheIR as the IR generator
+// that produces the stub, otherwise its code will never be looked up.
+// Stub field values don't matter as they are not part of the stub code.
+bool JitZone::ensureBaselineCacheIRStubCorpus(JSContext* cx) {
+  if (baselineCacheIRStubCorpusCompiled_) {
+    return true;
+  }
+
+  // Dense element stubs guard on the receiver's shape, so get an array shape
+  // before any stub fields are added to a writer.
+  RootedArrayObject array(cx, NewDenseEmptyArray(cx));
+  if (!array) {
+    return false;
+  }
+
+  auto compile = [this, cx](const CacheIRWriter& writer, CacheKind kind,
+                            BaselineCacheIRStubKind stubKind) {
+    if (writer.failed()) {
+      return;
+    }
+    // The corpus is only an optimization. Failing to compile one of its stubs
+    // just means the stub will be compiled when it's first attached.
+    CacheIRStubInfo* stubInfo;
+    JitCode* code = GetOrCompileBaselineCacheIRStubCode(cx, writer, kind,
+                                                        stubKind, &stubInfo);
+    if (code) {
+      mozilla::Unused << baselineCacheIRStubCorpus_.put(code);
+    }
+  };
+
+  // GetPropIRGenerator::tryAttachObjectLength for arrays.
+  {
+    CacheIRWriter writer(cx);
+    ValOperandId valId(writer.setInputOperandId(0));
+    ObjOperandId objId = writer.guardToObject(valId);
+    writer.guardClass(objId, GuardClassKind::Array);
+    writer.loadInt32ArrayLengthResult(objId);
+    writer.returnFromIC();
+    compile(writer, CacheKind::GetProp, BaselineCacheIRStubKind::Monitored);
+  }
+
+  // GetPropIRGenerator::tryAttachDenseElement with an int32 index.
+  {
+    CacheIRWriter writer(cx);
+    ValOperandId valId(writer.setInputOperandId(0));
+    ValOperandId keyId(writer.setInputOperandId(1));
+    ObjOperandId objId = writer.guardToObject(valId);
+    Int32OperandId indexId = writer.guardToInt32Index(keyId);
+    writer.guardShapeForOwnProperties(objId, array->lastProperty());
+    writer.loadDenseElementResult(objId, indexId);
+    writer.typeMonitorResult();
+    compile(writer, CacheKind::GetElem, BaselineCacheIRStubKind::Monitored);
+  }
+
+  // BinaryArithIRGenerator::tryAttachInt32 for int32 operands.
+  for (JSOp op : {JSOp::Add, JSOp::Sub, JSOp::Mul}) {
+    CacheIRWriter writer(cx);
+    ValOperandId lhsId(writer.setInputOperandId(0));
+    ValOperandId rhsId(writer.setInputOperandId(1));
+    Int32OperandId lhsIntId = writer.guardToInt32(lhsId);
+    Int32OperandId rhsIntId = writer.guardToInt32(rhsId);
+    switch (op) {
+      case JSOp::Add:
+        writer.int32AddResult(lhsIntId, rhsIntId);
+        break;
+      case JSOp::Sub:
+        writer.int32SubResult(lhsIntId, rhsIntId);
+        break;
+      case JSOp::Mul:
+        writer.int32MulResult(lhsIntId, rhsIntId);
+        break;
+      default:
+        MOZ_CRASH("Unexpected op");
+    }
+    writer.returnFromIC();
+    compile(writer, CacheKind::BinaryArith, BaselineCacheIRStubKind::Regular);
+  }
+
+  baselineCacheIRStubCorpusCompiled_ = true;
+  return true;
+}
+
 ICStub* js::jit::AttachBaselineCacheIRStub(
     JSContext* cx, const CacheIRWriter& writer, CacheKind kind,
     BaselineCacheIRStubKind stubKind, JSScript* outerScript, ICScript* icScript,
@@ -2201,66 +2347,26 @@ ICStub* js::jit::AttachBaselineCacheIRStub(
   MOZ_ASSERT(stub->numOptimizedStubs() < MaxOptimizedCacheIRStubs);
 #endif
 
-  uint32_t stubDataOffset = 0;
-  switch (stubKind) {
-    case BaselineCacheIRStubKind::Monitored:
-      stubDataOffset = sizeof(ICCacheIR_Monitored);
-      break;
-    case BaselineCacheIRStubKind::Regular:
-      stubDataOffset = sizeof(ICCacheIR_Regular);
-      break;
-    case BaselineCacheIRStubKind::Updated:
-      stubDataOffset = sizeof(ICCacheIR_Updated);
-      break;
-  }
-
-  JitZone* jitZone = cx->zone()->jitZone();
-
   // The script to invalidate if we are modifying a transpiled IC.
   JSScript* invalidationScript = icScript->isInlined()
                                      ? icScript->inliningRoot()->owningScript()
                                      : outerScript;
 
-  // Check if we already have JitCode for this stub.
   CacheIRStubInfo* stubInfo;
-  CacheIRStubKey::Lookup lookup(kind, ICStubEngine::Baseline,
-                                writer.codeStart(), writer.codeLength());
-  JitCode* code = jitZone->getBaselineCacheIRStubCode(lookup, &stubInfo);
+  JitCode* code = GetOrCompileBaselineCacheIRStubCode(cx, writer, kind,
+                                                      stubKind, &stubInfo);
   if (!code) {
-    // We have to generate stub code.
-    JitContext jctx(cx, nullptr);
-    BaselineCacheIRCompiler comp(cx, writer, stubDataOffset, stubKind);
-    if (!comp.init(kind)) {
-      return nullptr;
-    }
-
-    code = comp.compile();
-    if (!code) {
-      return nullptr;
-    }
-
-    // Allocate the shared CacheIRStubInfo. Note that the
-    // putBaselineCacheIRStubCode call below will transfer ownership
-    // to the stub code HashMap, so we don't have to worry about freeing
-    // it below.
-    MOZ_ASSERT(!stubInfo);
-    stubInfo =
-        CacheIRStubInfo::New(kind, ICStubEngine::Baseline, comp.makesGCCalls(),
-                             stubDataOffset, writer);
-    if (!stubInfo) {
-      return nullptr;
-    }
-
-    CacheIRStubKey key(stubInfo);
-    if (!jitZone->putBaselineCacheIRStubCode(lookup, key, code)) {
-      return nullptr;
-    }
+    return nullptr;
   }
 
   MOZ_ASSERT(code);
   MOZ_ASSERT(stubInfo);
   MOZ_ASSERT(stubInfo->stubDataSize() == writer.stubDataSize());
 
+  if (JitOptions.baselineCacheIRStubCorpus) {
+    cx->zone()->jitZone()->noteBaselineCacheIRStubCode(code);
+  }
+
   // Ensure we don't attach duplicate stubs. This can happen if a stub failed
   // for some reason and the IR generator doesn't check for exactly the same
   // conditions.
@@ -27,6 +27,13 @@ ICStub* AttachBaselineCacheIRStub(JSContext* cx, const CacheIRWriter& writer,
                                   JSScript* outerScript, ICScript* icScript,
                                   ICFallbackStub* stub, bool* attached);
 
+// Return the zone's shared stub code for |writer|, compiling it if necessary.
+JitCode* GetOrCompileBaselineCacheIRStubCode(JSContext* cx,
+                                             const CacheIRWriter& writer,
+                                             CacheKind kind,
+                                             BaselineCacheIRStubKind stubKind,
+                                             CacheIRStubInfo** stubInfo);
+
 // BaselineCacheIRCompiler compiles CacheIR to BaselineIC native code.
 class MOZ_RAII BaselineCacheIRCompiler : public CacheIRCompiler {
   bool makesGCCalls_;
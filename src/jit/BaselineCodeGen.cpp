@@ -325,7 +325,7 @@ MethodStatus BaselineCompiler::compile() {
   script->jitScript()->setBaselineScript(script, baselineScript.release());
 
 #ifdef JS_ION_PERF
-  writePerfSpewerBaselineProfile(script, code);
+  writePerfSpewerBaselineProfile(script, code, perfOps_);
 #endif
 
 #ifdef MOZ_VTUNE
@@ -6797,6 +6797,16 @@ MethodStatus BaselineCompiler::emitBody() {
 
     frame.assertValidState(*info);
 
+#ifdef JS_ION_PERF
+    if (PerfJitdumpEnabled()) {
+      uint32_t pcOffset = script->pcToOffset(handler.pc());
+      if (!perfOps_.append(BaselinePerfOp{masm.currentOffset(), pcOffset})) {
+        ReportOutOfMemory(cx);
+        return Method_Error;
+      }
+    }
+#endif
+
     // If the script has a resume offset for this pc we need to keep track of
     // the native code offset.
     if (info->hasResumeOffset) {
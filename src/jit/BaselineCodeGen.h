@@ -12,6 +12,9 @@
 #include "jit/BytecodeAnalysis.h"
 #include "jit/FixedList.h"
 #include "jit/MacroAssembler.h"
+#ifdef JS_ION_PERF
+#  include "jit/PerfSpewer.h"
+#endif
 #include "vm/GeneratorResumeKind.h"  // GeneratorResumeKind
 
 namespace js {
@@ -375,6 +378,11 @@ class BaselineCompiler final : private BaselineCompilerCodeGen {
       Vector<BaselineScript::DebugTrapEntry, 0, SystemAllocPolicy>;
   DebugTrapEntryVector debugTrapEntries_;
 
+#ifdef JS_ION_PERF
+  // Native code offsets for all bytecode ops, for jitdump line tables.
+  BaselinePerfOpVector perfOps_;
+#endif
+
   CodeOffset profilerPushToggleOffset_;
 
   CodeOffset traceLoggerScriptTextIdOffset_;
@@ -307,8 +307,8 @@ bool ICScript::initICEntries(JSContext* cx, JSScript* script) {
         if (!group) {
           return false;
         }
-        ICStub* stub =
-            alloc.newStub<ICNewArray_Fallback>(Kind::NewArray, group);
+        ICStub* stub = alloc.newStub<ICNewArray_Fallback>(
+            Kind::NewArray, group, cx->zone(), loc.bytecodeToOffset(script));
         if (!addIC(loc, stub)) {
           return false;
         }
@@ -317,7 +317,8 @@ bool ICScript::initICEntries(JSContext* cx, JSScript* script) {
       case JSOp::NewObject:
       case JSOp::NewObjectWithGroup:
       case JSOp::NewInit: {
-        ICStub* stub = alloc.newStub<ICNewObject_Fallback>(Kind::NewObject);
+        ICStub* stub = alloc.newStub<ICNewObject_Fallback>(
+            Kind::NewObject, cx->zone(), loc.bytecodeToOffset(script));
         if (!addIC(loc, stub)) {
           return false;
         }
@@ -3803,7 +3804,8 @@ bool DoNewArrayFallback(JSContext* cx, BaselineFrame* frame,
   RootedObject obj(cx);
   if (stub->templateObject()) {
     RootedObject templateObject(cx, stub->templateObject());
-    obj = NewArrayOperationWithTemplate(cx, templateObject);
+    obj = NewArrayOperationWithTemplate(cx, templateObject,
+                                        stub->allocSite());
     if (!obj) {
       return false;
     }
@@ -3856,7 +3858,8 @@ bool DoNewObjectFallback(JSContext* cx, BaselineFrame* frame,
   if (templateObject) {
     MOZ_ASSERT(
         !templateObject->group()->maybePreliminaryObjectsDontCheckGeneration());
-    obj = NewObjectOperationWithTemplate(cx, templateObject);
+    obj = NewObjectOperationWithTemplate(cx, templateObject,
+                                         stub->allocSite());
   } else {
     RootedScript script(cx, frame->script());
     jsbytecode* pc = stub->icEntry()->pc(script);
@@ -3871,7 +3874,8 @@ bool DoNewObjectFallback(JSContext* cx, BaselineFrame* frame,
 
       TryAttachStub<NewObjectIRGenerator>("NewObject", cx, frame, stub,
                                           BaselineCacheIRStubKind::Regular,
-                                          JSOp(*pc), templateObject);
+                                          JSOp(*pc), templateObject,
+                                          stub->allocSite());
 
       stub->setTemplateObject(templateObject);
     }
@@ -12,6 +12,7 @@
 #include "builtin/TypedObject.h"
 #include "gc/Barrier.h"
 #include "gc/GC.h"
+#include "gc/Pretenuring.h"
 #include "jit/BaselineICList.h"
 #include "jit/BaselineJIT.h"
 #include "jit/ICState.h"
@@ -1761,13 +1762,19 @@ class ICNewArray_Fallback : public ICFallbackStub {
   // template object itself is not.
   GCPtrObjectGroup templateGroup_;
 
-  ICNewArray_Fallback(TrampolinePtr stubCode, ObjectGroup* templateGroup)
+  // Allocation site for the arrays created here. See gc/Pretenuring.h.
+  gc::AllocSite allocSite_;
+
+  ICNewArray_Fallback(TrampolinePtr stubCode, ObjectGroup* templateGroup,
+                      JS::Zone* zone, uint32_t pcOffset)
       : ICFallbackStub(ICStub::NewArray_Fallback, stubCode),
         templateObject_(nullptr),
-        templateGroup_(templateGroup) {}
+        templateGroup_(templateGroup),
+        allocSite_(zone, pcOffset) {}
 
  public:
   GCPtrArrayObject& templateObject() { return templateObject_; }
+  gc::AllocSite* allocSite() { return &allocSite_; }
 
   void setTemplateObject(ArrayObject* obj) {
     MOZ_ASSERT(obj->group() == templateGroup());
@@ -1789,12 +1796,18 @@ class ICNewObject_Fallback : public ICFallbackStub {
 
   GCPtrObject templateObject_;
 
-  explicit ICNewObject_Fallback(TrampolinePtr stubCode)
+  // Allocation site for the objects created here. See gc/Pretenuring.h.
+  gc::AllocSite allocSite_;
+
+  ICNewObject_Fallback(TrampolinePtr stubCode, JS::Zone* zone,
+                       uint32_t pcOffset)
       : ICFallbackStub(ICStub::NewObject_Fallback, stubCode),
-        templateObject_(nullptr) {}
+        templateObject_(nullptr),
+        allocSite_(zone, pcOffset) {}
 
  public:
   GCPtrObject& templateObject() { return templateObject_; }
+  gc::AllocSite* allocSite() { return &allocSite_; }
 
   void setTemplateObject(JSObject* obj) { templateObject_ = obj; }
 };
@@ -750,6 +750,18 @@ ObjectGroup* BaselineInspector::getTemplateObjectGroup(jsbytecode* pc) {
   return nullptr;
 }
 
+gc::AllocSite* BaselineInspector::getAllocSite(jsbytecode* pc) {
+  ICFallbackStub* stub = icEntryFromPC(pc).fallbackStub();
+  switch (stub->kind()) {
+    case ICStub::NewArray_Fallback:
+      return stub->toNewArray_Fallback()->allocSite();
+    case ICStub::NewObject_Fallback:
+      return stub->toNewObject_Fallback()->allocSite();
+    default:
+      return nullptr;
+  }
+}
+
 JSFunction* BaselineInspector::getSingleCallee(jsbytecode* pc) {
   MOZ_ASSERT(IsConstructPC(pc));
 
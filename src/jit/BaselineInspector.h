@@ -99,6 +99,7 @@ class BaselineInspector {
   // Sometimes the group a template object will have is known, even if the
   // object itself isn't.
   ObjectGroup* getTemplateObjectGroup(jsbytecode* pc);
+  gc::AllocSite* getAllocSite(jsbytecode* pc);
 
   JSFunction* getSingleCallee(jsbytecode* pc);
 
@@ -5511,6 +5511,33 @@ AttachDecision CallIRGenerator::tryAttachIsObject(HandleFunction callee) {
   return AttachDecision::Attach;
 }
 
+AttachDecision CallIRGenerator::tryAttachAssertRecoveredOnBailout(
+    HandleFunction callee) {
+  // Expecting the value and a boolean constant.
+  if (argc_ != 2 || !args_[1].isBoolean()) {
+    return AttachDecision::NoAction;
+  }
+
+  bool mustBeRecovered = args_[1].toBoolean();
+
+  // Initialize the input operand.
+  Int32OperandId argcId(writer.setInputOperandId(0));
+
+  // Guard callee is the 'assertRecoveredOnBailout' native function.
+  emitNativeCalleeGuard(callee);
+
+  ValOperandId valId = writer.loadArgumentFixedSlot(ArgumentKind::Arg0, argc_);
+  writer.assertRecoveredOnBailoutResult(valId, mustBeRecovered);
+
+  // This stub does not need to be monitored, because it always returns
+  // undefined.
+  writer.returnFromIC();
+  cacheIRStubKind_ = BaselineCacheIRStubKind::Regular;
+
+  trackAttached("AssertRecoveredOnBailout");
+  return AttachDecision::Attach;
+}
+
 AttachDecision CallIRGenerator::tryAttachIsPackedArray(HandleFunction callee) {
   // Self-hosted code calls this with a single object argument.
   MOZ_ASSERT(argc_ == 1);
@@ -7335,6 +7362,10 @@ AttachDecision CallIRGenerator::tryAttachInlinableNative(
     case InlinableNative::IntrinsicTypedArrayLength:
       return tryAttachTypedArrayLength(callee);
 
+    // Testing functions.
+    case InlinableNative::TestAssertRecoveredOnBailout:
+      return tryAttachAssertRecoveredOnBailout(callee);
+
     default:
       return AttachDecision::NoAction;
   }
@@ -9402,13 +9433,16 @@ AttachDecision BinaryArithIRGenerator::tryAttachStringInt32Arith() {
 
 NewObjectIRGenerator::NewObjectIRGenerator(JSContext* cx, HandleScript script,
                                            jsbytecode* pc, ICState::Mode mode,
-                                           JSOp op, HandleObject templateObj)
+                                           JSOp op, HandleObject templateObj,
+                                           gc::AllocSite* site)
     : IRGenerator(cx, script, pc, CacheKind::NewObject, mode),
 #ifdef JS_CACHEIR_SPEW
       op_(op),
 #endif
-      templateObject_(templateObj) {
+      templateObject_(templateObj),
+      site_(site) {
   MOZ_ASSERT(templateObject_);
+  MOZ_ASSERT(site_);
 }
 
 void NewObjectIRGenerator::trackAttached(const char* name) {
@@ -9447,7 +9481,7 @@ AttachDecision NewObjectIRGenerator::tryAttachStub() {
   uint64_t id = cx_->runtime()->jitRuntime()->nextDisambiguationId();
   uint32_t idHi = id >> 32;
   uint32_t idLo = id & UINT32_MAX;
-  writer.loadNewObjectFromTemplateResult(templateObject_, idHi, idLo);
+  writer.loadNewObjectFromTemplateResult(templateObject_, site_, idHi, idLo);
 
   writer.returnFromIC();
 
@@ -30,6 +30,7 @@
 #include "vm/ArrayBufferObject.h"
 #include "vm/ArrayBufferViewObject.h"
 #include "vm/BigIntType.h"
+#include "vm/Caches.h"
 #include "vm/FunctionFlags.h"  // js::FunctionFlags
 #include "vm/GeneratorObject.h"
 
@@ -3835,6 +3836,17 @@ bool CacheIRCompiler::emitArrayJoinResult(ObjOperandId objId) {
   return true;
 }
 
+bool CacheIRCompiler::emitAssertRecoveredOnBailoutResult(ValOperandId valId,
+                                                         bool mustBeRecovered) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoOutputRegister output(*this);
+
+  // This is a no-op outside of Ion.
+  masm.moveValue(UndefinedValue(), output.valueReg());
+  return true;
+}
+
 bool CacheIRCompiler::emitIsObjectResult(ValOperandId inputId) {
   JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
 
@@ -5611,13 +5623,14 @@ bool CacheIRCompiler::emitLoadBigIntTruthyResult(BigIntOperandId bigIntId) {
 }
 
 bool CacheIRCompiler::emitLoadNewObjectFromTemplateResult(
-    uint32_t templateObjectOffset, uint32_t, uint32_t) {
+    uint32_t templateObjectOffset, uint32_t siteOffset, uint32_t, uint32_t) {
   JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
   AutoOutputRegister output(*this);
   AutoScratchRegister obj(allocator, masm);
   AutoScratchRegisterMaybeOutput scratch(allocator, masm, output);
 
   TemplateObject templateObj(objectStubFieldUnchecked(templateObjectOffset));
+  gc::AllocSite* site = allocSiteStubFieldUnchecked(siteOffset);
 
   FailurePath* failure;
   if (!addFailurePath(&failure)) {
@@ -5625,7 +5638,7 @@ bool CacheIRCompiler::emitLoadNewObjectFromTemplateResult(
   }
 
   masm.createGCObject(obj, scratch, templateObj, gc::DefaultHeap,
-                      failure->label());
+                      failure->label(), /* initContents = */ true, site);
   masm.tagValue(JSVAL_TYPE_OBJECT, obj, output.valueReg());
   return true;
 }
@@ -6686,6 +6699,52 @@ bool CacheIRCompiler::emitMegamorphicLoadSlotResult(ObjOperandId objId,
   // The object must be Native.
   masm.branchIfNonNativeObj(obj, scratch3, failure->label());
 
+  // Probe the runtime's megamorphic cache before calling into the VM. An entry
+  // matching the object's shape and the property name gives the location of
+  // an own data property. See MegamorphicCache in vm/Caches.h.
+  using CacheEntry = MegamorphicCache::Entry;
+  const MegamorphicCache& cache = cx_->runtime()->caches().megamorphicCache;
+
+  Label cacheMiss, done;
+  masm.loadPtr(Address(obj, JSObject::offsetOfShape()), scratch1);
+  emitLoadStubField(name, scratch2);
+  masm.movePtr(scratch1, scratch3);
+  masm.xorPtr(scratch2, scratch3);
+  masm.rshiftPtr(Imm32(MegamorphicCache::ShapeHashShift), scratch3);
+  masm.andPtr(Imm32(MegamorphicCache::NumEntries - 1), scratch3);
+  masm.lshiftPtr(Imm32(MegamorphicCache::EntryShift), scratch3);
+  masm.addPtr(ImmPtr(cache.entries()), scratch3);
+
+  masm.branchPtr(Assembler::NotEqual,
+                 Address(scratch3, CacheEntry::offsetOfShape()), scratch1,
+                 &cacheMiss);
+  masm.branchPtr(Assembler::NotEqual,
+                 Address(scratch3, CacheEntry::offsetOfKey()), scratch2,
+                 &cacheMiss);
+  masm.loadPtr(Address(scratch3, CacheEntry::offsetOfGeneration()), scratch2);
+  masm.branchPtr(Assembler::NotEqual,
+                 AbsoluteAddress(cache.addressOfGeneration()), scratch2,
+                 &cacheMiss);
+
+  // Cache hit. Load the slot from the object or its slots array. Don't use
+  // scratch1 here because it may alias the output register.
+  Label dynamicSlot, loadSlot;
+  masm.loadPtr(Address(scratch3, CacheEntry::offsetOfSlotOffset()), scratch2);
+  masm.branchTestPtr(Assembler::Zero, scratch2,
+                     Imm32(MegamorphicCache::FixedSlotFlag), &dynamicSlot);
+  masm.movePtr(obj, scratch3);
+  masm.jump(&loadSlot);
+  masm.bind(&dynamicSlot);
+  masm.loadPtr(Address(obj, NativeObject::offsetOfSlots()), scratch3);
+  masm.bind(&loadSlot);
+  masm.rshiftPtr(Imm32(1), scratch2);
+  if (JitOptions.spectreObjectMitigationsMisc) {
+    masm.speculationBarrier();
+  }
+  masm.loadTypedOrValue(BaseIndex(scratch3, scratch2, TimesOne), output);
+  masm.jump(&done);
+
+  masm.bind(&cacheMiss);
   masm.Push(UndefinedValue());
   masm.moveStackPtrTo(scratch3.get());
 
@@ -6721,6 +6780,7 @@ bool CacheIRCompiler::emitMegamorphicLoadSlotResult(ObjOperandId objId,
     masm.speculationBarrier();
   }
 
+  masm.bind(&done);
   return true;
 }
 
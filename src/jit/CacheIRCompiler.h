@@ -857,6 +857,11 @@ class MOZ_RAII CacheIRCompiler {
         .readStubFieldForIon(offset, StubField::Type::JSObject)
         .asWord();
   }
+  gc::AllocSite* allocSiteStubFieldUnchecked(uint32_t offset) {
+    return (gc::AllocSite*)writer_
+        .readStubFieldForIon(offset, StubField::Type::RawWord)
+        .asWord();
+  }
   JSString* stringStubField(uint32_t offset) {
     MOZ_ASSERT(stubFieldPolicy_ == StubFieldPolicy::Constant);
     return (JSString*)readStubWord(offset, StubField::Type::String);
@@ -60,6 +60,40 @@ bool CacheIRHealth::spewHealthForStubsInCacheIREntry(AutoStructuredSpewer& spew,
   return true;
 }
 
+bool CacheIRHealth::spewBailoutsForPCOffset(AutoStructuredSpewer& spew,
+                                            JitScript* jitScript,
+                                            uint32_t pcOffset) {
+  const auto* bailoutData = jitScript->bailoutData();
+  if (!bailoutData) {
+    return true;
+  }
+
+  bool hasBailouts = false;
+  for (const BailoutSite& site : bailoutData->sites) {
+    if (site.pcOffset != pcOffset) {
+      continue;
+    }
+
+    if (!hasBailouts) {
+      spew->beginListProperty("bailouts");
+      hasBailouts = true;
+    }
+
+    spew->beginObject();
+    spew->property("kind", BailoutKindString(site.kind));
+    spew->property("count", site.count);
+    if (site.licmDisabled) {
+      spew->property("licmDisabled", true);
+    }
+    spew->endObject();
+  }
+
+  if (hasBailouts) {
+    spew->endList();  // bailouts
+  }
+  return true;
+}
+
 uint32_t CacheIRHealth::spewJSOpForCacheIRHealth(AutoStructuredSpewer& spew,
                                                  unsigned pcOffset,
                                                  jsbytecode next) {
@@ -106,6 +140,8 @@ bool CacheIRHealth::rateMyCacheIR(JSContext* cx, HandleScript script) {
                       ICStub::IsCacheIRKind(entry->firstStub()->kind()))) {
           spewHealthForStubsInCacheIREntry(spew, entry);
         }
+
+        spewBailoutsForPCOffset(spew, jitScript, pcOffset);
       }
       spew->endObject();
 
@@ -16,6 +16,8 @@
 namespace js {
 namespace jit {
 
+class JitScript;
+
 // [SMDOC] CacheIR Health Rating
 //
 // The goal of CacheIR health rating is to make the costlier
@@ -33,6 +35,10 @@ namespace jit {
 // for the script associated with that function, or if you call rateMyCacheIR()
 // without any parameters it will take the topmost script and rate that.
 //
+// Ops where Ion code bailed out also list the bailouts recorded at that
+// location (see JitScript::noteBailout), so expensive stubs and the guards
+// that keep failing can be diagnosed together.
+//
 
 class CacheIRHealth {
  public:
@@ -41,6 +47,9 @@ class CacheIRHealth {
   // Health of all the stubs in an individual CacheIR Entry.
   bool spewHealthForStubsInCacheIREntry(AutoStructuredSpewer& spew,
                                         ICEntry* entry);
+  // Bailouts from Ion code that resumed at a particular bytecode offset.
+  bool spewBailoutsForPCOffset(AutoStructuredSpewer& spew, JitScript* jitScript,
+                               uint32_t pcOffset);
   // Show JSOps present in the script, formatted for CacheIR
   // health report.
   uint32_t spewJSOpForCacheIRHealth(AutoStructuredSpewer& spew,
@@ -6906,11 +6906,13 @@ void CodeGenerator::visitNewArrayCallVM(LNewArray* lir) {
   JSObject* templateObject = lir->mir()->templateObject();
 
   if (templateObject) {
+    pushArg(ImmPtr(lir->mir()->allocSite()));
     pushArg(Imm32(lir->mir()->convertDoubleElements()));
     pushArg(ImmGCPtr(templateObject->group()));
     pushArg(Imm32(lir->mir()->length()));
 
-    using Fn = ArrayObject* (*)(JSContext*, uint32_t, HandleObjectGroup, bool);
+    using Fn = ArrayObject* (*)(JSContext*, uint32_t, HandleObjectGroup, bool,
+                                gc::AllocSite*);
     callVM<Fn, NewArrayWithGroup>(lir);
   } else {
     pushArg(Imm32(GenericObject));
@@ -6994,7 +6996,8 @@ void CodeGenerator::visitNewArray(LNewArray* lir) {
              "Inline allocation only supports inline elements");
 #endif
   masm.createGCObject(objReg, tempReg, templateObject,
-                      lir->mir()->initialHeap(), ool->entry());
+                      lir->mir()->initialHeap(), ool->entry(),
+                      /* initContents = */ true, lir->mir()->allocSite());
 
   masm.bind(ool->rejoin());
 }
@@ -7205,9 +7208,10 @@ void CodeGenerator::visitNewObjectVMCall(LNewObject* lir) {
   switch (lir->mir()->mode()) {
     case MNewObject::ObjectLiteral:
       if (templateObject) {
+        pushArg(ImmPtr(lir->mir()->allocSite()));
         pushArg(ImmGCPtr(templateObject));
 
-        using Fn = JSObject* (*)(JSContext*, HandleObject);
+        using Fn = JSObject* (*)(JSContext*, HandleObject, gc::AllocSite*);
         callVM<Fn, NewObjectOperationWithTemplate>(lir);
       } else {
         pushArg(Imm32(GenericObject));
@@ -7342,7 +7346,8 @@ void CodeGenerator::visitNewObject(LNewObject* lir) {
 
   bool initContents = ShouldInitFixedSlots(lir, templateObject);
   masm.createGCObject(objReg, tempReg, templateObject,
-                      lir->mir()->initialHeap(), ool->entry(), initContents);
+                      lir->mir()->initialHeap(), ool->entry(), initContents,
+                      lir->mir()->allocSite());
 
   masm.bind(ool->rejoin());
 }
@@ -11195,12 +11200,14 @@ bool CodeGenerator::link(JSContext* cx, CompilerConstraintList* constraints,
   if (jsbytecode* osrPc = gen->outerInfo().osrPc()) {
     ionScript->setOsrPc(osrPc);
     ionScript->setOsrEntryOffset(getOsrEntryOffset());
+    ionScript->setNumSpecializedOsrValues(gen->numSpecializedOsrValues());
   }
   ionScript->setInvalidationEpilogueOffset(invalidate_.offset());
 
 #if defined(JS_ION_PERF)
   if (PerfEnabled()) {
-    perfSpewer_.writeProfile(script, code, masm);
+    perfSpewer_.writeProfile(script, code, masm, nativeToBytecodeList_.begin(),
+                             nativeToBytecodeList_.length());
   }
 #endif
 
@@ -164,8 +164,17 @@ void CompileZone::setMinorGCShouldCancelIonCompilations() {
   rt->gc.storeBuffer().setShouldCancelIonCompilations();
 }
 
-uintptr_t CompileZone::nurseryCellHeader(JS::TraceKind kind) {
-  return gc::NurseryCellHeader::MakeValue(zone(), kind);
+gc::AllocSite** CompileZone::addressOfNurseryAllocatedSites() {
+  return zone()->runtimeFromAnyThread()->gc.nursery().addressOfAllocatedSites();
+}
+
+gc::AllocSite* CompileZone::unknownAllocSite(JS::TraceKind kind) {
+  return zone()->unknownAllocSite(kind);
+}
+
+uintptr_t CompileZone::nurseryCellHeader(JS::TraceKind kind,
+                                         gc::AllocSite* site) {
+  return gc::NurseryCellHeader::MakeValue(site, kind);
 }
 
 JS::Realm* CompileRealm::realm() { return reinterpret_cast<JS::Realm*>(this); }
@@ -78,12 +78,14 @@ class CompileZone {
   const void* addressOfBigIntNurseryCurrentEnd();
 
   uint32_t* addressOfNurseryAllocCount();
+  gc::AllocSite** addressOfNurseryAllocatedSites();
 
   bool canNurseryAllocateStrings();
   bool canNurseryAllocateBigInts();
   void setMinorGCShouldCancelIonCompilations();
 
-  uintptr_t nurseryCellHeader(JS::TraceKind kind);
+  gc::AllocSite* unknownAllocSite(JS::TraceKind kind);
+  uintptr_t nurseryCellHeader(JS::TraceKind kind, gc::AllocSite* site);
 };
 
 class JitRealm;
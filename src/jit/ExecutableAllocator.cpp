@@ -58,6 +58,9 @@ void ExecutablePool::release(size_t n, CodeKind kind) {
   m_codeBytes[kind] -= n;
   MOZ_ASSERT(m_codeBytes[kind] < m_allocation.size);  // Shouldn't underflow.
 
+  MOZ_ASSERT(m_allocator->m_codeBytes[kind] >= n);
+  m_allocator->m_codeBytes[kind] -= n;
+
   release();
 }
 
@@ -76,6 +79,7 @@ void* ExecutablePool::alloc(size_t n, CodeKind kind) {
   m_freePtr += n;
 
   m_codeBytes[kind] += n;
+  m_allocator->m_codeBytes[kind] += n;
 
   MOZ_MAKE_MEM_UNDEFINED(result, n);
   return result;
@@ -192,6 +196,7 @@ ExecutablePool* ExecutableAllocator::createPool(size_t n) {
     return nullptr;
   }
 
+  m_poolBytes += a.size;
   return pool;
 }
 
@@ -227,6 +232,8 @@ void ExecutableAllocator::releasePoolPages(ExecutablePool* pool) {
   // Pool may not be present in m_pools if we hit OOM during creation.
   if (auto ptr = m_pools.lookup(pool)) {
     m_pools.remove(ptr);
+    MOZ_ASSERT(m_poolBytes >= pool->m_allocation.size);
+    m_poolBytes -= pool->m_allocation.size;
   }
 }
 
@@ -107,14 +107,6 @@ class ExecutablePool {
   }
   bool isMarked() const { return m_mark; }
 
- private:
-  ExecutablePool(const ExecutablePool&) = delete;
-  void operator=(const ExecutablePool&) = delete;
-
-  void* alloc(size_t n, CodeKind kind);
-
-  size_t available() const;
-
   // Returns the number of bytes that are currently in use (referenced by
   // live JitCode objects).
   size_t usedCodeBytes() const {
@@ -124,6 +116,18 @@ class ExecutablePool {
     }
     return res;
   }
+
+  // Returns the size of the pool's pages. Space released by dead code is
+  // only reclaimed once the whole pool is freed.
+  size_t allocatedBytes() const { return m_allocation.size; }
+
+ private:
+  ExecutablePool(const ExecutablePool&) = delete;
+  void operator=(const ExecutablePool&) = delete;
+
+  void* alloc(size_t n, CodeKind kind);
+
+  size_t available() const;
 };
 
 struct JitPoisonRange {
@@ -138,6 +142,8 @@ struct JitPoisonRange {
 typedef Vector<JitPoisonRange, 0, SystemAllocPolicy> JitPoisonRangeVector;
 
 class ExecutableAllocator {
+  friend class ExecutablePool;
+
  public:
   ExecutableAllocator() = default;
   ~ExecutableAllocator();
@@ -153,6 +159,21 @@ class ExecutableAllocator {
 
   void addSizeOfCode(JS::CodeSizes* sizes) const;
 
+  // Number of bytes used by live code, per CodeKind and in total. Unlike
+  // addSizeOfCode, these are maintained incrementally and are cheap to query.
+  size_t codeBytes(CodeKind kind) const { return m_codeBytes[kind]; }
+  size_t totalCodeBytes() const {
+    size_t res = 0;
+    for (size_t count : m_codeBytes) {
+      res += count;
+    }
+    return res;
+  }
+
+  // Number of bytes of pages allocated for pools, including space that is
+  // unused or was used by code that has been freed.
+  size_t totalPoolBytes() const { return m_poolBytes; }
+
  private:
   static const size_t OVERSIZE_ALLOCATION = size_t(-1);
 
@@ -201,6 +222,11 @@ class ExecutableAllocator {
                       js::SystemAllocPolicy>
       ExecPoolHashSet;
   ExecPoolHashSet m_pools;  // All pools, just for stats purposes.
+
+  // Bytes currently allocated for each CodeKind across all pools, and the
+  // total size of all pools. See codeBytes() and totalPoolBytes().
+  mozilla::EnumeratedArray<CodeKind, CodeKind::Count, size_t> m_codeBytes{};
+  size_t m_poolBytes = 0;
 };
 
 }  // namespace jit
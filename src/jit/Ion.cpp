@@ -11,6 +11,7 @@
 #include "mozilla/IntegerPrintfMacros.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/ThreadLocal.h"
+#include "mozilla/TimeStamp.h"
 #include "mozilla/Unused.h"
 
 #include "gc/FreeOp.h"
@@ -445,6 +446,23 @@ void JitRealm::traceWeak(JSTracer* trc, JS::Realm* realm) {
 
 void JitZone::traceWeak(JSTracer* trc) {
   baselineCacheIRStubCodes_.traceWeak(trc);
+
+  // The corpus is dropped as a whole once any of its code dies, so that it is
+  // compiled again rather than left incomplete.
+  bool corpusDied = false;
+  for (auto r = baselineCacheIRStubCorpus_.all(); !r.empty(); r.popFront()) {
+    JitCode* code = r.front();
+    if (!TraceManuallyBarrieredWeakEdge(trc, &code,
+                                        "JitZone::baselineCacheIRStubCorpus_")) {
+      corpusDied = true;
+      break;
+    }
+    MOZ_ASSERT(code == r.front(), "JitCode is never moved");
+  }
+  if (corpusDied) {
+    baselineCacheIRStubCorpus_.clearAndCompact();
+    baselineCacheIRStubCorpusCompiled_ = false;
+  }
 }
 
 size_t JitRealm::sizeOfIncludingThis(mozilla::MallocSizeOf mallocSizeOf) const {
@@ -462,6 +480,7 @@ void JitZone::addSizeOfIncludingThis(mozilla::MallocSizeOf mallocSizeOf,
   *jitZone +=
       baselineCacheIRStubCodes_.shallowSizeOfExcludingThis(mallocSizeOf);
   *jitZone += ionCacheIRStubInfoSet_.shallowSizeOfExcludingThis(mallocSizeOf);
+  *jitZone += baselineCacheIRStubCorpus_.shallowSizeOfExcludingThis(mallocSizeOf);
 
   execAlloc().addSizeOfCode(code);
 
@@ -584,10 +603,11 @@ void JitCode::finalize(JSFreeOp* fop) {
   setHeaderPtr(nullptr);
 
   // Code buffers are stored inside ExecutablePools. Pools are refcounted.
-  // Releasing the pool may free it. Horrible hack: if we are using perf
+  // Releasing the pool may free it. Horrible hack: if we are using perf map
   // integration, we don't want to reuse code addresses, so we just leak the
-  // memory instead.
-  if (!PerfEnabled()) {
+  // memory instead. jitdump records are timestamped, so perf can tell code
+  // reusing an address apart.
+  if (!PerfEnabled() || PerfJitdumpEnabled()) {
     pool_->release(headerSize_ + bufferSize_, CodeKind(kind_));
   }
 
@@ -1400,11 +1420,12 @@ LIRGraph* GenerateLIR(MIRGenerator* mir) {
     AutoTraceLog log(logger, TraceLogger_RegisterAllocation);
 
     IonRegisterAllocator allocator =
-        mir->optimizationInfo().registerAllocator();
+        mir->optimizationInfo().registerAllocator(lir->numInstructions());
 
     switch (allocator) {
       case RegisterAllocator_Backtracking:
-      case RegisterAllocator_Testbed: {
+      case RegisterAllocator_Testbed:
+      case RegisterAllocator_Fast: {
 #ifdef DEBUG
         if (JitOptions.fullDebugChecks) {
           if (!integrity.record()) {
@@ -1413,12 +1434,23 @@ LIRGraph* GenerateLIR(MIRGenerator* mir) {
         }
 #endif
 
+        mozilla::TimeStamp start = mozilla::TimeStamp::Now();
+
         BacktrackingAllocator regalloc(mir, &lirgen, *lir,
-                                       allocator == RegisterAllocator_Testbed);
+                                       allocator == RegisterAllocator_Testbed,
+                                       allocator == RegisterAllocator_Fast);
         if (!regalloc.go()) {
           return nullptr;
         }
 
+        JitSpew(JitSpew_RegAllocStats,
+                "%s register allocation: %u instructions, %u vregs, %.3f ms, "
+                "%zu spilled bundles",
+                allocator == RegisterAllocator_Fast ? "Fast" : "Backtracking",
+                lir->numInstructions(), lir->numVirtualRegisters(),
+                (mozilla::TimeStamp::Now() - start).ToMilliseconds(),
+                regalloc.numSpilledBundles());
+
 #ifdef DEBUG
         if (JitOptions.fullDebugChecks) {
           if (!integrity.check()) {
@@ -1427,7 +1459,9 @@ LIRGraph* GenerateLIR(MIRGenerator* mir) {
         }
 #endif
 
-        gs.spewPass("Allocate Registers [Backtracking]");
+        gs.spewPass(allocator == RegisterAllocator_Fast
+                        ? "Allocate Registers [Fast]"
+                        : "Allocate Registers [Backtracking]");
         break;
       }
 
@@ -1464,6 +1498,9 @@ CodeGenerator* CompileBackEnd(MIRGenerator* mir, WarpSnapshot* snapshot) {
   AutoEnterIonBackend enter(mir->safeForMinorGC());
   AutoSpewEndFunction spewEndFunction(mir);
 
+  GraphSpewer& gs = mir->graphSpewer();
+  gs.startTimingPasses(mir->outerInfo().script());
+
   MOZ_ASSERT(!!snapshot == JitOptions.warpBuilder);
 
   if (snapshot) {
@@ -1483,7 +1520,10 @@ CodeGenerator* CompileBackEnd(MIRGenerator* mir, WarpSnapshot* snapshot) {
     return nullptr;
   }
 
-  return GenerateCode(mir, lir);
+  CodeGenerator* codegen = GenerateCode(mir, lir);
+  gs.spewPassTime("Generate Code");
+  gs.spewTotalTime();
+  return codegen;
 }
 
 static void TrackIonAbort(JSContext* cx, JSScript* script, jsbytecode* pc,
@@ -1589,16 +1629,16 @@ static AbortReason BuildMIR(JSContext* cx, MIRGenerator* mirGen,
   return AbortReason::NoAbort;
 }
 
-static AbortReasonOr<WarpSnapshot*> CreateWarpSnapshot(JSContext* cx,
-                                                       MIRGenerator* mirGen,
-                                                       HandleScript script) {
+static AbortReasonOr<WarpSnapshot*> CreateWarpSnapshot(
+    JSContext* cx, MIRGenerator* mirGen, HandleScript script,
+    BaselineFrame* baselineFrame, uint32_t baselineFrameSize) {
   // Suppress GC. This matches the AutoEnterAnalysis (which suppresses GC) in
   // BuildMIR.
   gc::AutoSuppressGC suppressGC(cx);
 
   SpewBeginFunction(mirGen, script);
 
-  WarpOracle oracle(cx, *mirGen, script);
+  WarpOracle oracle(cx, *mirGen, script, baselineFrame, baselineFrameSize);
 
   AbortReasonOr<WarpSnapshot*> result = oracle.createSnapshot();
 
@@ -1692,8 +1732,8 @@ static AbortReason IonCompile(JSContext* cx, HandleScript script,
 
   WarpSnapshot* snapshot = nullptr;
   if (JitOptions.warpBuilder) {
-    AbortReasonOr<WarpSnapshot*> result =
-        CreateWarpSnapshot(cx, mirGen, script);
+    AbortReasonOr<WarpSnapshot*> result = CreateWarpSnapshot(
+        cx, mirGen, script, baselineFrame, baselineFrameSize);
     if (result.isErr()) {
       return result.unwrapErr();
     }
@@ -1938,6 +1978,16 @@ static MethodStatus Compile(JSContext* cx, HandleScript script,
     LinkIonScript(cx, script);
   }
 
+  // Back off if previous Ion code for this script was invalidated because of
+  // frequent bailouts. See JitScript::noteFrequentBailoutInvalidation.
+  if (!script->hasIonScript() &&
+      script->jitScript()->consumeIonCompileDelay(/* isOsr = */ !!osrPc)) {
+    JitSpew(JitSpew_IonAbort, "Delaying recompilation of %s:%u:%u",
+            script->filename(), script->lineno(), script->column());
+    script->resetWarmUpCounterToDelayIonCompilation();
+    return Method_Skipped;
+  }
+
   if (script->hasIonScript()) {
     IonScript* scriptIon = script->ionScript();
     if (!scriptIon->method()) {
@@ -1637,6 +1637,13 @@ static bool ShouldSpecializeOsrPhis() {
   // (1) Specialize phis but ignore MOsrValue phi inputs. In other words,
   //     pretend the OSR entry block doesn't exist. See GuessPhiType.
   //
+  //     The exception is MOsrValues with a type hint: WarpOracle records the
+  //     types of the values in the BaselineFrame we're compiling for, and
+  //     these are treated as typed phi inputs. This way the loop is
+  //     specialized for the types it's actually entered with. If later frames
+  //     have different types, the guards added in step (3) bail out and
+  //     frequent bailouts invalidate the IonScript.
+  //
   // (2) Once phi specialization is done, look at the types of loop header phis
   //     and add these types to the corresponding preheader phis. This way, the
   //     types of the preheader phis are based on the code before the loop and
@@ -1655,6 +1662,24 @@ static bool ShouldSpecializeOsrPhis() {
   return JitOptions.warpBuilder;
 }
 
+// Returns the type an OSR value is known to have in the frame we're compiling
+// for, if the OSR block can guard on it with a fallible unbox. Returns
+// MIRType::Value otherwise.
+static MIRType OsrValueTypeHint(MOsrValue* osrv) {
+  switch (osrv->typeHint()) {
+    case MIRType::Boolean:
+    case MIRType::Int32:
+    case MIRType::Double:
+    case MIRType::String:
+    case MIRType::Symbol:
+    case MIRType::BigInt:
+    case MIRType::Object:
+      return osrv->typeHint();
+    default:
+      return MIRType::Value;
+  }
+}
+
 // Try to specialize this phi based on its non-cyclic inputs.
 static MIRType GuessPhiType(MPhi* phi, bool* hasInputsWithEmptyTypes) {
 #ifdef DEBUG
@@ -1701,32 +1726,38 @@ static MIRType GuessPhiType(MPhi* phi, bool* hasInputsWithEmptyTypes) {
       continue;
     }
 
+    MIRType inType = in->type();
+    bool inCanProduceFloat32 = in->canProduceFloat32();
+
     // See ShouldSpecializeOsrPhis comment. This is the first step mentioned
     // there.
     if (ShouldSpecializeOsrPhis() && in->isOsrValue()) {
-      continue;
+      inType = OsrValueTypeHint(in->toOsrValue());
+      if (inType == MIRType::Value) {
+        continue;
+      }
     }
 
     if (type == MIRType::None) {
-      type = in->type();
-      if (in->canProduceFloat32()) {
+      type = inType;
+      if (inCanProduceFloat32) {
         convertibleToFloat32 = true;
       }
       continue;
     }
 
-    if (type == in->type()) {
-      convertibleToFloat32 = convertibleToFloat32 && in->canProduceFloat32();
+    if (type == inType) {
+      convertibleToFloat32 = convertibleToFloat32 && inCanProduceFloat32;
     } else {
-      if (convertibleToFloat32 && in->type() == MIRType::Float32) {
+      if (convertibleToFloat32 && inType == MIRType::Float32) {
         // If we only saw definitions that can be converted into Float32 before
         // and encounter a Float32 value, promote previous values to Float32
         type = MIRType::Float32;
       } else if (IsTypeRepresentableAsDouble(type) &&
-                 IsTypeRepresentableAsDouble(in->type())) {
+                 IsTypeRepresentableAsDouble(inType)) {
         // Specialize phis with int32 and double operands as double.
         type = MIRType::Double;
-        convertibleToFloat32 = convertibleToFloat32 && in->canProduceFloat32();
+        convertibleToFloat32 = convertibleToFloat32 && inCanProduceFloat32;
       } else {
         return MIRType::Value;
       }
@@ -1913,6 +1944,19 @@ bool TypeAnalyzer::specializePhis() {
       MOZ_ASSERT(header->isPendingLoopHeader());
       MOZ_ASSERT(header->numPredecessors() == 1);
     }
+
+    // Count the OSR values whose types in the frame we're compiling for were
+    // used to specialize the preheader phis.
+    uint32_t numSpecialized = 0;
+    for (MPhiIterator phi(preHeader->phisBegin()); phi != preHeader->phisEnd();
+         phi++) {
+      MDefinition* osrInput = phi->getOperand(1);
+      if (phi->type() != MIRType::Value && osrInput->isOsrValue() &&
+          OsrValueTypeHint(osrInput->toOsrValue()) != MIRType::Value) {
+        numSpecialized++;
+      }
+    }
+    mir->setNumSpecializedOsrValues(numSpecialized);
   }
 
   MOZ_ASSERT(phiWorklist_.empty());
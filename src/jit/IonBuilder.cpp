@@ -6694,6 +6694,7 @@ AbortReasonOr<Ok> IonBuilder::newArrayTryTemplateObject(
 
   MNewArray* ins =
       MNewArray::New(alloc(), constraints(), length, templateConst, heap, pc);
+  ins->setAllocSite(inspector->getAllocSite(pc));
   current->add(ins);
   current->push(ins);
 
@@ -6718,6 +6719,7 @@ AbortReasonOr<Ok> IonBuilder::newArrayTryVM(bool* emitted,
 
   MNewArray* ins =
       MNewArray::NewVM(alloc(), constraints(), length, templateConst, heap, pc);
+  ins->setAllocSite(inspector->getAllocSite(pc));
   current->add(ins);
   current->push(ins);
 
@@ -6807,6 +6809,7 @@ AbortReasonOr<Ok> IonBuilder::newObjectTryTemplateObject(
 
   MNewObject* ins =
       MNewObject::New(alloc(), constraints(), templateConst, heap, mode);
+  ins->setAllocSite(inspector->getAllocSite(pc));
   current->add(ins);
   current->push(ins);
 
@@ -6835,6 +6838,7 @@ AbortReasonOr<Ok> IonBuilder::newObjectTryVM(bool* emitted,
 
   MNewObject* ins = MNewObject::NewVM(alloc(), constraints(), templateConst,
                                       heap, MNewObject::ObjectLiteral);
+  ins->setAllocSite(inspector->getAllocSite(pc));
   current->add(ins);
   current->push(ins);
 
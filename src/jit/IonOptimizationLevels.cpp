@@ -36,6 +36,7 @@ void OptimizationInfo::initNormalOptimizationInfo() {
   sink_ = true;
 
   registerAllocator_ = RegisterAllocator_Backtracking;
+  fastRegisterAllocatorMinInstructions_ = 20000;
 
   inlineMaxBytecodePerCallSiteMainThread_ = 200;
   inlineMaxBytecodePerCallSiteHelperThread_ = 400;
@@ -58,6 +59,10 @@ void OptimizationInfo::initFullOptimizationInfo() {
   maxInlineDepth_ = 3;
   smallFunctionMaxInlineDepth_ = 10;
   inliningWarmUpThresholdFactor_ = 0.125;
+
+  // This is the last level, so there is no later recompilation that could
+  // improve on the fast register allocator's output.
+  fastRegisterAllocatorMinInstructions_ = UINT32_MAX;
 }
 
 void OptimizationInfo::initWasmOptimizationInfo() {
@@ -75,6 +80,9 @@ void OptimizationInfo::initWasmOptimizationInfo() {
   eliminateRedundantChecks_ = false;
   scalarReplacement_ = false;  // wasm has no objects.
   sink_ = false;
+
+  // Wasm functions are not recompiled.
+  fastRegisterAllocatorMinInstructions_ = UINT32_MAX;
 }
 
 uint32_t OptimizationInfo::compilerWarmUpThreshold(JSScript* script,
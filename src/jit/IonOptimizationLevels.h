@@ -103,6 +103,12 @@ class OptimizationInfo {
   // Describes which register allocator to use.
   IonRegisterAllocator registerAllocator_;
 
+  // Functions with at least this many LIR instructions use the fast register
+  // allocator instead, as the backtracking allocator's compilation time grows
+  // faster than linearly. Such functions are recompiled with
+  // registerAllocator_ if they reach the next optimization level.
+  uint32_t fastRegisterAllocatorMinInstructions_;
+
   // The maximum total bytecode size of an inline call site. We use a lower
   // value if off-thread compilation is not available, to avoid stalling the
   // main thread.
@@ -178,6 +184,7 @@ class OptimizationInfo {
         autoTruncate_(false),
         sink_(false),
         registerAllocator_(RegisterAllocator_Backtracking),
+        fastRegisterAllocatorMinInstructions_(UINT32_MAX),
         inlineMaxBytecodePerCallSiteHelperThread_(0),
         inlineMaxBytecodePerCallSiteMainThread_(0),
         inlineMaxCalleeInlinedBytecodeLength_(0),
@@ -238,8 +245,14 @@ class OptimizationInfo {
     return eliminateRedundantChecks_;
   }
 
-  IonRegisterAllocator registerAllocator() const {
-    return JitOptions.forcedRegisterAllocator.valueOr(registerAllocator_);
+  IonRegisterAllocator registerAllocator(uint32_t numLIRInstructions) const {
+    if (JitOptions.forcedRegisterAllocator.isSome()) {
+      return JitOptions.forcedRegisterAllocator.ref();
+    }
+    if (numLIRInstructions >= fastRegisterAllocatorMinInstructions_) {
+      return RegisterAllocator_Fast;
+    }
+    return registerAllocator_;
   }
 
   bool scalarReplacementEnabled() const {
@@ -127,6 +127,10 @@ class alignas(8) IonScript final : public TrailingArray {
   // a LOOPENTRY pc other than osrPc_.
   uint32_t osrPcMismatchCounter_ = 0;
 
+  // For OSR compilations, the number of OSR entry values that were
+  // specialized on the types of the frame the compilation was triggered from.
+  uint32_t numSpecializedOsrValues_ = 0;
+
   // TraceLogger events that are baked into the IonScript.
   TraceLoggerEventVector traceLoggerEvents_;
 
@@ -309,6 +313,8 @@ class alignas(8) IonScript final : public TrailingArray {
     osrEntryOffset_ = offset;
   }
   uint32_t osrEntryOffset() const { return osrEntryOffset_; }
+  void setNumSpecializedOsrValues(uint32_t n) { numSpecializedOsrValues_ = n; }
+  uint32_t numSpecializedOsrValues() const { return numSpecializedOsrValues_; }
   void setSkipArgCheckEntryOffset(uint32_t offset) {
     MOZ_ASSERT(!skipArgCheckEntryOffset_);
     skipArgCheckEntryOffset_ = offset;
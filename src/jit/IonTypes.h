@@ -179,6 +179,11 @@ enum class BailoutKind : uint8_t {
   // Bailout triggered by MGuardNullOrUndefined.
   NullOrUndefinedGuard,
 
+  // Bailout from an instruction that LICM hoisted out of a loop. It is used
+  // instead of the instruction's own kind, unless that kind is handled
+  // specially when resuming in Baseline.
+  LICM,
+
   // When we're trying to use an uninitialized lexical.
   UninitializedLexical,
 
@@ -265,6 +270,8 @@ inline const char* BailoutKindString(BailoutKind kind) {
       return "BailoutKind::ValueGuard";
     case BailoutKind::NullOrUndefinedGuard:
       return "BailoutKind::NullOrUndefinedGuard";
+    case BailoutKind::LICM:
+      return "BailoutKind::LICM";
     case BailoutKind::UninitializedLexical:
       return "BailoutKind::UninitializedLexical";
     case BailoutKind::IonExceptionDebugMode:
@@ -96,6 +96,7 @@ class JitCode : public gc::TenuredCellWithNonGCPointer<uint8_t> {
   size_t instructionsSize() const { return insnSize_; }
   size_t bufferSize() const { return bufferSize_; }
   size_t headerSize() const { return headerSize_; }
+  ExecutablePool* pool() const { return pool_; }
 
   void traceChildren(JSTracer* trc);
   void finalize(JSFreeOp* fop);
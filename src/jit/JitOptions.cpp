@@ -114,6 +114,11 @@ DefaultJitOptions::DefaultJitOptions() {
   // Toggles whether CacheIR stubs are used.
   SET_DEFAULT(disableCacheIR, false);
 
+  // Whether the code for common Baseline CacheIR stubs is compiled when a
+  // zone starts running JIT code, rather than when each stub is first
+  // attached.
+  SET_DEFAULT(baselineCacheIRStubCorpus, false);
+
   // Toggles whether sink code motion is globally disabled.
   SET_DEFAULT(disableSink, true);
 
@@ -196,6 +201,11 @@ DefaultJitOptions::DefaultJitOptions() {
   // Duplicated in all.js - ensure both match.
   SET_DEFAULT(frequentBailoutThreshold, 10);
 
+  // Per-zone budget for Baseline and Ion code, in kilobytes. When a GC
+  // preserves JIT code and the zone is over budget, the code of the scripts
+  // that have not run for the longest time is discarded. 0 means no limit.
+  SET_DEFAULT(jitCodeBudgetKB, 0);
+
   // Whether to run all debug checks in debug builds.
   // Disabling might make it more enjoyable to run JS in debug builds.
   SET_DEFAULT(fullDebugChecks, true);
@@ -283,6 +293,12 @@ DefaultJitOptions::DefaultJitOptions() {
   SET_DEFAULT(wasmBatchIonThreshold, 1100);
   SET_DEFAULT(wasmBatchCraneliftThreshold, 5000);
 
+  // When nonzero, tiered wasm compilation defers tier-2 compilation until a
+  // function has been entered or has iterated a loop this many times, and
+  // then only optimizes the functions that are warm. When zero, the whole
+  // module is compiled at tier-2 as soon as tier-1 is done.
+  SET_DEFAULT(wasmTierUpThreshold, 0);
+
 #ifdef JS_TRACE_LOGGING
   // Toggles whether the traceLogger should be on or off.  In either case,
   // some data structures will always be created and initialized such as
@@ -19,6 +19,7 @@ namespace jit {
 enum IonRegisterAllocator {
   RegisterAllocator_Backtracking,
   RegisterAllocator_Testbed,
+  RegisterAllocator_Fast,
 };
 
 static inline mozilla::Maybe<IonRegisterAllocator> LookupRegisterAllocator(
@@ -29,6 +30,9 @@ static inline mozilla::Maybe<IonRegisterAllocator> LookupRegisterAllocator(
   if (!strcmp(name, "testbed")) {
     return mozilla::Some(RegisterAllocator_Testbed);
   }
+  if (!strcmp(name, "fast")) {
+    return mozilla::Some(RegisterAllocator_Fast);
+  }
   return mozilla::Nothing();
 }
 
@@ -52,6 +56,7 @@ struct DefaultJitOptions {
   bool disableRecoverIns;
   bool disableScalarReplacement;
   bool disableCacheIR;
+  bool baselineCacheIRStubCorpus;
   bool disableSink;
   bool disableOptimizationLevels;
   bool baselineInterpreter;
@@ -92,6 +97,7 @@ struct DefaultJitOptions {
   uint32_t regexpWarmUpThreshold;
   uint32_t exceptionBailoutThreshold;
   uint32_t frequentBailoutThreshold;
+  uint32_t jitCodeBudgetKB;
   uint32_t maxStackArgs;
   uint32_t osrPcMismatchesBeforeRecompile;
   uint32_t smallFunctionMaxBytecodeLength_;
@@ -108,6 +114,7 @@ struct DefaultJitOptions {
   uint32_t wasmBatchBaselineThreshold;
   uint32_t wasmBatchIonThreshold;
   uint32_t wasmBatchCraneliftThreshold;
+  uint32_t wasmTierUpThreshold;
   mozilla::Maybe<IonRegisterAllocator> forcedRegisterAllocator;
 
   // Spectre mitigation flags. Each mitigation has its own flag in order to
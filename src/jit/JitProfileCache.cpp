@@ -0,0 +1,322 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jit/JitProfileCache.h"
+
+#include "mozilla/CheckedInt.h"
+#include "mozilla/Utf8.h"
+
+#include <algorithm>
+#include <string.h>
+#include <utility>
+
+#include "jit/BaselineIC.h"
+#include "jit/IonOptimizationLevels.h"
+#include "jit/JitOptions.h"
+#include "jit/JitRealm.h"
+#include "jit/JitScript.h"
+#include "jit/TrialInlining.h"
+#include "js/experimental/JitProfile.h"  // JS::{Save,Load,Clear}JitProfile
+#include "js/friend/ErrorMessages.h"      // js::GetErrorMessage, JSMSG_*
+#include "vm/JSContext.h"
+#include "vm/JSScript.h"
+#include "vm/Runtime.h"
+
+#include "gc/GC-inl.h"
+
+using namespace js;
+using namespace js::jit;
+
+using mozilla::CheckedInt;
+
+// The profile is a header followed by a list of entries, all stored as
+// uint32_t values in native byte order:
+//
+//   magic, version, entry count
+//   { source hash, source start, source end, warm-up count, flags } * count
+static const uint32_t ProfileMagic = 0x4a495450;  // 'JITP'
+static const uint32_t ProfileVersion = 2;
+static const size_t HeaderWords = 3;
+static const size_t EntryWords = 5;
+
+template <typename Unit>
+static bool HashSourceText(JSContext* cx, ScriptSource* ss, size_t begin,
+                           size_t length, HashNumber* hash) {
+  UncompressedSourceCache::AutoHoldEntry holder;
+  ScriptSource::PinnedUnits<Unit> units(cx, ss, holder, begin, length);
+  if (!units.get()) {
+    return false;
+  }
+
+  *hash = mozilla::HashBytes(units.get(), length * sizeof(Unit));
+  return true;
+}
+
+/* static */
+bool JitProfileCache::keyFor(JSContext* cx, BaseScript* script,
+                             mozilla::Maybe<Key>* key) {
+  key->reset();
+
+  ScriptSource* ss = script->scriptSource();
+  const char* filename = ss->filename();
+  if (!filename || !ss->hasSourceText()) {
+    return true;
+  }
+
+  // Hash the script's own source text, so that a script whose text changed
+  // doesn't pick up a stale entry even if its extent is the same.
+  uint32_t begin = script->sourceStart();
+  uint32_t length = script->sourceEnd() - begin;
+  HashNumber textHash;
+  if (ss->hasSourceType<mozilla::Utf8Unit>()) {
+    if (!HashSourceText<mozilla::Utf8Unit>(cx, ss, begin, length, &textHash)) {
+      return false;
+    }
+  } else {
+    MOZ_ASSERT(ss->hasSourceType<char16_t>());
+    if (!HashSourceText<char16_t>(cx, ss, begin, length, &textHash)) {
+      return false;
+    }
+  }
+
+  key->emplace();
+  (*key)->sourceHash =
+      mozilla::AddToHash(mozilla::HashString(filename), textHash);
+  (*key)->sourceStart = script->sourceStart();
+  (*key)->sourceEnd = script->sourceEnd();
+  return true;
+}
+
+uint32_t JitProfileCache::warmUpCountFor(JSContext* cx,
+                                         JSScript* script) const {
+  if (entries_.empty()) {
+    return 0;
+  }
+
+  // The profile is only a hint, so failing to look the script up just means
+  // it warms up as usual.
+  mozilla::Maybe<Key> key;
+  if (!keyFor(cx, script, &key)) {
+    cx->recoverFromOutOfMemory();
+    return 0;
+  }
+  if (key.isNothing()) {
+    return 0;
+  }
+
+  auto p = entries_.lookup(*key);
+  if (!p) {
+    return 0;
+  }
+
+  const Entry& entry = p->value();
+  uint32_t warmUpCount = entry.warmUpCount;
+  if (entry.flags & CallTarget) {
+    warmUpCount =
+        std::max(warmUpCount, JitOptions.baselineJitWarmUpThreshold + 1);
+  }
+  if (entry.flags & IonCompiled) {
+    warmUpCount = std::max(
+        warmUpCount, IonOptimizations.get(OptimizationLevel::Normal)
+                         ->compilerWarmUpThreshold(script));
+  }
+  return warmUpCount;
+}
+
+static uint32_t ReadWord(const uint8_t* data, size_t index) {
+  uint32_t word;
+  memcpy(&word, data + index * sizeof(uint32_t), sizeof(uint32_t));
+  return word;
+}
+
+bool JitProfileCache::load(JSContext* cx, const uint8_t* data, size_t length) {
+  auto reportBadProfile = [cx]() {
+    JS_ReportErrorNumberASCII(cx, GetErrorMessage, nullptr,
+                              JSMSG_BAD_JIT_PROFILE);
+    return false;
+  };
+
+  if (length < HeaderWords * sizeof(uint32_t) ||
+      ReadWord(data, 0) != ProfileMagic ||
+      ReadWord(data, 1) != ProfileVersion) {
+    return reportBadProfile();
+  }
+
+  uint32_t count = ReadWord(data, 2);
+  CheckedInt<size_t> expectedLength = count;
+  expectedLength *= EntryWords;
+  expectedLength += HeaderWords;
+  expectedLength *= sizeof(uint32_t);
+  if (!expectedLength.isValid() || expectedLength.value() != length) {
+    return reportBadProfile();
+  }
+
+  EntryMap entries;
+  if (!entries.reserve(count)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    size_t base = HeaderWords + i * EntryWords;
+    Key key;
+    key.sourceHash = ReadWord(data, base);
+    key.sourceStart = ReadWord(data, base + 1);
+    key.sourceEnd = ReadWord(data, base + 2);
+    Entry entry;
+    entry.warmUpCount = ReadWord(data, base + 3);
+    entry.flags = ReadWord(data, base + 4);
+    if (key.sourceStart > key.sourceEnd || (entry.flags & ~AllFlags)) {
+      return reportBadProfile();
+    }
+
+    // Scripts with identical keys can't be distinguished so keep the larger
+    // count and the union of the flags.
+    auto p = entries.lookupForAdd(key);
+    if (p) {
+      p->value().warmUpCount =
+          std::max(p->value().warmUpCount, entry.warmUpCount);
+      p->value().flags |= entry.flags;
+    } else if (!entries.add(p, key, entry)) {
+      ReportOutOfMemory(cx);
+      return false;
+    }
+  }
+
+  entries_ = std::move(entries);
+  return true;
+}
+
+static bool AppendWord(JS::TranscodeBuffer& buffer, uint32_t word) {
+  return buffer.append(reinterpret_cast<const uint8_t*>(&word),
+                       sizeof(uint32_t));
+}
+
+// Find the scripts that are the single target of a call IC, which trial
+// inlining would consider inlining.
+using ScriptSet = HashSet<BaseScript*, DefaultHasher<BaseScript*>,
+                          SystemAllocPolicy>;
+static bool FindCallTargets(JSContext* cx, ScriptSet& targets) {
+  for (ZonesIter zone(cx->runtime(), SkipAtoms); !zone.done(); zone.next()) {
+    for (auto base = zone->cellIter<BaseScript>(); !base.done(); base.next()) {
+      if (!base->hasJitScript()) {
+        continue;
+      }
+
+      JSScript* script = base->asJSScript();
+      ICScript* icScript = script->jitScript()->icScript();
+      for (size_t i = 0; i < icScript->numICEntries(); i++) {
+        ICEntry& entry = icScript->icEntry(i);
+        if (entry.isForPrologue()) {
+          continue;
+        }
+        JSOp op = JSOp(*entry.pc(script));
+        if (op != JSOp::Call && op != JSOp::CallIgnoresRv) {
+          continue;
+        }
+
+        ICStub* stub = entry.firstStub();
+        if (stub->isFallback() || !stub->next()->isFallback()) {
+          continue;
+        }
+
+        mozilla::Maybe<InlinableCallData> data = FindInlinableCallData(stub);
+        if (data.isNothing() || !data->target->hasBaseScript()) {
+          continue;
+        }
+
+        if (!targets.put(data->target->baseScript())) {
+          ReportOutOfMemory(cx);
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+/* static */
+bool JitProfileCache::save(JSContext* cx, JS::TranscodeBuffer& buffer) {
+  MOZ_ASSERT(buffer.empty());
+
+  ScriptSet callTargets;
+  if (!FindCallTargets(cx, callTargets)) {
+    return false;
+  }
+
+  if (!AppendWord(buffer, ProfileMagic) ||
+      !AppendWord(buffer, ProfileVersion) || !AppendWord(buffer, 0)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  uint32_t count = 0;
+  for (ZonesIter zone(cx->runtime(), SkipAtoms); !zone.done(); zone.next()) {
+    for (auto base = zone->cellIter<BaseScript>(); !base.done(); base.next()) {
+      if (!base->hasJitScript()) {
+        continue;
+      }
+
+      JitScript* jitScript = base->asJSScript()->jitScript();
+      Entry entry;
+      entry.warmUpCount = jitScript->warmUpCount();
+      if (jitScript->hasIonScript()) {
+        entry.flags |= IonCompiled;
+      }
+      if (callTargets.has(base)) {
+        entry.flags |= CallTarget;
+      }
+      if (!entry.warmUpCount && !entry.flags) {
+        continue;
+      }
+
+      mozilla::Maybe<Key> key;
+      if (!keyFor(cx, base, &key)) {
+        return false;
+      }
+      if (key.isNothing()) {
+        continue;
+      }
+
+      if (!AppendWord(buffer, key->sourceHash) ||
+          !AppendWord(buffer, key->sourceStart) ||
+          !AppendWord(buffer, key->sourceEnd) ||
+          !AppendWord(buffer, entry.warmUpCount) ||
+          !AppendWord(buffer, entry.flags)) {
+        ReportOutOfMemory(cx);
+        return false;
+      }
+      count++;
+    }
+  }
+
+  memcpy(buffer.begin() + 2 * sizeof(uint32_t), &count, sizeof(uint32_t));
+  return true;
+}
+
+JS_PUBLIC_API bool JS::SaveJitProfile(JSContext* cx,
+                                      JS::TranscodeBuffer& buffer) {
+  return JitProfileCache::save(cx, buffer);
+}
+
+JS_PUBLIC_API bool JS::LoadJitProfile(JSContext* cx, const uint8_t* data,
+                                      size_t length) {
+  JitRuntime* jrt = cx->runtime()->jitRuntime();
+  if (!jrt) {
+    // Without a JIT there is nothing to warm up, but still check the data.
+    JitProfileCache unused;
+    return unused.load(cx, data, length);
+  }
+
+  return jrt->profileCache().load(cx, data, length);
+}
+
+JS_PUBLIC_API void JS::ClearJitProfile(JSContext* cx) {
+  if (JitRuntime* jrt = cx->runtime()->jitRuntime()) {
+    jrt->profileCache().clear();
+  }
+}
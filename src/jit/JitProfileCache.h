@@ -0,0 +1,109 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef jit_JitProfileCache_h
+#define jit_JitProfileCache_h
+
+#include "mozilla/HashFunctions.h"
+#include "mozilla/Maybe.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "js/HashTable.h"
+#include "js/Transcoding.h"
+#include "js/TypeDecls.h"
+
+namespace js {
+
+class BaseScript;
+
+namespace jit {
+
+/*
+ * A JIT profile records how hot each script was in a previous run so that a
+ * later run can skip most of the warm-up phase.
+ *
+ * Scripts are identified by their filename, a hash of their source text and
+ * their source extent, so editing a script invalidates its entries. For each
+ * script the profile records:
+ *
+ *  - its warm-up count;
+ *  - whether it had Ion code, in which case a new JitScript starts at the Ion
+ *    warm-up threshold and the script is compiled off-thread as soon as it
+ *    reaches a warm-up check in Baseline code;
+ *  - whether it was the single target of a call IC, which is what trial
+ *    inlining looks for. Such scripts start above the Baseline JIT threshold,
+ *    so that they already have Baseline code when their callers try to inline
+ *    them.
+ *
+ * IC stub shapes and the callee of each call site are not recorded. They refer
+ * to shapes, groups and functions that only exist in the process that created
+ * them; the flags above are what carries over to a new process.
+ */
+class JitProfileCache {
+ public:
+  struct Key {
+    HashNumber sourceHash;
+    uint32_t sourceStart;
+    uint32_t sourceEnd;
+
+    bool operator==(const Key& other) const {
+      return sourceHash == other.sourceHash &&
+             sourceStart == other.sourceStart && sourceEnd == other.sourceEnd;
+    }
+  };
+
+  struct KeyHasher {
+    using Lookup = Key;
+    static HashNumber hash(const Lookup& key) {
+      return mozilla::AddToHash(key.sourceHash, key.sourceStart,
+                                key.sourceEnd);
+    }
+    static bool match(const Key& key, const Lookup& lookup) {
+      return key == lookup;
+    }
+  };
+
+  enum Flags : uint32_t {
+    IonCompiled = 1 << 0,
+    CallTarget = 1 << 1,
+  };
+  static const uint32_t AllFlags = IonCompiled | CallTarget;
+
+  struct Entry {
+    uint32_t warmUpCount = 0;
+    uint32_t flags = 0;
+  };
+
+  // Set |*key| to the key for |script|, or to Nothing if |script| can't be
+  // identified across runs. Returns false on OOM.
+  static MOZ_MUST_USE bool keyFor(JSContext* cx, BaseScript* script,
+                                  mozilla::Maybe<Key>* key);
+
+  bool empty() const { return entries_.empty(); }
+  void clear() { entries_.clearAndCompact(); }
+
+  // Returns the warm-up count a new JitScript for |script| should start with,
+  // or zero if the profile has nothing for it.
+  uint32_t warmUpCountFor(JSContext* cx, JSScript* script) const;
+
+  // Replace the contents of the cache with a profile previously produced by
+  // save(). Reports an error if the data is malformed.
+  MOZ_MUST_USE bool load(JSContext* cx, const uint8_t* data, size_t length);
+
+  // Write the profile of all scripts in the runtime to |buffer|.
+  static MOZ_MUST_USE bool save(JSContext* cx, JS::TranscodeBuffer& buffer);
+
+ private:
+  using EntryMap = HashMap<Key, Entry, KeyHasher, SystemAllocPolicy>;
+  EntryMap entries_;
+};
+
+}  // namespace jit
+}  // namespace js
+
+#endif /* jit_JitProfileCache_h */
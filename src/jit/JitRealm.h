@@ -21,6 +21,7 @@
 #include "jit/ICStubSpace.h"
 #include "jit/JitCode.h"
 #include "jit/JitFrames.h"
+#include "jit/JitProfileCache.h"
 #include "jit/shared/Assembler-shared.h"
 #include "js/GCHashTable.h"
 #include "js/Value.h"
@@ -240,6 +241,9 @@ class JitRuntime {
   // Counter used to help dismbiguate stubs in CacheIR
   MainThreadData<uint64_t> disambiguationId_{0};
 
+  // Warm-up counts from a previous run, used to seed new JitScripts.
+  MainThreadData<JitProfileCache> profileCache_;
+
 #ifdef DEBUG
   // Flag that can be set from JIT code to indicate it's invalid to call
   // arbitrary JS code in a particular region. This is checked in RunScript.
@@ -443,6 +447,8 @@ class JitRuntime {
   void ionLazyLinkListAdd(JSRuntime* rt, js::jit::IonCompileTask* task);
 
   uint64_t nextDisambiguationId() { return disambiguationId_++; }
+
+  JitProfileCache& profileCache() { return profileCache_.ref(); }
 };
 
 enum class CacheKind : uint8_t;
@@ -504,6 +510,20 @@ class JitZone {
                 SystemAllocPolicy, IcStubCodeMapGCPolicy<CacheIRStubKey>>;
   BaselineCacheIRStubCodeMap baselineCacheIRStubCodes_;
 
+  // Whether the stubs in the Baseline CacheIR stub corpus have been compiled.
+  bool baselineCacheIRStubCorpusCompiled_ = false;
+
+  // The stub code compiled for the corpus. It is held weakly, so that it
+  // doesn't keep the zone alive. When any of it dies the whole corpus is
+  // dropped, and it is compiled again when a realm in the zone next creates
+  // its JitRealm.
+  using BaselineCacheIRStubCorpus =
+      HashSet<JitCode*, DefaultHasher<JitCode*>, SystemAllocPolicy>;
+  BaselineCacheIRStubCorpus baselineCacheIRStubCorpus_;
+
+  // The number of Baseline IC stubs attached using code from the corpus.
+  size_t baselineCacheIRStubCorpusHits_ = 0;
+
   // Executable allocator for all code except wasm code.
   MainThreadData<ExecutableAllocator> execAlloc_;
 
@@ -534,6 +554,22 @@ class JitZone {
     return baselineCacheIRStubCodes_.add(p, std::move(key), stubCode);
   }
 
+  // Compile the stub code for common Baseline IC stubs up front, so that
+  // attaching them only needs a lookup.
+  MOZ_MUST_USE bool ensureBaselineCacheIRStubCorpus(JSContext* cx);
+
+  size_t baselineCacheIRStubCorpusLength() const {
+    return baselineCacheIRStubCorpus_.count();
+  }
+  size_t baselineCacheIRStubCorpusHits() const {
+    return baselineCacheIRStubCorpusHits_;
+  }
+  void noteBaselineCacheIRStubCode(JitCode* code) {
+    if (baselineCacheIRStubCorpus_.has(code)) {
+      baselineCacheIRStubCorpusHits_++;
+    }
+  }
+
   CacheIRStubInfo* getIonCacheIRStubInfo(const CacheIRStubKey::Lookup& key) {
     IonCacheIRStubInfoSet::Ptr p = ionCacheIRStubInfoSet_.lookup(key);
     return p ? p->stubInfo.get() : nullptr;
@@ -10,11 +10,13 @@
 #include "mozilla/IntegerPrintfMacros.h"
 #include "mozilla/ScopeExit.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "jit/BaselineIC.h"
 #include "jit/BytecodeAnalysis.h"
 #include "jit/IonScript.h"
+#include "jit/JitRealm.h"
 #include "util/Memory.h"
 #include "vm/BytecodeIterator.h"
 #include "vm/BytecodeLocation.h"
@@ -170,6 +172,15 @@ bool JSScript::createJitScript(JSContext* cx) {
   warmUpData_.initJitScript(jitScript.release());
   AddCellMemory(this, allocSize.value(), MemoryUse::JitScript);
 
+  // Scripts that were hot in a previous run start out warmed up.
+  if (JitRuntime* jrt = cx->runtime()->jitRuntime()) {
+    uint32_t profiledWarmUpCount =
+        jrt->profileCache().warmUpCountFor(cx, this);
+    if (profiledWarmUpCount > this->jitScript()->warmUpCount()) {
+      this->jitScript()->resetWarmUpCount(profiledWarmUpCount);
+    }
+  }
+
   // We have a JitScript so we can set the script's jitCodeRaw pointer to the
   // Baseline Interpreter code.
   updateJitCodeRaw(cx->runtime());
@@ -615,6 +626,135 @@ void JitScript::removeDependentWasmImport(wasm::Instance& instance,
   }
 }
 
+void JitScript::noteBailout(uint32_t pcOffset, BailoutKind kind) {
+  // Bailout data is only used for heuristics and reporting, so ignore OOM.
+  if (!bailoutData_) {
+    bailoutData_ = js::MakeUnique<BailoutData>();
+    if (!bailoutData_) {
+      return;
+    }
+  }
+
+  auto& sites = bailoutData_->sites;
+  BailoutSite* site = nullptr;
+  for (BailoutSite& s : sites) {
+    if (s.pcOffset == pcOffset && s.kind == kind) {
+      site = &s;
+      break;
+    }
+  }
+  if (!site) {
+    if (sites.length() >= MaxBailoutSites ||
+        !sites.emplaceBack(pcOffset, kind)) {
+      return;
+    }
+    site = &sites.back();
+  }
+
+  site->count++;
+  site->recentCount++;
+}
+
+void JitScript::noteFrequentBailoutInvalidation() {
+  if (!bailoutData_) {
+    bailoutData_ = js::MakeUnique<BailoutData>();
+    if (!bailoutData_) {
+      return;
+    }
+  }
+
+  // Recompile as usual after the first invalidation. After that, skip
+  // 2^n - 1 compilation attempts after the (n+1)th invalidation so that
+  // scripts that keep bailing out don't keep the compiler busy.
+  static constexpr uint32_t MaxDelayShift = 6;
+  uint32_t shift = std::min(bailoutData_->numInvalidations, MaxDelayShift);
+  bailoutData_->numInvalidations++;
+  bailoutData_->ionCompileDelay = (uint32_t(1) << shift) - 1;
+  bailoutData_->skippedDelayForOsr = false;
+
+  for (BailoutSite& site : bailoutData_->sites) {
+    site.recentCount = 0;
+  }
+}
+
+bool JitScript::disableLICMForFrequentBailouts(JSScript* script) {
+  if (!bailoutData_) {
+    return false;
+  }
+
+  // Bailouts from instructions hoisted by LICM are reported as
+  // BailoutKind::LICM at the head of the loop they were hoisted out of. Find
+  // the site responsible for most of the recent bailouts and check whether
+  // it's one of those. Other bailouts, such as failed unboxes when entering a
+  // loop through OSR, may resume at a loop head too.
+  BailoutSite* hottest = nullptr;
+  uint32_t totalRecent = 0;
+  size_t numDisabled = 0;
+  for (BailoutSite& site : bailoutData_->sites) {
+    totalRecent += site.recentCount;
+    if (site.licmDisabled) {
+      numDisabled++;
+    }
+    if (!hottest || site.recentCount > hottest->recentCount) {
+      hottest = &site;
+    }
+  }
+
+  if (!hottest || hottest->recentCount * 2 <= totalRecent ||
+      hottest->kind != BailoutKind::LICM) {
+    return false;
+  }
+
+  jsbytecode* pc = script->offsetToPC(hottest->pcOffset);
+  if (JSOp(*pc) != JSOp::LoopHead) {
+    return false;
+  }
+
+  if (isLICMDisabledForLoop(hottest->pcOffset)) {
+    // Hoisting is already disabled for this loop, so the bailouts are caused
+    // by something else.
+    return false;
+  }
+
+  if (numDisabled >= MaxLICMDisabledLoops) {
+    return false;
+  }
+
+  hottest->licmDisabled = true;
+  return true;
+}
+
+bool JitScript::isLICMDisabledForLoop(uint32_t pcOffset) const {
+  if (!bailoutData_) {
+    return false;
+  }
+
+  for (const BailoutSite& site : bailoutData_->sites) {
+    if (site.pcOffset == pcOffset && site.licmDisabled) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool JitScript::consumeIonCompileDelay(bool isOsr) {
+  if (!bailoutData_ || bailoutData_->ionCompileDelay == 0) {
+    return false;
+  }
+
+  bailoutData_->ionCompileDelay--;
+
+  // Let one OSR compilation through, so that a script invalidated while
+  // running a long loop doesn't stay in Baseline until the loop exits. Further
+  // OSR attempts wait like any other, as each can be invalidated again.
+  if (isOsr && !bailoutData_->skippedDelayForOsr) {
+    bailoutData_->skippedDelayForOsr = true;
+    return false;
+  }
+
+  return true;
+}
+
 JitScript::CachedIonData::CachedIonData(EnvironmentObject* templateEnv,
                                         IonBytecodeInfo bytecodeInfo)
     : templateEnv(templateEnv), bytecodeInfo(bytecodeInfo) {}
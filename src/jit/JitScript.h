@@ -31,6 +31,25 @@ struct DependentWasmImport {
       : instance(&instance), importIndex(importIndex) {}
 };
 
+// Bailouts from Ion code that resumed at a particular bytecode location of a
+// script for a particular reason. See JitScript::noteBailout.
+struct BailoutSite {
+  uint32_t pcOffset;
+  BailoutKind kind;
+
+  // Whether LICM has been disabled for the loop starting at this site. See
+  // JitScript::disableLICMForFrequentBailouts.
+  bool licmDisabled = false;
+
+  // The total number of bailouts at this site, and the number since the script
+  // was last invalidated because of frequent bailouts.
+  uint32_t count = 0;
+  uint32_t recentCount = 0;
+
+  BailoutSite(uint32_t pcOffset, BailoutKind kind)
+      : pcOffset(pcOffset), kind(kind) {}
+};
+
 // Information about a script's bytecode, used by IonBuilder. This is cached
 // in JitScript.
 struct IonBytecodeInfo {
@@ -304,6 +323,26 @@ class alignas(uintptr_t) JitScript final : public TrailingArray {
   };
   js::UniquePtr<CachedIonData> cachedIonData_;
 
+  // Data allocated lazily the first time Ion code bails out to this script or
+  // is invalidated because of frequent bailouts.
+  struct BailoutData {
+    // Bailout sites, at most MaxBailoutSites of them.
+    Vector<BailoutSite, 0, SystemAllocPolicy> sites;
+
+    // The number of times Ion code for this script was invalidated because of
+    // frequent bailouts.
+    uint32_t numInvalidations = 0;
+
+    // The number of times Ion compilation must be skipped before this script
+    // is recompiled. See noteFrequentBailoutInvalidation.
+    uint32_t ionCompileDelay = 0;
+
+    // Whether an OSR compilation has skipped the delay since the last
+    // invalidation. See consumeIonCompileDelay.
+    bool skippedDelayForOsr = false;
+  };
+  js::UniquePtr<BailoutData> bailoutData_;
+
   // Baseline code for the script. Either nullptr, BaselineDisabledScriptPtr or
   // a valid BaselineScript*.
   BaselineScript* baselineScript_ = nullptr;
@@ -325,6 +364,12 @@ class alignas(uintptr_t) JitScript final : public TrailingArray {
   // bytecode map queries are in linear order.
   uint32_t bytecodeTypeMapHint_ = 0;
 
+  // Used to find cold scripts when the zone is over its JIT code budget. The
+  // warm-up counter is sampled on each GC and gcsSinceLastRun_ counts the GCs
+  // for which it did not change. See Zone::discardColdJitCode.
+  uint32_t warmUpCountAtLastGC_ = 0;
+  uint32_t gcsSinceLastRun_ = 0;
+
   struct Flags {
     // Flag set when discarding JIT code to indicate this script is on the stack
     // and type information and JIT code should not be discarded.
@@ -445,6 +490,19 @@ class alignas(uintptr_t) JitScript final : public TrailingArray {
   void setActive() { flags_.active = true; }
   void resetActive() { flags_.active = false; }
 
+  // Update gcsSinceLastRun() for a GC. Must be called after marking active
+  // scripts. Scripts only running Ion code that doesn't check the warm-up
+  // counter look cold unless they're on the stack.
+  void noteGCForColdness(uint32_t warmUpCount) {
+    if (active() || warmUpCount != warmUpCountAtLastGC_) {
+      warmUpCountAtLastGC_ = warmUpCount;
+      gcsSinceLastRun_ = 0;
+    } else if (gcsSinceLastRun_ < UINT32_MAX) {
+      gcsSinceLastRun_++;
+    }
+  }
+  uint32_t gcsSinceLastRun() const { return gcsSinceLastRun_; }
+
   void ensureProfileString(JSContext* cx, JSScript* script);
 
   const char* profileString() const {
@@ -579,6 +637,36 @@ class alignas(uintptr_t) JitScript final : public TrailingArray {
 
   ICEntry& icEntry(size_t index) { return icScript_.icEntry(index); }
 
+  // Bailout sites beyond this limit are not recorded.
+  static constexpr size_t MaxBailoutSites = 32;
+
+  // LICM is disabled for at most this many loops in a script. If frequent
+  // bailouts happen for more loops, LICM is disabled for the whole script.
+  static constexpr size_t MaxLICMDisabledLoops = 4;
+
+  // Record a bailout from Ion code that resumed in this script at |pcOffset|.
+  void noteBailout(uint32_t pcOffset, BailoutKind kind);
+
+  // Called when Ion code for this script is invalidated because of frequent
+  // bailouts. Delays recompilation exponentially in the number of such
+  // invalidations.
+  void noteFrequentBailoutInvalidation();
+
+  // If the recent bailouts for this script come mostly from instructions
+  // hoisted out of a single loop, disable LICM for that loop only and return
+  // true. Returns false if
+  // LICM has to be disabled for the whole script instead.
+  bool disableLICMForFrequentBailouts(JSScript* script);
+
+  bool isLICMDisabledForLoop(uint32_t pcOffset) const;
+
+  // Returns true if the next attempt to Ion-compile this script should be
+  // skipped because of the recompilation delay. The first OSR compilation
+  // after an invalidation isn't skipped, but still counts as an attempt.
+  bool consumeIonCompileDelay(bool isOsr);
+
+  const BailoutData* bailoutData() const { return bailoutData_.get(); }
+
   // Used to inform IonBuilder that a getter has been used and we must
   // use a type barrier.
   void noteAccessedGetter(uint32_t pcOffset);
@@ -256,7 +256,42 @@ void GraphSpewer::beginWasmFunction(unsigned funcIndex) {
   ionspewer.beginFunction();
 }
 
+void GraphSpewer::startTimingPasses(JSScript* script) {
+  if (!JitSpewEnabled(JitSpew_IonPassTimes)) {
+    return;
+  }
+
+  JitSpew(JitSpew_IonPassTimes, "Backend pass times for %s:%u:%u",
+          script->filename(), script->lineno(), script->column());
+  backendStart_ = mozilla::TimeStamp::Now();
+  lastPassEnd_ = backendStart_;
+}
+
+void GraphSpewer::spewPassTime(const char* pass) {
+  if (lastPassEnd_.IsNull()) {
+    return;
+  }
+
+  mozilla::TimeStamp now = mozilla::TimeStamp::Now();
+  JitSpew(JitSpew_IonPassTimes, "  %-40s %10.3f ms", pass,
+          (now - lastPassEnd_).ToMilliseconds());
+  lastPassEnd_ = now;
+}
+
+void GraphSpewer::spewTotalTime() {
+  if (backendStart_.IsNull()) {
+    return;
+  }
+
+  JitSpew(JitSpew_IonPassTimes, "  %-40s %10.3f ms", "Total",
+          (mozilla::TimeStamp::Now() - backendStart_).ToMilliseconds());
+  backendStart_ = mozilla::TimeStamp();
+  lastPassEnd_ = mozilla::TimeStamp();
+}
+
 void GraphSpewer::spewPass(const char* pass) {
+  spewPassTime(pass);
+
   if (!isSpewing()) {
     return;
   }
@@ -268,6 +303,11 @@ void GraphSpewer::spewPass(const char* pass) {
 
   ionspewer.spewPass(this);
 
+  // Don't count the time taken to spew the graph against the next pass.
+  if (!lastPassEnd_.IsNull()) {
+    lastPassEnd_ = mozilla::TimeStamp::Now();
+  }
+
   // As this function is used for debugging, we ignore any of the previous
   // failures and ensure there is enough ballast space, such that we do not
   // exhaust the ballast space before running the next phase.
@@ -280,6 +320,8 @@ void GraphSpewer::spewPass(const char* pass) {
 }
 
 void GraphSpewer::spewPass(const char* pass, BacktrackingAllocator* ra) {
+  spewPassTime(pass);
+
   if (!isSpewing()) {
     return;
   }
@@ -291,6 +333,10 @@ void GraphSpewer::spewPass(const char* pass, BacktrackingAllocator* ra) {
   jsonSpewer_.endPass();
 
   ionspewer.spewPass(this);
+
+  if (!lastPassEnd_.IsNull()) {
+    lastPassEnd_ = mozilla::TimeStamp::Now();
+  }
 }
 
 void GraphSpewer::endFunction() {
@@ -360,6 +406,8 @@ static void PrintHelpAndExit(int status = 0) {
       "  eaa           Effective address analysis\n"
       "  sink          Sink transformation\n"
       "  regalloc      Register allocation\n"
+      "  regalloc-stats Register allocation time and spill counts\n"
+      "  pass-times    Time taken by each Ion backend pass\n"
       "  inline        Inlining\n"
       "  snapshots     Snapshot information\n"
       "  codegen       Native code generation\n"
@@ -447,6 +495,10 @@ void jit::CheckLogging() {
       EnableChannel(JitSpew_Sink);
     } else if (IsFlag(found, "regalloc")) {
       EnableChannel(JitSpew_RegAlloc);
+    } else if (IsFlag(found, "regalloc-stats")) {
+      EnableChannel(JitSpew_RegAllocStats);
+    } else if (IsFlag(found, "pass-times")) {
+      EnableChannel(JitSpew_IonPassTimes);
     } else if (IsFlag(found, "inline")) {
       EnableChannel(JitSpew_Inlining);
     } else if (IsFlag(found, "snapshots")) {
@@ -9,6 +9,7 @@
 
 #include "mozilla/DebugOnly.h"
 #include "mozilla/IntegerPrintfMacros.h"
+#include "mozilla/TimeStamp.h"
 
 #include <stdarg.h>
 
@@ -45,6 +46,10 @@ namespace jit {
   _(EAA)                                   \
   /* Information during regalloc */        \
   _(RegAlloc)                              \
+  /* Register allocator time and spills */ \
+  _(RegAllocStats)                         \
+  /* Time taken by each Ion backend pass */ \
+  _(IonPassTimes)                          \
   /* Information during inlining */        \
   _(Inlining)                              \
   /* Information during codegen */         \
@@ -133,6 +138,11 @@ class GraphSpewer {
   LSprinter jsonPrinter_;
   JSONSpewer jsonSpewer_;
 
+  // When the previous pass ended and when the backend started, for the
+  // IonPassTimes channel. Null unless startTimingPasses has been called.
+  mozilla::TimeStamp lastPassEnd_;
+  mozilla::TimeStamp backendStart_;
+
  public:
   explicit GraphSpewer(TempAllocator* alloc);
 
@@ -144,6 +154,13 @@ class GraphSpewer {
   void spewPass(const char* pass, BacktrackingAllocator* ra);
   void endFunction();
 
+  // Report the time taken by each pass of an Ion backend compilation,
+  // starting now, on the IonPassTimes channel. Passes that call spewPass are
+  // reported automatically; other steps can call spewPassTime.
+  void startTimingPasses(JSScript* script);
+  void spewPassTime(const char* pass);
+  void spewTotalTime();
+
   void dump(Fprinter& json);
 };
 
@@ -212,6 +229,10 @@ class GraphSpewer {
   void spewPass(const char* pass, BacktrackingAllocator* ra) {}
   void endFunction() {}
 
+  void startTimingPasses(JSScript* script) {}
+  void spewPassTime(const char* pass) {}
+  void spewTotalTime() {}
+
   void dump(Fprinter& c1, Fprinter& json) {}
 };
 
@@ -150,6 +150,7 @@ static void MoveDeferredOperands(MInstruction* ins, MInstruction* hoistPoint,
 #endif
 
     opIns->block()->moveBefore(hoistPoint, opIns);
+    opIns->setHoisted();
   }
 }
 
@@ -190,6 +191,7 @@ static void VisitLoopBlock(MBasicBlock* block, MBasicBlock* header,
 
     // Move the instruction to the hoistPoint.
     block->moveBefore(hoistPoint, ins);
+    ins->setHoisted();
   }
 }
 
@@ -236,6 +238,15 @@ bool jit::LICM(MIRGenerator* mir, MIRGraph& graph) {
       continue;
     }
 
+    // Instructions hoisted out of this loop bailed out frequently in a
+    // previous compilation.
+    if (header->licmDisabled()) {
+      JitSpew(JitSpew_LICM,
+              "  Skipping loop with header block%u due to frequent bailouts",
+              header->id());
+      continue;
+    }
+
     bool canOsr;
     size_t numBlocks = MarkLoopBlocks(graph, header, &canOsr);
 
@@ -5323,7 +5323,9 @@ bool LIRGenerator::visitInstruction(MInstruction* ins) {
   if (!gen->ensureBallast()) {
     return false;
   }
+  loweringHoistedIns_ = ins->isHoisted();
   visitInstructionDispatch(ins);
+  loweringHoistedIns_ = false;
 
   if (ins->resumePoint()) {
     updateResumeState(ins);
@@ -175,6 +175,11 @@ static inline MIRType MIRTypeFromValue(const js::Value& vp) {
    */                                                                          \
   _(CallResultCapture)                                                         \
                                                                                \
+  /* The instruction was hoisted out of a loop by LICM. Its bailouts are       \
+   * reported as BailoutKind::LICM, see LIRGeneratorShared::assignSnapshot.    \
+   */                                                                          \
+  _(Hoisted)                                                                   \
+                                                                               \
   /* The current instruction got discarded from the MIR Graph. This is useful  \
    * when we want to iterate over resume points and instructions, while        \
    * handling instructions which are discarded without reporting to the        \
@@ -2047,6 +2052,9 @@ class MNewArray : public MUnaryInstruction, public NoTypePolicy::Data {
 
   bool vmCall_;
 
+  // Site the array is allocated for, if known. See gc::AllocSite.
+  gc::AllocSite* allocSite_ = nullptr;
+
   MNewArray(TempAllocator& alloc, CompilerConstraintList* constraints,
             uint32_t length, MConstant* templateConst,
             gc::InitialHeap initialHeap, jsbytecode* pc, bool vmCall = false);
@@ -2077,6 +2085,9 @@ class MNewArray : public MUnaryInstruction, public NoTypePolicy::Data {
 
   bool convertDoubleElements() const { return convertDoubleElements_; }
 
+  gc::AllocSite* allocSite() const { return allocSite_; }
+  void setAllocSite(gc::AllocSite* site) { allocSite_ = site; }
+
   // NewArray is marked as non-effectful because all our allocations are
   // either lazy when we are using "new Array(length)" or bounded by the
   // script or the stack size when we are using "new Array(...)" or "[...]"
@@ -2310,6 +2321,9 @@ class MNewObject : public MUnaryInstruction, public NoTypePolicy::Data {
   Mode mode_;
   bool vmCall_;
 
+  // Site the object is allocated for, if known. See gc::AllocSite.
+  gc::AllocSite* allocSite_ = nullptr;
+
   MNewObject(TempAllocator& alloc, CompilerConstraintList* constraints,
              MConstant* templateConst, gc::InitialHeap initialHeap, Mode mode,
              bool vmCall = false)
@@ -2357,6 +2371,9 @@ class MNewObject : public MUnaryInstruction, public NoTypePolicy::Data {
 
   bool isVMCall() const { return vmCall_; }
 
+  gc::AllocSite* allocSite() const { return allocSite_; }
+  void setAllocSite(gc::AllocSite* site) { allocSite_ = site; }
+
   MOZ_MUST_USE bool writeRecoverData(
       CompactBufferWriter& writer) const override;
   bool canRecoverOnBailout() const override {
@@ -6268,6 +6285,11 @@ class MOsrValue : public MUnaryInstruction, public NoTypePolicy::Data {
  private:
   ptrdiff_t frameOffset_;
 
+  // The type of this value in the frame we're compiling for, or
+  // MIRType::Value if unknown. Used for phi specialization, see
+  // ShouldSpecializeOsrPhis.
+  MIRType typeHint_ = MIRType::Value;
+
   MOsrValue(MOsrEntry* entry, ptrdiff_t frameOffset)
       : MUnaryInstruction(classOpcode, entry), frameOffset_(frameOffset) {
     setResultType(MIRType::Value);
@@ -6279,6 +6301,9 @@ class MOsrValue : public MUnaryInstruction, public NoTypePolicy::Data {
 
   ptrdiff_t frameOffset() const { return frameOffset_; }
 
+  MIRType typeHint() const { return typeHint_; }
+  void setTypeHint(MIRType type) { typeHint_ = type; }
+
   MOsrEntry* entry() { return getOperand(0)->toOsrEntry(); }
 
   AliasSet getAliasSet() const override { return AliasSet::None(); }
@@ -123,6 +123,11 @@ class MIRGenerator final {
   void setNeedsStaticStackAlignment() { needsStaticStackAlignment_ = true; }
   bool needsStaticStackAlignment() const { return needsStaticStackAlignment_; }
 
+  // The number of OSR entry values whose phis were specialized on the types
+  // of the frame we're compiling for. See ShouldSpecializeOsrPhis.
+  void setNumSpecializedOsrValues(uint32_t n) { numSpecializedOsrValues_ = n; }
+  uint32_t numSpecializedOsrValues() const { return numSpecializedOsrValues_; }
+
  public:
   CompileRealm* realm;
   CompileRuntime* runtime;
@@ -138,6 +143,7 @@ class MIRGenerator final {
   mozilla::Atomic<bool, mozilla::Relaxed> cancelBuild_;
 
   uint32_t wasmMaxStackArgBytes_;
+  uint32_t numSpecializedOsrValues_ = 0;
   bool needsOverrecursedCheck_;
   bool needsStaticStackAlignment_;
 
@@ -451,6 +451,7 @@ MBasicBlock::MBasicBlock(MIRGraph& graph, const CompileInfo& info,
                          BytecodeSite* site, Kind kind)
     : unreachable_(false),
       specialized_(false),
+      licmDisabled_(false),
       graph_(graph),
       info_(info),
       predecessors_(graph.alloc()),
@@ -54,6 +54,9 @@ class MBasicBlock : public TempObject, public InlineListNode<MBasicBlock> {
   // Keeps track if the phis has been type specialized already.
   bool specialized_;
 
+  // Set on loop headers if LICM must not hoist instructions out of the loop.
+  bool licmDisabled_;
+
   // Pushes a copy of a local variable or argument.
   void pushVariable(uint32_t slot) { push(slots_[slot]); }
 
@@ -458,6 +461,9 @@ class MBasicBlock : public TempObject, public InlineListNode<MBasicBlock> {
   bool isSplitEdge() const { return kind_ == SPLIT_EDGE; }
   bool isDead() const { return kind_ == DEAD; }
 
+  bool licmDisabled() const { return licmDisabled_; }
+  void setLICMDisabled() { licmDisabled_ = true; }
+
   uint32_t stackDepth() const { return stackPosition_; }
   void setStackDepth(uint32_t depth) { stackPosition_ = depth; }
   bool isMarked() const { return mark_; }
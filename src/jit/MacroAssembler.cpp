@@ -648,7 +648,8 @@ bool MacroAssembler::shouldNurseryAllocate(gc::AllocKind allocKind,
 // this fills in the slots_ pointer.
 void MacroAssembler::nurseryAllocateObject(Register result, Register temp,
                                            gc::AllocKind allocKind,
-                                           size_t nDynamicSlots, Label* fail) {
+                                           size_t nDynamicSlots, Label* fail,
+                                           gc::AllocSite* site) {
   MOZ_ASSERT(IsNurseryAllocable(allocKind));
 
   // We still need to allocate in the nursery, per the comment in
@@ -668,9 +669,14 @@ void MacroAssembler::nurseryAllocateObject(Register result, Register temp,
   MOZ_ASSERT(totalSize < INT32_MAX);
   MOZ_ASSERT(totalSize % gc::CellAlignBytes == 0);
 
-  bumpPointerAllocate(
-      result, temp, fail, zone, zone->addressOfNurseryPosition(),
-      zone->addressOfNurseryCurrentEnd(), JS::TraceKind::Object, totalSize);
+  if (!site) {
+    site = zone->unknownAllocSite(JS::TraceKind::Object);
+  }
+
+  bumpPointerAllocate(result, temp, fail, zone,
+                      zone->addressOfNurseryPosition(),
+                      zone->addressOfNurseryCurrentEnd(), JS::TraceKind::Object,
+                      totalSize, site);
 
   if (nDynamicSlots) {
     computeEffectiveAddress(Address(result, thingSize), temp);
@@ -740,14 +746,40 @@ void MacroAssembler::callFreeStub(Register slots) {
 void MacroAssembler::allocateObject(Register result, Register temp,
                                     gc::AllocKind allocKind,
                                     uint32_t nDynamicSlots,
-                                    gc::InitialHeap initialHeap, Label* fail) {
+                                    gc::InitialHeap initialHeap, Label* fail,
+                                    gc::AllocSite* site) {
   MOZ_ASSERT(gc::IsObjectAllocKind(allocKind));
+  MOZ_ASSERT_IF(site, !site->isCatchAll());
 
   checkAllocatorState(fail);
 
   if (shouldNurseryAllocate(allocKind, initialHeap)) {
     MOZ_ASSERT(initialHeap == gc::DefaultHeap);
-    return nurseryAllocateObject(result, temp, allocKind, nDynamicSlots, fail);
+    if (!site) {
+      return nurseryAllocateObject(result, temp, allocKind, nDynamicSlots, fail,
+                                   nullptr);
+    }
+
+    // The site's state is checked at runtime so that code doesn't need to be
+    // invalidated when it changes. This mirrors AllocSite::initialHeap.
+    Label nursery, done;
+    movePtr(ImmPtr(site), temp);
+    branch32(Assembler::NotEqual, Address(temp, gc::AllocSite::offsetOfState()),
+             Imm32(int32_t(gc::AllocSite::State::LongLived)), &nursery);
+    add32(Imm32(1), Address(temp, gc::AllocSite::offsetOfTenuredAllocCount()));
+    branchTest32(Assembler::Zero,
+                 Address(temp, gc::AllocSite::offsetOfTenuredAllocCount()),
+                 Imm32(gc::AllocSite::SampleInterval - 1), &nursery);
+    if (nDynamicSlots) {
+      jump(fail);
+    } else {
+      freeListAllocate(result, temp, allocKind, fail);
+      jump(&done);
+    }
+    bind(&nursery);
+    nurseryAllocateObject(result, temp, allocKind, nDynamicSlots, fail, site);
+    bind(&done);
+    return;
   }
 
   // Fall back to calling into the VM to allocate objects in the tenured heap
@@ -763,7 +795,7 @@ void MacroAssembler::allocateObject(Register result, Register temp,
 void MacroAssembler::createGCObject(Register obj, Register temp,
                                     const TemplateObject& templateObj,
                                     gc::InitialHeap initialHeap, Label* fail,
-                                    bool initContents) {
+                                    bool initContents, gc::AllocSite* site) {
   gc::AllocKind allocKind = templateObj.getAllocKind();
   MOZ_ASSERT(gc::IsObjectAllocKind(allocKind));
 
@@ -781,7 +813,7 @@ void MacroAssembler::createGCObject(Register obj, Register temp,
     }
   }
 
-  allocateObject(obj, temp, allocKind, nDynamicSlots, initialHeap, fail);
+  allocateObject(obj, temp, allocKind, nDynamicSlots, initialHeap, fail, site);
   initGCThing(obj, temp, templateObj, initContents);
 }
 
@@ -809,7 +841,8 @@ void MacroAssembler::nurseryAllocateString(Register result, Register temp,
   bumpPointerAllocate(result, temp, fail, zone,
                       zone->addressOfStringNurseryPosition(),
                       zone->addressOfStringNurseryCurrentEnd(),
-                      JS::TraceKind::String, thingSize);
+                      JS::TraceKind::String, thingSize,
+                      zone->unknownAllocSite(JS::TraceKind::String));
 }
 
 // Inline version of Nursery::allocateBigInt.
@@ -826,14 +859,15 @@ void MacroAssembler::nurseryAllocateBigInt(Register result, Register temp,
   bumpPointerAllocate(result, temp, fail, zone,
                       zone->addressOfBigIntNurseryPosition(),
                       zone->addressOfBigIntNurseryCurrentEnd(),
-                      JS::TraceKind::BigInt, thingSize);
+                      JS::TraceKind::BigInt, thingSize,
+                      zone->unknownAllocSite(JS::TraceKind::BigInt));
 }
 
 void MacroAssembler::bumpPointerAllocate(Register result, Register temp,
                                          Label* fail, CompileZone* zone,
                                          void* posAddr, const void* curEndAddr,
                                          JS::TraceKind traceKind,
-                                         uint32_t size) {
+                                         uint32_t size, gc::AllocSite* site) {
   uint32_t totalSize = size + Nursery::nurseryCellHeaderSize();
   MOZ_ASSERT(totalSize < INT32_MAX, "Nursery allocation too large");
   MOZ_ASSERT(totalSize % gc::CellAlignBytes == 0);
@@ -856,7 +890,7 @@ void MacroAssembler::bumpPointerAllocate(Register result, Register temp,
   branchPtr(Assembler::Below, Address(temp, endOffset.value()), result, fail);
   storePtr(result, Address(temp, 0));
   subPtr(Imm32(size), result);
-  storePtr(ImmWord(zone->nurseryCellHeader(traceKind)),
+  storePtr(ImmWord(zone->nurseryCellHeader(traceKind, site)),
            Address(result, -js::Nursery::nurseryCellHeaderSize()));
 
   if (GetJitContext()->runtime->geckoProfiler().enabled()) {
@@ -872,6 +906,24 @@ void MacroAssembler::bumpPointerAllocate(Register result, Register temp,
       add32(Imm32(1), Address(temp, 0));
     }
   }
+
+  // Count the allocation against its site, and add the site to the nursery's
+  // list of sites that allocated since the last minor GC if it's not already
+  // there. See Nursery::noteAllocation.
+  Label siteInList;
+  movePtr(ImmPtr(site), temp);
+  add32(Imm32(1), Address(temp, gc::AllocSite::offsetOfNurseryAllocCount()));
+  branchPtr(Assembler::NotEqual,
+            Address(temp, gc::AllocSite::offsetOfNextNurseryAllocated()),
+            ImmWord(0), &siteInList);
+  gc::AllocSite** listHead = zone->addressOfNurseryAllocatedSites();
+  void* siteNext = reinterpret_cast<uint8_t*>(site) +
+                   gc::AllocSite::offsetOfNextNurseryAllocated();
+  loadPtr(AbsoluteAddress(listHead), temp);
+  storePtr(temp, AbsoluteAddress(siteNext));
+  movePtr(ImmPtr(site), temp);
+  storePtr(temp, AbsoluteAddress(listHead));
+  bind(&siteInList);
 }
 
 // Inlined equivalent of gc::AllocateString, jumping to fail if nursery
@@ -3481,6 +3533,22 @@ void MacroAssembler::wasmInterruptCheck(Register tls,
   bind(&ok);
 }
 
+void MacroAssembler::wasmHotnessCheck(Register tls, uint32_t funcIndex,
+                                      wasm::BytecodeOffset bytecodeOffset) {
+  Register counters = tls;
+  loadPtr(Address(tls, offsetof(wasm::TlsData, hotnessCounters)), counters);
+
+  // The counters are shared by all threads running this code, so updates can
+  // be lost; that only makes the counters a little less precise.
+  Address counter(counters, funcIndex * sizeof(int32_t));
+  add32(Imm32(-1), counter);
+
+  Label ok;
+  branch32(Assembler::GreaterThanOrEqual, counter, Imm32(0), &ok);
+  wasmTrap(wasm::Trap::TierUp, bytecodeOffset);
+  bind(&ok);
+}
+
 std::pair<CodeOffset, uint32_t> MacroAssembler::wasmReserveStackChecked(
     uint32_t amount, wasm::BytecodeOffset trapOffset) {
   if (amount > MAX_UNCHECKED_LEAF_FRAME_SIZE) {
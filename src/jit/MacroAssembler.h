@@ -2098,6 +2098,12 @@ class MacroAssembler : public MacroAssemblerSpecific {
   inline void mulInt64x2(FloatRegister rhs, FloatRegister lhsDest,
                          FloatRegister temp) DEFINED_ON(x86_shared);
 
+  // Integer dot product: each 32-bit lane of the result is the sum of the
+  // products of the two corresponding pairs of signed 16-bit lanes.
+
+  inline void widenDotInt16x8(FloatRegister rhs, FloatRegister lhsDest)
+      DEFINED_ON(x86_shared);
+
   // Integer Negate
 
   inline void negInt8x16(FloatRegister src, FloatRegister dest)
@@ -2419,6 +2425,23 @@ class MacroAssembler : public MacroAssemblerSpecific {
   inline void maxFloat64x2(FloatRegister rhs, FloatRegister lhsDest,
                            FloatRegister temp) DEFINED_ON(x86_shared);
 
+  // Compare-based minimum and maximum: lhsDest = lhsDest < rhs ? lhsDest : rhs
+  // for min and lhsDest = lhsDest > rhs ? lhsDest : rhs for max.  Note these
+  // are Wasm's pmin and pmax with the operands reversed, which is what the
+  // hardware offers.
+
+  inline void pseudoMinFloat32x4(FloatRegister rhs, FloatRegister lhsDest)
+      DEFINED_ON(x86_shared);
+
+  inline void pseudoMinFloat64x2(FloatRegister rhs, FloatRegister lhsDest)
+      DEFINED_ON(x86_shared);
+
+  inline void pseudoMaxFloat32x4(FloatRegister rhs, FloatRegister lhsDest)
+      DEFINED_ON(x86_shared);
+
+  inline void pseudoMaxFloat64x2(FloatRegister rhs, FloatRegister lhsDest)
+      DEFINED_ON(x86_shared);
+
   // Floating add
 
   inline void addFloat32x4(FloatRegister rhs, FloatRegister lhsDest)
@@ -2569,6 +2592,11 @@ class MacroAssembler : public MacroAssemblerSpecific {
   void wasmTrap(wasm::Trap trap, wasm::BytecodeOffset bytecodeOffset);
   void wasmInterruptCheck(Register tls, wasm::BytecodeOffset bytecodeOffset);
 
+  // Count down the hotness counter of function |funcIndex| and trap with
+  // Trap::TierUp if it goes negative. |tls| is clobbered.
+  void wasmHotnessCheck(Register tls, uint32_t funcIndex,
+                        wasm::BytecodeOffset bytecodeOffset);
+
   // Returns a pair: the offset of the undefined (trapping) instruction, and
   // the number of extra bytes of stack allocated prior to the trap
   // instruction proper.
@@ -3618,17 +3646,17 @@ class MacroAssembler : public MacroAssemblerSpecific {
                              gc::InitialHeap initialHeap);
   void nurseryAllocateObject(Register result, Register temp,
                              gc::AllocKind allocKind, size_t nDynamicSlots,
-                             Label* fail);
+                             Label* fail, gc::AllocSite* site);
   void bumpPointerAllocate(Register result, Register temp, Label* fail,
                            CompileZone* zone, void* posAddr,
                            const void* curEddAddr, JS::TraceKind traceKind,
-                           uint32_t size);
+                           uint32_t size, gc::AllocSite* site);
 
   void freeListAllocate(Register result, Register temp, gc::AllocKind allocKind,
                         Label* fail);
   void allocateObject(Register result, Register temp, gc::AllocKind allocKind,
                       uint32_t nDynamicSlots, gc::InitialHeap initialHeap,
-                      Label* fail);
+                      Label* fail, gc::AllocSite* site);
   void nurseryAllocateString(Register result, Register temp,
                              gc::AllocKind allocKind, Label* fail);
   void allocateString(Register result, Register temp, gc::AllocKind allocKind,
@@ -3654,7 +3682,8 @@ class MacroAssembler : public MacroAssemblerSpecific {
   void createGCObject(Register result, Register temp,
                       const TemplateObject& templateObj,
                       gc::InitialHeap initialHeap, Label* fail,
-                      bool initContents = true);
+                      bool initContents = true,
+                      gc::AllocSite* site = nullptr);
 
   void initGCThing(Register obj, Register temp,
                    const TemplateObject& templateObj, bool initContents = true);
@@ -14,10 +14,24 @@
 #endif
 
 #ifdef JS_ION_PERF
+#  include <algorithm>
+#  include <errno.h>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  ifdef XP_LINUX
+#    include <sys/syscall.h>
+#  endif
+#  include <time.h>
+
+#  include "frontend/SourceNotes.h"
+#  include "jit/JitcodeMap.h"
 #  include "jit/JitSpewer.h"
 #  include "jit/LIR.h"
 #  include "jit/MIR.h"
 #  include "jit/MIRGraph.h"
+#  include "threading/ConditionVariable.h"
+#  include "threading/LockGuard.h"
+#  include "threading/Thread.h"
 #endif
 
 #include "vm/MutexIDs.h"
@@ -43,6 +57,7 @@ using namespace js::jit;
 #define PERF_MODE_NONE 1
 #define PERF_MODE_FUNC 2
 #define PERF_MODE_BLOCK 3
+#define PERF_MODE_JITDUMP 4
 
 #ifdef JS_ION_PERF
 
@@ -73,14 +88,248 @@ static bool openPerfMap(const char* dir) {
   return true;
 }
 
+// jitdump output. The file format is described in
+// tools/perf/Documentation/jitdump-specification.txt in the Linux sources.
+//
+// Records are appended to a buffer while holding PerfMutex, and a helper
+// thread writes the buffer out, so compilation never waits on file IO.
+
+namespace {
+
+enum class JitdumpRecordId : uint32_t {
+  CodeLoad = 0,
+  // JitCode is never moved, so JIT_CODE_MOVE records aren't written.
+  CodeMove = 1,
+  CodeDebugInfo = 2,
+};
+
+struct JitdumpFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t totalSize;
+  uint32_t elfMach;
+  uint32_t pad1;
+  uint32_t pid;
+  uint64_t timestamp;
+  uint64_t flags;
+};
+
+struct JitdumpRecordHeader {
+  uint32_t id;
+  uint32_t totalSize;
+  uint64_t timestamp;
+};
+
+// Followed by the null-terminated function name and a copy of the code.
+struct JitdumpCodeLoad {
+  JitdumpRecordHeader header;
+  uint32_t pid;
+  uint32_t tid;
+  uint64_t vma;
+  uint64_t codeAddr;
+  uint64_t codeSize;
+  uint64_t codeIndex;
+};
+
+// Followed by |numEntries| JitdumpDebugEntry, each of them followed by the
+// null-terminated source file name.
+struct JitdumpDebugInfo {
+  JitdumpRecordHeader header;
+  uint64_t codeAddr;
+  uint64_t numEntries;
+};
+
+struct JitdumpDebugEntry {
+  uint64_t addr;
+  uint32_t line;
+  uint32_t discrim;
+};
+
+// Source line of the code starting at |nativeOffset|.
+struct JitdumpLine {
+  uint32_t nativeOffset;
+  const char* filename;
+  uint32_t line;
+};
+
+}  // namespace
+
+typedef Vector<JitdumpLine, 0, SystemAllocPolicy> JitdumpLineVector;
+typedef Vector<uint8_t, 0, SystemAllocPolicy> JitdumpBuffer;
+
+static const uint32_t JitdumpMagic = 0x4A695444;
+static const uint32_t JitdumpVersion = 1;
+
+// The writer thread is woken up once this much data is buffered. Otherwise it
+// writes out whatever is pending every second.
+static const size_t JitdumpFlushThreshold = 64 * 1024;
+
+static int JitdumpFd = -1;
+static void* JitdumpMarker = nullptr;
+static size_t JitdumpMarkerSize = 0;
+static uint64_t JitdumpCodeIndex = 0;
+static JitdumpBuffer* JitdumpPending = nullptr;
+static js::ConditionVariable* JitdumpWakeup = nullptr;
+static js::Thread* JitdumpThread = nullptr;
+static bool JitdumpShuttingDown = false;
+
+static uint32_t JitdumpElfMachine() {
+#  if defined(JS_CODEGEN_X64)
+  return 62;  // EM_X86_64
+#  elif defined(JS_CODEGEN_X86)
+  return 3;  // EM_386
+#  elif defined(JS_CODEGEN_ARM)
+  return 40;  // EM_ARM
+#  elif defined(JS_CODEGEN_ARM64)
+  return 183;  // EM_AARCH64
+#  elif defined(JS_CODEGEN_MIPS32) || defined(JS_CODEGEN_MIPS64)
+  return 8;  // EM_MIPS
+#  else
+  return 0;  // EM_NONE
+#  endif
+}
+
+// This has to be the clock perf uses for its samples; see |perf record -k|.
+static uint64_t JitdumpTimestamp() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return uint64_t(ts.tv_sec) * 1000000000 + uint64_t(ts.tv_nsec);
+}
+
+static uint32_t JitdumpThreadId() {
+#  ifdef XP_LINUX
+  return uint32_t(syscall(SYS_gettid));
+#  else
+  return uint32_t(getpid());
+#  endif
+}
+
+static bool JitdumpWriteAll(const uint8_t* data, size_t length) {
+  while (length > 0) {
+    ssize_t written = write(JitdumpFd, data, length);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    length -= written;
+  }
+  return true;
+}
+
+static void JitdumpWriterThreadMain() {
+  ThisThread::SetName("JS jitdump");
+
+  JitdumpBuffer buffer;
+  bool failed = false;
+
+  LockGuard<Mutex> lock(*PerfMutex);
+  while (!JitdumpShuttingDown) {
+    if (JitdumpPending->length() < JitdumpFlushThreshold) {
+      JitdumpWakeup->wait_for(lock, mozilla::TimeDuration::FromSeconds(1));
+    }
+    if (JitdumpPending->empty()) {
+      continue;
+    }
+
+    // Swap buffers so other threads can keep appending records while we
+    // write this batch out.
+    buffer.swap(*JitdumpPending);
+    {
+      UnlockGuard<Mutex> unlock(lock);
+      if (!failed && !JitdumpWriteAll(buffer.begin(), buffer.length())) {
+        fprintf(stderr, "Warning: failed to write the jitdump file.\n");
+        failed = true;
+      }
+      buffer.clear();
+    }
+  }
+
+  if (!failed) {
+    JitdumpWriteAll(JitdumpPending->begin(), JitdumpPending->length());
+  }
+  JitdumpPending->clear();
+}
+
+static void CloseJitdump() {
+  js_delete(JitdumpThread);
+  JitdumpThread = nullptr;
+  js_delete(JitdumpWakeup);
+  JitdumpWakeup = nullptr;
+  js_delete(JitdumpPending);
+  JitdumpPending = nullptr;
+
+  if (JitdumpMarker) {
+    munmap(JitdumpMarker, JitdumpMarkerSize);
+    JitdumpMarker = nullptr;
+  }
+  if (JitdumpFd != -1) {
+    close(JitdumpFd);
+    JitdumpFd = -1;
+  }
+}
+
+static bool openJitdump(const char* dir) {
+  const ssize_t bufferSize = 256;
+  char filenameBuffer[bufferSize];
+
+  if (snprintf(filenameBuffer, bufferSize, "%sjit-%d.dump", dir, getpid()) >=
+      bufferSize) {
+    return false;
+  }
+
+  MOZ_ASSERT(JitdumpFd == -1);
+  JitdumpFd = open(filenameBuffer, O_CREAT | O_TRUNC | O_RDWR, 0666);
+  if (JitdumpFd == -1) {
+    return false;
+  }
+
+  JitdumpFileHeader header = {};
+  header.magic = JitdumpMagic;
+  header.version = JitdumpVersion;
+  header.totalSize = sizeof(header);
+  header.elfMach = JitdumpElfMachine();
+  header.pid = getpid();
+  header.timestamp = JitdumpTimestamp();
+  if (!JitdumpWriteAll(reinterpret_cast<const uint8_t*>(&header),
+                       sizeof(header))) {
+    CloseJitdump();
+    return false;
+  }
+
+  // perf finds the file through the MMAP event for this mapping, which is
+  // only recorded for executable mappings.
+  JitdumpMarkerSize = sysconf(_SC_PAGESIZE);
+  JitdumpMarker = mmap(nullptr, JitdumpMarkerSize, PROT_READ | PROT_EXEC,
+                       MAP_PRIVATE, JitdumpFd, 0);
+  if (JitdumpMarker == MAP_FAILED) {
+    JitdumpMarker = nullptr;
+    CloseJitdump();
+    return false;
+  }
+
+  JitdumpPending = js_new<JitdumpBuffer>();
+  JitdumpWakeup = js_new<js::ConditionVariable>();
+  JitdumpThread = js_new<js::Thread>();
+  if (!JitdumpPending || !JitdumpWakeup || !JitdumpThread ||
+      !JitdumpThread->init(JitdumpWriterThreadMain)) {
+    CloseJitdump();
+    return false;
+  }
+
+  return true;
+}
+
 void js::jit::CheckPerf() {
   if (!PerfChecked) {
     const char* env = getenv("IONPERF");
     if (env == nullptr) {
       PerfMode = PERF_MODE_NONE;
       fprintf(stderr,
-              "Warning: JIT perf reporting requires IONPERF set to \"block\" "
-              "or \"func\". ");
+              "Warning: JIT perf reporting requires IONPERF set to \"block\", "
+              "\"func\" or \"jitdump\". ");
       fprintf(stderr, "Perf mapping will be deactivated.\n");
     } else if (!strcmp(env, "none")) {
       PerfMode = PERF_MODE_NONE;
@@ -88,13 +337,17 @@ void js::jit::CheckPerf() {
       PerfMode = PERF_MODE_BLOCK;
     } else if (!strcmp(env, "func")) {
       PerfMode = PERF_MODE_FUNC;
+    } else if (!strcmp(env, "jitdump")) {
+      PerfMode = PERF_MODE_JITDUMP;
     } else {
       fprintf(stderr, "Use IONPERF=func to record at function granularity\n");
       fprintf(stderr,
               "Use IONPERF=block to record at basic block granularity\n");
+      fprintf(stderr,
+              "Use IONPERF=jitdump to write a jitdump file with line tables\n");
       fprintf(stderr, "\n");
-      fprintf(stderr, "Be advised that using IONPERF will cause all scripts\n");
-      fprintf(stderr, "to be leaked.\n");
+      fprintf(stderr, "Be advised that using IONPERF=func or IONPERF=block\n");
+      fprintf(stderr, "will cause all scripts to be leaked.\n");
       exit(0);
     }
 
@@ -104,18 +357,20 @@ void js::jit::CheckPerf() {
         MOZ_CRASH("failed to allocate PerfMutex");
       }
 
-      if (openPerfMap(PERF_SPEW_DIR)) {
+      auto openFile =
+          PerfMode == PERF_MODE_JITDUMP ? openJitdump : openPerfMap;
+      if (openFile(PERF_SPEW_DIR)) {
         PerfChecked = true;
         return;
       }
 
 #  if defined(__ANDROID__)
-      if (openPerfMap(PERF_SPEW_DIR_2)) {
+      if (openFile(PERF_SPEW_DIR_2)) {
         PerfChecked = true;
         return;
       }
 #  endif
-      fprintf(stderr, "Failed to open perf map file.  Disabling IONPERF.\n");
+      fprintf(stderr, "Failed to open perf output file.  Disabling IONPERF.\n");
       PerfMode = PERF_MODE_NONE;
     }
     PerfChecked = true;
@@ -132,6 +387,34 @@ bool js::jit::PerfFuncEnabled() {
   return PerfMode == PERF_MODE_FUNC;
 }
 
+bool js::jit::PerfJitdumpEnabled() {
+  MOZ_ASSERT(PerfMode);
+  return PerfMode == PERF_MODE_JITDUMP;
+}
+
+void js::jit::ShutdownPerf() {
+  if (!PerfChecked || PerfMode == PERF_MODE_NONE) {
+    return;
+  }
+
+  if (JitdumpThread) {
+    {
+      LockGuard<Mutex> lock(*PerfMutex);
+      JitdumpShuttingDown = true;
+      JitdumpWakeup->notify_one();
+    }
+    JitdumpThread->join();
+    CloseJitdump();
+  }
+
+  if (PerfFilePtr) {
+    fclose(PerfFilePtr);
+    PerfFilePtr = nullptr;
+  }
+
+  PerfMode = PERF_MODE_NONE;
+}
+
 namespace {
 struct MOZ_RAII AutoLockPerfMap {
   AutoLockPerfMap() {
@@ -139,16 +422,198 @@ struct MOZ_RAII AutoLockPerfMap {
       return;
     }
     PerfMutex->lock();
-    MOZ_ASSERT(PerfFilePtr);
+    MOZ_ASSERT(PerfFilePtr || JitdumpPending);
   }
   ~AutoLockPerfMap() {
-    MOZ_ASSERT(PerfFilePtr);
-    fflush(PerfFilePtr);
+    if (PerfFilePtr) {
+      fflush(PerfFilePtr);
+    }
     PerfMutex->unlock();
   }
 };
+
+// Computes the line numbers of bytecode offsets passed in increasing order,
+// with a single pass over the script's source notes. See PCToLineNumber.
+class SourceLineScanner {
+  SrcNoteIterator iter_;
+  uint32_t noteOffset_ = 0;
+  uint32_t line_;
+
+ public:
+  explicit SourceLineScanner(JSScript* script)
+      : iter_(script->notes()), line_(script->lineno()) {}
+
+  uint32_t lineAt(uint32_t pcOffset) {
+    for (; !iter_.atEnd(); ++iter_) {
+      const SrcNote* sn = *iter_;
+      if (noteOffset_ + sn->delta() > pcOffset) {
+        break;
+      }
+      noteOffset_ += sn->delta();
+
+      SrcNoteType type = sn->type();
+      if (type == SrcNoteType::SetLine) {
+        line_ = SrcNote::SetLine::getLine(sn);
+      } else if (type == SrcNoteType::NewLine) {
+        line_++;
+      }
+    }
+    return line_;
+  }
+};
 }  // namespace
 
+static const char* JitdumpFilename(JSScript* script) {
+  return script->filename() ? script->filename() : "<unknown>";
+}
+
+// Consecutive entries for the same line are merged to keep records small.
+static bool AppendJitdumpLine(JitdumpLineVector& lines, uint32_t nativeOffset,
+                              const char* filename, uint32_t line) {
+  if (!lines.empty() && lines.back().line == line &&
+      lines.back().filename == filename) {
+    return true;
+  }
+  return lines.append(JitdumpLine{nativeOffset, filename, line});
+}
+
+static bool BaselineJitdumpLines(JSScript* script,
+                                 const BaselinePerfOpVector& ops,
+                                 JitdumpLineVector& lines) {
+  const char* filename = JitdumpFilename(script);
+  SourceLineScanner scanner(script);
+  for (const BaselinePerfOp& op : ops) {
+    uint32_t line = scanner.lineAt(op.pcOffset);
+    if (!AppendJitdumpLine(lines, op.nativeOffset, filename, line)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Sites in inlined scripts get the inlined script's file and line, so
+// samples in inlined code are attributed to the right source lines.
+static bool IonJitdumpLines(const NativeToBytecode* entries, size_t length,
+                            JitdumpLineVector& lines) {
+  struct Site {
+    JSScript* script;
+    uint32_t pcOffset;
+    uint32_t index;
+  };
+
+  // The entries are in native code order. Sort them by script and bytecode
+  // offset so each script's source notes only have to be scanned once.
+  Vector<Site, 0, SystemAllocPolicy> sites;
+  Vector<uint32_t, 0, SystemAllocPolicy> lineNumbers;
+  if (!sites.reserve(length) || !lineNumbers.resize(length)) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    JSScript* script = entries[i].tree->script();
+    sites.infallibleAppend(
+        Site{script, script->pcToOffset(entries[i].pc), uint32_t(i)});
+  }
+  std::sort(sites.begin(), sites.end(), [](const Site& a, const Site& b) {
+    if (a.script != b.script) {
+      return uintptr_t(a.script) < uintptr_t(b.script);
+    }
+    return a.pcOffset < b.pcOffset;
+  });
+
+  for (size_t i = 0; i < sites.length();) {
+    JSScript* script = sites[i].script;
+    SourceLineScanner scanner(script);
+    for (; i < sites.length() && sites[i].script == script; i++) {
+      lineNumbers[sites[i].index] = scanner.lineAt(sites[i].pcOffset);
+    }
+  }
+
+  for (size_t i = 0; i < length; i++) {
+    JSScript* script = entries[i].tree->script();
+    if (!AppendJitdumpLine(lines, entries[i].nativeOffset.offset(),
+                           JitdumpFilename(script), lineNumbers[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+static bool AppendJitdumpPod(JitdumpBuffer& buffer, const T& value) {
+  return buffer.append(reinterpret_cast<const uint8_t*>(&value), sizeof(T));
+}
+
+// Appends a JIT_CODE_DEBUG_INFO record if there are |lines|, followed by the
+// JIT_CODE_LOAD record. perf needs them in this order.
+static void WriteJitdumpEntry(const AutoLockPerfMap&, const uint8_t* code,
+                              size_t size, const JitdumpLineVector* lines,
+                              const char* fmt, ...) MOZ_FORMAT_PRINTF(5, 6);
+
+static void WriteJitdumpEntry(const AutoLockPerfMap&, const uint8_t* code,
+                              size_t size, const JitdumpLineVector* lines,
+                              const char* fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  auto name = mozilla::Vsmprintf<js::SystemAllocPolicy>(fmt, ap);
+  va_end(ap);
+  if (!name) {
+    return;
+  }
+
+  JitdumpBuffer& buffer = *JitdumpPending;
+  size_t start = buffer.length();
+  uint64_t timestamp = JitdumpTimestamp();
+  uint64_t codeAddr = uintptr_t(code);
+  bool ok = true;
+
+  if (lines && !lines->empty()) {
+    size_t totalSize = sizeof(JitdumpDebugInfo);
+    for (const JitdumpLine& line : *lines) {
+      totalSize += sizeof(JitdumpDebugEntry) + strlen(line.filename) + 1;
+    }
+
+    JitdumpDebugInfo info = {};
+    info.header.id = uint32_t(JitdumpRecordId::CodeDebugInfo);
+    info.header.totalSize = totalSize;
+    info.header.timestamp = timestamp;
+    info.codeAddr = codeAddr;
+    info.numEntries = lines->length();
+    ok = AppendJitdumpPod(buffer, info);
+
+    for (const JitdumpLine& line : *lines) {
+      JitdumpDebugEntry entry = {};
+      entry.addr = codeAddr + line.nativeOffset;
+      entry.line = line.line;
+      ok = ok && AppendJitdumpPod(buffer, entry) &&
+           buffer.append(line.filename, strlen(line.filename) + 1);
+    }
+  }
+
+  size_t nameLength = strlen(name.get()) + 1;
+  JitdumpCodeLoad load = {};
+  load.header.id = uint32_t(JitdumpRecordId::CodeLoad);
+  load.header.totalSize = sizeof(load) + nameLength + size;
+  load.header.timestamp = timestamp;
+  load.pid = getpid();
+  load.tid = JitdumpThreadId();
+  load.vma = codeAddr;
+  load.codeAddr = codeAddr;
+  load.codeSize = size;
+  load.codeIndex = JitdumpCodeIndex++;
+  ok = ok && AppendJitdumpPod(buffer, load) &&
+       buffer.append(name.get(), nameLength) && buffer.append(code, size);
+
+  if (!ok) {
+    // Drop the records on OOM.
+    buffer.shrinkTo(start);
+    return;
+  }
+
+  if (buffer.length() >= JitdumpFlushThreshold) {
+    JitdumpWakeup->notify_one();
+  }
+}
+
 uint32_t PerfSpewer::nextFunctionIndex = 0;
 
 bool PerfSpewer::startBasicBlock(MBasicBlock* blk, MacroAssembler& masm) {
@@ -195,7 +660,26 @@ void PerfSpewer::WriteEntry(const AutoLockPerfMap&, uintptr_t address,
 }
 
 void PerfSpewer::writeProfile(JSScript* script, JitCode* code,
-                              MacroAssembler& masm) {
+                              MacroAssembler& masm,
+                              const NativeToBytecode* nativeToBytecode,
+                              size_t nativeToBytecodeLength) {
+  if (PerfJitdumpEnabled()) {
+    size_t size = code->instructionsSize();
+    if (size == 0) {
+      return;
+    }
+
+    JitdumpLineVector lines;
+    if (!IonJitdumpLines(nativeToBytecode, nativeToBytecodeLength, lines)) {
+      lines.clear();
+    }
+
+    AutoLockPerfMap lock;
+    WriteJitdumpEntry(lock, code->raw(), size, &lines, "%s:%u:%u: Ion",
+                      script->filename(), script->lineno(), script->column());
+    return;
+  }
+
   AutoLockPerfMap lock;
 
   if (PerfFuncEnabled()) {
@@ -265,13 +749,23 @@ void PerfSpewer::writeProfile(JSScript* script, JitCode* code,
   }
 }
 
-void js::jit::writePerfSpewerBaselineProfile(JSScript* script, JitCode* code) {
+void js::jit::writePerfSpewerBaselineProfile(JSScript* script, JitCode* code,
+                                            const BaselinePerfOpVector& ops) {
   if (!PerfEnabled()) {
     return;
   }
 
   size_t size = code->instructionsSize();
-  if (size > 0) {
+  if (size > 0 && PerfJitdumpEnabled()) {
+    JitdumpLineVector lines;
+    if (!BaselineJitdumpLines(script, ops, lines)) {
+      lines.clear();
+    }
+
+    AutoLockPerfMap lock;
+    WriteJitdumpEntry(lock, code->raw(), size, &lines, "%s:%u:%u: Baseline",
+                      script->filename(), script->lineno(), script->column());
+  } else if (size > 0) {
     AutoLockPerfMap lock;
     PerfSpewer::WriteEntry(lock, reinterpret_cast<uintptr_t>(code->raw()), size,
                            "%s:%u: Baseline", script->filename(),
@@ -285,7 +779,10 @@ void js::jit::writePerfSpewerJitCodeProfile(JitCode* code, const char* msg) {
   }
 
   size_t size = code->instructionsSize();
-  if (size > 0) {
+  if (size > 0 && PerfJitdumpEnabled()) {
+    AutoLockPerfMap lock;
+    WriteJitdumpEntry(lock, code->raw(), size, nullptr, "%s", msg);
+  } else if (size > 0) {
     AutoLockPerfMap lock;
     PerfSpewer::WriteEntry(lock, reinterpret_cast<uintptr_t>(code->raw()), size,
                            "%s (%p 0x%zx)", msg, code->raw(), size);
@@ -295,11 +792,16 @@ void js::jit::writePerfSpewerJitCodeProfile(JitCode* code, const char* msg) {
 void js::jit::writePerfSpewerWasmMap(uintptr_t base, uintptr_t size,
                                      const char* filename,
                                      const char* annotation) {
-  if (!PerfFuncEnabled() || size == 0U) {
+  if (!(PerfFuncEnabled() || PerfJitdumpEnabled()) || size == 0U) {
     return;
   }
 
   AutoLockPerfMap lock;
+  if (PerfJitdumpEnabled()) {
+    WriteJitdumpEntry(lock, reinterpret_cast<const uint8_t*>(base), size,
+                      nullptr, "%s: Function %s", filename, annotation);
+    return;
+  }
   PerfSpewer::WriteEntry(lock, base, size, "%s: Function %s", filename,
                          annotation);
 }
@@ -308,11 +810,17 @@ void js::jit::writePerfSpewerWasmFunctionMap(uintptr_t base, uintptr_t size,
                                              const char* filename,
                                              unsigned lineno,
                                              const char* funcName) {
-  if (!PerfFuncEnabled() || size == 0U) {
+  if (!(PerfFuncEnabled() || PerfJitdumpEnabled()) || size == 0U) {
     return;
   }
 
   AutoLockPerfMap lock;
+  if (PerfJitdumpEnabled()) {
+    WriteJitdumpEntry(lock, reinterpret_cast<const uint8_t*>(base), size,
+                      nullptr, "%s:%u: Function %s", filename, lineno,
+                      funcName);
+    return;
+  }
   PerfSpewer::WriteEntry(lock, base, size, "%s:%u: Function %s", filename,
                          lineno, funcName);
 }
@@ -21,18 +21,27 @@ namespace jit {
 
 class MBasicBlock;
 class MacroAssembler;
+struct NativeToBytecode;
 
+// IONPERF=func and IONPERF=block append entries to a /tmp/perf-PID.map file.
+// IONPERF=jitdump writes a jit-PID.dump file in the jitdump format instead,
+// with a copy of the code and line tables. Use it with |perf record -k 1| and
+// |perf inject --jit|.
 #ifdef JS_ION_PERF
 void CheckPerf();
+void ShutdownPerf();
 bool PerfBlockEnabled();
 bool PerfFuncEnabled();
+bool PerfJitdumpEnabled();
 static inline bool PerfEnabled() {
-  return PerfBlockEnabled() || PerfFuncEnabled();
+  return PerfBlockEnabled() || PerfFuncEnabled() || PerfJitdumpEnabled();
 }
 #else
 static inline void CheckPerf() {}
+static inline void ShutdownPerf() {}
 static inline bool PerfBlockEnabled() { return false; }
 static inline bool PerfFuncEnabled() { return false; }
+static inline bool PerfJitdumpEnabled() { return false; }
 static inline bool PerfEnabled() { return false; }
 #endif
 
@@ -74,13 +83,27 @@ class PerfSpewer {
   virtual void endBasicBlock(MacroAssembler& masm);
   void noteEndInlineCode(MacroAssembler& masm);
 
-  void writeProfile(JSScript* script, JitCode* code, MacroAssembler& masm);
+  // |nativeToBytecode| is only used for jitdump line tables. It's empty
+  // unless the profiler or jitdump is enabled.
+  void writeProfile(JSScript* script, JitCode* code, MacroAssembler& masm,
+                    const NativeToBytecode* nativeToBytecode,
+                    size_t nativeToBytecodeLength);
 
   static void WriteEntry(const AutoLockPerfMap&, uintptr_t address, size_t size,
                          const char* fmt, ...) MOZ_FORMAT_PRINTF(4, 5);
 };
 
-void writePerfSpewerBaselineProfile(JSScript* script, JitCode* code);
+// Native code offset of the first instruction of each bytecode op compiled
+// by Baseline. Only collected when jitdump is enabled.
+struct BaselinePerfOp {
+  uint32_t nativeOffset;
+  uint32_t pcOffset;
+};
+
+typedef Vector<BaselinePerfOp, 0, SystemAllocPolicy> BaselinePerfOpVector;
+
+void writePerfSpewerBaselineProfile(JSScript* script, JitCode* code,
+                                    const BaselinePerfOpVector& ops);
 void writePerfSpewerJitCodeProfile(JitCode* code, const char* msg);
 
 // wasm doesn't support block annotations.
@@ -155,7 +155,8 @@ static inline bool IsOptimizableObjectInstruction(MInstruction* ins) {
 static bool IsObjectEscaped(MInstruction* ins, JSObject* objDefault) {
   MOZ_ASSERT(ins->type() == MIRType::Object);
   MOZ_ASSERT(IsOptimizableObjectInstruction(ins) || ins->isGuardShape() ||
-             ins->isGuardObjectGroup() || ins->isFunctionEnvironment());
+             ins->isGuardObjectGroup() || ins->isGuardToClass() ||
+             ins->isFunctionEnvironment());
 
   JitSpewDef(JitSpew_Escape, "Check object\n", ins);
   JitSpewIndent spewIndent(JitSpew_Escape);
@@ -244,6 +245,21 @@ static bool IsObjectEscaped(MInstruction* ins, JSObject* objDefault) {
         break;
       }
 
+      // Self-hosted code guards on the class of iterators, for example
+      // GuardToArrayIterator in ArrayIteratorNext.
+      case MDefinition::Opcode::GuardToClass: {
+        MGuardToClass* guard = def->toGuardToClass();
+        if (obj->getClass() != guard->getClass()) {
+          JitSpewDef(JitSpew_Escape, "has a non-matching class guard\n", guard);
+          return true;
+        }
+        if (IsObjectEscaped(def->toInstruction(), obj)) {
+          JitSpewDef(JitSpew_Escape, "is indirectly escaped by\n", def);
+          return true;
+        }
+        break;
+      }
+
       case MDefinition::Opcode::Lambda:
       case MDefinition::Opcode::LambdaArrow:
       case MDefinition::Opcode::FunctionWithProto: {
@@ -304,6 +320,9 @@ class ObjectMemoryView : public MDefinitionVisitorDefaultNoop {
 
   bool oom() const { return oom_; }
 
+ private:
+  void replaceLoad(MInstruction* load, MDefinition* value);
+
  public:
   void visitResumePoint(MResumePoint* rp);
   void visitObjectState(MObjectState* ins);
@@ -314,6 +333,7 @@ class ObjectMemoryView : public MDefinitionVisitorDefaultNoop {
   void visitLoadDynamicSlot(MLoadDynamicSlot* ins);
   void visitGuardShape(MGuardShape* ins);
   void visitGuardObjectGroup(MGuardObjectGroup* ins);
+  void visitGuardToClass(MGuardToClass* ins);
   void visitFunctionEnvironment(MFunctionEnvironment* ins);
   void visitLambda(MLambda* ins);
   void visitLambdaArrow(MLambdaArrow* ins);
@@ -525,6 +545,27 @@ void ObjectMemoryView::visitStoreFixedSlot(MStoreFixedSlot* ins) {
   ins->block()->discard(ins);
 }
 
+void ObjectMemoryView::replaceLoad(MInstruction* load, MDefinition* value) {
+  // Typed loads, such as those emitted for UnsafeGetInt32FromReservedSlot,
+  // know the type of the slot. Unbox the emulated value to match, and only
+  // check the type if the stored value has a different type.
+  MIRType type = load->type();
+  if (type != MIRType::Value && value->type() != type) {
+    MUnbox::Mode mode = MUnbox::Infallible;
+    if (value->type() != MIRType::Value) {
+      MBox* box = MBox::New(alloc_, value);
+      load->block()->insertBefore(load, box);
+      value = box;
+      mode = MUnbox::Fallible;
+    }
+    MUnbox* unbox = MUnbox::New(alloc_, value, type, mode);
+    load->block()->insertBefore(load, unbox);
+    value = unbox;
+  }
+
+  load->replaceAllUsesWith(value);
+}
+
 void ObjectMemoryView::visitLoadFixedSlot(MLoadFixedSlot* ins) {
   // Skip loads made on other objects.
   if (ins->object() != obj_) {
@@ -533,13 +574,13 @@ void ObjectMemoryView::visitLoadFixedSlot(MLoadFixedSlot* ins) {
 
   // Replace load by the slot value.
   if (state_->hasFixedSlot(ins->slot())) {
-    ins->replaceAllUsesWith(state_->getFixedSlot(ins->slot()));
+    replaceLoad(ins, state_->getFixedSlot(ins->slot()));
   } else {
     // UnsafeGetReserveSlot can access baked-in slots which are guarded by
     // conditions, which are not seen by the escape analysis.
     MBail* bailout = MBail::New(alloc_, BailoutKind::Inevitable);
     ins->block()->insertBefore(ins, bailout);
-    ins->replaceAllUsesWith(undefinedVal_);
+    replaceLoad(ins, undefinedVal_);
   }
 
   // Remove original instruction.
@@ -599,13 +640,13 @@ void ObjectMemoryView::visitLoadDynamicSlot(MLoadDynamicSlot* ins) {
 
   // Replace load by the slot value.
   if (state_->hasDynamicSlot(ins->slot())) {
-    ins->replaceAllUsesWith(state_->getDynamicSlot(ins->slot()));
+    replaceLoad(ins, state_->getDynamicSlot(ins->slot()));
   } else {
     // UnsafeGetReserveSlot can access baked-in slots which are guarded by
     // conditions, which are not seen by the escape analysis.
     MBail* bailout = MBail::New(alloc_, BailoutKind::Inevitable);
     ins->block()->insertBefore(ins, bailout);
-    ins->replaceAllUsesWith(undefinedVal_);
+    replaceLoad(ins, undefinedVal_);
   }
 
   // Remove original instruction.
@@ -638,6 +679,10 @@ void ObjectMemoryView::visitGuardObjectGroup(MGuardObjectGroup* ins) {
   visitObjectGuard(ins, ins->object());
 }
 
+void ObjectMemoryView::visitGuardToClass(MGuardToClass* ins) {
+  visitObjectGuard(ins, ins->object());
+}
+
 void ObjectMemoryView::visitFunctionEnvironment(MFunctionEnvironment* ins) {
   // Skip function environment which are not aliases of the NewCallObject.
   MDefinition* input = ins->input();
@@ -710,9 +755,32 @@ static bool IndexOf(MDefinition* ins, int32_t* res) {
   return true;
 }
 
+// Returns true if the index of |load| is bounds checked against the
+// initialized length of |elements|, which is what Warp emits for dense element
+// loads.
+static bool IsBoundsCheckedAgainstInitializedLength(MLoadElement* load,
+                                                    MDefinition* elements) {
+  MDefinition* index = load->index();
+  if (index->isSpectreMaskIndex()) {
+    index = index->toSpectreMaskIndex()->index();
+  }
+  if (!index->isBoundsCheck()) {
+    return false;
+  }
+  MDefinition* length = index->toBoundsCheck()->length();
+  return length->isInitializedLength() &&
+         length->toInitializedLength()->elements() == elements;
+}
+
 // Returns False if the elements is not escaped and if it is optimizable by
 // ScalarReplacementOfArray.
-static bool IsElementEscaped(MDefinition* def, uint32_t arraySize) {
+//
+// |noHolesBelowInitLength| is true if all elements below the initialized
+// length of the array have been stored with MStoreElement. This holds for
+// MNewArray allocations, as storing a hole requires MStoreHoleValueElement,
+// which makes the array escape.
+static bool IsElementEscaped(MDefinition* def, uint32_t arraySize,
+                             bool noHolesBelowInitLength) {
   MOZ_ASSERT(def->isElements() || def->isConvertElementsToDoubles());
 
   JitSpewDef(JitSpew_Escape, "Check elements\n", def);
@@ -731,8 +799,13 @@ static bool IsElementEscaped(MDefinition* def, uint32_t arraySize) {
         // as the array might refer to the prototype chain to look
         // for properties, thus it might do additional side-effects
         // which are not reflected by the alias set, is we are
-        // bailing on holes.
-        if (access->toLoadElement()->needsHoleCheck()) {
+        // bailing on holes. The hole check is redundant if the load is
+        // bounds checked against the initialized length and there are no
+        // holes below it.
+        if (access->toLoadElement()->needsHoleCheck() &&
+            !(noHolesBelowInitLength &&
+              IsBoundsCheckedAgainstInitializedLength(access->toLoadElement(),
+                                                      def))) {
           JitSpewDef(JitSpew_Escape, "has a load element with a hole check\n",
                      access);
           return true;
@@ -805,7 +878,7 @@ static bool IsElementEscaped(MDefinition* def, uint32_t arraySize) {
 
       case MDefinition::Opcode::ConvertElementsToDoubles:
         MOZ_ASSERT(access->toConvertElementsToDoubles()->elements() == def);
-        if (IsElementEscaped(access, arraySize)) {
+        if (IsElementEscaped(access, arraySize, noHolesBelowInitLength)) {
           JitSpewDef(JitSpew_Escape, "is indirectly escaped by\n", access);
           return true;
         }
@@ -832,21 +905,25 @@ static inline bool IsOptimizableArrayInstruction(MInstruction* ins) {
 static bool IsArrayEscaped(MInstruction* ins, MInstruction* newArray) {
   MOZ_ASSERT(ins->type() == MIRType::Object);
   MOZ_ASSERT(IsOptimizableArrayInstruction(ins) ||
-             ins->isMaybeCopyElementsForWrite());
+             ins->isMaybeCopyElementsForWrite() || ins->isGuardShape() ||
+             ins->isGuardToClass());
   MOZ_ASSERT(IsOptimizableArrayInstruction(newArray));
 
   JitSpewDef(JitSpew_Escape, "Check array\n", ins);
   JitSpewIndent spewIndent(JitSpew_Escape);
 
+  JSObject* templateObject;
   uint32_t length;
   if (newArray->isNewArray()) {
-    if (!newArray->toNewArray()->templateObject()) {
+    templateObject = newArray->toNewArray()->templateObject();
+    if (!templateObject) {
       JitSpew(JitSpew_Escape, "No template object defined.");
       return true;
     }
 
     length = newArray->toNewArray()->length();
   } else {
+    templateObject = newArray->toNewArrayCopyOnWrite()->templateObject();
     length = newArray->toNewArrayCopyOnWrite()->templateObject()->length();
   }
 
@@ -874,7 +951,7 @@ static bool IsArrayEscaped(MInstruction* ins, MInstruction* newArray) {
       case MDefinition::Opcode::Elements: {
         MElements* elem = def->toElements();
         MOZ_ASSERT(elem->object() == ins);
-        if (IsElementEscaped(elem, length)) {
+        if (IsElementEscaped(elem, length, newArray->isNewArray())) {
           JitSpewDef(JitSpew_Escape, "is indirectly escaped by\n", elem);
           return true;
         }
@@ -892,6 +969,34 @@ static bool IsArrayEscaped(MInstruction* ins, MInstruction* newArray) {
         break;
       }
 
+      // Warp's element and length ICs guard on the shape or the class of
+      // the array, for example when reading from a rest array.
+      case MDefinition::Opcode::GuardShape: {
+        MGuardShape* guard = def->toGuardShape();
+        if (templateObject->shape() != guard->shape()) {
+          JitSpewDef(JitSpew_Escape, "has a non-matching guard shape\n", guard);
+          return true;
+        }
+        if (IsArrayEscaped(guard, newArray)) {
+          JitSpewDef(JitSpew_Escape, "is indirectly escaped by\n", guard);
+          return true;
+        }
+        break;
+      }
+
+      case MDefinition::Opcode::GuardToClass: {
+        MGuardToClass* guard = def->toGuardToClass();
+        if (templateObject->getClass() != guard->getClass()) {
+          JitSpewDef(JitSpew_Escape, "has a non-matching class guard\n", guard);
+          return true;
+        }
+        if (IsArrayEscaped(guard, newArray)) {
+          JitSpewDef(JitSpew_Escape, "is indirectly escaped by\n", guard);
+          return true;
+        }
+        break;
+      }
+
       // This instruction is a no-op used to verify that scalar replacement
       // is working as expected in jit-test.
       case MDefinition::Opcode::AssertRecoveredOnBailout:
@@ -963,6 +1068,9 @@ class ArrayMemoryView : public MDefinitionVisitorDefaultNoop {
   void visitArrayLength(MArrayLength* ins);
   void visitMaybeCopyElementsForWrite(MMaybeCopyElementsForWrite* ins);
   void visitConvertElementsToDoubles(MConvertElementsToDoubles* ins);
+  void visitGuardShape(MGuardShape* ins);
+  void visitGuardToClass(MGuardToClass* ins);
+  void visitArrayGuard(MInstruction* ins, MDefinition* operand);
 };
 
 const char* ArrayMemoryView::phaseName = "Scalar Replacement of Array";
@@ -1257,6 +1365,32 @@ void ArrayMemoryView::visitMaybeCopyElementsForWrite(
   ins->block()->discard(ins);
 }
 
+void ArrayMemoryView::visitArrayGuard(MInstruction* ins,
+                                      MDefinition* operand) {
+  MOZ_ASSERT(ins->numOperands() == 1);
+  MOZ_ASSERT(ins->getOperand(0) == operand);
+  MOZ_ASSERT(ins->type() == MIRType::Object);
+
+  // Skip guards on other objects.
+  if (operand != arr_) {
+    return;
+  }
+
+  // Replace the guard by the array.
+  ins->replaceAllUsesWith(arr_);
+
+  // Remove original instruction.
+  ins->block()->discard(ins);
+}
+
+void ArrayMemoryView::visitGuardShape(MGuardShape* ins) {
+  visitArrayGuard(ins, ins->object());
+}
+
+void ArrayMemoryView::visitGuardToClass(MGuardToClass* ins) {
+  visitArrayGuard(ins, ins->object());
+}
+
 void ArrayMemoryView::visitConvertElementsToDoubles(
     MConvertElementsToDoubles* ins) {
   MOZ_ASSERT(ins->numOperands() == 1);
@@ -20,6 +20,7 @@
 #include "js/friend/StackLimits.h"  // js::CheckRecursionLimitWithExtra
 #include "js/friend/WindowProxy.h"  // js::IsWindow
 #include "vm/ArrayObject.h"
+#include "vm/Caches.h"
 #include "vm/EqualityOperations.h"  // js::StrictlyEqual
 #include "vm/Interpreter.h"
 #include "vm/PlainObject.h"  // js::PlainObject
@@ -1563,12 +1564,25 @@ static MOZ_ALWAYS_INLINE bool GetNativeDataPropertyPure(JSContext* cx,
 
   MOZ_ASSERT(JSID_IS_ATOM(id) || JSID_IS_SYMBOL(id));
 
+  // Try the megamorphic cache first. MegamorphicLoadSlotResult stubs probe
+  // it inline, but the ByValue variant only looks it up here.
+  MegamorphicCache& cache = cx->caches().megamorphicCache;
+  const MegamorphicCache::Entry* entry;
+  if (cache.lookup(obj->lastProperty(), id, &entry)) {
+    *vp = obj->getSlot(entry->slot(obj));
+    return true;
+  }
+
+  NativeObject* receiver = obj;
   while (true) {
     if (Shape* shape = obj->lastProperty()->search(cx, id)) {
       if (!shape->isDataProperty()) {
         return false;
       }
 
+      if (obj == receiver) {
+        cache.fill(obj, id, shape);
+      }
       *vp = obj->getSlot(shape->slot());
       return true;
     }
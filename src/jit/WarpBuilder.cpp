@@ -220,8 +220,14 @@ bool WarpBuilder::startNewOsrPreHeaderBlock(BytecodeLocation loopHead) {
     }
   }
 
-  // Initialize locals.
+  // Type hints for the locals and stack values, based on the frame we're
+  // compiling for. Ignore them if they don't match the frame layout we expect.
   uint32_t nlocals = info().nlocals();
+  uint32_t numStackSlots = current->stackDepth() - info().firstStackSlot();
+  const WarpSnapshot::OsrValueTypeVector& osrTypes = snapshot().osrValueTypes();
+  bool useTypeHints = osrTypes.length() == nlocals + numStackSlots;
+
+  // Initialize locals.
   for (uint32_t i = 0; i < nlocals; i++) {
     uint32_t slot = info().localSlot(i);
     ptrdiff_t offset = BaselineFrame::reverseOffsetOfLocal(i);
@@ -229,12 +235,14 @@ bool WarpBuilder::startNewOsrPreHeaderBlock(BytecodeLocation loopHead) {
     if (!osrv) {
       return false;
     }
+    if (useTypeHints) {
+      osrv->setTypeHint(osrTypes[i]);
+    }
     current->add(osrv);
     current->initSlot(slot, osrv);
   }
 
   // Initialize expression stack slots.
-  uint32_t numStackSlots = current->stackDepth() - info().firstStackSlot();
   for (uint32_t i = 0; i < numStackSlots; i++) {
     uint32_t slot = info().stackSlot(i);
     ptrdiff_t offset = BaselineFrame::reverseOffsetOfLocal(nlocals + i);
@@ -242,6 +250,9 @@ bool WarpBuilder::startNewOsrPreHeaderBlock(BytecodeLocation loopHead) {
     if (!osrv) {
       return false;
     }
+    if (useTypeHints) {
+      osrv->setTypeHint(osrTypes[nlocals + i]);
+    }
     current->add(osrv);
     current->initSlot(slot, osrv);
   }
@@ -1313,6 +1324,10 @@ bool WarpBuilder::build_LoopHead(BytecodeLocation loc) {
 
   pred->end(MGoto::New(alloc(), current));
 
+  if (getOpSnapshot<WarpNoLICM>(loc)) {
+    current->setLICMDisabled();
+  }
+
   if (!addIteratorLoopPhis(loc)) {
     return false;
   }
@@ -2248,13 +2263,16 @@ bool WarpBuilder::build_CallSiteObj(BytecodeLocation loc) {
 bool WarpBuilder::build_NewArray(BytecodeLocation loc) {
   uint32_t length = loc.getNewArrayLength();
 
-  // TODO: support pre-tenuring.
+  // Pretenuring is decided at runtime by the allocation site, see
+  // gc::AllocSite.
   gc::InitialHeap heap = gc::DefaultHeap;
 
   MConstant* templateConst;
+  gc::AllocSite* site = nullptr;
   bool useVMCall;
   if (const auto* snapshot = getOpSnapshot<WarpNewArray>(loc)) {
     templateConst = constant(ObjectValue(*snapshot->templateObject()));
+    site = snapshot->allocSite();
     useVMCall = snapshot->useVMCall();
   } else {
     templateConst = constant(NullValue());
@@ -2269,6 +2287,7 @@ bool WarpBuilder::build_NewArray(BytecodeLocation loc) {
     ins = MNewArray::New(alloc(), /* constraints = */ nullptr, length,
                          templateConst, heap, loc.toRawBytecode());
   }
+  ins->setAllocSite(site);
   current->add(ins);
   current->push(ins);
   return true;
@@ -2293,7 +2312,8 @@ bool WarpBuilder::build_NewArrayCopyOnWrite(BytecodeLocation loc) {
 }
 
 bool WarpBuilder::build_NewObject(BytecodeLocation loc) {
-  // TODO: support pre-tenuring.
+  // Pretenuring is decided at runtime by the allocation site, see
+  // gc::AllocSite.
   gc::InitialHeap heap = gc::DefaultHeap;
 
   MNewObject* ins;
@@ -2301,6 +2321,7 @@ bool WarpBuilder::build_NewObject(BytecodeLocation loc) {
     auto* templateConst = constant(ObjectValue(*snapshot->templateObject()));
     ins = MNewObject::New(alloc(), /* constraints = */ nullptr, templateConst,
                           heap, MNewObject::ObjectLiteral);
+    ins->setAllocSite(snapshot->allocSite());
   } else {
     auto* templateConst = constant(NullValue());
     ins = MNewObject::NewVM(alloc(), /* constraints = */ nullptr, templateConst,
@@ -2437,6 +2458,14 @@ bool WarpBuilder::build_CheckIsObj(BytecodeLocation loc) {
   CheckIsObjectKind kind = loc.getCheckIsObjectKind();
   MDefinition* val = current->pop();
 
+  // The check can't fail if the value is known to be an object. Don't emit it
+  // then: it would needlessly prevent scalar replacement of iterator result
+  // objects.
+  if (val->type() == MIRType::Object) {
+    current->push(val);
+    return true;
+  }
+
   MCheckIsObj* ins = MCheckIsObj::New(alloc(), val, uint8_t(kind));
   current->add(ins);
   current->push(ins);
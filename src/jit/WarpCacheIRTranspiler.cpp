@@ -1849,6 +1849,44 @@ bool WarpCacheIRTranspiler::emitIsArrayResult(ValOperandId inputId) {
   return resumeAfter(isArray);
 }
 
+bool WarpCacheIRTranspiler::emitAssertRecoveredOnBailoutResult(
+    ValOperandId valId, bool mustBeRecovered) {
+  MDefinition* val = getOperand(valId);
+
+  // Don't assert for recovered instructions when recovering is disabled.
+  // If we are checking the range of all instructions, then the guards
+  // inserted by Range Analysis prevent the use of recover instructions too.
+  if (JitOptions.disableRecoverIns || JitOptions.checkRangeAnalysis) {
+    pushResult(constant(UndefinedValue()));
+    return true;
+  }
+
+  auto* assertion =
+      MAssertRecoveredOnBailout::New(alloc(), val, mustBeRecovered);
+  add(assertion);
+  current->push(assertion);
+
+  // Create an instruction sequence which implies that the argument of the
+  // assertRecoveredOnBailout function would be encoded at least in one
+  // Snapshot.
+  auto* nop = MNop::New(alloc());
+  add(nop);
+
+  MResumePoint* resumePoint = MResumePoint::New(
+      alloc(), nop->block(), loc_.toRawBytecode(), MResumePoint::ResumeAfter);
+  if (!resumePoint) {
+    return false;
+  }
+  nop->setResumePoint(resumePoint);
+
+  add(MEncodeSnapshot::New(alloc()));
+
+  current->pop();
+
+  pushResult(constant(UndefinedValue()));
+  return true;
+}
+
 bool WarpCacheIRTranspiler::emitIsObjectResult(ValOperandId inputId) {
   MDefinition* value = getOperand(inputId);
 
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 
+#include "jit/BaselineFrame.h"
 #include "jit/CacheIR.h"
 #include "jit/CacheIRCompiler.h"
 #include "jit/CacheIROpsGenerated.h"
@@ -81,11 +82,14 @@ class MOZ_STACK_CLASS WarpScriptOracle {
 };
 
 WarpOracle::WarpOracle(JSContext* cx, MIRGenerator& mirGen,
-                       HandleScript outerScript)
+                       HandleScript outerScript, BaselineFrame* osrFrame,
+                       uint32_t osrFrameSize)
     : cx_(cx),
       mirGen_(mirGen),
       alloc_(mirGen.alloc()),
-      outerScript_(outerScript) {}
+      outerScript_(outerScript),
+      osrFrame_(osrFrame),
+      osrFrameSize_(osrFrameSize) {}
 
 mozilla::GenericErrorResult<AbortReason> WarpOracle::abort(HandleScript script,
                                                            AbortReason r) {
@@ -141,6 +145,10 @@ AbortReasonOr<WarpSnapshot*> WarpOracle::createSnapshot() {
     return abort(outerScript_, AbortReason::Alloc);
   }
 
+  if (!recordOsrValueTypes(snapshot)) {
+    return abort(outerScript_, AbortReason::Alloc);
+  }
+
 #ifdef JS_JITSPEW
   if (JitSpewEnabled(JitSpew_WarpSnapshots)) {
     Fprinter& out = JitSpewPrinter();
@@ -151,6 +159,33 @@ AbortReasonOr<WarpSnapshot*> WarpOracle::createSnapshot() {
   return snapshot;
 }
 
+bool WarpOracle::recordOsrValueTypes(WarpSnapshot* snapshot) {
+  // For OSR compilations, record the types of the values that are live in the
+  // frame at the loop header. WarpBuilder uses these to specialize the OSR
+  // entry block for the frame we're actually going to enter from, instead of
+  // relying only on the types seen by the code before and in the loop. If the
+  // types later change, the unbox instructions in the OSR entry block will
+  // bail out and frequent bailouts will invalidate the IonScript as usual.
+  if (!mirGen_.outerInfo().osrPc() || !osrFrame_) {
+    return true;
+  }
+
+  MOZ_ASSERT(osrFrame_->script() == outerScript_);
+
+  size_t numSlots = osrFrame_->numValueSlots(osrFrameSize_);
+  if (!snapshot->osrValueTypes().reserve(numSlots)) {
+    return false;
+  }
+  for (size_t i = 0; i < numSlots; i++) {
+    // Magic values (for example uninitialized lexicals) are handled by the
+    // existing OSR guards, so only record types we can unbox to.
+    const Value& v = *osrFrame_->valueSlot(i);
+    MIRType type = v.isMagic() ? MIRType::Value : MIRTypeFromValue(v);
+    snapshot->osrValueTypes().infallibleAppend(type);
+  }
+  return true;
+}
+
 template <typename T, typename... Args>
 static MOZ_MUST_USE bool AddOpSnapshot(TempAllocator& alloc,
                                        WarpOpSnapshotList& snapshots,
@@ -311,6 +346,14 @@ AbortReasonOr<WarpScriptSnapshot*> WarpScriptOracle::createScriptSnapshot() {
         break;
       }
 
+      case JSOp::LoopHead:
+        if (script_->jitScript()->isLICMDisabledForLoop(offset)) {
+          if (!AddOpSnapshot<WarpNoLICM>(alloc_, opSnapshots, offset)) {
+            return abort(AbortReason::Alloc);
+          }
+        }
+        break;
+
       case JSOp::FunctionThis:
         if (!script_->strict() && script_->hasNonSyntacticScope()) {
           // Abort because MBoxNonStrictThis doesn't support non-syntactic
@@ -493,7 +536,8 @@ AbortReasonOr<WarpScriptSnapshot*> WarpScriptOracle::createScriptSnapshot() {
               ObjectElements::VALUES_PER_HEADER;
           bool useVMCall = loc.getNewArrayLength() > numInlineElements;
           if (!AddOpSnapshot<WarpNewArray>(alloc_, opSnapshots, offset,
-                                           templateObj, useVMCall)) {
+                                           templateObj, stub->allocSite(),
+                                           useVMCall)) {
             return abort(AbortReason::Alloc);
           }
         }
@@ -507,7 +551,7 @@ AbortReasonOr<WarpScriptSnapshot*> WarpScriptOracle::createScriptSnapshot() {
         auto* stub = entry.fallbackStub()->toNewObject_Fallback();
         if (JSObject* templateObj = stub->templateObject()) {
           if (!AddOpSnapshot<WarpNewObject>(alloc_, opSnapshots, offset,
-                                            templateObj)) {
+                                            templateObj, stub->allocSite())) {
             return abort(AbortReason::Alloc);
           }
         }
@@ -633,7 +677,6 @@ AbortReasonOr<WarpScriptSnapshot*> WarpScriptOracle::createScriptSnapshot() {
       case JSOp::GetArg:
       case JSOp::SetArg:
       case JSOp::JumpTarget:
-      case JSOp::LoopHead:
       case JSOp::IfEq:
       case JSOp::IfNe:
       case JSOp::And:
@@ -14,6 +14,7 @@
 namespace js {
 namespace jit {
 
+class BaselineFrame;
 class MIRGenerator;
 
 // WarpOracle creates a WarpSnapshot data structure that's used by WarpBuilder
@@ -23,6 +24,11 @@ class MOZ_STACK_CLASS WarpOracle {
   MIRGenerator& mirGen_;
   TempAllocator& alloc_;
   HandleScript outerScript_;
+
+  // The BaselineFrame we're compiling for if this is an OSR compilation.
+  BaselineFrame* osrFrame_;
+  uint32_t osrFrameSize_;
+
   WarpBailoutInfo bailoutInfo_;
   WarpScriptSnapshotList scriptSnapshots_;
 
@@ -36,7 +42,8 @@ class MOZ_STACK_CLASS WarpOracle {
   NurseryObjectsMap nurseryObjectsMap_;
 
  public:
-  WarpOracle(JSContext* cx, MIRGenerator& mirGen, HandleScript outerScript);
+  WarpOracle(JSContext* cx, MIRGenerator& mirGen, HandleScript outerScript,
+             BaselineFrame* osrFrame, uint32_t osrFrameSize);
   ~WarpOracle() { scriptSnapshots_.clear(); }
 
   MIRGenerator& mirGen() { return mirGen_; }
@@ -46,6 +53,7 @@ class MOZ_STACK_CLASS WarpOracle {
                                           uint32_t* nurseryIndex);
 
   AbortReasonOr<WarpSnapshot*> createSnapshot();
+  MOZ_MUST_USE bool recordOsrValueTypes(WarpSnapshot* snapshot);
 
   mozilla::GenericErrorResult<AbortReason> abort(HandleScript script,
                                                  AbortReason r);
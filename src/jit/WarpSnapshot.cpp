@@ -30,7 +30,8 @@ WarpSnapshot::WarpSnapshot(JSContext* cx, TempAllocator& alloc,
       globalLexicalEnv_(&cx->global()->lexicalEnvironment()),
       globalLexicalEnvThis_(globalLexicalEnv_->thisObject()),
       bailoutInfo_(bailoutInfo),
-      nurseryObjects_(alloc) {}
+      nurseryObjects_(alloc),
+      osrValueTypes_(alloc) {}
 
 WarpScriptSnapshot::WarpScriptSnapshot(
     JSScript* script, const WarpEnvironment& env,
@@ -68,6 +69,15 @@ void WarpSnapshot::dump(GenericPrinter& out) const {
   }
   out.printf("\n");
 
+  if (!osrValueTypes_.empty()) {
+    out.printf("OSR value types (%u):\n", unsigned(osrValueTypes_.length()));
+    for (size_t i = 0; i < osrValueTypes_.length(); i++) {
+      out.printf("  %u: %s\n", unsigned(i),
+                 StringFromMIRType(osrValueTypes_[i]));
+    }
+    out.printf("\n");
+  }
+
   for (auto* scriptSnapshot : scriptSnapshots_) {
     scriptSnapshot->dump(out);
   }
@@ -160,11 +170,13 @@ void WarpRest::dumpData(GenericPrinter& out) const {
 
 void WarpNewArray::dumpData(GenericPrinter& out) const {
   out.printf("    template: 0x%p\n", templateObject());
+  out.printf("    allocSite: 0x%p\n", allocSite());
   out.printf("    useVMCall: %u\n", useVMCall());
 }
 
 void WarpNewObject::dumpData(GenericPrinter& out) const {
   out.printf("    template: 0x%p\n", templateObject());
+  out.printf("    allocSite: 0x%p\n", allocSite());
 }
 
 void WarpBindGName::dumpData(GenericPrinter& out) const {
@@ -175,6 +187,10 @@ void WarpBailout::dumpData(GenericPrinter& out) const {
   // No fields.
 }
 
+void WarpNoLICM::dumpData(GenericPrinter& out) const {
+  // No fields.
+}
+
 void WarpCacheIR::dumpData(GenericPrinter& out) const {
   out.printf("    stubCode: 0x%p\n", static_cast<JitCode*>(stubCode_));
   out.printf("    stubInfo: 0x%p\n", stubInfo_);
@@ -303,6 +319,10 @@ void WarpBailout::traceData(JSTracer* trc) {
   // No GC pointers.
 }
 
+void WarpNoLICM::traceData(JSTracer* trc) {
+  // No GC pointers.
+}
+
 void WarpCacheIR::traceData(JSTracer* trc) {
   TraceWarpGCPtr(trc, stubCode_, "warp-stub-code");
 
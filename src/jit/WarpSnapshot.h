@@ -11,6 +11,7 @@
 #include "mozilla/Variant.h"
 
 #include "gc/Policy.h"
+#include "jit/IonTypes.h"
 #include "jit/JitAllocPolicy.h"
 #include "jit/JitContext.h"
 #include "vm/FunctionFlags.h"  // js::FunctionFlags
@@ -38,6 +39,7 @@ class WarpScriptSnapshot;
   _(WarpNewObject)               \
   _(WarpBindGName)               \
   _(WarpBailout)                 \
+  _(WarpNoLICM)                  \
   _(WarpCacheIR)                 \
   _(WarpInlinedCall)
 
@@ -255,6 +257,22 @@ class WarpBailout : public WarpOpSnapshot {
 #endif
 };
 
+// LICM must not hoist instructions out of this loop because hoisted
+// instructions bailed out frequently. See
+// JitScript::disableLICMForFrequentBailouts.
+class WarpNoLICM : public WarpOpSnapshot {
+ public:
+  static constexpr Kind ThisKind = Kind::WarpNoLICM;
+
+  explicit WarpNoLICM(uint32_t offset) : WarpOpSnapshot(ThisKind, offset) {}
+
+  void traceData(JSTracer* trc);
+
+#ifdef JS_JITSPEW
+  void dumpData(GenericPrinter& out) const;
+#endif
+};
+
 // Information from a Baseline IC stub.
 class WarpCacheIR : public WarpOpSnapshot {
   // Baseline stub code. Stored here to keep the CacheIRStubInfo alive.
@@ -395,20 +413,24 @@ class WarpRest : public WarpOpSnapshot {
 #endif
 };
 
-// Template object for JSOp::NewArray.
+// Template object and allocation site for JSOp::NewArray.
 class WarpNewArray : public WarpOpSnapshot {
   WarpGCPtr<ArrayObject*> templateObject_;
+  gc::AllocSite* allocSite_;
   bool useVMCall_;
 
  public:
   static constexpr Kind ThisKind = Kind::WarpNewArray;
 
-  WarpNewArray(uint32_t offset, ArrayObject* templateObject, bool useVMCall)
+  WarpNewArray(uint32_t offset, ArrayObject* templateObject,
+               gc::AllocSite* allocSite, bool useVMCall)
       : WarpOpSnapshot(ThisKind, offset),
         templateObject_(templateObject),
+        allocSite_(allocSite),
         useVMCall_(useVMCall) {}
 
   ArrayObject* templateObject() const { return templateObject_; }
+  gc::AllocSite* allocSite() const { return allocSite_; }
   bool useVMCall() const { return useVMCall_; }
 
   void traceData(JSTracer* trc);
@@ -418,17 +440,23 @@ class WarpNewArray : public WarpOpSnapshot {
 #endif
 };
 
-// Template object for JSOp::NewObject, JSOp::NewInit, JSOp::NewObjectWithGroup.
+// Template object and allocation site for JSOp::NewObject, JSOp::NewInit,
+// JSOp::NewObjectWithGroup.
 class WarpNewObject : public WarpOpSnapshot {
   WarpGCPtr<JSObject*> templateObject_;
+  gc::AllocSite* allocSite_;
 
  public:
   static constexpr Kind ThisKind = Kind::WarpNewObject;
 
-  WarpNewObject(uint32_t offset, JSObject* templateObject)
-      : WarpOpSnapshot(ThisKind, offset), templateObject_(templateObject) {}
+  WarpNewObject(uint32_t offset, JSObject* templateObject,
+                gc::AllocSite* allocSite)
+      : WarpOpSnapshot(ThisKind, offset),
+        templateObject_(templateObject),
+        allocSite_(allocSite) {}
 
   JSObject* templateObject() const { return templateObject_; }
+  gc::AllocSite* allocSite() const { return allocSite_; }
 
   void traceData(JSTracer* trc);
 
@@ -575,6 +603,13 @@ class WarpSnapshot : public TempObject {
   using NurseryObjectVector = Vector<JSObject*, 0, JitAllocPolicy>;
   NurseryObjectVector nurseryObjects_;
 
+  // For OSR compilations, the types of the locals and expression stack values
+  // of the BaselineFrame that triggered the compilation. WarpBuilder uses these
+  // as type hints for the OSR entry block. Empty if this isn't an OSR
+  // compilation.
+  using OsrValueTypeVector = Vector<MIRType, 0, JitAllocPolicy>;
+  OsrValueTypeVector osrValueTypes_;
+
  public:
   explicit WarpSnapshot(JSContext* cx, TempAllocator& alloc,
                         WarpScriptSnapshotList&& scriptSnapshots,
@@ -595,6 +630,9 @@ class WarpSnapshot : public TempObject {
   NurseryObjectVector& nurseryObjects() { return nurseryObjects_; }
   const NurseryObjectVector& nurseryObjects() const { return nurseryObjects_; }
 
+  OsrValueTypeVector& osrValueTypes() { return osrValueTypes_; }
+  const OsrValueTypeVector& osrValueTypes() const { return osrValueTypes_; }
+
 #ifdef JS_JITSPEW
   void dump() const;
   void dump(GenericPrinter& out) const;
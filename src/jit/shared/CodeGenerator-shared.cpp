@@ -17,6 +17,7 @@
 #include "jit/MacroAssembler.h"
 #include "jit/MIR.h"
 #include "jit/MIRGenerator.h"
+#include "jit/PerfSpewer.h"
 #include "js/Conversions.h"
 #include "util/Memory.h"
 #include "vm/TraceLogging.h"
@@ -204,8 +205,8 @@ void CodeGeneratorShared::addOutOfLineCode(OutOfLineCode* code,
 }
 
 bool CodeGeneratorShared::addNativeToBytecodeEntry(const BytecodeSite* site) {
-  // Skip the table entirely if profiling is not enabled.
-  if (!isProfilerInstrumentationEnabled()) {
+  // Skip the table entirely if neither profiling nor jitdump is enabled.
+  if (!isProfilerInstrumentationEnabled() && !PerfJitdumpEnabled()) {
     return true;
   }
 
@@ -251,11 +251,37 @@ LSnapshot* LIRGeneratorShared::buildSnapshot(LInstruction* ins,
 }
 #endif
 
+// Bailouts from instructions hoisted out of a loop resume at the loop's head.
+// They are reported as BailoutKind::LICM so that frequent bailouts can be
+// blamed on the hoisting, and not on other bailouts that resume there, such
+// as failed unboxes of OSR values. Kinds that are handled specially when
+// resuming in Baseline are kept.
+static BailoutKind HoistedBailoutKind(BailoutKind kind) {
+  switch (kind) {
+    case BailoutKind::FirstExecution:
+    case BailoutKind::OverflowInvalidate:
+    case BailoutKind::DoubleOutput:
+    case BailoutKind::ObjectIdentityOrTypeGuard:
+    case BailoutKind::ArgumentCheck:
+    case BailoutKind::BoundsCheck:
+    case BailoutKind::ShapeGuard:
+    case BailoutKind::UninitializedLexical:
+    case BailoutKind::IonExceptionDebugMode:
+      return kind;
+    default:
+      return BailoutKind::LICM;
+  }
+}
+
 void LIRGeneratorShared::assignSnapshot(LInstruction* ins, BailoutKind kind) {
   // assignSnapshot must be called before define/add, since
   // it may add new instructions for emitted-at-use operands.
   MOZ_ASSERT(ins->id() == 0);
 
+  if (loweringHoistedIns_) {
+    kind = HoistedBailoutKind(kind);
+  }
+
   LSnapshot* snapshot = buildSnapshot(ins, lastResumePoint_, kind);
   if (!snapshot) {
     abort(AbortReason::Alloc, "buildSnapshot failed");
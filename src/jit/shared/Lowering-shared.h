@@ -32,6 +32,9 @@ class LIRGeneratorShared {
   LRecoverInfo* cachedRecoverInfo_;
   LOsiPoint* osiPoint_;
 
+  // Whether the instruction being lowered was hoisted out of a loop by LICM.
+  bool loweringHoistedIns_;
+
   LIRGeneratorShared(MIRGenerator* gen, MIRGraph& graph, LIRGraph& lirGraph)
       : gen(gen),
         graph(graph),
@@ -39,7 +42,8 @@ class LIRGeneratorShared {
         current(nullptr),
         lastResumePoint_(nullptr),
         cachedRecoverInfo_(nullptr),
-        osiPoint_(nullptr) {}
+        osiPoint_(nullptr),
+        loweringHoistedIns_(false) {}
 
   MIRGenerator* mir() { return gen; }
 
@@ -2444,6 +2444,23 @@ void CodeGenerator::visitWasmBinarySimd128(LWasmBinarySimd128* ins) {
     case wasm::SimdOp::F64x2Max:
       masm.maxFloat64x2(rhs, lhsDest, temp1);
       break;
+    case wasm::SimdOp::F32x4PMin:
+      // x86/x64 specific: The operands were swapped during lowering, see
+      // pseudoMinFloat32x4.
+      masm.pseudoMinFloat32x4(rhs, lhsDest);
+      break;
+    case wasm::SimdOp::F32x4PMax:
+      masm.pseudoMaxFloat32x4(rhs, lhsDest);
+      break;
+    case wasm::SimdOp::F64x2PMin:
+      masm.pseudoMinFloat64x2(rhs, lhsDest);
+      break;
+    case wasm::SimdOp::F64x2PMax:
+      masm.pseudoMaxFloat64x2(rhs, lhsDest);
+      break;
+    case wasm::SimdOp::I32x4DotSI16x8:
+      masm.widenDotInt16x8(rhs, lhsDest);
+      break;
     case wasm::SimdOp::V8x16Swizzle:
       masm.swizzleInt8x16(rhs, lhsDest, temp1);
       break;
@@ -315,6 +315,7 @@ enum TwoByteOpcodeID {
   OP2_PSLLD_VdqWdq = 0xF2,
   OP2_PSLLQ_VdqWdq = 0xF3,
   OP2_PMULUDQ_VdqWdq = 0xF4,
+  OP2_PMADDWD_VdqWdq = 0xF5,
   OP2_PSUBB_VdqWdq = 0xF8,
   OP2_PSUBW_VdqWdq = 0xF9,
   OP2_PSUBD_VdqWdq = 0xFA,
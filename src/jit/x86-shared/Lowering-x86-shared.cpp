@@ -739,7 +739,11 @@ void LIRGenerator::visitWasmBinarySimd128(MWasmBinarySimd128* ins) {
   LDefinition tempReg0 = LDefinition::BogusTemp();
   LDefinition tempReg1 = LDefinition::BogusTemp();
   switch (ins->simdOp()) {
-    case wasm::SimdOp::V128AndNot: {
+    case wasm::SimdOp::V128AndNot:
+    case wasm::SimdOp::F32x4PMin:
+    case wasm::SimdOp::F32x4PMax:
+    case wasm::SimdOp::F64x2PMin:
+    case wasm::SimdOp::F64x2PMax: {
       // x86/x64 specific: Code generation requires the operands to be reversed.
       MDefinition* tmp = lhs;
       lhs = rhs;
@@ -1476,6 +1476,12 @@ void MacroAssembler::mulInt64x2(FloatRegister rhs, FloatRegister lhsDest,
                                              //    <(BE+AF)_low+AE_high AE_low>
 }
 
+// Integer dot product
+
+void MacroAssembler::widenDotInt16x8(FloatRegister rhs, FloatRegister lhsDest) {
+  vpmaddwd(Operand(rhs), lhsDest, lhsDest);
+}
+
 // Integer negate
 
 void MacroAssembler::negInt8x16(FloatRegister src, FloatRegister dest) {
@@ -1981,6 +1987,28 @@ void MacroAssembler::maxFloat64x2(FloatRegister rhs, FloatRegister lhsDest,
   MacroAssemblerX86Shared::maxFloat64x2(lhsDest, Operand(rhs), temp, lhsDest);
 }
 
+// Compare-based minimum and maximum
+
+void MacroAssembler::pseudoMinFloat32x4(FloatRegister rhs,
+                                        FloatRegister lhsDest) {
+  vminps(Operand(rhs), lhsDest, lhsDest);
+}
+
+void MacroAssembler::pseudoMinFloat64x2(FloatRegister rhs,
+                                        FloatRegister lhsDest) {
+  vminpd(Operand(rhs), lhsDest, lhsDest);
+}
+
+void MacroAssembler::pseudoMaxFloat32x4(FloatRegister rhs,
+                                        FloatRegister lhsDest) {
+  vmaxps(Operand(rhs), lhsDest, lhsDest);
+}
+
+void MacroAssembler::pseudoMaxFloat64x2(FloatRegister rhs,
+                                        FloatRegister lhsDest) {
+  vmaxpd(Operand(rhs), lhsDest, lhsDest);
+}
+
 // Floating add
 
 void MacroAssembler::addFloat32x4(FloatRegister rhs, FloatRegister lhsDest) {
@@ -0,0 +1,165 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/Sprintf.h"
+
+#include "gc/GCLock.h"
+#include "gc/GCRuntime.h"
+#include "gc/Heap.h"
+#include "js/CompilationAndEvaluation.h"  // JS::CompileOffThread
+#include "js/SourceText.h"                // JS::Source{Ownership,Text}
+#include "jsapi-tests/tests.h"
+#include "vm/HelperThreads.h"
+#include "vm/Monitor.h"
+#include "vm/MutexIDs.h"
+
+#include "gc/ArenaList-inl.h"
+
+using namespace js;
+using namespace js::gc;
+
+// Helper threads allocate arenas in batches in the zones they parse into.
+// Parse a script that allocates many arenas, and check that batched arenas
+// that weren't used don't end up in the target zone.
+
+struct ArenaBatchParseTask {
+  ArenaBatchParseTask()
+      : monitor(mutexid::ShellOffThreadState), token(nullptr) {}
+
+  JS::OffThreadToken* waitUntilDone(JSContext* cx) {
+    if (OffThreadParsingMustWaitForGC(cx->runtime())) {
+      FinishGC(cx);
+    }
+
+    AutoLockMonitor alm(monitor);
+    while (!token) {
+      alm.wait();
+    }
+    JS::OffThreadToken* result = token;
+    token = nullptr;
+    return result;
+  }
+
+  static void Callback(JS::OffThreadToken* token, void* context) {
+    auto self = static_cast<ArenaBatchParseTask*>(context);
+    AutoLockMonitor alm(self->monitor);
+    self->token = token;
+    alm.notify();
+  }
+
+  Monitor monitor;
+  JS::OffThreadToken* token;
+};
+
+static const size_t FunctionCount = 2000;
+
+// Each function allocates a script, scopes, atoms and literal templates.
+static bool MakeSource(JSContext* cx, js::Vector<char16_t>& source) {
+  for (size_t i = 0; i < FunctionCount; i++) {
+    char buf[128];
+    int len = SprintfLiteral(
+        buf, "function f%zu() { return [%zu, 'atom%zu', {p%zu: %zu}]; }\n", i,
+        i, i, i, i);
+    for (int j = 0; j < len; j++) {
+      if (!source.append(char16_t(buf[j]))) {
+        return false;
+      }
+    }
+  }
+
+  static const char tail[] = "f1999()[0] + f0()[0];\n";
+  for (size_t j = 0; j < sizeof(tail) - 1; j++) {
+    if (!source.append(char16_t(tail[j]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static size_t CountArenas(Zone* zone, bool* foundEmpty) {
+  size_t count = 0;
+  for (auto kind : AllAllocKinds()) {
+    for (Arena* arena = zone->arenas.getFirstArena(kind); arena;
+         arena = arena->next) {
+      if (arena->isEmpty()) {
+        *foundEmpty = true;
+      }
+      count++;
+    }
+  }
+  return count;
+}
+
+BEGIN_TEST(testGCHelperThreadArenas) {
+  if (!CanUseExtraThreads()) {
+    return true;
+  }
+
+  js::Vector<char16_t> source(cx);
+  CHECK(MakeSource(cx, source));
+
+  // Make sure background finalization isn't changing the arena lists while
+  // they are checked.
+  JS_GC(cx);
+  cx->runtime()->gc.waitBackgroundSweepEnd();
+
+  Zone* zone = global->zone();
+  bool foundEmpty = false;
+  size_t arenasBefore = CountArenas(zone, &foundEmpty);
+  CHECK(!foundEmpty);
+
+  GCRuntime& gc = cx->runtime()->gc;
+  GCRuntime::HelperThreadArenaStats statsBefore;
+  {
+    AutoLockGC lock(&gc);
+    statsBefore = gc.helperThreadArenaStats.ref();
+  }
+
+  JS::CompileOptions options(cx);
+  options.forceAsync = true;
+
+  JS::SourceText<char16_t> srcBuf;
+  CHECK(srcBuf.init(cx, source.begin(), source.length(),
+                    JS::SourceOwnership::Borrowed));
+
+  ArenaBatchParseTask task;
+  CHECK(JS::CompileOffThread(cx, options, srcBuf,
+                             ArenaBatchParseTask::Callback, &task));
+  JS::OffThreadToken* token = task.waitUntilDone(cx);
+  CHECK(token);
+
+  JS::RootedScript script(cx, JS::FinishOffThreadScript(cx, token));
+  CHECK(script);
+
+  // The parse allocated its arenas in batches, and more arenas than fit in
+  // one batch. Every arena merged into the target zone is in use, and each
+  // batch left at most HelperThreadArenaBatchSize - 1 arenas unused.
+  FinishGC(cx);
+  gc.waitBackgroundSweepEnd();
+  size_t arenasAfter = CountArenas(zone, &foundEmpty);
+  CHECK(!foundEmpty);
+  CHECK(arenasAfter > arenasBefore + HelperThreadArenaBatchSize);
+
+  GCRuntime::HelperThreadArenaStats statsAfter;
+  {
+    AutoLockGC lock(&gc);
+    statsAfter = gc.helperThreadArenaStats.ref();
+  }
+  size_t batches = statsAfter.batches - statsBefore.batches;
+  size_t unusedArenas = statsAfter.unusedArenas - statsBefore.unusedArenas;
+  CHECK(batches > 0);
+  CHECK(unusedArenas <= batches * (HelperThreadArenaBatchSize - 1));
+  CHECK(statsAfter.cellsMerged > statsBefore.cellsMerged);
+
+  JS::RootedValue result(cx);
+  CHECK(JS_ExecuteScript(cx, script, &result));
+  CHECK(result.isInt32());
+  CHECK_EQUAL(result.toInt32(), 1999);
+
+  return true;
+}
+END_TEST(testGCHelperThreadArenas)
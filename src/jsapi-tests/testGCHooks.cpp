@@ -97,3 +97,72 @@ BEGIN_TEST(testGCRootsRemoved) {
   return true;
 }
 END_TEST(testGCRootsRemoved)
+
+struct TelemetryRecordCounts {
+  unsigned majorSlices = 0;
+  unsigned lastSlices = 0;
+  unsigned minorGCs = 0;
+  bool sawPhaseTimes = false;
+};
+
+static void CountingGCTelemetryCallback(JSContext* cx,
+                                        const JS::GCTelemetryRecord& record,
+                                        void* data) {
+  auto* counts = static_cast<TelemetryRecordCounts*>(data);
+  MOZ_RELEASE_ASSERT(record.end >= record.start);
+
+  if (record.kind == JS::GCTelemetryEventKind::MinorGC) {
+    MOZ_RELEASE_ASSERT(record.tenuredBytes <= record.nurseryUsedBytes);
+    MOZ_RELEASE_ASSERT(record.promotionRate >= 0.0 &&
+                       record.promotionRate <= 1.0);
+    counts->minorGCs++;
+    return;
+  }
+
+  MOZ_RELEASE_ASSERT(record.sliceNumber == counts->majorSlices);
+  MOZ_RELEASE_ASSERT(record.phaseCount == 0 || record.phaseTimes);
+  for (size_t i = 0; i < record.phaseCount; i++) {
+    MOZ_RELEASE_ASSERT(record.phaseTimes[i].name);
+    counts->sawPhaseTimes = true;
+  }
+  counts->majorSlices++;
+  if (record.isLastSlice) {
+    counts->lastSlices++;
+  }
+}
+
+BEGIN_TEST(testGCTelemetryCallback) {
+#ifdef JS_GC_ZEAL
+  AutoLeaveZeal nozeal(cx);
+#endif /* JS_GC_ZEAL */
+
+  TelemetryRecordCounts counts;
+  JS::SetGCTelemetryCallback(cx, CountingGCTelemetryCallback, &counts);
+
+  JS_GC(cx);
+  CHECK(counts.majorSlices == 1);
+  CHECK(counts.lastSlices == 1);
+  CHECK(counts.sawPhaseTimes);
+  CHECK(counts.minorGCs >= 1);
+
+  // Records are numbered from zero within each incremental GC.
+  counts = TelemetryRecordCounts();
+  JS_SetGCParameter(cx, JSGC_MODE, JSGC_MODE_ZONE_INCREMENTAL);
+  JS::PrepareForFullGC(cx);
+  js::SliceBudget budget(js::WorkBudget(1));
+  cx->runtime()->gc.startDebugGC(GC_NORMAL, budget);
+  CHECK(JS::IsIncrementalGCInProgress(cx));
+  JS::FinishIncrementalGC(cx, JS::GCReason::DEBUG_GC);
+  CHECK(!JS::IsIncrementalGCInProgress(cx));
+  CHECK(counts.majorSlices >= 2);
+  CHECK(counts.lastSlices == 1);
+  JS_SetGCParameter(cx, JSGC_MODE, JSGC_MODE_GLOBAL);
+
+  JS::SetGCTelemetryCallback(cx, nullptr, nullptr);
+  counts = TelemetryRecordCounts();
+  JS_GC(cx);
+  CHECK(counts.majorSlices == 0);
+
+  return true;
+}
+END_TEST(testGCTelemetryCallback)
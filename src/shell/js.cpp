@@ -104,8 +104,9 @@
 #include "js/Equality.h"                 // JS::SameValue
 #include "js/ErrorReport.h"              // JS::PrintError
 #include "js/Exception.h"                // JS::StealPendingExceptionStack
+#include "js/experimental/JitProfile.h"  // JS::{Save,Load,Clear}JitProfile
 #include "js/experimental/SourceHook.h"  // js::{Set,Forget,}SourceHook
-#include "js/experimental/TypedData.h"   // JS_NewUint8Array
+#include "js/experimental/TypedData.h"   // JS_GetObjectAsUint8Array, JS_NewUint8Array
 #include "js/friend/DumpFunctions.h"     // JS::FormatStackDump
 #include "js/friend/StackLimits.h"       // js::CheckRecursionLimitConservative
 #include "js/friend/WindowProxy.h"  // js::IsWindowProxy, js::SetWindowProxyClass, js::ToWindowProxyIfWindow, js::ToWindowIfWindowProxy
@@ -157,12 +158,14 @@
 #include "vm/ToSource.h"  // js::ValueToSource
 #include "vm/TypedArrayObject.h"
 #include "vm/WrapperObject.h"
+#include "wasm/WasmCodeCache.h"
 #include "wasm/WasmJS.h"
 
 #include "vm/Compartment-inl.h"
 #include "vm/ErrorObject-inl.h"
 #include "vm/Interpreter-inl.h"
 #include "vm/JSObject-inl.h"
+#include "vm/JSScript-inl.h"
 #include "vm/Realm-inl.h"
 #include "vm/Stack-inl.h"
 
@@ -7990,6 +7993,79 @@ static bool WasmCodeOffsets(JSContext* cx, unsigned argc, Value* vp) {
   return true;
 }
 
+static bool SaveJitProfile(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  JS::TranscodeBuffer buffer;
+  if (!JS::SaveJitProfile(cx, buffer)) {
+    return false;
+  }
+
+  RootedObject profile(cx, JS_NewUint8Array(cx, buffer.length()));
+  if (!profile) {
+    return false;
+  }
+
+  memcpy(profile->as<TypedArrayObject>().dataPointerUnshared(), buffer.begin(),
+         buffer.length());
+
+  args.rval().setObject(*profile);
+  return true;
+}
+
+static bool LoadJitProfile(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  RootedObject callee(cx, &args.callee());
+
+  if (!args.requireAtLeast(cx, "loadJitProfile", 1)) {
+    return false;
+  }
+
+  uint32_t length;
+  bool isSharedMemory;
+  uint8_t* data;
+  if (!args[0].isObject() ||
+      !JS_GetObjectAsUint8Array(&args[0].toObject(), &length, &isSharedMemory,
+                                &data) ||
+      isSharedMemory || !data) {
+    ReportUsageErrorASCII(cx, callee, "First argument must be a Uint8Array");
+    return false;
+  }
+
+  if (!JS::LoadJitProfile(cx, data, length)) {
+    return false;
+  }
+
+  args.rval().setUndefined();
+  return true;
+}
+
+static bool ClearJitProfile(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  JS::ClearJitProfile(cx);
+  args.rval().setUndefined();
+  return true;
+}
+
+static bool GetWarmUpCount(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  RootedObject callee(cx, &args.callee());
+
+  if (!args.get(0).isObject() || !args[0].toObject().is<JSFunction>()) {
+    ReportUsageErrorASCII(cx, callee, "First argument must be a function");
+    return false;
+  }
+
+  JSFunction* fun = &args[0].toObject().as<JSFunction>();
+  if (!fun->hasBytecode()) {
+    args.rval().setUndefined();
+    return true;
+  }
+
+  args.rval().setNumber(fun->nonLazyScript()->getWarmUpCount());
+  return true;
+}
+
 #ifndef __AFL_HAVE_MANUAL_CONTROL
 #  define __AFL_LOOP(x) true
 #endif
@@ -8958,6 +9034,25 @@ JS_FN_HELP("rateMyCacheIR", RateMyCacheIR, 0, 0,
 "  Decodes the given wasm binary to find the offsets of every instruction in the"
 "  code section."),
 
+    JS_FN_HELP("saveJitProfile", SaveJitProfile, 0, 0,
+"saveJitProfile()",
+"  Returns a Uint8Array holding the warm-up counts of all scripts that have\n"
+"  run so far, for use with loadJitProfile in a later run."),
+
+    JS_FN_HELP("loadJitProfile", LoadJitProfile, 1, 0,
+"loadJitProfile(profile)",
+"  Load a Uint8Array returned by saveJitProfile. Scripts that start running\n"
+"  afterwards begin with the warm-up count recorded for them."),
+
+    JS_FN_HELP("clearJitProfile", ClearJitProfile, 0, 0,
+"clearJitProfile()",
+"  Discard any profile loaded by loadJitProfile."),
+
+    JS_FN_HELP("getWarmUpCount", GetWarmUpCount, 1, 0,
+"getWarmUpCount(fun)",
+"  Returns the warm-up count of |fun|'s script, or undefined if it has not\n"
+"  been compiled to bytecode yet."),
+
     JS_FN_HELP("transplantableObject", TransplantableObject, 0, 0,
 "transplantableObject([options])",
 "  Returns the pair {object, transplant}. |object| is an object which can be\n"
@@ -10093,6 +10188,20 @@ static bool SetContextOptions(JSContext* cx, const OptionParser& op) {
 #endif
   enableWasmVerbose = op.getBoolOption("wasm-verbose");
   enableTestWasmAwaitTier2 = op.getBoolOption("test-wasm-await-tier2");
+  if (const char* dir = op.getStringOption("wasm-code-cache")) {
+    if (!wasm::SetCodeCacheDirectory(dir)) {
+      fprintf(stderr,
+              "Warning: can't use %s as the wasm code cache directory, "
+              "continuing without a cache.\n",
+              dir);
+    }
+  } else if (op.getBoolOption("wasm-code-cache-temp")) {
+    if (!wasm::CreateTemporaryCodeCacheDirectory()) {
+      fprintf(stderr,
+              "Warning: can't create a temporary wasm code cache directory, "
+              "continuing without a cache.\n");
+    }
+  }
   enableSourcePragmas = !op.getBoolOption("no-source-pragmas");
   enableAsyncStacks = !op.getBoolOption("no-async-stacks");
   enableAsyncStackCaptureDebuggeeOnly =
@@ -10317,6 +10426,11 @@ static bool SetContextOptions(JSContext* cx, const OptionParser& op) {
     jit::JitOptions.baselineJitWarmUpThreshold = warmUpThreshold;
   }
 
+  warmUpThreshold = op.getIntOption("wasm-tier-up-threshold");
+  if (warmUpThreshold >= 0) {
+    jit::JitOptions.wasmTierUpThreshold = warmUpThreshold;
+  }
+
   warmUpThreshold = op.getIntOption("trial-inlining-warmup-threshold");
   if (warmUpThreshold >= 0) {
     jit::JitOptions.trialInliningWarmUpThreshold = warmUpThreshold;
@@ -10327,6 +10441,11 @@ static bool SetContextOptions(JSContext* cx, const OptionParser& op) {
     jit::JitOptions.regexpWarmUpThreshold = warmUpThreshold;
   }
 
+  int32_t codeBudget = op.getIntOption("jit-code-budget");
+  if (codeBudget >= 0) {
+    jit::JitOptions.jitCodeBudgetKB = codeBudget;
+  }
+
   if (op.getBoolOption("baseline-eager")) {
     jit::JitOptions.setEagerBaselineCompilation();
   }
@@ -10360,6 +10479,10 @@ static bool SetContextOptions(JSContext* cx, const OptionParser& op) {
     jit::JitOptions.nativeRegExp = false;
   }
 
+  if (op.getBoolOption("cacheir-stub-corpus")) {
+    jit::JitOptions.baselineCacheIRStubCorpus = true;
+  }
+
   if (op.getBoolOption("trace-regexp-parser")) {
     jit::JitOptions.traceRegExpParser = true;
   }
@@ -10923,6 +11046,17 @@ int main(int argc, char** argv, char** envp) {
       !op.addBoolOption('\0', "test-wasm-await-tier2",
                         "Forcibly activate tiering and block "
                         "instantiation on completion of tier2") ||
+      !op.addStringOption('\0', "wasm-code-cache", "DIR",
+                          "Cache optimized wasm code in DIR across runs") ||
+      !op.addBoolOption('\0', "wasm-code-cache-temp",
+                        "Cache optimized wasm code in a new temporary "
+                        "directory, removed on exit (for testing)") ||
+      !op.addIntOption('\0', "wasm-tier-up-threshold", "COUNT",
+                       "Start wasm tier-2 compilation once a function has "
+                       "been called or has iterated COUNT times, and only "
+                       "optimize warm functions (default: 0, which compiles "
+                       "the whole module at tier-2 eagerly)",
+                       -1) ||
       !op.addBoolOption('\0', "no-wasm-reftypes",
                         "Disable wasm reference types features") ||
 #ifdef ENABLE_WASM_GC
@@ -10945,6 +11079,9 @@ int main(int argc, char** argv, char** envp) {
 #endif
       !op.addBoolOption('\0', "no-native-regexp",
                         "Disable native regexp compilation") ||
+      !op.addBoolOption('\0', "cacheir-stub-corpus",
+                        "Compile the code for common Baseline IC stubs before "
+                        "they are first attached") ||
       !op.addIntOption(
           '\0', "regexp-warmup-threshold", "COUNT",
           "Wait for COUNT invocations before compiling regexps to native code "
@@ -11046,12 +11183,21 @@ int main(int argc, char** argv, char** envp) {
                        "Wait for COUNT calls or iterations before compiling "
                        "at the 'full' optimization level (default: 100,000)",
                        -1) ||
+      !op.addIntOption('\0', "jit-code-budget", "KB",
+                       "Discard the JIT code of cold scripts on GC when a "
+                       "zone has more than KB kilobytes of Baseline and Ion "
+                       "code (default: 0, no limit)",
+                       -1) ||
       !op.addStringOption(
           '\0', "ion-regalloc", "[mode]",
           "Specify Ion register allocation:\n"
           "  backtracking: Priority based backtracking register allocation "
           "(default)\n"
           "  testbed: Backtracking allocator with experimental features\n"
+          "  fast: Backtracking allocator that spills instead of searching "
+          "for\n"
+          "        better splits (used for large functions at the 'normal'\n"
+          "        optimization level)\n"
           "  stupid: Simple block local register allocation") ||
       !op.addBoolOption(
           '\0', "ion-eager",
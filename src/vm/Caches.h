@@ -223,12 +223,155 @@ class NewObjectCache {
   }
 };
 
+/*
+ * Cache for the megamorphic property lookups done by JIT IC stubs. Entries map
+ * a receiver's shape and a property id to the location of an own data
+ * property, so megamorphic stubs can probe the table inline and only call
+ * into the VM on a miss.
+ *
+ * Only own data properties are cached: the receiver's shape determines the
+ * slot of those, but not the object's prototype, so hits on the prototype
+ * chain always take the slow path.
+ *
+ * Entries are validated against a generation counter so the whole cache can
+ * be purged in constant time on GC, when shapes may be finalized or moved.
+ * Dictionary-mode objects mutate their shapes in place, so NativeObject's
+ * property operations invalidate the affected entry explicitly (see
+ * vm/Shape.cpp).
+ */
+class MegamorphicCache {
+ public:
+  static constexpr size_t NumEntriesLog2 = 10;
+  static constexpr size_t NumEntries = size_t(1) << NumEntriesLog2;
+
+  // The low bit of an entry's slot offset is set for fixed slots; the
+  // remaining bits are the offset in bytes from the object (fixed slots) or
+  // from its slots pointer (dynamic slots).
+  static constexpr uint32_t FixedSlotFlag = 1;
+
+  class Entry {
+    // Fields are word-sized so that sizeof(Entry) is a power of two, which
+    // lets JIT code compute the address of an entry with a shift.
+    Shape* shape_ = nullptr;
+    uintptr_t key_ = 0;
+    uintptr_t slotOffset_ = 0;
+    uintptr_t generation_ = 0;
+
+    friend class MegamorphicCache;
+
+   public:
+    bool isFixedSlot() const { return slotOffset_ & FixedSlotFlag; }
+    uint32_t offset() const { return uint32_t(slotOffset_ >> 1); }
+
+    uint32_t slot(NativeObject* obj) const {
+      MOZ_ASSERT(obj->lastProperty() == shape_);
+      if (isFixedSlot()) {
+        return (offset() - NativeObject::getFixedSlotOffset(0)) /
+               sizeof(Value);
+      }
+      return obj->numFixedSlots() + offset() / sizeof(Value);
+    }
+
+    static constexpr size_t offsetOfShape() { return offsetof(Entry, shape_); }
+    static constexpr size_t offsetOfKey() { return offsetof(Entry, key_); }
+    static constexpr size_t offsetOfSlotOffset() {
+      return offsetof(Entry, slotOffset_);
+    }
+    static constexpr size_t offsetOfGeneration() {
+      return offsetof(Entry, generation_);
+    }
+  };
+
+  static constexpr size_t EntryShift = sizeof(uintptr_t) == 8 ? 5 : 4;
+
+ private:
+  static_assert(sizeof(Entry) == size_t(1) << EntryShift,
+                "JIT code relies on the entry size being a power of two");
+
+  Entry entries_[NumEntries];
+
+  // Entries are only valid if their generation matches this. Generation 0 is
+  // never used so that zeroed entries are never valid.
+  uintptr_t generation_ = 1;
+
+  static size_t hash(Shape* shape, jsid id) {
+    return ((uintptr_t(shape) ^ JSID_BITS(id)) >> ShapeHashShift) &
+           (NumEntries - 1);
+  }
+
+ public:
+  // Shapes are at least this aligned; shifting out the always-zero low bits
+  // improves the distribution of the hash.
+  static constexpr uint32_t ShapeHashShift = 3;
+
+  MegamorphicCache() = default;
+  MegamorphicCache(const MegamorphicCache&) = delete;
+  void operator=(const MegamorphicCache&) = delete;
+
+  bool lookup(Shape* shape, jsid id, const Entry** entry) const {
+    const Entry& e = entries_[hash(shape, id)];
+    if (e.shape_ != shape || e.key_ != JSID_BITS(id) ||
+        e.generation_ != generation_) {
+      return false;
+    }
+    *entry = &e;
+    return true;
+  }
+
+  void fill(NativeObject* obj, jsid id, Shape* prop) {
+    MOZ_ASSERT(prop->isDataProperty());
+    MOZ_ASSERT(obj->containsPure(prop));
+    MOZ_ASSERT(prop->propid() == id);
+
+    uint32_t slot = prop->slot();
+    uint32_t nfixed = obj->numFixedSlots();
+    uintptr_t slotOffset;
+    if (slot < nfixed) {
+      slotOffset = (uintptr_t(NativeObject::getFixedSlotOffset(slot)) << 1) |
+                   FixedSlotFlag;
+    } else {
+      slotOffset = uintptr_t((slot - nfixed) * sizeof(Value)) << 1;
+    }
+
+    Entry& e = entries_[hash(obj->lastProperty(), id)];
+    e.shape_ = obj->lastProperty();
+    e.key_ = JSID_BITS(id);
+    e.slotOffset_ = slotOffset;
+    e.generation_ = generation_;
+  }
+
+  // Drop the entry for |shape| and |id|, if there is one. Called before a
+  // dictionary-mode object's shape is modified in place.
+  void invalidateEntry(Shape* shape, jsid id) {
+    Entry& e = entries_[hash(shape, id)];
+    if (e.shape_ == shape && e.key_ == JSID_BITS(id)) {
+      e.shape_ = nullptr;
+    }
+  }
+
+  void purge() {
+    generation_++;
+    if (MOZ_UNLIKELY(generation_ == 0)) {
+      // The generation wrapped around; clear all entries so that stale ones
+      // can't become valid again.
+      for (Entry& e : entries_) {
+        e = Entry();
+      }
+      generation_ = 1;
+    }
+  }
+
+  const Entry* entries() const { return entries_; }
+  const uintptr_t* addressOfGeneration() const { return &generation_; }
+};
+
 class RuntimeCaches {
  public:
   js::GSNCache gsnCache;
   js::NewObjectCache newObjectCache;
   js::UncompressedSourceCache uncompressedSourceCache;
   js::EvalCache evalCache;
+  js::MegamorphicCache megamorphicCache;
 
   void purgeForMinorGC(JSRuntime* rt) {
     newObjectCache.clearNurseryObjects(rt);
@@ -238,6 +381,7 @@ class RuntimeCaches {
   void purgeForCompaction() {
     newObjectCache.purge();
     evalCache.clear();
+    megamorphicCache.purge();
   }
 
   void purge() {
@@ -145,9 +145,14 @@ bool js::StartOffThreadWasmCompile(wasm::CompileTask* task,
 }
 
 void js::StartOffThreadWasmTier2Generator(wasm::UniqueTier2GeneratorTask task) {
-  MOZ_ASSERT(CanUseExtraThreads());
-
   AutoLockHelperThreadState lock;
+  StartOffThreadWasmTier2Generator(std::move(task), lock);
+}
+
+void js::StartOffThreadWasmTier2Generator(
+    wasm::UniqueTier2GeneratorTask task,
+    const AutoLockHelperThreadState& lock) {
+  MOZ_ASSERT(CanUseExtraThreads());
 
   if (!HelperThreadState().wasmTier2GeneratorWorklist(lock).append(
           task.get())) {
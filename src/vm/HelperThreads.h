@@ -511,6 +511,8 @@ void ExecuteCompileTaskFromHelperThread(CompileTask* task);
 
 // Enqueues a wasm compilation task.
 void StartOffThreadWasmTier2Generator(wasm::UniqueTier2GeneratorTask task);
+void StartOffThreadWasmTier2Generator(wasm::UniqueTier2GeneratorTask task,
+                                      const AutoLockHelperThreadState& lock);
 
 // Cancel all background Wasm Tier-2 compilations.
 void CancelOffThreadWasmTier2Generator();
@@ -22,6 +22,7 @@
 #include "jit/ExecutableAllocator.h"
 #include "jit/Ion.h"
 #include "jit/JitCommon.h"
+#include "jit/PerfSpewer.h"
 #include "js/Utility.h"
 #if JS_HAS_INTL_API
 #  include "unicode/putil.h"
@@ -242,6 +243,9 @@ JS_PUBLIC_API void JS_ShutDown(void) {
 
   js::jit::AtomicOperations::ShutDown();
 
+  // Flush and close perf jitdump output.
+  js::jit::ShutdownPerf();
+
 #ifdef JS_TRACE_LOGGING
   js::DestroyTraceLoggerThreadState();
   js::DestroyTraceLoggerGraphState();
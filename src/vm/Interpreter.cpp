@@ -27,6 +27,7 @@
 #include "builtin/ModuleObject.h"
 #include "builtin/Promise.h"
 #include "jit/AtomicOperations.h"
+#include "jit/BaselineIC.h"
 #include "jit/BaselineJIT.h"
 #include "jit/Ion.h"
 #include "jit/IonAnalysis.h"
@@ -5387,6 +5388,36 @@ bool js::OptimizeSpreadCall(JSContext* cx, HandleValue arg, bool* optimized) {
   return stubChain->tryOptimizeArray(cx, obj.as<ArrayObject>(), optimized);
 }
 
+gc::AllocSite* js::MaybeLiteralAllocSite(JSScript* script, jsbytecode* pc) {
+  if (!script->hasJitScript()) {
+    return nullptr;
+  }
+
+  jit::ICEntry& entry =
+      script->jitScript()->icEntryFromPCOffset(script->pcToOffset(pc));
+  jit::ICFallbackStub* stub = entry.fallbackStub();
+  if (stub->isNewArray_Fallback()) {
+    return stub->toNewArray_Fallback()->allocSite();
+  }
+  return stub->toNewObject_Fallback()->allocSite();
+}
+
+NewObjectKind js::NewKindForAllocSite(gc::AllocSite* site,
+                                      NewObjectKind newKind) {
+  if (site && newKind == GenericObject &&
+      site->initialHeap() == gc::TenuredHeap) {
+    return TenuredObject;
+  }
+  return newKind;
+}
+
+void js::SetNurseryAllocSite(JSContext* cx, JSObject* obj,
+                             gc::AllocSite* site) {
+  if (site && IsInsideNursery(obj)) {
+    cx->nursery().setAllocSite(obj, site);
+  }
+}
+
 JSObject* js::NewObjectOperation(JSContext* cx, HandleScript script,
                                  jsbytecode* pc,
                                  NewObjectKind newKind /* = GenericObject */) {
@@ -5434,6 +5465,12 @@ JSObject* js::NewObjectOperation(JSContext* cx, HandleScript script,
     }
   }
 
+  gc::AllocSite* site = nullptr;
+  if (newKind == GenericObject) {
+    site = MaybeLiteralAllocSite(script, pc);
+    newKind = NewKindForAllocSite(site, newKind);
+  }
+
   RootedPlainObject obj(cx);
 
   // Actually allocate the object.
@@ -5448,6 +5485,8 @@ JSObject* js::NewObjectOperation(JSContext* cx, HandleScript script,
     return nullptr;
   }
 
+  SetNurseryAllocSite(cx, obj, site);
+
   if (newKind == SingletonObject) {
     MOZ_ASSERT(obj->isSingleton());
   } else {
@@ -5465,8 +5504,9 @@ JSObject* js::NewObjectOperation(JSContext* cx, HandleScript script,
   return obj;
 }
 
-JSObject* js::NewObjectOperationWithTemplate(JSContext* cx,
-                                             HandleObject templateObject) {
+JSObject* js::NewObjectOperationWithTemplate(
+    JSContext* cx, HandleObject templateObject,
+    gc::AllocSite* site /* = nullptr */) {
   // This is an optimized version of NewObjectOperation for use when the
   // object is not a singleton and has had its preliminary objects analyzed,
   // with the template object a copy of the object to create.
@@ -5479,6 +5519,7 @@ JSObject* js::NewObjectOperationWithTemplate(JSContext* cx,
     AutoSweepObjectGroup sweep(group);
     newKind = group->shouldPreTenure(sweep) ? TenuredObject : GenericObject;
   }
+  newKind = NewKindForAllocSite(site, newKind);
 
   JSObject* obj =
       CopyInitializerObject(cx, templateObject.as<PlainObject>(), newKind);
@@ -5486,6 +5527,7 @@ JSObject* js::NewObjectOperationWithTemplate(JSContext* cx,
     return nullptr;
   }
 
+  SetNurseryAllocSite(cx, obj, site);
   obj->setGroup(templateObject->group());
   return obj;
 }
@@ -5522,11 +5564,19 @@ ArrayObject* js::NewArrayOperation(
     }
   }
 
+  gc::AllocSite* site = nullptr;
+  if (newKind == GenericObject) {
+    site = MaybeLiteralAllocSite(script, pc);
+    newKind = NewKindForAllocSite(site, newKind);
+  }
+
   ArrayObject* obj = NewDenseFullyAllocatedArray(cx, length, nullptr, newKind);
   if (!obj) {
     return nullptr;
   }
 
+  SetNurseryAllocSite(cx, obj, site);
+
   if (newKind == SingletonObject) {
     MOZ_ASSERT(obj->isSingleton());
   } else {
@@ -5536,8 +5586,9 @@ ArrayObject* js::NewArrayOperation(
   return obj;
 }
 
-ArrayObject* js::NewArrayOperationWithTemplate(JSContext* cx,
-                                               HandleObject templateObject) {
+ArrayObject* js::NewArrayOperationWithTemplate(
+    JSContext* cx, HandleObject templateObject,
+    gc::AllocSite* site /* = nullptr */) {
   MOZ_ASSERT(!templateObject->isSingleton());
 
   NewObjectKind newKind;
@@ -5546,6 +5597,7 @@ ArrayObject* js::NewArrayOperationWithTemplate(JSContext* cx,
     newKind = templateObject->group()->shouldPreTenure(sweep) ? TenuredObject
                                                               : GenericObject;
   }
+  newKind = NewKindForAllocSite(site, newKind);
 
   ArrayObject* obj = NewDenseFullyAllocatedArray(
       cx, templateObject->as<ArrayObject>().length(), nullptr, newKind);
@@ -5553,6 +5605,8 @@ ArrayObject* js::NewArrayOperationWithTemplate(JSContext* cx,
     return nullptr;
   }
 
+  SetNurseryAllocSite(cx, obj, site);
+
   MOZ_ASSERT(obj->lastProperty() ==
              templateObject->as<ArrayObject>().lastProperty());
   obj->setGroup(templateObject->group());
@@ -19,6 +19,10 @@
 
 namespace js {
 
+namespace gc {
+class AllocSite;
+}  // namespace gc
+
 class EnvironmentIter;
 class PlainObject;
 
@@ -634,11 +638,23 @@ bool SpreadCallOperation(JSContext* cx, HandleScript script, jsbytecode* pc,
 
 bool OptimizeSpreadCall(JSContext* cx, HandleValue arg, bool* optimized);
 
+// Object and array literals have an allocation site in their op's Baseline
+// fallback stub once the script has ICs. See gc/Pretenuring.h.
+gc::AllocSite* MaybeLiteralAllocSite(JSScript* script, jsbytecode* pc);
+
+// The kind of object to create for |site|, for an object that would otherwise
+// be created with |newKind|. |site| may be null.
+NewObjectKind NewKindForAllocSite(gc::AllocSite* site, NewObjectKind newKind);
+
+// Attribute |obj| to |site| if it was allocated in the nursery.
+void SetNurseryAllocSite(JSContext* cx, JSObject* obj, gc::AllocSite* site);
+
 JSObject* NewObjectOperation(JSContext* cx, HandleScript script, jsbytecode* pc,
                              NewObjectKind newKind = GenericObject);
 
 JSObject* NewObjectOperationWithTemplate(JSContext* cx,
-                                         HandleObject templateObject);
+                                         HandleObject templateObject,
+                                         gc::AllocSite* site = nullptr);
 JSObject* CreateThisWithTemplate(JSContext* cx, HandleObject templateObject);
 
 ArrayObject* NewArrayOperation(JSContext* cx, HandleScript script,
@@ -646,7 +662,8 @@ ArrayObject* NewArrayOperation(JSContext* cx, HandleScript script,
                                NewObjectKind newKind = GenericObject);
 
 ArrayObject* NewArrayOperationWithTemplate(JSContext* cx,
-                                           HandleObject templateObject);
+                                           HandleObject templateObject,
+                                           gc::AllocSite* site = nullptr);
 
 ArrayObject* NewArrayCopyOnWriteOperation(JSContext* cx, HandleScript script,
                                           jsbytecode* pc);
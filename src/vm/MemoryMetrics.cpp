@@ -220,6 +220,9 @@ static void StatsZoneCallback(JSRuntime* rt, void* data, Zone* zone,
       &rtStats->runtime.atomsMarkBitmaps, &zStats.compartmentObjects,
       &zStats.crossCompartmentWrappersTables, &zStats.compartmentsPrivateData,
       &zStats.scriptCountsMap);
+
+  zStats.tenuredStringsDeduplicated = zone->tenuredStringsDeduplicated;
+  zStats.tenuredStringDedupBytesSaved = zone->tenuredStringDedupBytesSaved;
 }
 
 static void StatsRealmCallback(JSContext* cx, void* data, Realm* realm,
@@ -28,10 +28,19 @@
                                       \
   _(StoreBuffer, 275)                 \
                                       \
+  _(GCParallelTenuringAlloc, 290)     \
+                                      \
   _(GlobalHelperThreadState, 300)     \
                                       \
   _(GCLock, 400)                      \
                                       \
+  _(GCParallelMarkerStack, 440)       \
+  _(GCParallelMarkerWeakMaps, 450)    \
+  _(GCParallelMarker, 460)            \
+  _(GCParallelTenuring, 470)          \
+  _(GCParallelTenuringQueue, 480)     \
+  _(GCParallelTenuringTables, 490)    \
+                                      \
   _(SharedImmutableStringsCache, 500) \
   _(FutexThread, 500)                 \
   _(GeckoProfilerStrings, 500)        \
@@ -52,6 +61,7 @@
   _(RuntimeScriptData, 500)           \
   _(WasmFuncTypeIdSet, 500)           \
   _(WasmCodeProfilingLabels, 500)     \
+  _(WasmLazyTier2, 500)               \
   _(WasmCompileTaskState, 500)        \
   _(WasmCodeBytesEnd, 500)            \
   _(WasmStreamEnd, 500)               \
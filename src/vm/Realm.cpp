@@ -171,6 +171,11 @@ bool Realm::ensureJitRealmExists(JSContext* cx) {
     return false;
   }
 
+  if (JitOptions.baselineCacheIRStubCorpus && IsBaselineInterpreterEnabled() &&
+      !zone()->jitZone()->ensureBaselineCacheIRStubCorpus(cx)) {
+    return false;
+  }
+
   jitRealm_ = std::move(jitRealm);
   return true;
 }
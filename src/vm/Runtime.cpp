@@ -345,6 +345,8 @@ void JSRuntime::addSizeOfIncludingThis(mozilla::MallocSizeOf mallocSizeOf,
 
   rtSizes->atomsTable += atoms().sizeOfIncludingThis(mallocSizeOf);
   rtSizes->gc.marker += gc.marker.sizeOfExcludingThis(mallocSizeOf);
+  rtSizes->gc.marker += gc.parallelMarker.sizeOfExcludingThis(mallocSizeOf);
+  rtSizes->gc.marker += gc.parallelTenuring.sizeOfExcludingThis(mallocSizeOf);
 
   if (!parentRuntime) {
     rtSizes->atomsTable += mallocSizeOf(staticStrings);
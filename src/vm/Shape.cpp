@@ -1070,6 +1070,7 @@ Shape* NativeObject::putDataProperty(JSContext* cx, HandleNativeObject obj,
     // shape for the existing property, and also generate a new shape for
     // the last property of the dictionary (unless the modified property
     // is also the last property).
+    cx->caches().megamorphicCache.invalidateEntry(obj->lastProperty(), id);
     bool updateLast = (shape == obj->lastProperty());
     shape = NativeObject::replaceWithNewEquivalentShape(
         cx, obj, shape, nullptr,
@@ -1182,6 +1183,7 @@ Shape* NativeObject::putAccessorProperty(JSContext* cx, HandleNativeObject obj,
     // shape for the existing property, and also generate a new shape for
     // the last property of the dictionary (unless the modified property
     // is also the last property).
+    cx->caches().megamorphicCache.invalidateEntry(obj->lastProperty(), id);
     bool updateLast = (shape == obj->lastProperty());
     shape =
         NativeObject::replaceWithNewEquivalentShape(cx, obj, shape, nullptr,
@@ -1305,6 +1307,8 @@ bool NativeObject::removeProperty(JSContext* cx, HandleNativeObject obj,
    */
   RootedShape spare(cx);
   if (obj->inDictionaryMode()) {
+    cx->caches().megamorphicCache.invalidateEntry(obj->lastProperty(), id);
+
     /* For simplicity, always allocate an accessor shape for now. */
     spare = Allocate<AccessorShape>(cx);
     if (!spare) {
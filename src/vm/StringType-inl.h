@@ -437,6 +437,30 @@ inline size_t JSLinearString::allocSize() const {
   return count * charSize;
 }
 
+inline void JSLinearString::deduplicateTo(JSFreeOp* fop,
+                                          JSLinearString* base) {
+  MOZ_ASSERT(this != base);
+  MOZ_ASSERT(isTenured() && base->isTenured());
+  MOZ_ASSERT(zone() == base->zone());
+  MOZ_ASSERT(ownsMallocedChars() && !isExtensible() && !isAtom());
+  MOZ_ASSERT(!base->isInline() && !base->isDependent());
+  MOZ_ASSERT(hasLatin1Chars() == base->hasLatin1Chars());
+  MOZ_ASSERT(js::EqualChars(this, base));
+
+  fop->free_(this, nonInlineCharsRaw(), allocSize(),
+             js::MemoryUse::StringContents);
+
+  JS::AutoCheckCannotGC nogc;
+  if (base->hasLatin1Chars()) {
+    setLengthAndFlags(length(), INIT_DEPENDENT_FLAGS | LATIN1_CHARS_BIT);
+    d.s.u2.nonInlineCharsLatin1 = base->latin1Chars(nogc);
+  } else {
+    setLengthAndFlags(length(), INIT_DEPENDENT_FLAGS);
+    d.s.u2.nonInlineCharsTwoByte = base->twoByteChars(nogc);
+  }
+  d.s.u3.base = base;
+}
+
 inline void JSFatInlineString::finalize(JSFreeOp* fop) {
   MOZ_ASSERT(getAllocKind() == js::gc::AllocKind::FAT_INLINE_STRING);
   MOZ_ASSERT(isInline());
@@ -1335,6 +1335,9 @@ static void MarkStringAndBasesNonDeduplicatable(JSLinearString* s) {
     if (!s->isTenured()) {
       s->setNonDeduplicatable();
     }
+    if (!s->isAtom()) {
+      s->setNonTenuredDeduplicatable();
+    }
     if (!s->hasBase()) {
       break;
     }
@@ -263,6 +263,15 @@ class JSString : public js::gc::CellWithLengthAndFlags {
    *   Bit 5: IsDependent
    *   Bit 6: IsInline (Inline, FatInline)
    *
+   * The bits above the type bits are used as follows:
+   *
+   *   Bit 9:  LATIN1_CHARS_BIT
+   *   Bit 10: INDEX_VALUE_BIT
+   *   Bit 11: NON_DEDUP_BIT (nursery string deduplication)
+   *   Bit 12: NON_TENURED_DEDUP_BIT (tenured string deduplication)
+   *
+   * Bits 13..15 are currently unused.
+   *
    * If INDEX_VALUE_BIT is set, bits 16 and up will also hold an integer index.
    */
 
@@ -300,6 +309,13 @@ class JSString : public js::gc::CellWithLengthAndFlags {
   // NON_DEDUP_BIT is used in string deduplication during tenuring.
   static const uint32_t NON_DEDUP_BIT = js::Bit(11);
 
+  // NON_TENURED_DEDUP_BIT is set on strings whose chars must stay where they
+  // are, either because they are the base of a dependent string or because
+  // they are in use by AutoStableStringChars. Such strings are never merged by
+  // tenured string deduplication during a major GC. Unlike NON_DEDUP_BIT it is
+  // kept when a string is tenured.
+  static const uint32_t NON_TENURED_DEDUP_BIT = js::Bit(12);
+
   static const uint32_t MAX_LENGTH = js::MaxStringLength;
 
   static const JS::Latin1Char MAX_LATIN1_CHAR = 0xff;
@@ -514,6 +530,14 @@ class JSString : public js::gc::CellWithLengthAndFlags {
   MOZ_ALWAYS_INLINE
   bool isDeduplicatable() { return !(flags() & NON_DEDUP_BIT); }
 
+  MOZ_ALWAYS_INLINE
+  void setNonTenuredDeduplicatable() { setFlagBit(NON_TENURED_DEDUP_BIT); }
+
+  MOZ_ALWAYS_INLINE
+  bool isTenuredDeduplicatable() {
+    return !(flags() & NON_TENURED_DEDUP_BIT);
+  }
+
   // Fills |array| with various strings that represent the different string
   // kinds and character encodings.
   static bool fillWithRepresentatives(JSContext* cx,
@@ -907,6 +931,13 @@ class JSLinearString : public JSString {
   inline void finalize(JSFreeOp* fop);
   inline size_t allocSize() const;
 
+  /*
+   * Free this string's chars and turn it into a dependent string of |base|,
+   * which must be another tenured string in the same zone with the same
+   * contents. Used to deduplicate tenured strings during a major GC.
+   */
+  inline void deduplicateTo(JSFreeOp* fop, JSLinearString* base);
+
 #if defined(DEBUG) || defined(JS_JITSPEW)
   void dumpRepresentationChars(js::GenericPrinter& out, int indent) const;
   void dumpRepresentation(js::GenericPrinter& out, int indent) const;
@@ -3169,6 +3169,25 @@ class BaseCompiler final : public BaseCompilerInterface {
 
   bool usesSharedMemory() const { return env_.usesSharedMemory(); }
 
+  // Whether inline copies and fills can move 16 bytes per access.
+  bool useSimdMemoryTransfers() const {
+#if defined(ENABLE_WASM_SIMD) && defined(JS_CODEGEN_X64)
+    return env_.v128Enabled();
+#else
+    return false;
+#endif
+  }
+
+  uint32_t maxInlineMemoryCopyLength() const {
+    return useSimdMemoryTransfers() ? MaxInlineMemoryCopyLengthSimd
+                                    : MaxInlineMemoryCopyLength;
+  }
+
+  uint32_t maxInlineMemoryFillLength() const {
+    return useSimdMemoryTransfers() ? MaxInlineMemoryFillLengthSimd
+                                    : MaxInlineMemoryFillLength;
+  }
+
  private:
   ////////////////////////////////////////////////////////////
   //
@@ -5296,6 +5315,10 @@ class BaseCompiler final : public BaseCompilerInterface {
     fr.zeroLocals(&ra);
     fr.storeTlsPtr(WasmTlsReg);
 
+    if (env_.lazyTiering() && !addHotnessCheck()) {
+      return false;
+    }
+
     if (env_.debugEnabled()) {
       insertBreakablePoint(CallSiteDesc::EnterFrame);
       if (!createStackMap("debug: breakable point")) {
@@ -5851,6 +5874,13 @@ class BaseCompiler final : public BaseCompilerInterface {
     return createStackMap("addInterruptCheck");
   }
 
+  MOZ_MUST_USE bool addHotnessCheck() {
+    ScratchI32 tmp(*this);
+    fr.loadTlsPtr(tmp);
+    masm.wasmHotnessCheck(tmp, func_.index, bytecodeOffset());
+    return createStackMap("addHotnessCheck");
+  }
+
   void jumpTable(const LabelVector& labels, Label* theTable) {
     // Flush constant pools to ensure that the table is never interrupted by
     // constant pool entries.
@@ -8105,6 +8135,9 @@ class BaseCompiler final : public BaseCompilerInterface {
   void emitVectorBinop(void (*op)(MacroAssembler& masm, RegV128 src,
                                   RegV128 srcDest));
 
+  void emitVectorBinopReversed(void (*op)(MacroAssembler& masm, RegV128 src,
+                                          RegV128 srcDest));
+
   template <typename TempRegType>
   void emitVectorBinopWithTemp(void (*)(MacroAssembler& masm, RegV128 rs,
                                         RegV128 rsd, TempRegType temp));
@@ -9531,6 +9564,9 @@ bool BaseCompiler::emitLoop() {
     if (!addInterruptCheck()) {
       return false;
     }
+    if (env_.lazyTiering() && !addHotnessCheck()) {
+      return false;
+    }
   }
 
   return true;
@@ -11763,7 +11799,7 @@ bool BaseCompiler::emitMemCopy() {
   int32_t signedLength;
   if (MacroAssembler::SupportsFastUnalignedAccesses() &&
       peekConstI32(&signedLength) && signedLength != 0 &&
-      uint32_t(signedLength) <= MaxInlineMemoryCopyLength) {
+      uint32_t(signedLength) <= maxInlineMemoryCopyLength()) {
     return emitMemCopyInline();
   }
 
@@ -11787,13 +11823,20 @@ bool BaseCompiler::emitMemCopyInline() {
   int32_t signedLength;
   MOZ_ALWAYS_TRUE(popConstI32(&signedLength));
   uint32_t length = signedLength;
-  MOZ_ASSERT(length != 0 && length <= MaxInlineMemoryCopyLength);
+  MOZ_ASSERT(length != 0 && length <= maxInlineMemoryCopyLength());
 
   RegI32 src = popI32();
   RegI32 dest = popI32();
 
   // Compute the number of copies of each width we will need to do
   size_t remainder = length;
+#ifdef ENABLE_WASM_SIMD
+  size_t numCopies16 = 0;
+  if (useSimdMemoryTransfers()) {
+    numCopies16 = remainder / sizeof(V128);
+    remainder %= sizeof(V128);
+  }
+#endif
 #ifdef JS_64BIT
   size_t numCopies8 = remainder / sizeof(uint64_t);
   remainder %= sizeof(uint64_t);
@@ -11810,6 +11853,24 @@ bool BaseCompiler::emitMemCopyInline() {
   bool omitBoundsCheck = false;
   size_t offset = 0;
 
+#ifdef ENABLE_WASM_SIMD
+  for (uint32_t i = 0; i < numCopies16; i++) {
+    RegI32 temp = needI32();
+    moveI32(src, temp);
+    pushI32(temp);
+
+    MemoryAccessDesc access(Scalar::Simd128, 1, offset, bytecodeOffset());
+    AccessCheck check;
+    check.omitBoundsCheck = omitBoundsCheck;
+    if (!loadCommon(&access, check, ValType::V128)) {
+      return false;
+    }
+
+    offset += sizeof(V128);
+    omitBoundsCheck = true;
+  }
+#endif
+
 #ifdef JS_64BIT
   for (uint32_t i = 0; i < numCopies8; i++) {
     RegI32 temp = needI32();
@@ -11956,6 +12017,27 @@ bool BaseCompiler::emitMemCopyInline() {
   }
 #endif
 
+#ifdef ENABLE_WASM_SIMD
+  for (uint32_t i = 0; i < numCopies16; i++) {
+    offset -= sizeof(V128);
+
+    RegV128 value = popV128();
+    RegI32 temp = needI32();
+    moveI32(dest, temp);
+    pushI32(temp);
+    pushV128(value);
+
+    MemoryAccessDesc access(Scalar::Simd128, 1, offset, bytecodeOffset());
+    AccessCheck check;
+    check.omitBoundsCheck = omitBoundsCheck;
+    if (!storeCommon(&access, check, ValType::V128)) {
+      return false;
+    }
+
+    omitBoundsCheck = true;
+  }
+#endif
+
   freeI32(dest);
   freeI32(src);
   return true;
@@ -12022,7 +12104,7 @@ bool BaseCompiler::emitMemFill() {
   int32_t signedValue;
   if (MacroAssembler::SupportsFastUnalignedAccesses() &&
       peek2xI32(&signedLength, &signedValue) && signedLength != 0 &&
-      uint32_t(signedLength) <= MaxInlineMemoryFillLength) {
+      uint32_t(signedLength) <= maxInlineMemoryFillLength()) {
     return emitMemFillInline();
   }
   return emitMemFillCall(lineOrBytecode);
@@ -12044,12 +12126,19 @@ bool BaseCompiler::emitMemFillInline() {
   MOZ_ALWAYS_TRUE(popConstI32(&signedValue));
   uint32_t length = uint32_t(signedLength);
   uint32_t value = uint32_t(signedValue);
-  MOZ_ASSERT(length != 0 && length <= MaxInlineMemoryFillLength);
+  MOZ_ASSERT(length != 0 && length <= maxInlineMemoryFillLength());
 
   RegI32 dest = popI32();
 
   // Compute the number of copies of each width we will need to do
   size_t remainder = length;
+#ifdef ENABLE_WASM_SIMD
+  size_t numCopies16 = 0;
+  if (useSimdMemoryTransfers()) {
+    numCopies16 = remainder / sizeof(V128);
+    remainder %= sizeof(V128);
+  }
+#endif
 #ifdef JS_64BIT
   size_t numCopies8 = remainder / sizeof(uint64_t);
   remainder %= sizeof(uint64_t);
@@ -12063,6 +12152,10 @@ bool BaseCompiler::emitMemFillInline() {
   MOZ_ASSERT(numCopies2 <= 1 && numCopies1 <= 1);
 
   // Generate splatted definitions for wider fills as needed
+#ifdef ENABLE_WASM_SIMD
+  V128 val16;
+  memset(val16.bytes, uint8_t(value), sizeof(val16.bytes));
+#endif
 #ifdef JS_64BIT
   uint64_t val8 = SplatByteToUInt<uint64_t>(value, 8);
 #endif
@@ -12149,6 +12242,26 @@ bool BaseCompiler::emitMemFillInline() {
   }
 #endif
 
+#ifdef ENABLE_WASM_SIMD
+  for (uint32_t i = 0; i < numCopies16; i++) {
+    offset -= sizeof(V128);
+
+    RegI32 temp = needI32();
+    moveI32(dest, temp);
+    pushI32(temp);
+    pushV128(val16);
+
+    MemoryAccessDesc access(Scalar::Simd128, 1, offset, bytecodeOffset());
+    AccessCheck check;
+    check.omitBoundsCheck = omitBoundsCheck;
+    if (!storeCommon(&access, check, ValType::V128)) {
+      return false;
+    }
+
+    omitBoundsCheck = true;
+  }
+#endif
+
   freeI32(dest);
   return true;
 }
@@ -12776,6 +12889,26 @@ static void MaxF64x2(MacroAssembler& masm, RegV128 rs, RegV128 rsd,
   masm.maxFloat64x2(rs, rsd, temp);
 }
 
+static void PMinF32x4(MacroAssembler& masm, RegV128 rs, RegV128 rsd) {
+  masm.pseudoMinFloat32x4(rs, rsd);
+}
+
+static void PMinF64x2(MacroAssembler& masm, RegV128 rs, RegV128 rsd) {
+  masm.pseudoMinFloat64x2(rs, rsd);
+}
+
+static void PMaxF32x4(MacroAssembler& masm, RegV128 rs, RegV128 rsd) {
+  masm.pseudoMaxFloat32x4(rs, rsd);
+}
+
+static void PMaxF64x2(MacroAssembler& masm, RegV128 rs, RegV128 rsd) {
+  masm.pseudoMaxFloat64x2(rs, rsd);
+}
+
+static void DotI16x8(MacroAssembler& masm, RegV128 rs, RegV128 rsd) {
+  masm.widenDotInt16x8(rs, rsd);
+}
+
 static void CmpI8x16(MacroAssembler& masm, Assembler::Condition cond,
                      RegV128 rs, RegV128 rsd) {
   masm.compareInt8x16(cond, rs, rsd);
@@ -13209,6 +13342,18 @@ void BaseCompiler::emitVectorBinop(void (*op)(MacroAssembler& masm, RegV128 src,
   pushV128(r);
 }
 
+void BaseCompiler::emitVectorBinopReversed(
+    void (*op)(MacroAssembler& masm, RegV128 src, RegV128 srcDest)) {
+  // For operations where the available instruction computes the wasm
+  // operation with its operands reversed: the result ends up in the register
+  // of the right-hand operand.
+  RegV128 r, rs;
+  pop2xV128(&r, &rs);
+  op(masm, r, rs);
+  freeV128(r);
+  pushV128(rs);
+}
+
 template <typename TempRegType>
 void BaseCompiler::emitVectorBinopWithTemp(void (*op)(MacroAssembler& masm,
                                                       RegV128 rs, RegV128 rsd,
@@ -14524,6 +14669,20 @@ bool BaseCompiler::emitBody() {
             CHECK_NEXT(dispatchVectorBinary(emitVectorBinop, MinF64x2));
           case uint32_t(SimdOp::F64x2Max):
             CHECK_NEXT(dispatchVectorBinary(emitVectorBinopWithTemp, MaxF64x2));
+          case uint32_t(SimdOp::F32x4PMin):
+            CHECK_NEXT(
+                dispatchVectorBinary(emitVectorBinopReversed, PMinF32x4));
+          case uint32_t(SimdOp::F32x4PMax):
+            CHECK_NEXT(
+                dispatchVectorBinary(emitVectorBinopReversed, PMaxF32x4));
+          case uint32_t(SimdOp::F64x2PMin):
+            CHECK_NEXT(
+                dispatchVectorBinary(emitVectorBinopReversed, PMinF64x2));
+          case uint32_t(SimdOp::F64x2PMax):
+            CHECK_NEXT(
+                dispatchVectorBinary(emitVectorBinopReversed, PMaxF64x2));
+          case uint32_t(SimdOp::I32x4DotSI16x8):
+            CHECK_NEXT(dispatchVectorBinary(emitVectorBinop, DotI16x8));
           case uint32_t(SimdOp::I8x16NarrowSI16x8):
             CHECK_NEXT(dispatchVectorBinary(emitVectorBinop, NarrowI16x8));
           case uint32_t(SimdOp::I8x16NarrowUI16x8):
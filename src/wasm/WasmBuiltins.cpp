@@ -33,6 +33,7 @@
 #include "util/Memory.h"
 #include "util/Poison.h"
 #include "vm/BigIntType.h"
+#include "wasm/WasmCompile.h"
 #include "wasm/WasmInstance.h"
 #include "wasm/WasmStubs.h"
 #include "wasm/WasmTypes.h"
@@ -466,6 +467,19 @@ static void* CheckInterrupt(JSContext* cx, JitActivation* activation) {
   return resumePC;
 }
 
+// Has the same return-value convention as HandleTrap().
+static void* TierUp(JitActivation* activation) {
+  void* resumePC = activation->wasmTrapData().resumePC;
+
+  const CodeRange* codeRange;
+  const Code* code = LookupCode(resumePC, &codeRange);
+  MOZ_RELEASE_ASSERT(code && codeRange->isFunction());
+  NoteHotFunction(*code, codeRange->funcIndex());
+
+  activation->finishWasmTrap();
+  return resumePC;
+}
+
 // The calling convention between this function and its caller in the stub
 // generated by GenerateTrapExit() is:
 //   - return nullptr if the stub should jump to the throw stub to unwind
@@ -497,6 +511,8 @@ static void* WasmHandleTrap() {
       return ReportError(cx, JSMSG_WASM_UNALIGNED_ACCESS);
     case Trap::CheckInterrupt:
       return CheckInterrupt(cx, activation);
+    case Trap::TierUp:
+      return TierUp(activation);
     case Trap::StackOverflow:
       // TlsData::setInterrupt() causes a fake stack overflow. Since
       // TlsData::setInterrupt() is called racily, it's possible for a real
@@ -33,6 +33,7 @@
 #ifdef MOZ_VTUNE
 #  include "vtune/VTuneWrapper.h"
 #endif
+#include "wasm/WasmCompile.h"
 #include "wasm/WasmModule.h"
 #include "wasm/WasmProcess.h"
 #include "wasm/WasmSerialize.h"
@@ -262,7 +263,7 @@ static void SendCodeRangesToProfiler(const ModuleSegment& ms,
                                      const CodeRangeVector& codeRanges) {
   bool enabled = false;
 #ifdef JS_ION_PERF
-  enabled |= PerfFuncEnabled();
+  enabled |= PerfFuncEnabled() || PerfJitdumpEnabled();
 #endif
 #ifdef MOZ_VTUNE
   enabled |= vtune::IsProfilingActive();
@@ -289,7 +290,7 @@ static void SendCodeRangesToProfiler(const ModuleSegment& ms,
     (void)size;
 
 #ifdef JS_ION_PERF
-    if (PerfFuncEnabled()) {
+    if (PerfFuncEnabled() || PerfJitdumpEnabled()) {
       const char* file = metadata.filename.get();
       if (codeRange.isFunction()) {
         if (!name.append('\0')) {
@@ -1138,6 +1139,22 @@ bool JumpTables::init(CompileMode mode, const ModuleSegment& ms,
   return true;
 }
 
+bool JumpTables::initHotness(int32_t threshold) {
+  MOZ_ASSERT(mode_ == CompileMode::Tier1);
+  MOZ_ASSERT(threshold > 0);
+
+  hotness_ = CounterPointer(js_pod_malloc<int32_t>(numFuncs_));
+  if (!hotness_) {
+    return false;
+  }
+
+  hotnessThreshold_ = threshold;
+  for (size_t i = 0; i < numFuncs_; i++) {
+    hotness_[i] = threshold;
+  }
+  return true;
+}
+
 Code::Code(UniqueCodeTier tier1, const Metadata& metadata,
            JumpTables&& maybeJumpTables, StructTypeVector&& structTypes)
     : tier1_(std::move(tier1)),
@@ -1145,7 +1162,18 @@ Code::Code(UniqueCodeTier tier1, const Metadata& metadata,
       profilingLabels_(mutexid::WasmCodeProfilingLabels,
                        CacheableCharsVector()),
       jumpTables_(std::move(maybeJumpTables)),
-      structTypes_(std::move(structTypes)) {}
+      structTypes_(std::move(structTypes)),
+      lazyTier2_(mutexid::WasmLazyTier2),
+      lazyTier2Batches_(nullptr) {}
+
+Code::~Code() {
+  LazyTier2Batch* batch = lazyTier2Batches_;
+  while (batch) {
+    LazyTier2Batch* next = batch->next;
+    js_delete(batch);
+    batch = next;
+  }
+}
 
 bool Code::initialize(const LinkData& linkData) {
   MOZ_ASSERT(!initialized());
@@ -1179,6 +1207,206 @@ void Code::commitTier2() const {
   MOZ_ASSERT(hasTier2());
 }
 
+bool Code::setLazyTier2(const CompileArgs& args,
+                        const ShareableBytes& bytecode) {
+  MOZ_ASSERT(jumpTables_.hotness());
+
+  auto state = lazyTier2_.lock();
+  MOZ_ASSERT(!state->args);
+  if (!state->hot.appendN(false, jumpTables_.numFuncs()) ||
+      !state->batched.appendN(false, jumpTables_.numFuncs())) {
+    return false;
+  }
+  state->args = &args;
+  state->bytecode = &bytecode;
+  return true;
+}
+
+void Code::noteLazyTier2HotFunction(uint32_t funcIndex) const {
+  auto state = lazyTier2_.lock();
+  MOZ_ASSERT(state->args);
+  if (!state->batched[funcIndex]) {
+    state->hot[funcIndex] = true;
+  }
+}
+
+bool Code::claimLazyTier2Batch(int32_t warmCounter,
+                               RefPtr<const CompileArgs>* args,
+                               SharedBytes* bytecode,
+                               HotFuncVector* funcs) const {
+  auto state = lazyTier2_.lock();
+  if (!state->args || state->batchRunning) {
+    return false;
+  }
+
+  if (!funcs->appendN(false, jumpTables_.numFuncs())) {
+    return false;
+  }
+
+  bool lastBatch = state->numBatches + 1 >= MaxLazyTier2Batches;
+
+  // Imports have no tier-1 code of their own and are never hot.
+  int32_t* counters = jumpTables_.hotness();
+  bool any = false;
+  for (uint32_t i = metadata(Tier::Baseline).funcImports.length();
+       i < funcs->length(); i++) {
+    if (state->batched[i] ||
+        (!lastBatch && !state->hot[i] && counters[i] > warmCounter)) {
+      continue;
+    }
+
+    // Warm functions mustn't trap once they're in a batch either.
+    counters[i] = INT32_MAX;
+    state->hot[i] = false;
+    state->batched[i] = true;
+    (*funcs)[i] = true;
+    any = true;
+  }
+  if (!any) {
+    return false;
+  }
+
+  state->batchRunning = true;
+  *args = state->args;
+  *bytecode = state->bytecode;
+  return true;
+}
+
+void Code::finishLazyTier2Batch(const HotFuncVector& funcs,
+                                bool succeeded) const {
+  auto state = lazyTier2_.lock();
+  MOZ_ASSERT(state->batchRunning);
+  state->batchRunning = false;
+
+  if (succeeded) {
+    state->numBatches++;
+    return;
+  }
+
+  // Starting the batch again right away would most likely fail the same way,
+  // on OOM say, so wait for the functions to get hot again.
+  int32_t* counters = jumpTables_.hotness();
+  int32_t threshold = jumpTables_.hotnessThreshold();
+  for (uint32_t i = 0; i < funcs.length(); i++) {
+    if (funcs[i]) {
+      state->batched[i] = false;
+      counters[i] = threshold;
+    }
+  }
+}
+
+bool Code::finishTier2(const LinkData& linkData2, UniqueCodeTier code2,
+                       const HotFuncVector* hotFuncs) const {
+  MOZ_ASSERT(bestTier() == Tier::Baseline &&
+             code2->tier() == Tier::Optimized);
+
+  // Install the data in the data structures. They will not be visible
+  // until commitTier2().
+
+  if (!setTier2(std::move(code2), linkData2)) {
+    return false;
+  }
+
+  // Before we can make tier-2 live, we need to compile tier2 versions of any
+  // extant tier1 lazy stubs (otherwise, tiering would break the assumption
+  // that any extant exported wasm function has had a lazy entry stub already
+  // compiled for it).
+  {
+    // We need to prevent new tier1 stubs generation until we've committed
+    // the newer tier2 stubs, otherwise we might not generate one tier2
+    // stub that has been generated for tier1 before we committed.
+
+    const MetadataTier& metadataTier1 = metadata(Tier::Baseline);
+
+    auto stubs1 = codeTier(Tier::Baseline).lazyStubs().lock();
+    auto stubs2 = codeTier(Tier::Optimized).lazyStubs().lock();
+
+    MOZ_ASSERT(stubs2->empty());
+
+    Uint32Vector funcExportIndices;
+    for (size_t i = 0; i < metadataTier1.funcExports.length(); i++) {
+      const FuncExport& fe = metadataTier1.funcExports[i];
+      if (fe.hasEagerStubs()) {
+        continue;
+      }
+      if (!stubs1->hasStub(fe.funcIndex())) {
+        continue;
+      }
+      if (!funcExportIndices.emplaceBack(i)) {
+        return false;
+      }
+    }
+
+    const CodeTier& tier2 = codeTier(Tier::Optimized);
+
+    Maybe<size_t> stub2Index;
+    if (!stubs2->createTier2(funcExportIndices, tier2, &stub2Index)) {
+      return false;
+    }
+
+    // Now that we can't fail or otherwise abort tier2, make it live.
+
+    MOZ_ASSERT(!hasTier2());
+    commitTier2();
+
+    stubs2->setJitEntries(stub2Index, *this);
+  }
+
+  // And we update the jump vector.  Functions that weren't optimized have a
+  // tier-2 forwarder that jumps back to their tier-1 code through the jump
+  // vector, so their entries must stay as they are.
+
+  uint8_t* base = segment(Tier::Optimized).base();
+  for (const CodeRange& cr : metadata(Tier::Optimized).codeRanges) {
+    // These are racy writes that we just want to be visible, atomically,
+    // eventually.  All hardware we care about will do this right.  But
+    // we depend on the compiler not splitting the stores hidden inside the
+    // set*Entry functions.
+    if (cr.isFunction()) {
+      if (!hotFuncs || (*hotFuncs)[cr.funcIndex()]) {
+        setTieringEntry(cr.funcIndex(), base + cr.funcTierEntry());
+      }
+    } else if (cr.isJitEntry()) {
+      setJitEntry(cr.funcIndex(), base + cr.begin());
+    }
+  }
+
+  return true;
+}
+
+bool Code::addLazyTier2Batch(const LinkData& linkData, UniqueCodeTier codeTier,
+                             const HotFuncVector& hotFuncs) const {
+  MOZ_ASSERT(hasTier2() && codeTier->tier() == Tier::Optimized);
+
+  auto batch = js::MakeUnique<LazyTier2Batch>();
+  if (!batch) {
+    return false;
+  }
+
+  if (!codeTier->initialize(*this, linkData, *metadata_)) {
+    return false;
+  }
+
+  // Publish the batch before any code can run in it, so that the lookup
+  // functions below find it. Only one batch is finished at a time.
+  uint8_t* base = codeTier->segment().base();
+  const CodeRangeVector& codeRanges = codeTier->metadata().codeRanges;
+  batch->codeTier = std::move(codeTier);
+  batch->next = lazyTier2Batches_;
+  lazyTier2Batches_ = batch.release();
+
+  // The functions of this batch that are called from earlier tier-2 code
+  // are called through their forwarders there, so the tiering jump table is
+  // all that needs updating. See also finishTier2().
+  for (const CodeRange& cr : codeRanges) {
+    if (cr.isFunction() && hotFuncs[cr.funcIndex()]) {
+      setTieringEntry(cr.funcIndex(), base + cr.funcTierEntry());
+    }
+  }
+
+  return true;
+}
+
 uint32_t Code::getFuncIndex(JSFunction* fun) const {
   MOZ_ASSERT(fun->isWasm() || fun->isAsmJSNative());
   if (!fun->isWasmWithJitEntry()) {
@@ -1232,16 +1460,28 @@ const CodeTier& Code::codeTier(Tier tier) const {
   MOZ_CRASH();
 }
 
-bool Code::containsCodePC(const void* pc) const {
+template <typename F>
+bool Code::anyCodeTier(F f) const {
   for (Tier t : tiers()) {
-    const ModuleSegment& ms = segment(t);
-    if (ms.containsCodePC(pc)) {
+    if (f(codeTier(t))) {
+      return true;
+    }
+  }
+  for (const LazyTier2Batch* batch = lazyTier2Batches_; batch;
+       batch = batch->next) {
+    if (f(*batch->codeTier)) {
       return true;
     }
   }
   return false;
 }
 
+bool Code::containsCodePC(const void* pc) const {
+  return anyCodeTier([pc](const CodeTier& codeTier) {
+    return codeTier.segment().containsCodePC(pc);
+  });
+}
+
 struct CallSiteRetAddrOffset {
   const CallSiteVector& callSites;
   explicit CallSiteRetAddrOffset(const CallSiteVector& callSites)
@@ -1252,38 +1492,45 @@ struct CallSiteRetAddrOffset {
 };
 
 const CallSite* Code::lookupCallSite(void* returnAddress) const {
-  for (Tier t : tiers()) {
-    uint32_t target = ((uint8_t*)returnAddress) - segment(t).base();
+  const CallSite* result = nullptr;
+  anyCodeTier([returnAddress, &result](const CodeTier& codeTier) {
+    const CallSiteVector& callSites = codeTier.metadata().callSites;
+    uint32_t target =
+        ((uint8_t*)returnAddress) - codeTier.segment().base();
     size_t lowerBound = 0;
-    size_t upperBound = metadata(t).callSites.length();
+    size_t upperBound = callSites.length();
 
     size_t match;
-    if (BinarySearch(CallSiteRetAddrOffset(metadata(t).callSites), lowerBound,
-                     upperBound, target, &match))
-      return &metadata(t).callSites[match];
-  }
-
-  return nullptr;
+    if (!BinarySearch(CallSiteRetAddrOffset(callSites), lowerBound,
+                      upperBound, target, &match)) {
+      return false;
+    }
+    result = &callSites[match];
+    return true;
+  });
+  return result;
 }
 
 const CodeRange* Code::lookupFuncRange(void* pc) const {
-  for (Tier t : tiers()) {
-    const CodeRange* result = codeTier(t).lookupRange(pc);
-    if (result && result->isFunction()) {
-      return result;
+  const CodeRange* result = nullptr;
+  anyCodeTier([pc, &result](const CodeTier& codeTier) {
+    const CodeRange* range = codeTier.lookupRange(pc);
+    if (!range || !range->isFunction()) {
+      return false;
     }
-  }
-  return nullptr;
+    result = range;
+    return true;
+  });
+  return result;
 }
 
 const StackMap* Code::lookupStackMap(uint8_t* nextPC) const {
-  for (Tier t : tiers()) {
-    const StackMap* result = metadata(t).stackMaps.findMap(nextPC);
-    if (result) {
-      return result;
-    }
-  }
-  return nullptr;
+  const StackMap* result = nullptr;
+  anyCodeTier([nextPC, &result](const CodeTier& codeTier) {
+    result = codeTier.metadata().stackMaps.findMap(nextPC);
+    return !!result;
+  });
+  return result;
 }
 
 struct TrapSitePCOffset {
@@ -1294,27 +1541,26 @@ struct TrapSitePCOffset {
 };
 
 bool Code::lookupTrap(void* pc, Trap* trapOut, BytecodeOffset* bytecode) const {
-  for (Tier t : tiers()) {
-    const TrapSiteVectorArray& trapSitesArray = metadata(t).trapSites;
+  return anyCodeTier([=](const CodeTier& codeTier) {
+    const TrapSiteVectorArray& trapSitesArray = codeTier.metadata().trapSites;
     for (Trap trap : MakeEnumeratedRange(Trap::Limit)) {
       const TrapSiteVector& trapSites = trapSitesArray[trap];
 
-      uint32_t target = ((uint8_t*)pc) - segment(t).base();
+      uint32_t target = ((uint8_t*)pc) - codeTier.segment().base();
       size_t lowerBound = 0;
       size_t upperBound = trapSites.length();
 
       size_t match;
       if (BinarySearch(TrapSitePCOffset(trapSites), lowerBound, upperBound,
                        target, &match)) {
-        MOZ_ASSERT(segment(t).containsCodePC(pc));
+        MOZ_ASSERT(codeTier.segment().containsCodePC(pc));
         *trapOut = trap;
         *bytecode = trapSites[match].bytecode;
         return true;
       }
     }
-  }
-
-  return false;
+    return false;
+  });
 }
 
 // When enabled, generate profiling labels for every name in funcNames_ that is
@@ -1410,9 +1656,10 @@ void Code::addSizeOfMiscIfNotSeen(MallocSizeOf mallocSizeOf,
            profilingLabels_.lock()->sizeOfExcludingThis(mallocSizeOf) +
            jumpTables_.sizeOfMiscExcludingThis();
 
-  for (auto t : tiers()) {
-    codeTier(t).addSizeOfMisc(mallocSizeOf, code, data);
-  }
+  anyCodeTier([=](const CodeTier& codeTier) {
+    codeTier.addSizeOfMisc(mallocSizeOf, code, data);
+    return false;
+  });
   *data += SizeOfVectorExcludingThis(structTypes_, mallocSizeOf);
 }
 
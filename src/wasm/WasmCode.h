@@ -33,6 +33,7 @@ struct AsmJSMetadata;
 
 namespace wasm {
 
+struct CompileArgs;
 struct MetadataTier;
 struct Metadata;
 
@@ -607,18 +608,29 @@ class CodeTier {
 
 class JumpTables {
   using TablePointer = mozilla::UniquePtr<void*[], JS::FreePolicy>;
+  using CounterPointer = mozilla::UniquePtr<int32_t[], JS::FreePolicy>;
 
   CompileMode mode_;
   TablePointer tiering_;
   TablePointer jit_;
+  CounterPointer hotness_;
+  int32_t hotnessThreshold_ = 0;
   size_t numFuncs_;
 
  public:
   bool init(CompileMode mode, const ModuleSegment& ms,
             const CodeRangeVector& codeRanges);
 
+  // When tiering lazily, baseline code counts down a hotness counter per
+  // function on entry and on each loop iteration, and traps with
+  // Trap::TierUp when the counter goes negative.
+  bool initHotness(int32_t threshold);
+  int32_t* hotness() const { return hotness_.get(); }
+  int32_t hotnessThreshold() const { return hotnessThreshold_; }
+  size_t numFuncs() const { return numFuncs_; }
+
   void setJitEntry(size_t i, void* target) const {
-    // Make sure that write is atomic; see comment in wasm::Module::finishTier2
+    // Make sure that write is atomic; see comment in wasm::Code::finishTier2
     // to that effect.
     MOZ_ASSERT(i < numFuncs_);
     jit_.get()[i] = target;
@@ -636,7 +648,7 @@ class JumpTables {
 
   void setTieringEntry(size_t i, void* target) const {
     MOZ_ASSERT(i < numFuncs_);
-    // See comment in wasm::Module::finishTier2.
+    // See comment in wasm::Code::finishTier2.
     if (mode_ == CompileMode::Tier1) {
       tiering_.get()[i] = target;
     }
@@ -645,11 +657,19 @@ class JumpTables {
 
   size_t sizeOfMiscExcludingThis() const {
     // 2 words per function for the jit entry table, plus maybe 1 per
-    // function if we're tiering.
-    return sizeof(void*) * (2 + (tiering_ ? 1 : 0)) * numFuncs_;
+    // function if we're tiering, plus maybe a counter per function if we're
+    // tiering lazily.
+    return sizeof(void*) * (2 + (tiering_ ? 1 : 0)) * numFuncs_ +
+           (hotness_ ? sizeof(int32_t) * numFuncs_ : 0);
   }
 };
 
+// For lazy tier-2 compilation, the functions that are compiled with the
+// optimizing compiler, indexed by function index. The others are only given
+// tier-2 forwarders to their baseline code.
+
+using HotFuncVector = Vector<bool, 0, SystemAllocPolicy>;
+
 // Code objects own executable code and the metadata that describe it. A single
 // Code object is normally shared between a module and all its instances.
 //
@@ -667,9 +687,42 @@ class Code : public ShareableBase<Code> {
   JumpTables jumpTables_;
   StructTypeVector structTypes_;
 
+  // When tiering lazily, tier-2 code is compiled in batches of functions that
+  // got hot, one batch at a time. This is what's needed to select and compile
+  // the next batch.
+  struct LazyTier2State {
+    RefPtr<const CompileArgs> args;
+    SharedBytes bytecode;
+    // Functions that trapped with Trap::TierUp but aren't in a batch yet.
+    HotFuncVector hot;
+    // Functions that have been given to a batch.
+    HotFuncVector batched;
+    bool batchRunning = false;
+    // The number of batches that have been installed.
+    uint32_t numBatches = 0;
+  };
+  ExclusiveData<LazyTier2State> lazyTier2_;
+
+  // The lazy tier-2 batches after the first one, which is tier2_, newest
+  // first. Each is a complete optimized tier in which only the functions of
+  // that batch are optimized. Their code may be running or on the stack at
+  // any time, so batches are never removed, and the list is only ever
+  // prepended to so that lookups from any thread can walk it.
+  struct LazyTier2Batch {
+    UniqueCodeTier codeTier;
+    LazyTier2Batch* next;
+  };
+  mutable Atomic<LazyTier2Batch*> lazyTier2Batches_;
+
+  // Calls |f| with each tier and then each later lazy tier-2 batch, until it
+  // returns true.
+  template <typename F>
+  bool anyCodeTier(F f) const;
+
  public:
   Code(UniqueCodeTier tier1, const Metadata& metadata,
        JumpTables&& maybeJumpTables, StructTypeVector&& structTypes);
+  ~Code();
   bool initialized() const { return tier1_->initialized(); }
 
   bool initialize(const LinkData& linkData);
@@ -687,9 +740,46 @@ class Code : public ShareableBase<Code> {
   }
   uint32_t getFuncIndex(JSFunction* fun) const;
 
+  int32_t* hotnessCounters() const { return jumpTables_.hotness(); }
+  const JumpTables& jumpTables() const { return jumpTables_; }
+
+  // Each lazy tier-2 batch has stubs, forwarders and metadata for the whole
+  // module, and is kept for the lifetime of the Code. To bound that memory,
+  // the batch that reaches this limit takes every function still running
+  // tier-1 code, and no batches follow it.
+  static const uint32_t MaxLazyTier2Batches = 4;
+
+  // Lazy tier-2 compilation. A function that got hot is noted with
+  // noteLazyTier2HotFunction(). claimLazyTier2Batch() then selects the next
+  // batch, unless one is already running: the hot functions and those whose
+  // counter is at most |warmCounter|, leaving out functions that were in an
+  // earlier batch. It returns false if there is nothing to compile. Once the
+  // batch is done, successfully or not, finishLazyTier2Batch() lets the next
+  // one be claimed. The functions of a batch that failed go back to tier-1
+  // code with a fresh counter, so that they are batched again if they get hot.
+  MOZ_MUST_USE bool setLazyTier2(const CompileArgs& args,
+                                 const ShareableBytes& bytecode);
+  void noteLazyTier2HotFunction(uint32_t funcIndex) const;
+  bool claimLazyTier2Batch(int32_t warmCounter,
+                           RefPtr<const CompileArgs>* args,
+                           SharedBytes* bytecode,
+                           HotFuncVector* funcs) const;
+  void finishLazyTier2Batch(const HotFuncVector& funcs, bool succeeded) const;
+
   bool setTier2(UniqueCodeTier tier2, const LinkData& linkData) const;
   void commitTier2() const;
 
+  // Install tier-2 code and redirect tier-1 code to it through the tiering
+  // jump table. If |hotFuncs| is given, only the functions it selects are
+  // redirected, the others keep running their tier-1 code.
+  bool finishTier2(const LinkData& linkData2, UniqueCodeTier code2,
+                   const HotFuncVector* hotFuncs = nullptr) const;
+
+  // Install a lazy tier-2 batch after the first one, and redirect the
+  // functions selected by |hotFuncs| to it.
+  bool addLazyTier2Batch(const LinkData& linkData, UniqueCodeTier codeTier,
+                         const HotFuncVector& hotFuncs) const;
+
   bool hasTier2() const { return hasTier2_; }
   Tiers tiers() const;
   bool hasTier(Tier t) const;
@@ -0,0 +1,368 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ *
+ * Copyright 2020 Mozilla Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wasm/WasmCodeCache.h"
+
+#include "mozilla/Atomics.h"
+#include "mozilla/HashFunctions.h"
+#include "mozilla/ScopeExit.h"
+
+#ifdef XP_UNIX
+#  include <dirent.h>
+#  include <errno.h>
+#  include <fcntl.h>
+#  include <stdlib.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "js/BuildId.h"  // JS::BuildIdCharVector
+#include "js/Printf.h"
+#include "js/RefCounted.h"
+#include "util/Text.h"
+#include "wasm/WasmCompile.h"
+
+using namespace js;
+using namespace js::wasm;
+
+using mozilla::Atomic;
+
+static char* CacheDirectory = nullptr;
+
+// Whether CacheDirectory was created by CreateTemporaryCodeCacheDirectory and
+// is removed on shutdown.
+static bool CacheDirectoryIsTemporary = false;
+
+static Atomic<uint32_t> CacheHits(0);
+static Atomic<uint32_t> CacheMisses(0);
+static Atomic<uint32_t> CacheStores(0);
+
+#ifdef XP_UNIX
+
+// Distinguishes temporary files written concurrently by this process.
+static Atomic<uint32_t> TempFileCounter(0);
+
+// An entry is a CodeCacheHeader followed by the build id, the bytecode and
+// the serialized module.
+struct CodeCacheHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t options;
+  uint32_t buildIdLength;
+  uint64_t bytecodeLength;
+  uint64_t serializedLength;
+};
+
+static const uint32_t CodeCacheMagic = 0x43435357;  // "WSCC"
+static const uint32_t CodeCacheVersion = 1;
+
+// The compile options that affect the optimized tier's code.
+static uint32_t CompileOptionBits(const CompileArgs& args) {
+  return uint32_t(args.craneliftEnabled) << 0 |
+         uint32_t(args.sharedMemoryEnabled) << 1 |
+         uint32_t(args.reftypesEnabled) << 2 |
+         uint32_t(args.gcEnabled) << 3 | uint32_t(args.hugeMemory) << 4 |
+         uint32_t(args.multiValuesEnabled) << 5 |
+         uint32_t(args.v128Enabled) << 6;
+}
+
+static UniqueChars EntryPath(const JS::BuildIdCharVector& buildId,
+                             uint32_t options, const ShareableBytes& bytecode) {
+  HashNumber hash = mozilla::HashBytes(bytecode.begin(), bytecode.length());
+  hash = mozilla::AddToHash(
+      hash, mozilla::HashBytes(buildId.begin(), buildId.length()), options);
+  return JS_smprintf("%s/%08x-%zx.wasmcache", CacheDirectory, hash,
+                     bytecode.length());
+}
+
+static bool WriteAll(int fd, const void* data, size_t length) {
+  const uint8_t* cursor = static_cast<const uint8_t*>(data);
+  while (length > 0) {
+    ssize_t written = write(fd, cursor, length);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    cursor += written;
+    length -= written;
+  }
+  return true;
+}
+
+static bool WriteEntry(const char* path, const CodeCacheHeader& header,
+                       const JS::BuildIdCharVector& buildId,
+                       const ShareableBytes& bytecode,
+                       const JS::OptimizedEncodingBytes& serialized) {
+  // Write to a temporary file and rename it, so that readers never see a
+  // partially written entry.
+  UniqueChars tempPath = JS_smprintf("%s.%d-%u.tmp", path, int(getpid()),
+                                     uint32_t(++TempFileCounter));
+  if (!tempPath) {
+    return false;
+  }
+
+  int fd = open(tempPath.get(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (fd == -1) {
+    return false;
+  }
+
+  bool ok = WriteAll(fd, &header, sizeof(header)) &&
+            WriteAll(fd, buildId.begin(), buildId.length()) &&
+            WriteAll(fd, bytecode.begin(), bytecode.length()) &&
+            WriteAll(fd, serialized.begin(), serialized.length());
+  ok = close(fd) == 0 && ok;
+
+  if (!ok || rename(tempPath.get(), path) != 0) {
+    unlink(tempPath.get());
+    return false;
+  }
+  return true;
+}
+
+static SharedModule LoadEntry(const char* path,
+                              const JS::BuildIdCharVector& buildId,
+                              uint32_t options,
+                              const ShareableBytes& bytecode) {
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return nullptr;
+  }
+  auto closeFile = mozilla::MakeScopeExit([&] { close(fd); });
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(CodeCacheHeader)) {
+    return nullptr;
+  }
+  size_t size = st.st_size;
+
+  // Map the entry instead of reading it into a buffer: only the bytecode
+  // comparison and deserialization touch the pages, once each.
+  void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (mapped == MAP_FAILED) {
+    return nullptr;
+  }
+  auto unmap = mozilla::MakeScopeExit([&] { munmap(mapped, size); });
+
+  const uint8_t* cursor = static_cast<const uint8_t*>(mapped);
+  const uint8_t* end = cursor + size;
+
+  CodeCacheHeader header;
+  memcpy(&header, cursor, sizeof(header));
+  cursor += sizeof(header);
+
+  if (header.magic != CodeCacheMagic || header.version != CodeCacheVersion ||
+      header.options != options || header.buildIdLength != buildId.length() ||
+      header.bytecodeLength != bytecode.length()) {
+    return nullptr;
+  }
+
+  size_t remaining = end - cursor;
+  if (remaining < buildId.length() ||
+      remaining - buildId.length() < bytecode.length() ||
+      remaining - buildId.length() - bytecode.length() !=
+          header.serializedLength) {
+    return nullptr;
+  }
+
+  // The file name is only a hash, so check that this really is an entry for
+  // this bytecode and build.
+  if (memcmp(cursor, buildId.begin(), buildId.length()) != 0) {
+    return nullptr;
+  }
+  cursor += buildId.length();
+
+  if (memcmp(cursor, bytecode.begin(), bytecode.length()) != 0) {
+    return nullptr;
+  }
+  cursor += bytecode.length();
+
+  return Module::deserialize(cursor, header.serializedLength);
+}
+
+namespace {
+
+// Stores the module in the cache once its optimized tier is serialized.
+class CodeCacheWriter : public AtomicRefCounted<CodeCacheWriter>,
+                        public JS::OptimizedEncodingListener {
+  using AtomicBase = AtomicRefCounted<CodeCacheWriter>;
+
+  UniqueChars path_;
+  JS::BuildIdCharVector buildId_;
+  uint32_t options_;
+  SharedBytes bytecode_;
+
+ public:
+  CodeCacheWriter(UniqueChars path, JS::BuildIdCharVector&& buildId,
+                  uint32_t options, const ShareableBytes& bytecode)
+      : path_(std::move(path)),
+        buildId_(std::move(buildId)),
+        options_(options),
+        bytecode_(&bytecode) {}
+
+  MozExternalRefCountType MOZ_XPCOM_ABI AddRef() override {
+    AtomicBase::AddRef();
+    return 1;  // unused
+  }
+  MozExternalRefCountType MOZ_XPCOM_ABI Release() override {
+    AtomicBase::Release();
+    return 0;  // unused
+  }
+
+  void storeOptimizedEncoding(JS::UniqueOptimizedEncodingBytes bytes) override {
+    CodeCacheHeader header = {};
+    header.magic = CodeCacheMagic;
+    header.version = CodeCacheVersion;
+    header.options = options_;
+    header.buildIdLength = buildId_.length();
+    header.bytecodeLength = bytecode_->length();
+    header.serializedLength = bytes->length();
+
+    if (WriteEntry(path_.get(), header, buildId_, *bytecode_, *bytes)) {
+      CacheStores++;
+    }
+  }
+};
+
+}  // namespace
+
+bool wasm::SetCodeCacheDirectory(const char* dir) {
+  MOZ_ASSERT(!CacheDirectory);
+
+  if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+    return false;
+  }
+
+  struct stat st;
+  if (stat(dir, &st) != 0 || !S_ISDIR(st.st_mode)) {
+    return false;
+  }
+
+  CacheDirectory = DuplicateString(dir).release();
+  return !!CacheDirectory;
+}
+
+bool wasm::CreateTemporaryCodeCacheDirectory() {
+  MOZ_ASSERT(!CacheDirectory);
+
+  const char* tmpDir = getenv("TMPDIR");
+  if (!tmpDir || !*tmpDir) {
+    tmpDir = "/tmp";
+  }
+
+  UniqueChars dir = JS_smprintf("%s/sm-wasm-code-cache-XXXXXX", tmpDir);
+  if (!dir || !mkdtemp(dir.get())) {
+    return false;
+  }
+
+  CacheDirectory = dir.release();
+  CacheDirectoryIsTemporary = true;
+  return true;
+}
+
+// Remove the entries, and any temporary files left by failed writes, then the
+// directory itself.
+static void RemoveTemporaryCacheDirectory() {
+  DIR* dir = opendir(CacheDirectory);
+  if (!dir) {
+    return;
+  }
+
+  while (struct dirent* entry = readdir(dir)) {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+      continue;
+    }
+    if (UniqueChars path =
+            JS_smprintf("%s/%s", CacheDirectory, entry->d_name)) {
+      unlink(path.get());
+    }
+  }
+  closedir(dir);
+
+  rmdir(CacheDirectory);
+}
+
+SharedModule wasm::LookupCodeCache(const CompileArgs& args,
+                                   const ShareableBytes& bytecode,
+                                   Tier2Listener* listener) {
+  MOZ_ASSERT(CodeCacheEnabled());
+
+  // Only optimized code can be serialized, and debugging needs code that
+  // isn't shared.
+  if (args.debugEnabled || !(args.ionEnabled || args.craneliftEnabled)) {
+    return nullptr;
+  }
+
+  JS::BuildIdCharVector buildId;
+  if (!GetOptimizedEncodingBuildId(&buildId)) {
+    return nullptr;
+  }
+
+  uint32_t options = CompileOptionBits(args);
+  UniqueChars path = EntryPath(buildId, options, bytecode);
+  if (!path) {
+    return nullptr;
+  }
+
+  if (SharedModule module = LoadEntry(path.get(), buildId, options, bytecode)) {
+    CacheHits++;
+    return module;
+  }
+
+  CacheMisses++;
+  *listener = js_new<CodeCacheWriter>(std::move(path), std::move(buildId),
+                                      options, bytecode);
+  return nullptr;
+}
+
+#else  // XP_UNIX
+
+bool wasm::SetCodeCacheDirectory(const char* dir) { return false; }
+
+bool wasm::CreateTemporaryCodeCacheDirectory() { return false; }
+
+SharedModule wasm::LookupCodeCache(const CompileArgs& args,
+                                   const ShareableBytes& bytecode,
+                                   Tier2Listener* listener) {
+  MOZ_CRASH("The wasm code cache is not supported on this platform");
+}
+
+#endif  // XP_UNIX
+
+void wasm::ShutDownCodeCache() {
+#ifdef XP_UNIX
+  if (CacheDirectory && CacheDirectoryIsTemporary) {
+    RemoveTemporaryCacheDirectory();
+  }
+#endif
+  js_free(CacheDirectory);
+  CacheDirectory = nullptr;
+  CacheDirectoryIsTemporary = false;
+}
+
+bool wasm::CodeCacheEnabled() { return !!CacheDirectory; }
+
+CodeCacheStats wasm::GetCodeCacheStats() {
+  CodeCacheStats stats;
+  stats.hits = CacheHits;
+  stats.misses = CacheMisses;
+  stats.stores = CacheStores;
+  return stats;
+}
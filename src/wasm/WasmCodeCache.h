@@ -0,0 +1,69 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ *
+ * Copyright 2020 Mozilla Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef wasm_code_cache_h
+#define wasm_code_cache_h
+
+#include "mozilla/Attributes.h"
+
+#include "wasm/WasmModule.h"
+
+namespace js {
+namespace wasm {
+
+// A persistent, process-wide cache of compiled modules in a directory on disk.
+// Entries are looked up by a hash of the bytecode and of everything that can
+// make machine code invalid (the build id, the CPU features and the compile
+// options). Each entry contains a copy of the bytecode, which is compared
+// against the bytecode being compiled, and the serialized optimized-tier
+// module. Entries are written when the optimized tier is done, which is in
+// the background for tiered compilation.
+//
+// The embedding enables the cache with SetCodeCacheDirectory before any
+// module is compiled. It's then used by CompileBuffer.
+
+MOZ_MUST_USE bool SetCodeCacheDirectory(const char* dir);
+
+// For testing: use a new, uniquely named directory under $TMPDIR as the cache,
+// and remove it with its entries in ShutDownCodeCache.
+MOZ_MUST_USE bool CreateTemporaryCodeCacheDirectory();
+
+void ShutDownCodeCache();
+
+bool CodeCacheEnabled();
+
+// On a hit, return the cached module. On a miss, return null and set
+// |listener| to an object that stores the module in the cache once it has
+// been compiled, if the compile options allow caching it.
+
+SharedModule LookupCodeCache(const CompileArgs& args,
+                             const ShareableBytes& bytecode,
+                             Tier2Listener* listener);
+
+struct CodeCacheStats {
+  uint32_t hits;
+  uint32_t misses;
+  uint32_t stores;
+};
+
+CodeCacheStats GetCodeCacheStats();
+
+}  // namespace wasm
+}  // namespace js
+
+#endif  // wasm_code_cache_h
@@ -25,7 +25,9 @@
 
 #include "jit/ProcessExecutableMemory.h"
 #include "util/Text.h"
+#include "vm/HelperThreads.h"
 #include "wasm/WasmBaselineCompile.h"
+#include "wasm/WasmCodeCache.h"
 #include "wasm/WasmCraneliftCompile.h"
 #include "wasm/WasmGenerator.h"
 #include "wasm/WasmIonCompile.h"
@@ -76,6 +78,20 @@ uint32_t wasm::ObservedCPUFeatures() {
 #endif
 }
 
+// A function is warm, and goes in the next lazy tier-2 batch, once it has used
+// up at least this fraction of its hotness counter.
+static const int32_t WarmFraction = 16;
+
+static Atomic<uint32_t> LazyTier2HotFuncs(0);
+static Atomic<uint32_t> LazyTier2Started(0);
+static Atomic<uint32_t> LazyTier2Finished(0);
+static Atomic<uint32_t> LazyTier2Failed(0);
+static Atomic<uint32_t> LazyTier2OptimizedFuncs(0);
+static Atomic<uint32_t> LazyTier2ForwardedFuncs(0);
+static Atomic<uint64_t> LazyTier2OptimizedBytes(0);
+static Atomic<uint64_t> LazyTier2ForwardedBytes(0);
+static Atomic<uint64_t> LazyTier2CompileTimeUs(0);
+
 SharedCompileArgs CompileArgs::build(JSContext* cx,
                                      ScriptedCaller&& scriptedCaller) {
   bool baseline = BaselineAvailable(cx);
@@ -131,6 +147,8 @@ SharedCompileArgs CompileArgs::build(JSContext* cx,
   target->hugeMemory = wasm::IsHugeMemoryEnabled();
   target->multiValuesEnabled = wasm::MultiValuesAvailable(cx);
   target->v128Enabled = wasm::SimdAvailable(cx);
+  target->tierUpThreshold =
+      std::min(JitOptions.wasmTierUpThreshold, uint32_t(INT32_MAX));
 
   Log(cx, "available wasm compilers: tier1=%s tier2=%s",
       baseline ? "baseline" : "none",
@@ -442,7 +460,8 @@ CompilerEnvironment::CompilerEnvironment(CompileMode mode, Tier tier,
       gcTypes_(gcTypesConfigured),
       multiValues_(multiValueConfigured),
       hugeMemory_(hugeMemory),
-      v128_(v128Configured) {}
+      v128_(v128Configured),
+      tierUpThreshold_(0) {}
 
 void CompilerEnvironment::computeParameters() {
   MOZ_ASSERT(state_ == InitialWithModeTierDebug);
@@ -468,6 +487,7 @@ void CompilerEnvironment::computeParameters(Decoder& d) {
   bool hugeMemory = args_->hugeMemory;
   bool multiValuesEnabled = args_->multiValuesEnabled;
   bool v128Enabled = args_->v128Enabled;
+  uint32_t tierUpThreshold = args_->tierUpThreshold;
 
   bool hasSecondTier = ionEnabled || craneliftEnabled;
   MOZ_ASSERT_IF(debugEnabled, baselineEnabled);
@@ -503,6 +523,7 @@ void CompilerEnvironment::computeParameters(Decoder& d) {
   hugeMemory_ = hugeMemory;
   multiValues_ = multiValuesEnabled;
   v128_ = v128Enabled;
+  tierUpThreshold_ = mode_ == CompileMode::Tier1 ? tierUpThreshold : 0;
 
   state_ = Computed;
 }
@@ -571,6 +592,15 @@ SharedModule wasm::CompileBuffer(const CompileArgs& args,
                                  UniqueChars* error,
                                  UniqueCharsVector* warnings,
                                  JS::OptimizedEncodingListener* listener) {
+  // An embedding that supplies its own listener does its own caching.
+  Tier2Listener cacheListener;
+  if (!listener && CodeCacheEnabled()) {
+    if (SharedModule module = LookupCodeCache(args, bytecode, &cacheListener)) {
+      return module;
+    }
+    listener = cacheListener;
+  }
+
   Decoder d(bytecode.bytes, 0, error, warnings);
 
   CompilerEnvironment compilerEnv(args);
@@ -597,8 +627,16 @@ SharedModule wasm::CompileBuffer(const CompileArgs& args,
   return mg.finishModule(bytecode, listener);
 }
 
-void wasm::CompileTier2(const CompileArgs& args, const Bytes& bytecode,
-                        const Module& module, Atomic<bool>* cancelled) {
+// Compile the second tier, either of the whole module, which is then added to
+// |module|, or, for lazy tiering, of the functions selected by |hotFuncs|,
+// which is then added to |code|. Returns false if the tier wasn't added.
+static bool CompileTier2Impl(const CompileArgs& args, const Bytes& bytecode,
+                             const Module* module, const Code* code,
+                             const HotFuncVector* hotFuncs,
+                             Atomic<bool>* cancelled) {
+  MOZ_ASSERT(!!module != !!code);
+  MOZ_ASSERT(!!code == !!hotFuncs);
+
   UniqueChars error;
   Decoder d(bytecode, 0, &error);
 
@@ -624,43 +662,199 @@ void wasm::CompileTier2(const CompileArgs& args, const Bytes& bytecode,
                                           ? Shareable::True
                                           : Shareable::False);
   if (!DecodeModuleEnvironment(d, &env)) {
-    return;
+    return false;
   }
 
   ModuleGenerator mg(args, &env, cancelled, &error);
   if (!mg.init()) {
-    return;
+    return false;
   }
 
+  mg.setHotFuncs(hotFuncs);
+
   if (!DecodeCodeSection(env, d, mg)) {
-    return;
+    return false;
   }
 
   if (!DecodeModuleTail(d, &env)) {
-    return;
+    return false;
   }
 
-  if (!mg.finishTier2(module)) {
-    return;
+  if (module) {
+    if (!mg.finishTier2(*module)) {
+      return false;
+    }
+  } else {
+    bool firstBatch = !code->hasTier2();
+    if (!mg.finishLazyTier2(*code)) {
+      return false;
+    }
+
+    uint32_t optimizedFuncs =
+        uint32_t(env.numFuncDefs() - mg.numForwardedFuncs());
+    LazyTier2Finished++;
+    LazyTier2OptimizedFuncs += optimizedFuncs;
+    LazyTier2OptimizedBytes += mg.optimizedBytecode();
+    LazyTier2CompileTimeUs += uint64_t(mg.compileTime().ToMicroseconds());
+
+    // The forwarded counters are of functions still running tier-1 code: all
+    // those the first batch didn't optimize, less those optimized later.
+    if (firstBatch) {
+      LazyTier2ForwardedFuncs += mg.numForwardedFuncs();
+      LazyTier2ForwardedBytes += mg.forwardedBytecode();
+    } else {
+      LazyTier2ForwardedFuncs -= optimizedFuncs;
+      LazyTier2ForwardedBytes -= mg.optimizedBytecode();
+    }
   }
 
+  return true;
+}
+
+void wasm::CompileTier2(const CompileArgs& args, const Bytes& bytecode,
+                        const Module& module, Atomic<bool>* cancelled) {
   // The caller doesn't care about success or failure; only that compilation
   // is inactive, so there is no success to return here.
+  mozilla::Unused << CompileTier2Impl(args, bytecode, &module, nullptr,
+                                      nullptr, cancelled);
+}
+
+static void StartLazyTier2Batch(const Code& code,
+                                const AutoLockHelperThreadState& lock);
+
+namespace {
+
+class LazyTier2GeneratorTask : public Tier2GeneratorTask {
+  SharedCompileArgs compileArgs_;
+  SharedBytes bytecode_;
+  SharedCode code_;
+  HotFuncVector hotFuncs_;
+  Atomic<bool> cancelled_;
+
+ public:
+  LazyTier2GeneratorTask(SharedCompileArgs compileArgs, SharedBytes bytecode,
+                         const Code& code, HotFuncVector&& hotFuncs)
+      : compileArgs_(std::move(compileArgs)),
+        bytecode_(std::move(bytecode)),
+        code_(&code),
+        hotFuncs_(std::move(hotFuncs)),
+        cancelled_(false) {}
+
+  void cancel() override { cancelled_ = true; }
+
+  void runTaskLocked(AutoLockHelperThreadState& locked) override {
+    bool succeeded;
+    {
+      AutoUnlockHelperThreadState unlock(locked);
+      succeeded = CompileTier2Impl(*compileArgs_, bytecode_->bytes, nullptr,
+                                   code_, &hotFuncs_, &cancelled_);
+    }
+    if (!succeeded && !cancelled_) {
+      LazyTier2Failed++;
+    }
+
+    // Functions that got hot while this batch was being compiled couldn't
+    // start a batch of their own, so start the next one now. Cancellation
+    // sets cancelled_ with the lock held, so no batch starts after it.
+    code_->finishLazyTier2Batch(hotFuncs_, succeeded);
+    if (!cancelled_) {
+      StartLazyTier2Batch(*code_, locked);
+    }
+
+    // See Module::Tier2GeneratorTaskImpl::runTaskLocked.
+    HelperThreadState().incWasmTier2GeneratorsFinished(locked);
+
+    // The task is finished, release it.
+    js_delete(this);
+  }
+
+  ThreadType threadType() override {
+    return ThreadType::THREAD_TYPE_WASM_TIER2;
+  }
+};
+
+}  // namespace
+
+static void StartLazyTier2Batch(const Code& code,
+                                const AutoLockHelperThreadState& lock) {
+  // Functions that have used up some of their counter are likely to get hot
+  // soon, so they go in the same batch as the ones that already are.
+  int32_t threshold = code.jumpTables().hotnessThreshold();
+  int32_t warmCounter = threshold - std::max(threshold / WarmFraction, 1);
+
+  SharedCompileArgs args;
+  SharedBytes bytecode;
+  HotFuncVector hotFuncs;
+  if (!code.claimLazyTier2Batch(warmCounter, &args, &bytecode, &hotFuncs)) {
+    return;
+  }
+
+  auto task = MakeUnique<LazyTier2GeneratorTask>(
+      std::move(args), std::move(bytecode), code, std::move(hotFuncs));
+  if (!task) {
+    // The task was never constructed, so |hotFuncs| wasn't moved from.
+    LazyTier2Failed++;
+    code.finishLazyTier2Batch(hotFuncs, false);
+    return;
+  }
+
+  LazyTier2Started++;
+  StartOffThreadWasmTier2Generator(std::move(task), lock);
+}
+
+void wasm::NoteHotFunction(const Code& code, uint32_t funcIndex) {
+  const JumpTables& jumpTables = code.jumpTables();
+  int32_t* counters = jumpTables.hotness();
+  MOZ_ASSERT(counters && funcIndex < jumpTables.numFuncs());
+
+  // Don't trap again for this function.
+  counters[funcIndex] = INT32_MAX;
+  LazyTier2HotFuncs++;
+
+  code.noteLazyTier2HotFunction(funcIndex);
+
+  AutoLockHelperThreadState lock;
+  StartLazyTier2Batch(code, lock);
+}
+
+LazyTieringStats wasm::GetLazyTieringStats() {
+  LazyTieringStats stats;
+  stats.hotFuncs = LazyTier2HotFuncs;
+  stats.started = LazyTier2Started;
+  stats.finished = LazyTier2Finished;
+  stats.failed = LazyTier2Failed;
+  stats.maxBatches = Code::MaxLazyTier2Batches;
+  stats.optimizedFuncs = LazyTier2OptimizedFuncs;
+  stats.forwardedFuncs = LazyTier2ForwardedFuncs;
+  stats.optimizedBytes = LazyTier2OptimizedBytes;
+  stats.forwardedBytes = LazyTier2ForwardedBytes;
+  stats.compileTimeUs = LazyTier2CompileTimeUs;
+
+  // Estimate the time that optimizing the forwarded functions would have
+  // taken from the bytecode sizes: compile time is roughly linear in them.
+  stats.savedTimeUs = 0;
+  if (stats.optimizedBytes > 0) {
+    stats.savedTimeUs = uint64_t(double(stats.compileTimeUs) *
+                                 stats.forwardedBytes / stats.optimizedBytes);
+  }
+  return stats;
 }
 
 class StreamingDecoder {
   Decoder d_;
   const ExclusiveBytesPtr& codeBytesEnd_;
   const Atomic<bool>& cancelled_;
+  ModuleGenerator& mg_;
 
  public:
   StreamingDecoder(const ModuleEnvironment& env, const Bytes& begin,
                    const ExclusiveBytesPtr& codeBytesEnd,
-                   const Atomic<bool>& cancelled, UniqueChars* error,
-                   UniqueCharsVector* warnings)
+                   const Atomic<bool>& cancelled, ModuleGenerator& mg,
+                   UniqueChars* error, UniqueCharsVector* warnings)
       : d_(begin, env.codeSection->start, error, warnings),
         codeBytesEnd_(codeBytesEnd),
-        cancelled_(cancelled) {}
+        cancelled_(cancelled),
+        mg_(mg) {}
 
   bool fail(const char* msg) { return d_.fail(msg); }
 
@@ -671,6 +865,15 @@ class StreamingDecoder {
   bool waitForBytes(size_t numBytes) {
     numBytes = std::min(numBytes, d_.bytesRemain());
     const uint8_t* requiredEnd = d_.currentPosition() + numBytes;
+
+    // Don't leave the functions decoded so far waiting in a partial batch
+    // while the stream stalls. This is done without holding the lock, which
+    // the thread supplying the bytes needs.
+    bool available = codeBytesEnd_.lock() >= requiredEnd;
+    if (!available && !mg_.launchPartialBatch()) {
+      return false;
+    }
+
     auto codeBytesEnd = codeBytesEnd_.lock();
     while (codeBytesEnd < requiredEnd) {
       if (cancelled_) {
@@ -754,9 +957,10 @@ SharedModule wasm::CompileStreaming(
   if (!mg.init()) {
     return nullptr;
   }
+  mg.setStreaming();
 
   {
-    StreamingDecoder d(env, codeBytes, codeBytesEnd, cancelled, error,
+    StreamingDecoder d(env, codeBytes, codeBytesEnd, cancelled, mg, error,
                        warnings);
 
     if (!DecodeCodeSection(env, d, mg)) {
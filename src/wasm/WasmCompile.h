@@ -62,6 +62,12 @@ struct CompileArgs : ShareableBase<CompileArgs> {
   bool multiValuesEnabled;
   bool v128Enabled;
 
+  // When nonzero and compiling in two tiers, tier-2 compilation doesn't start
+  // right away but once some function has been called or has iterated a loop
+  // this many times, and only the functions that are warm by then are
+  // compiled by the optimizing compiler.
+  uint32_t tierUpThreshold;
+
   // CompileArgs has two constructors:
   //
   // - one through a factory function `build`, which checks that flags are
@@ -86,7 +92,8 @@ struct CompileArgs : ShareableBase<CompileArgs> {
         gcEnabled(false),
         hugeMemory(false),
         multiValuesEnabled(false),
-        v128Enabled(false) {}
+        v128Enabled(false),
+        tierUpThreshold(0) {}
 };
 
 // Return the estimated compiled (machine) code size for the given bytecode size
@@ -110,6 +117,37 @@ SharedModule CompileBuffer(const CompileArgs& args,
 void CompileTier2(const CompileArgs& args, const Bytes& bytecode,
                   const Module& module, Atomic<bool>* cancelled);
 
+// With lazy tiering (CompileArgs::tierUpThreshold), called when the hotness
+// counter of the tier-1 function |funcIndex| has run out. Unless a batch is
+// already being compiled for the Code, this starts the background compilation
+// of a batch of tier-2 code in which the functions that are hot or warm by
+// then are optimized; the others keep running their tier-1 code. Functions
+// that get hot while a batch is being compiled go in the next one, which
+// starts when that batch is done.
+
+void NoteHotFunction(const Code& code, uint32_t funcIndex);
+
+// Counters for lazy tier-2 compilation, summed over all modules. started and
+// finished count batches. The forwarded functions are those still running
+// tier-1 code. The time saved is an estimate, from bytecode sizes, of what
+// optimizing them would have cost.
+
+struct LazyTieringStats {
+  uint32_t hotFuncs;
+  uint32_t started;
+  uint32_t finished;
+  uint32_t failed;
+  uint32_t maxBatches;
+  uint32_t optimizedFuncs;
+  uint32_t forwardedFuncs;
+  uint64_t optimizedBytes;
+  uint64_t forwardedBytes;
+  uint64_t compileTimeUs;
+  uint64_t savedTimeUs;
+};
+
+LazyTieringStats GetLazyTieringStats();
+
 // Compile the given WebAssembly module which has been broken into three
 // partitions:
 //  - envBytes contains a complete ModuleEnvironment that has already been
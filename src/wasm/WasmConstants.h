@@ -124,6 +124,11 @@ enum class Trap {
   // CheckForInterrupt(). This trap is resumable.
   CheckInterrupt,
 
+  // With lazy tiering, the hotness counter of a baseline function has run
+  // out and the engine should consider compiling it at tier-2. This trap is
+  // resumable.
+  TierUp,
+
   // Signal an error that was reported in C++ code.
   ThrowReported,
 
@@ -591,7 +596,7 @@ enum class SimdOp {
   I32x4MinU = 0xb7,
   I32x4MaxS = 0xb8,
   I32x4MaxU = 0xb9,
-  // AvgrS = 0xba
+  I32x4DotSI16x8 = 0xba,
   // AvgrU = 0xbb
   // Unused = 0xbc
   // Unused = 0xbd
@@ -639,8 +644,8 @@ enum class SimdOp {
   F32x4Div = 0xe7,
   F32x4Min = 0xe8,
   F32x4Max = 0xe9,
-  // PMin = 0xea
-  // PMax = 0xeb
+  F32x4PMin = 0xea,
+  F32x4PMax = 0xeb,
   F64x2Abs = 0xec,
   F64x2Neg = 0xed,
   // Round = 0xee
@@ -651,8 +656,8 @@ enum class SimdOp {
   F64x2Div = 0xf3,
   F64x2Min = 0xf4,
   F64x2Max = 0xf5,
-  // PMin = 0xf6
-  // PMax = 0xf7
+  F64x2PMin = 0xf6,
+  F64x2PMax = 0xf7,
   I32x4TruncSSatF32x4 = 0xf8,
   I32x4TruncUSatF32x4 = 0xf9,
   F32x4ConvertSI32x4 = 0xfa,
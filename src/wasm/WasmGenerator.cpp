@@ -42,6 +42,7 @@ using namespace js::wasm;
 
 using mozilla::CheckedInt;
 using mozilla::MakeEnumeratedRange;
+using mozilla::TimeStamp;
 using mozilla::Unused;
 
 bool CompiledCode::swap(MacroAssembler& masm) {
@@ -95,6 +96,11 @@ ModuleGenerator::ModuleGenerator(const CompileArgs& args,
       outstanding_(0),
       currentTask_(nullptr),
       batchedBytecode_(0),
+      helperThreads_(0),
+      streaming_(false),
+      hotFuncs_(nullptr),
+      optimizedBytecode_(0),
+      forwardedBytecode_(0),
       finishedFuncDefs_(false) {
   MOZ_ASSERT(IsCompilingWasm());
 }
@@ -429,7 +435,8 @@ bool ModuleGenerator::init(Metadata* maybeAsmJSMetadata) {
   uint32_t numTasks;
   if (CanUseExtraThreads() && threads.cpuCount > 1) {
     parallel_ = true;
-    numTasks = 2 * threads.maxWasmCompilationThreads();
+    helperThreads_ = threads.maxWasmCompilationThreads();
+    numTasks = 2 * helperThreads_;
   } else {
     numTasks = 1;
   }
@@ -736,6 +743,8 @@ static bool ExecuteCompileTask(CompileTask* task, UniqueChars* error) {
   MOZ_ASSERT(task->lifo.isEmpty());
   MOZ_ASSERT(task->output.empty());
 
+  TimeStamp start = TimeStamp::Now();
+
   switch (task->env.tier()) {
     case Tier::Optimized:
       switch (task->env.optimizedBackend()) {
@@ -764,6 +773,7 @@ static bool ExecuteCompileTask(CompileTask* task, UniqueChars* error) {
   MOZ_ASSERT(task->lifo.isEmpty());
   MOZ_ASSERT(task->inputs.length() == task->output.codeRanges.length());
   task->inputs.clear();
+  task->time = TimeStamp::Now() - start;
   return true;
 }
 
@@ -806,6 +816,7 @@ bool ModuleGenerator::finishTask(CompileTask* task) {
   }
 
   task->output.clear();
+  compileTime_ += task->time;
 
   MOZ_ASSERT(task->inputs.empty());
   MOZ_ASSERT(task->output.empty());
@@ -861,13 +872,37 @@ bool ModuleGenerator::finishOutstandingTask() {
   return finishTask(task);
 }
 
-bool ModuleGenerator::compileFuncDef(uint32_t funcIndex,
-                                     uint32_t lineOrBytecode,
-                                     const uint8_t* begin, const uint8_t* end,
-                                     Uint32Vector&& lineNums) {
-  MOZ_ASSERT(!finishedFuncDefs_);
-  MOZ_ASSERT(funcIndex < env_->numFuncs());
+bool ModuleGenerator::reapFinishedTasks() {
+  MOZ_ASSERT(parallel_);
+
+  while (outstanding_ > 0) {
+    CompileTask* task;
+    {
+      auto taskState = taskState_.lock();
+      if (taskState->numFailed > 0) {
+        return false;
+      }
+      if (taskState->finished.empty()) {
+        return true;
+      }
+      outstanding_--;
+      task = taskState->finished.popCopy();
+    }
+
+    // Call outside of the compilation lock.
+    if (!finishTask(task)) {
+      return false;
+    }
+  }
+
+  return true;
+}
 
+// Batches launched while streaming are never smaller than this, so that the
+// per-task overhead stays small relative to the compilation work.
+static const uint32_t MinStreamingBatchBytes = 200;
+
+uint32_t ModuleGenerator::batchThreshold() {
   uint32_t threshold;
   switch (tier()) {
     case Tier::Baseline:
@@ -890,8 +925,68 @@ bool ModuleGenerator::compileFuncDef(uint32_t funcIndex,
       break;
   }
 
+  // When streaming, a helper thread with no batch to compile is idle until
+  // the decoder has filled a batch, which can take a while when the bytes
+  // arrive slowly. Shrink batches while there are idle helper threads, and
+  // go back to the full threshold, which amortizes task overhead better, once
+  // they're all busy.
+  if (streaming_ && parallel_ && outstanding_ < helperThreads_) {
+    uint32_t idle = helperThreads_ - outstanding_;
+    threshold = std::max(threshold / (idle + 1),
+                         std::min(threshold, MinStreamingBatchBytes));
+  }
+
+  return threshold;
+}
+
+bool ModuleGenerator::launchPartialBatch() {
+  MOZ_ASSERT(streaming_);
+  MOZ_ASSERT(!finishedFuncDefs_);
+
+  if (!currentTask_ || currentTask_->inputs.empty()) {
+    return true;
+  }
+
+  // If every helper thread is busy the batch can keep filling up instead.
+  if (parallel_) {
+    if (!reapFinishedTasks()) {
+      return false;
+    }
+    if (outstanding_ >= helperThreads_) {
+      return true;
+    }
+  }
+
+  return launchBatchCompile();
+}
+
+bool ModuleGenerator::compileFuncDef(uint32_t funcIndex,
+                                     uint32_t lineOrBytecode,
+                                     const uint8_t* begin, const uint8_t* end,
+                                     Uint32Vector&& lineNums) {
+  MOZ_ASSERT(!finishedFuncDefs_);
+  MOZ_ASSERT(funcIndex < env_->numFuncs());
+
+  // Link the code of finished batches as they come in, so that the count of
+  // outstanding batches reflects the number of busy helper threads.
+  if (streaming_ && parallel_ && !reapFinishedTasks()) {
+    return false;
+  }
+
   uint32_t funcBytecodeLength = end - begin;
 
+  // For lazy tier-2 compilation, functions that aren't hot are given a
+  // forwarder to their tier-1 code once all functions have been compiled.
+  if (hotFuncs_) {
+    if (!(*hotFuncs_)[funcIndex]) {
+      forwardedBytecode_ += funcBytecodeLength;
+      return forwardedFuncs_.append(funcIndex);
+    }
+    optimizedBytecode_ += funcBytecodeLength;
+  }
+
+  uint32_t threshold = batchThreshold();
+
   // Do not go over the threshold if we can avoid it: spin off the compilation
   // before appending the function if we would go over.  (Very large single
   // functions may still exceed the threshold but this is fine; it'll be very
@@ -1023,6 +1118,25 @@ bool ModuleGenerator::finishMetadataTier() {
   return true;
 }
 
+bool ModuleGenerator::finishForwarders() {
+  MOZ_ASSERT(mode() == CompileMode::Tier2);
+  MOZ_ASSERT(!outstanding_);
+
+  CompiledCode& forwarderCode = tasks_[0].output;
+  MOZ_ASSERT(forwarderCode.empty());
+
+  if (!GenerateTier1Forwarders(*env_, forwardedFuncs_, &forwarderCode)) {
+    return false;
+  }
+
+  if (!linkCompiledCode(forwarderCode)) {
+    return false;
+  }
+
+  forwarderCode.clear();
+  return true;
+}
+
 UniqueCodeTier ModuleGenerator::finishCodeTier() {
   MOZ_ASSERT(finishedFuncDefs_);
 
@@ -1032,6 +1146,10 @@ UniqueCodeTier ModuleGenerator::finishCodeTier() {
     }
   }
 
+  if (!forwardedFuncs_.empty() && !finishForwarders()) {
+    return nullptr;
+  }
+
 #ifdef DEBUG
   for (uint32_t codeRangeIndex : metadataTier_->funcToCodeRange) {
     MOZ_ASSERT(codeRangeIndex != BAD_CODE_RANGE);
@@ -1157,6 +1275,10 @@ SharedModule ModuleGenerator::finishModule(
                        codeTier->metadata().codeRanges)) {
     return nullptr;
   }
+  if (env_->lazyTiering() &&
+      !jumpTables.initHotness(int32_t(env_->tierUpThreshold()))) {
+    return nullptr;
+  }
 
   // Copy over data from the Bytecode, which is going away at the end of
   // compilation.
@@ -1222,6 +1344,9 @@ SharedModule ModuleGenerator::finishModule(
   if (!code || !code->initialize(*linkData_)) {
     return nullptr;
   }
+  if (env_->lazyTiering() && !code->setLazyTier2(*compileArgs_, bytecode)) {
+    return nullptr;
+  }
 
   // See Module debugCodeClaimed_ comments for why we need to make a separate
   // debug copy.
@@ -1256,7 +1381,11 @@ SharedModule ModuleGenerator::finishModule(
     return nullptr;
   }
 
-  if (mode() == CompileMode::Tier1) {
+  // With lazy tiering, tier-2 compilation is started by NoteHotFunction()
+  // instead. It only optimizes some functions, so it isn't serialized and
+  // the listener isn't used.
+
+  if (mode() == CompileMode::Tier1 && !env_->lazyTiering()) {
     module->startTier2(*compileArgs_, bytecode, maybeTier2Listener);
   } else if (tier() == Tier::Serialized && maybeTier2Listener) {
     module->serialize(*linkData_, *maybeTier2Listener);
@@ -1288,6 +1417,27 @@ bool ModuleGenerator::finishTier2(const Module& module) {
   return module.finishTier2(*linkData_, std::move(codeTier));
 }
 
+bool ModuleGenerator::finishLazyTier2(const Code& code) {
+  MOZ_ASSERT(mode() == CompileMode::Tier2);
+  MOZ_ASSERT(tier() == Tier::Optimized);
+  MOZ_ASSERT(hotFuncs_);
+
+  if (cancelled_ && *cancelled_) {
+    return false;
+  }
+
+  UniqueCodeTier codeTier = finishCodeTier();
+  if (!codeTier) {
+    return false;
+  }
+
+  // The first batch becomes the optimized tier, later ones are added to it.
+  if (code.hasTier2()) {
+    return code.addLazyTier2Batch(*linkData_, std::move(codeTier), *hotFuncs_);
+  }
+  return code.finishTier2(*linkData_, std::move(codeTier), hotFuncs_);
+}
+
 void CompileTask::runTask() { ExecuteCompileTaskFromHelperThread(this); }
 
 size_t CompiledCode::sizeOfExcludingThis(
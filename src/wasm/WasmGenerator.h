@@ -20,6 +20,7 @@
 #define wasm_generator_h
 
 #include "mozilla/MemoryReporting.h"
+#include "mozilla/TimeStamp.h"
 
 #include "jit/MacroAssembler.h"
 #include "wasm/WasmCompile.h"
@@ -130,6 +131,7 @@ struct CompileTask : public RunnableTask {
   LifoAlloc lifo;
   FuncCompileInputVector inputs;
   CompiledCode output;
+  mozilla::TimeDuration time;
 
   CompileTask(const ModuleEnvironment& env, ExclusiveCompileTaskState& state,
               size_t defaultChunkSize)
@@ -191,6 +193,15 @@ class MOZ_STACK_CLASS ModuleGenerator {
   CompileTaskPtrVector freeTasks_;
   CompileTask* currentTask_;
   uint32_t batchedBytecode_;
+  uint32_t helperThreads_;
+  bool streaming_;
+
+  // Lazy tier-2 compilation
+  const HotFuncVector* hotFuncs_;
+  Uint32Vector forwardedFuncs_;
+  uint64_t optimizedBytecode_;
+  uint64_t forwardedBytecode_;
+  mozilla::TimeDuration compileTime_;
 
   // Assertions
   DebugOnly<bool> finishedFuncDefs_;
@@ -207,8 +218,11 @@ class MOZ_STACK_CLASS ModuleGenerator {
   bool finishTask(CompileTask* task);
   bool launchBatchCompile();
   bool finishOutstandingTask();
+  bool reapFinishedTasks();
+  uint32_t batchThreshold();
   bool finishCodegen();
   bool finishMetadataTier();
+  bool finishForwarders();
   UniqueCodeTier finishCodeTier();
   SharedMetadata finishMetadata(const Bytes& bytecode);
 
@@ -230,6 +244,28 @@ class MOZ_STACK_CLASS ModuleGenerator {
       uint32_t funcIndex, uint32_t lineOrBytecode, const uint8_t* begin,
       const uint8_t* end, Uint32Vector&& callSiteLineNums = Uint32Vector());
 
+  // Streaming compilation calls setStreaming() before the first
+  // compileFuncDef(). Batches are then sized by the number of idle helper
+  // threads, and launchPartialBatch() is called when the decoder is about to
+  // wait for more bytes, so that the functions decoded so far are compiled
+  // while the stream is stalled.
+
+  void setStreaming() { streaming_ = true; }
+  MOZ_MUST_USE bool launchPartialBatch();
+
+  // Lazy tier-2 compilation calls setHotFuncs() before the first
+  // compileFuncDef(). Only the selected functions are then compiled; the
+  // others get a forwarder that jumps to their tier-1 code.
+
+  void setHotFuncs(const HotFuncVector* hotFuncs) { hotFuncs_ = hotFuncs; }
+  uint32_t numForwardedFuncs() const { return forwardedFuncs_.length(); }
+  uint64_t optimizedBytecode() const { return optimizedBytecode_; }
+  uint64_t forwardedBytecode() const { return forwardedBytecode_; }
+
+  // The time spent compiling function bodies, summed over all threads.
+
+  mozilla::TimeDuration compileTime() const { return compileTime_; }
+
   // Must be called after the last compileFuncDef() and before finishModule()
   // or finishTier2().
 
@@ -237,12 +273,14 @@ class MOZ_STACK_CLASS ModuleGenerator {
 
   // If env->mode is Once or Tier1, finishModule() must be called to generate
   // a new Module. Otherwise, if env->mode is Tier2, finishTier2() must be
-  // called to augment the given Module with tier 2 code.
+  // called to augment the given Module with tier 2 code, or, for lazy tier-2
+  // compilation, finishLazyTier2() to augment the given Code.
 
   SharedModule finishModule(
       const ShareableBytes& bytecode,
       JS::OptimizedEncodingListener* maybeTier2Listener = nullptr);
   MOZ_MUST_USE bool finishTier2(const Module& module);
+  MOZ_MUST_USE bool finishLazyTier2(const Code& code);
 };
 
 }  // namespace wasm
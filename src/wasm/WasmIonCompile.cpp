@@ -3372,16 +3372,42 @@ static bool EmitMemCopyCall(FunctionCompiler& f, MDefinition* dst,
   return f.builtinInstanceMethodCall(callee, lineOrBytecode, args);
 }
 
+// Whether inline copies and fills can move 16 bytes per access.
+static bool UseSimdMemoryTransfers(FunctionCompiler& f) {
+#if defined(ENABLE_WASM_SIMD) && defined(JS_CODEGEN_X64)
+  return f.env().v128Enabled();
+#else
+  return false;
+#endif
+}
+
+static uint32_t MaxInlineMemoryCopyLengthFor(FunctionCompiler& f) {
+  return UseSimdMemoryTransfers(f) ? MaxInlineMemoryCopyLengthSimd
+                                   : MaxInlineMemoryCopyLength;
+}
+
+static uint32_t MaxInlineMemoryFillLengthFor(FunctionCompiler& f) {
+  return UseSimdMemoryTransfers(f) ? MaxInlineMemoryFillLengthSimd
+                                   : MaxInlineMemoryFillLength;
+}
+
 static bool EmitMemCopyInline(FunctionCompiler& f, MDefinition* dst,
                               MDefinition* src, MDefinition* len) {
   MOZ_ASSERT(MaxInlineMemoryCopyLength != 0);
 
   MOZ_ASSERT(len->isConstant() && len->type() == MIRType::Int32);
   uint32_t length = len->toConstant()->toInt32();
-  MOZ_ASSERT(length != 0 && length <= MaxInlineMemoryCopyLength);
+  MOZ_ASSERT(length != 0 && length <= MaxInlineMemoryCopyLengthFor(f));
 
   // Compute the number of copies of each width we will need to do
   size_t remainder = length;
+#ifdef ENABLE_WASM_SIMD
+  size_t numCopies16 = 0;
+  if (UseSimdMemoryTransfers(f)) {
+    numCopies16 = remainder / sizeof(V128);
+    remainder %= sizeof(V128);
+  }
+#endif
 #ifdef JS_64BIT
   size_t numCopies8 = remainder / sizeof(uint64_t);
   remainder %= sizeof(uint64_t);
@@ -3398,6 +3424,18 @@ static bool EmitMemCopyInline(FunctionCompiler& f, MDefinition* dst,
   size_t offset = 0;
   DefVector loadedValues;
 
+#ifdef ENABLE_WASM_SIMD
+  for (uint32_t i = 0; i < numCopies16; i++) {
+    MemoryAccessDesc access(Scalar::Simd128, 1, offset, f.bytecodeOffset());
+    auto* load = f.load(src, &access, ValType::V128);
+    if (!load || !loadedValues.append(load)) {
+      return false;
+    }
+
+    offset += sizeof(V128);
+  }
+#endif
+
 #ifdef JS_64BIT
   for (uint32_t i = 0; i < numCopies8; i++) {
     MemoryAccessDesc access(Scalar::Int64, 1, offset, f.bytecodeOffset());
@@ -3477,6 +3515,16 @@ static bool EmitMemCopyInline(FunctionCompiler& f, MDefinition* dst,
   }
 #endif
 
+#ifdef ENABLE_WASM_SIMD
+  for (uint32_t i = 0; i < numCopies16; i++) {
+    offset -= sizeof(V128);
+
+    MemoryAccessDesc access(Scalar::Simd128, 1, offset, f.bytecodeOffset());
+    auto* value = loadedValues.popCopy();
+    f.store(dst, &access, value);
+  }
+#endif
+
   return true;
 }
 
@@ -3495,7 +3543,8 @@ static bool EmitMemCopy(FunctionCompiler& f) {
 
   if (MacroAssembler::SupportsFastUnalignedAccesses() && len->isConstant() &&
       len->type() == MIRType::Int32 && len->toConstant()->toInt32() != 0 &&
-      uint32_t(len->toConstant()->toInt32()) <= MaxInlineMemoryCopyLength) {
+      uint32_t(len->toConstant()->toInt32()) <=
+          MaxInlineMemoryCopyLengthFor(f)) {
     return EmitMemCopyInline(f, dst, src, len);
   }
   return EmitMemCopyCall(f, dst, src, len);
@@ -3620,15 +3669,20 @@ static bool EmitMemFillInline(FunctionCompiler& f, MDefinition* start,
                               MDefinition* val, MDefinition* len) {
   MOZ_ASSERT(MaxInlineMemoryFillLength != 0);
 
-  MOZ_ASSERT(len->isConstant() && len->type() == MIRType::Int32 &&
-             val->isConstant() && val->type() == MIRType::Int32);
+  MOZ_ASSERT(len->isConstant() && len->type() == MIRType::Int32);
 
   uint32_t length = len->toConstant()->toInt32();
-  uint32_t value = val->toConstant()->toInt32();
-  MOZ_ASSERT(length != 0 && length <= MaxInlineMemoryFillLength);
+  MOZ_ASSERT(length != 0 && length <= MaxInlineMemoryFillLengthFor(f));
 
   // Compute the number of copies of each width we will need to do
   size_t remainder = length;
+#ifdef ENABLE_WASM_SIMD
+  size_t numCopies16 = 0;
+  if (UseSimdMemoryTransfers(f)) {
+    numCopies16 = remainder / sizeof(V128);
+    remainder %= sizeof(V128);
+  }
+#endif
 #ifdef JS_64BIT
   size_t numCopies8 = remainder / sizeof(uint64_t);
   remainder %= sizeof(uint64_t);
@@ -3639,20 +3693,62 @@ static bool EmitMemFillInline(FunctionCompiler& f, MDefinition* start,
   remainder %= sizeof(uint16_t);
   size_t numCopies1 = remainder;
 
-  // Generate splatted definitions for wider fills as needed
+  // Generate splatted definitions for wider fills as needed. Narrow stores
+  // only write the low bytes of their value, so |val| itself serves for
+  // single bytes, and the 4-byte splat for two bytes.
+#ifdef ENABLE_WASM_SIMD
+  MDefinition* val16 = nullptr;
+#endif
+#ifdef JS_64BIT
+  MDefinition* val8 = nullptr;
+#endif
+  MDefinition* val4 = nullptr;
+  MDefinition* val2 = nullptr;
+
+  if (val->isConstant()) {
+    uint32_t value = val->toConstant()->toInt32();
+#ifdef ENABLE_WASM_SIMD
+    if (numCopies16) {
+      V128 splat;
+      memset(splat.bytes, uint8_t(value), sizeof(splat.bytes));
+      val16 = f.constant(splat);
+    }
+#endif
+#ifdef JS_64BIT
+    if (numCopies8) {
+      val8 = f.constant(int64_t(SplatByteToUInt<uint64_t>(value, 8)));
+    }
+#endif
+    if (numCopies4) {
+      val4 = f.constant(Int32Value(SplatByteToUInt<uint32_t>(value, 4)),
+                        MIRType::Int32);
+    }
+    if (numCopies2) {
+      val2 = f.constant(Int32Value(SplatByteToUInt<uint32_t>(value, 2)),
+                        MIRType::Int32);
+    }
+  } else {
+    // Splat the low byte of the value by multiplying it with 0x01..01.
+    MDefinition* byte = f.binary<MBitAnd>(
+        val, f.constant(Int32Value(0xff), MIRType::Int32), MIRType::Int32);
+#ifdef ENABLE_WASM_SIMD
+    if (numCopies16) {
+      val16 = f.scalarToSimd128(val, SimdOp::I8x16Splat);
+    }
+#endif
 #ifdef JS_64BIT
-  MDefinition* val8 =
-      numCopies8 ? f.constant(int64_t(SplatByteToUInt<uint64_t>(value, 8)))
-                 : nullptr;
+    if (numCopies8) {
+      val8 = f.mul(f.extendI32(byte, /* isUnsigned = */ true),
+                   f.constant(int64_t(0x0101010101010101)), MIRType::Int64,
+                   MMul::Normal);
+    }
 #endif
-  MDefinition* val4 =
-      numCopies4 ? f.constant(Int32Value(SplatByteToUInt<uint32_t>(value, 4)),
-                              MIRType::Int32)
-                 : nullptr;
-  MDefinition* val2 =
-      numCopies2 ? f.constant(Int32Value(SplatByteToUInt<uint32_t>(value, 2)),
-                              MIRType::Int32)
-                 : nullptr;
+    if (numCopies4 || numCopies2) {
+      val4 = f.mul(byte, f.constant(Int32Value(0x01010101), MIRType::Int32),
+                   MIRType::Int32, MMul::Integer);
+      val2 = val4;
+    }
+  }
 
   // Store the fill value to the destination from high to low. We will trap
   // without writing anything on the first store if any dest byte is
@@ -3689,6 +3785,15 @@ static bool EmitMemFillInline(FunctionCompiler& f, MDefinition* start,
   }
 #endif
 
+#ifdef ENABLE_WASM_SIMD
+  for (uint32_t i = 0; i < numCopies16; i++) {
+    offset -= sizeof(V128);
+
+    MemoryAccessDesc access(Scalar::Simd128, 1, offset, f.bytecodeOffset());
+    f.store(start, &access, val16);
+  }
+#endif
+
   return true;
 }
 
@@ -3702,10 +3807,11 @@ static bool EmitMemFill(FunctionCompiler& f) {
     return true;
   }
 
+  // The fill value needn't be constant: it's splatted at run time otherwise.
   if (MacroAssembler::SupportsFastUnalignedAccesses() && len->isConstant() &&
       len->type() == MIRType::Int32 && len->toConstant()->toInt32() != 0 &&
-      uint32_t(len->toConstant()->toInt32()) <= MaxInlineMemoryFillLength &&
-      val->isConstant() && val->type() == MIRType::Int32) {
+      uint32_t(len->toConstant()->toInt32()) <=
+          MaxInlineMemoryFillLengthFor(f)) {
     return EmitMemFillInline(f, start, val, len);
   }
   return EmitMemFillCall(f, start, val, len);
@@ -4736,6 +4842,7 @@ static bool EmitBodyExprs(FunctionCompiler& f) {
           case uint32_t(SimdOp::F64x2Mul):
           case uint32_t(SimdOp::F64x2Min):
           case uint32_t(SimdOp::F64x2Max):
+          case uint32_t(SimdOp::I32x4DotSI16x8):
           case uint32_t(SimdOp::I8x16Eq):
           case uint32_t(SimdOp::I8x16Ne):
           case uint32_t(SimdOp::I16x8Eq):
@@ -4748,6 +4855,10 @@ static bool EmitBodyExprs(FunctionCompiler& f) {
           case uint32_t(SimdOp::F64x2Ne):
             CHECK(EmitBinarySimd128(f, /* commutative= */ true, SimdOp(op.b1)));
           case uint32_t(SimdOp::V128AndNot):
+          case uint32_t(SimdOp::F32x4PMin):
+          case uint32_t(SimdOp::F32x4PMax):
+          case uint32_t(SimdOp::F64x2PMin):
+          case uint32_t(SimdOp::F64x2PMax):
           case uint32_t(SimdOp::I8x16Sub):
           case uint32_t(SimdOp::I8x16SubSaturateS):
           case uint32_t(SimdOp::I8x16SubSaturateU):
@@ -112,76 +112,10 @@ void Module::startTier2(const CompileArgs& args, const ShareableBytes& bytecode,
 
 bool Module::finishTier2(const LinkData& linkData2,
                          UniqueCodeTier code2) const {
-  MOZ_ASSERT(code().bestTier() == Tier::Baseline &&
-             code2->tier() == Tier::Optimized);
-
-  // Install the data in the data structures. They will not be visible
-  // until commitTier2().
-
-  if (!code().setTier2(std::move(code2), linkData2)) {
+  if (!code().finishTier2(linkData2, std::move(code2))) {
     return false;
   }
 
-  // Before we can make tier-2 live, we need to compile tier2 versions of any
-  // extant tier1 lazy stubs (otherwise, tiering would break the assumption
-  // that any extant exported wasm function has had a lazy entry stub already
-  // compiled for it).
-  {
-    // We need to prevent new tier1 stubs generation until we've committed
-    // the newer tier2 stubs, otherwise we might not generate one tier2
-    // stub that has been generated for tier1 before we committed.
-
-    const MetadataTier& metadataTier1 = metadata(Tier::Baseline);
-
-    auto stubs1 = code().codeTier(Tier::Baseline).lazyStubs().lock();
-    auto stubs2 = code().codeTier(Tier::Optimized).lazyStubs().lock();
-
-    MOZ_ASSERT(stubs2->empty());
-
-    Uint32Vector funcExportIndices;
-    for (size_t i = 0; i < metadataTier1.funcExports.length(); i++) {
-      const FuncExport& fe = metadataTier1.funcExports[i];
-      if (fe.hasEagerStubs()) {
-        continue;
-      }
-      if (!stubs1->hasStub(fe.funcIndex())) {
-        continue;
-      }
-      if (!funcExportIndices.emplaceBack(i)) {
-        return false;
-      }
-    }
-
-    const CodeTier& tier2 = code().codeTier(Tier::Optimized);
-
-    Maybe<size_t> stub2Index;
-    if (!stubs2->createTier2(funcExportIndices, tier2, &stub2Index)) {
-      return false;
-    }
-
-    // Now that we can't fail or otherwise abort tier2, make it live.
-
-    MOZ_ASSERT(!code().hasTier2());
-    code().commitTier2();
-
-    stubs2->setJitEntries(stub2Index, code());
-  }
-
-  // And we update the jump vector.
-
-  uint8_t* base = code().segment(Tier::Optimized).base();
-  for (const CodeRange& cr : metadata(Tier::Optimized).codeRanges) {
-    // These are racy writes that we just want to be visible, atomically,
-    // eventually.  All hardware we care about will do this right.  But
-    // we depend on the compiler not splitting the stores hidden inside the
-    // set*Entry functions.
-    if (cr.isFunction()) {
-      code().setTieringEntry(cr.funcIndex(), base + cr.funcTierEntry());
-    } else if (cr.isJitEntry()) {
-      code().setJitEntry(cr.funcIndex(), base + cr.begin());
-    }
-  }
-
   // Tier-2 is done; let everyone know. Mark tier-2 active for testing
   // purposes so that wasmHasTier2CompilationCompleted() only returns true
   // after tier-2 has been fully cached.
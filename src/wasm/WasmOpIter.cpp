@@ -416,6 +416,11 @@ OpKind wasm::Classify(OpBytes op) {
         case SimdOp::F64x2Div:
         case SimdOp::F64x2Min:
         case SimdOp::F64x2Max:
+        case SimdOp::F32x4PMin:
+        case SimdOp::F32x4PMax:
+        case SimdOp::F64x2PMin:
+        case SimdOp::F64x2PMax:
+        case SimdOp::I32x4DotSI16x8:
         case SimdOp::I8x16NarrowSI16x8:
         case SimdOp::I8x16NarrowUI16x8:
         case SimdOp::I16x8NarrowSI32x4:
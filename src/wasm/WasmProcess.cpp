@@ -29,6 +29,7 @@
 #endif
 #include "wasm/WasmBuiltins.h"
 #include "wasm/WasmCode.h"
+#include "wasm/WasmCodeCache.h"
 #include "wasm/WasmInstance.h"
 
 using namespace js;
@@ -403,5 +404,6 @@ void wasm::ShutDown() {
   }
 
   ReleaseBuiltinThunks();
+  ShutDownCodeCache();
   js_delete(map);
 }
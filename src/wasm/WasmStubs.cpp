@@ -1956,6 +1956,48 @@ bool wasm::GenerateImportFunctions(const ModuleEnvironment& env,
   return code->swap(masm);
 }
 
+// Generate a tier-2 function for a function that lazy tier-2 compilation
+// didn't optimize. It's a tier-1 style prologue: after frame setup it jumps
+// through the tiering jump table, whose entry for this function keeps
+// pointing into the function's tier-1 code, which then runs with the frame
+// set up here. The epilogue is never reached but completes the offsets.
+static bool GenerateTier1Forwarder(MacroAssembler& masm, uint32_t funcIndex,
+                                   FuncTypeIdDesc funcTypeId,
+                                   FuncOffsets* offsets) {
+  AssertExpectedSP(masm);
+
+  GenerateFunctionPrologue(masm, funcTypeId, Some(funcIndex), offsets);
+  GenerateFunctionEpilogue(masm, 0, offsets);
+  return FinishOffsets(masm, offsets);
+}
+
+bool wasm::GenerateTier1Forwarders(const ModuleEnvironment& env,
+                                   const Uint32Vector& funcIndices,
+                                   CompiledCode* code) {
+  LifoAlloc lifo(STUBS_LIFO_DEFAULT_CHUNK_SIZE);
+  TempAllocator alloc(&lifo);
+  WasmMacroAssembler masm(alloc);
+
+  for (uint32_t funcIndex : funcIndices) {
+    FuncOffsets offsets;
+    if (!GenerateTier1Forwarder(masm, funcIndex, env.funcTypes[funcIndex]->id,
+                                &offsets)) {
+      return false;
+    }
+    if (!code->codeRanges.emplaceBack(funcIndex, /* bytecodeOffset = */ 0,
+                                      offsets)) {
+      return false;
+    }
+  }
+
+  masm.finish();
+  if (masm.oom()) {
+    return false;
+  }
+
+  return code->swap(masm);
+}
+
 // Generate a stub that is called via the internal ABI derived from the
 // signature of the import and calls into an appropriate callImport C++
 // function, having boxed all the ABI arguments into a homogeneous Value array.
@@ -251,6 +251,10 @@ extern bool GenerateImportFunctions(const ModuleEnvironment& env,
                                     const FuncImportVector& imports,
                                     CompiledCode* code);
 
+extern bool GenerateTier1Forwarders(const ModuleEnvironment& env,
+                                    const Uint32Vector& funcIndices,
+                                    CompiledCode* code);
+
 extern bool GenerateStubs(const ModuleEnvironment& env,
                           const FuncImportVector& imports,
                           const FuncExportVector& exports, CompiledCode* code);
@@ -2888,6 +2888,10 @@ struct TlsData {
   // baseline-compiled function.
   void** jumpTable;
 
+  // When tiering lazily, the hotness counters of the baseline-compiled
+  // functions, indexed by function index.
+  int32_t* hotnessCounters;
+
   // The globalArea must be the last field.  Globals for the module start here
   // and are inline in this structure.  16-byte alignment is required for SIMD
   // data.
@@ -3187,8 +3191,24 @@ static const uint32_t MaxInlineMemoryCopyLength = 0;
 static const uint32_t MaxInlineMemoryFillLength = 0;
 #endif
 
+// When the compiler can use SIMD, constant-length copies and fills move 16
+// bytes per access, which keeps them cheaper than the instance call up to
+// longer lengths.
+
+#if defined(ENABLE_WASM_SIMD) && defined(JS_CODEGEN_X64)
+static const uint32_t MaxInlineMemoryCopyLengthSimd = 256;
+static const uint32_t MaxInlineMemoryFillLengthSimd = 256;
+#else
+static const uint32_t MaxInlineMemoryCopyLengthSimd = MaxInlineMemoryCopyLength;
+static const uint32_t MaxInlineMemoryFillLengthSimd = MaxInlineMemoryFillLength;
+#endif
+
 static_assert(MaxInlineMemoryCopyLength < MinOffsetGuardLimit, "precondition");
 static_assert(MaxInlineMemoryFillLength < MinOffsetGuardLimit, "precondition");
+static_assert(MaxInlineMemoryCopyLengthSimd < MinOffsetGuardLimit,
+              "precondition");
+static_assert(MaxInlineMemoryFillLengthSimd < MinOffsetGuardLimit,
+              "precondition");
 
 // wasm::Frame represents the bytes pushed by the call instruction and the
 // fixed prologue generated by wasm::GenerateCallablePrologue.
@@ -1036,6 +1036,11 @@ static bool DecodeFunctionBodyExprs(const ModuleEnvironment& env,
           case uint32_t(SimdOp::F64x2Div):
           case uint32_t(SimdOp::F64x2Min):
           case uint32_t(SimdOp::F64x2Max):
+          case uint32_t(SimdOp::F32x4PMin):
+          case uint32_t(SimdOp::F32x4PMax):
+          case uint32_t(SimdOp::F64x2PMin):
+          case uint32_t(SimdOp::F64x2PMax):
+          case uint32_t(SimdOp::I32x4DotSI16x8):
           case uint32_t(SimdOp::I8x16NarrowSI16x8):
           case uint32_t(SimdOp::I8x16NarrowUI16x8):
           case uint32_t(SimdOp::I16x8NarrowSI32x4):
@@ -74,6 +74,7 @@ struct CompilerEnvironment {
       bool multiValues_;
       bool hugeMemory_;
       bool v128_;
+      uint32_t tierUpThreshold_;
     };
   };
 
@@ -136,6 +137,12 @@ struct CompilerEnvironment {
     MOZ_ASSERT(isComputed());
     return v128_;
   }
+  // Nonzero when tier-1 code counts function hotness and tier-2 compilation
+  // is started lazily; see JumpTables::initHotness.
+  uint32_t tierUpThreshold() const {
+    MOZ_ASSERT(isComputed());
+    return tierUpThreshold_;
+  }
 };
 
 // ModuleEnvironment contains all the state necessary to process or render
@@ -209,6 +216,8 @@ struct ModuleEnvironment {
   bool refTypesEnabled() const { return compilerEnv->refTypes(); }
   bool multiValuesEnabled() const { return compilerEnv->multiValues(); }
   bool v128Enabled() const { return compilerEnv->v128(); }
+  uint32_t tierUpThreshold() const { return compilerEnv->tierUpThreshold(); }
+  bool lazyTiering() const { return tierUpThreshold() != 0; }
   bool usesMemory() const { return memoryUsage != MemoryUsage::None; }
   bool usesSharedMemory() const { return memoryUsage == MemoryUsage::Shared; }
   bool isAsmJS() const { return kind == ModuleKind::AsmJS; }